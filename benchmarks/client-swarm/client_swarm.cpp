@@ -0,0 +1,701 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Puts many Wayland clients on a running server from a single process.
+ *
+ * Each client has its own connection, a wl_shm toplevel and an optional chain
+ * of subsurfaces. Clients commit at a fixed rate (throttled by frame callbacks
+ * and free buffers, as a well behaved client would be) and the time from each
+ * commit to its frame callback and to its buffer release is collected into
+ * histograms. The server's CPU time over the run is read from /proc for the
+ * process at the other end of the first connection.
+ *
+ * With --ramp the clients start committing one at a time instead, and the
+ * server CPU is reported as each is added: the cost of one more client.
+ */
+
+#include <wayland-client.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+enum class DamagePattern
+{
+    full,       // the whole buffer is redrawn and damaged
+    tile,       // one 64x64 tile, moving across the buffer, is redrawn and damaged
+    none        // the buffer is reattached without damage
+};
+
+struct Options
+{
+    int clients = 100;
+    double commit_rate = 60.0;
+    int width = 256;
+    int height = 256;
+    DamagePattern damage = DamagePattern::full;
+    int subsurfaces = 0;
+    int seconds = 10;
+    int ramp_seconds = 0;       // when set, clients start committing one at a time, this long apart
+    pid_t server_pid = 0;
+};
+
+class Histogram
+{
+public:
+    void add(Clock::duration latency)
+    {
+        samples.push_back(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    }
+
+    void print(std::ostream& out, char const* title)
+    {
+        out << title << ": " << samples.size() << " samples\n";
+        if (samples.empty())
+            return;
+
+        std::sort(begin(samples), end(samples));
+        auto const percentile = [this](double p)
+            { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))] / 1000.0; };
+
+        out << std::fixed << std::setprecision(2)
+            << "  p50 " << percentile(0.5) << "ms  p90 " << percentile(0.9) << "ms  p99 " << percentile(0.99)
+            << "ms  max " << samples.back() / 1000.0 << "ms\n";
+
+        // Buckets double from 250µs, which spans a single vsync to badly starved clients
+        std::array<size_t, 12> buckets{};
+        for (auto const sample : samples)
+        {
+            size_t bucket = 0;
+            for (auto limit = 250; sample >= limit && bucket < buckets.size() - 1; limit *= 2)
+                ++bucket;
+            ++buckets[bucket];
+        }
+
+        auto const tallest = *std::max_element(begin(buckets), end(buckets));
+        for (size_t i = 0; i != buckets.size(); ++i)
+        {
+            auto const last = i == buckets.size() - 1;
+            auto const bound = (250 << (last ? i - 1 : i)) / 1000.0;
+            out << (last ? "  >= " : "  <  ") << std::setw(7) << bound << "ms " << std::setw(8) << buckets[i] << ' '
+                << std::string(tallest ? 50 * buckets[i] / tallest : 0, '#') << '\n';
+        }
+    }
+
+private:
+    std::vector<std::chrono::microseconds::rep> samples;
+};
+
+struct Statistics
+{
+    Histogram commit_to_frame;
+    Histogram commit_to_release;
+    uint64_t commits = 0;
+    uint64_t throttled = 0;     // commits that were due but waited for a frame callback or a free buffer
+};
+
+auto make_shm_fd(size_t size) -> int
+{
+    auto const shm_dir = getenv("XDG_RUNTIME_DIR");
+    int fd = shm_dir ? open(shm_dir, O_TMPFILE | O_RDWR | O_EXCL | O_CLOEXEC, S_IRWXU) : -1;
+
+    // Workaround for filesystems that don't support O_TMPFILE
+    if (fd < 0)
+    {
+        char template_filename[] = "/dev/shm/mir-swarm-XXXXXX";
+        fd = mkostemp(template_filename, O_CLOEXEC);
+        if (fd >= 0)
+            unlink(template_filename);
+    }
+
+    if (fd < 0 || posix_fallocate(fd, 0, size) != 0)
+    {
+        if (fd >= 0)
+            close(fd);
+        throw std::system_error{errno, std::system_category(), "Failed to create shm buffer"};
+    }
+
+    return fd;
+}
+
+class Client
+{
+public:
+    Client(Options const& options, int index, Statistics& statistics) :
+        options{options},
+        index{index},
+        statistics{statistics},
+        display{wl_display_connect(nullptr)}
+    {
+        if (!display)
+            throw std::runtime_error{"Failed to connect to the Wayland server"};
+
+        auto const registry = wl_display_get_registry(display);
+        wl_registry_add_listener(registry, &registry_listener, this);
+        wl_display_roundtrip(display);
+        wl_registry_destroy(registry);
+
+        if (!compositor || !shm || !shell || (options.subsurfaces && !subcompositor))
+            throw std::runtime_error{"Server lacks the globals the swarm needs"};
+
+        create_buffers();
+
+        for (int i = 0; i <= options.subsurfaces; ++i)
+        {
+            surfaces.emplace_back();
+            auto& surface = surfaces.back();
+            surface.surface = wl_compositor_create_surface(compositor);
+            for (auto& buffer : surface.buffers)
+            {
+                buffer = &buffers[next_buffer++];
+            }
+
+            if (i == 0)
+            {
+                shell_surface = wl_shell_get_shell_surface(shell, surface.surface);
+                wl_shell_surface_add_listener(shell_surface, &shell_surface_listener, this);
+                wl_shell_surface_set_toplevel(shell_surface);
+            }
+            else
+            {
+                // Each subsurface is a child of the previous one, so deeper trees stress the
+                // synchronized commit path. They are offset so that each one is partly visible.
+                surface.subsurface = wl_subcompositor_get_subsurface(
+                    subcompositor, surface.surface, surfaces[i-1].surface);
+                wl_subsurface_set_position(surface.subsurface, options.width/8, options.height/8);
+            }
+        }
+
+        wl_display_roundtrip(display);
+    }
+
+    ~Client()
+    {
+        if (frame)
+            wl_callback_destroy(frame);
+
+        if (shell_surface)
+            wl_shell_surface_destroy(shell_surface);
+
+        for (auto i = surfaces.rbegin(); i != surfaces.rend(); ++i)
+        {
+            if (i->subsurface)
+                wl_subsurface_destroy(i->subsurface);
+            wl_surface_destroy(i->surface);
+        }
+
+        for (auto& buffer : buffers)
+            wl_buffer_destroy(buffer.buffer);
+
+        if (pool_data != MAP_FAILED)
+            munmap(pool_data, pool_size);
+
+        if (subcompositor)
+            wl_subcompositor_destroy(subcompositor);
+        if (shell)
+            wl_shell_destroy(shell);
+        if (shm)
+            wl_shm_destroy(shm);
+        if (compositor)
+            wl_compositor_destroy(compositor);
+
+        wl_display_disconnect(display);
+    }
+
+    Client(Client const&) = delete;
+    Client& operator=(Client const&) = delete;
+
+    auto wayland_display() const -> wl_display* { return display; }
+
+    auto next_commit() const -> Clock::time_point { return next_commit_; }
+
+    void schedule_first_commit(Clock::time_point start)
+    {
+        // Stagger the clients across the first period so they don't all commit in the same instant
+        auto const period = std::chrono::duration<double>{1.0 / options.commit_rate};
+        next_commit_ = start + std::chrono::duration_cast<Clock::duration>(period * index / options.clients);
+    }
+
+    void commit(Clock::time_point now)
+    {
+        auto const period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>{1.0 / options.commit_rate});
+        next_commit_ += period;
+        if (next_commit_ < now)
+            next_commit_ = now + period;
+
+        if (frame || !std::all_of(begin(surfaces), end(surfaces), [](Surface const& s) { return s.free_buffer(); }))
+        {
+            ++statistics.throttled;
+            return;
+        }
+
+        ++frame_count;
+
+        // Subsurfaces are synchronized, so their state is only applied by the commit of the
+        // toplevel at the root of the tree. Commit children first, leaves to root.
+        for (auto i = surfaces.rbegin(); i != surfaces.rend(); ++i)
+        {
+            auto const buffer = i->free_buffer();
+            draw(*buffer, *i);
+            buffer->busy = true;
+            buffer->committed = now;
+            wl_surface_attach(i->surface, buffer->buffer, 0, 0);
+
+            if (i == surfaces.rend() - 1)
+            {
+                frame = wl_surface_frame(i->surface);
+                wl_callback_add_listener(frame, &frame_listener, this);
+                frame_committed = now;
+            }
+
+            wl_surface_commit(i->surface);
+        }
+
+        ++statistics.commits;
+    }
+
+private:
+    struct Buffer
+    {
+        Client* client;
+        wl_buffer* buffer;
+        uint32_t* pixels;
+        bool busy;
+        Clock::time_point committed;
+    };
+
+    struct Surface
+    {
+        wl_surface* surface = nullptr;
+        wl_subsurface* subsurface = nullptr;
+        std::array<Buffer*, 2> buffers{};
+
+        auto free_buffer() const -> Buffer*
+        {
+            for (auto const buffer : buffers)
+            {
+                if (!buffer->busy)
+                    return buffer;
+            }
+            return nullptr;
+        }
+    };
+
+    void create_buffers()
+    {
+        auto const stride = options.width * 4;
+        auto const buffer_size = static_cast<size_t>(stride) * options.height;
+        auto const count = 2 * (options.subsurfaces + 1);
+
+        pool_size = buffer_size * count;
+        auto const fd = make_shm_fd(pool_size);
+        pool_data = mmap(nullptr, pool_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (pool_data == MAP_FAILED)
+        {
+            close(fd);
+            throw std::system_error{errno, std::system_category(), "Failed to map shm buffer"};
+        }
+
+        auto const pool = wl_shm_create_pool(shm, fd, pool_size);
+        close(fd);
+
+        buffers.resize(count);
+        for (int i = 0; i != count; ++i)
+        {
+            auto& buffer = buffers[i];
+            buffer.client = this;
+            buffer.buffer = wl_shm_pool_create_buffer(
+                pool, i * buffer_size, options.width, options.height, stride, WL_SHM_FORMAT_ARGB8888);
+            buffer.pixels = reinterpret_cast<uint32_t*>(static_cast<char*>(pool_data) + i * buffer_size);
+            buffer.busy = false;
+            wl_buffer_add_listener(buffer.buffer, &buffer_listener, &buffer);
+        }
+
+        wl_shm_pool_destroy(pool);
+    }
+
+    void draw(Buffer& buffer, Surface const& surface)
+    {
+        auto const colour = 0xff000000u | ((index * 0x3f5a7u + frame_count * 0x010203u) & 0x00ffffffu);
+
+        switch (options.damage)
+        {
+        case DamagePattern::full:
+            std::fill_n(buffer.pixels, options.width * options.height, colour);
+            wl_surface_damage(surface.surface, 0, 0, options.width, options.height);
+            break;
+
+        case DamagePattern::tile:
+        {
+            int const tile = std::min({64, options.width, options.height});
+            int const columns = options.width / tile;
+            int const rows = options.height / tile;
+            int const x = (frame_count % columns) * tile;
+            int const y = (frame_count / columns % rows) * tile;
+
+            for (int row = y; row != y + tile; ++row)
+                std::fill_n(buffer.pixels + row * options.width + x, tile, colour);
+
+            wl_surface_damage(surface.surface, x, y, tile, tile);
+            break;
+        }
+
+        case DamagePattern::none:
+            break;
+        }
+    }
+
+    static void new_global(void* data, wl_registry* registry, uint32_t id, char const* interface, uint32_t version)
+    {
+        auto const self = static_cast<Client*>(data);
+
+        if (strcmp(interface, wl_compositor_interface.name) == 0)
+        {
+            self->compositor = static_cast<wl_compositor*>(
+                wl_registry_bind(registry, id, &wl_compositor_interface, std::min(version, 3u)));
+        }
+        else if (strcmp(interface, wl_subcompositor_interface.name) == 0)
+        {
+            self->subcompositor = static_cast<wl_subcompositor*>(
+                wl_registry_bind(registry, id, &wl_subcompositor_interface, 1));
+        }
+        else if (strcmp(interface, wl_shm_interface.name) == 0)
+        {
+            self->shm = static_cast<wl_shm*>(wl_registry_bind(registry, id, &wl_shm_interface, 1));
+        }
+        else if (strcmp(interface, wl_shell_interface.name) == 0)
+        {
+            self->shell = static_cast<wl_shell*>(wl_registry_bind(registry, id, &wl_shell_interface, 1));
+        }
+    }
+
+    static void remove_global(void*, wl_registry*, uint32_t)
+    {
+    }
+
+    static void frame_done(void* data, wl_callback* callback, uint32_t)
+    {
+        auto const self = static_cast<Client*>(data);
+        self->statistics.commit_to_frame.add(Clock::now() - self->frame_committed);
+        wl_callback_destroy(callback);
+        self->frame = nullptr;
+    }
+
+    static void buffer_released(void* data, wl_buffer*)
+    {
+        auto const buffer = static_cast<Buffer*>(data);
+        buffer->client->statistics.commit_to_release.add(Clock::now() - buffer->committed);
+        buffer->busy = false;
+    }
+
+    static void ping(void*, wl_shell_surface* shell_surface, uint32_t serial)
+    {
+        wl_shell_surface_pong(shell_surface, serial);
+    }
+
+    static void configure(void*, wl_shell_surface*, uint32_t, int32_t, int32_t)
+    {
+    }
+
+    static void popup_done(void*, wl_shell_surface*)
+    {
+    }
+
+    static wl_registry_listener const registry_listener;
+    static wl_callback_listener const frame_listener;
+    static wl_buffer_listener const buffer_listener;
+    static wl_shell_surface_listener const shell_surface_listener;
+
+    Options const& options;
+    int const index;
+    Statistics& statistics;
+
+    wl_display* const display;
+    wl_compositor* compositor = nullptr;
+    wl_subcompositor* subcompositor = nullptr;
+    wl_shm* shm = nullptr;
+    wl_shell* shell = nullptr;
+    wl_shell_surface* shell_surface = nullptr;
+
+    void* pool_data = MAP_FAILED;
+    size_t pool_size = 0;
+    std::vector<Buffer> buffers;
+    size_t next_buffer = 0;
+    std::vector<Surface> surfaces;
+
+    wl_callback* frame = nullptr;
+    Clock::time_point frame_committed;
+    Clock::time_point next_commit_;
+    int frame_count = 0;
+};
+
+wl_registry_listener const Client::registry_listener = { &Client::new_global, &Client::remove_global };
+wl_callback_listener const Client::frame_listener = { &Client::frame_done };
+wl_buffer_listener const Client::buffer_listener = { &Client::buffer_released };
+wl_shell_surface_listener const Client::shell_surface_listener =
+    { &Client::ping, &Client::configure, &Client::popup_done };
+
+auto server_pid_for(wl_display* display) -> pid_t
+{
+    ucred credentials;
+    socklen_t length = sizeof credentials;
+    if (getsockopt(wl_display_get_fd(display), SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0)
+        return 0;
+    return credentials.pid;
+}
+
+// utime + stime of the whole process (all threads), in seconds
+auto process_cpu_seconds(pid_t pid) -> double
+{
+    std::ifstream stat{"/proc/" + std::to_string(pid) + "/stat"};
+    std::string contents{std::istreambuf_iterator<char>{stat}, std::istreambuf_iterator<char>{}};
+
+    // The command name is in parentheses and may contain spaces, so count fields from after it
+    auto const end_of_name = contents.rfind(')');
+    if (end_of_name == std::string::npos)
+        return -1;
+
+    std::istringstream fields{contents.substr(end_of_name + 2)};
+    std::string field;
+    unsigned long long utime = 0, stime = 0;
+    for (int i = 3; i != 14 && fields >> field; ++i)
+        ;
+    fields >> utime >> stime;
+
+    return double(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+/// Runs the first \a active clients (and dispatches events for them all) until \a finish
+void drive(std::vector<std::unique_ptr<Client>> const& clients, size_t active, Clock::time_point finish)
+{
+    std::vector<pollfd> fds(clients.size());
+    for (size_t i = 0; i != clients.size(); ++i)
+        fds[i] = {wl_display_get_fd(clients[i]->wayland_display()), POLLIN, 0};
+
+    for (auto now = Clock::now(); now < finish; now = Clock::now())
+    {
+        auto next_commit = finish;
+        for (size_t i = 0; i != active; ++i)
+        {
+            auto const& client = clients[i];
+            if (client->next_commit() <= now)
+                client->commit(now);
+            next_commit = std::min(next_commit, client->next_commit());
+        }
+
+        for (auto const& client : clients)
+        {
+            auto const display = client->wayland_display();
+            while (wl_display_prepare_read(display) != 0)
+                wl_display_dispatch_pending(display);
+            wl_display_flush(display);
+        }
+
+        auto const timeout = std::chrono::duration_cast<std::chrono::milliseconds>(next_commit - Clock::now());
+        auto const ready = poll(fds.data(), fds.size(), std::max<int>(0, timeout.count()));
+
+        for (size_t i = 0; i != clients.size(); ++i)
+        {
+            auto const display = clients[i]->wayland_display();
+            if (ready > 0 && (fds[i].revents & (POLLIN | POLLERR | POLLHUP)))
+            {
+                if (wl_display_read_events(display) != 0)
+                    throw std::runtime_error{"Lost connection to the Wayland server"};
+            }
+            else
+            {
+                wl_display_cancel_read(display);
+            }
+            wl_display_dispatch_pending(display);
+        }
+    }
+}
+
+/*
+ * Starts the clients one at a time, holding each count for ramp_seconds, so that
+ * the server CPU each additional client costs is measured rather than averaged.
+ */
+void ramp(Options const& options, std::vector<std::unique_ptr<Client>> const& clients, pid_t server_pid)
+{
+    auto const step = std::chrono::seconds{options.ramp_seconds};
+
+    auto const measure = [&](size_t active)
+        {
+            auto const cpu_before = process_cpu_seconds(server_pid);
+            auto const start = Clock::now();
+            drive(clients, active, start + step);
+            auto const elapsed = std::chrono::duration<double>{Clock::now() - start}.count();
+            return 100 * (process_cpu_seconds(server_pid) - cpu_before) / elapsed;
+        };
+
+    // Every client is connected, but none are committing yet
+    auto previous = measure(0);
+    auto const idle = previous;
+    std::cout << std::fixed << std::setprecision(2)
+              << "server (pid " << server_pid << ") CPU with " << clients.size() << " idle clients: " << idle << "%\n";
+
+    for (size_t active = 1; active <= clients.size(); ++active)
+    {
+        clients[active - 1]->schedule_first_commit(Clock::now());
+        auto const cpu = measure(active);
+        std::cout << "  " << std::setw(4) << active << " committing: " << std::setw(7) << cpu << "% ("
+                  << std::showpos << cpu - previous << std::noshowpos << "%)\n";
+        previous = cpu;
+    }
+
+    std::cout << "server CPU added by each committing client: " << (previous - idle) / clients.size() << "%\n";
+}
+
+void run(Options const& options)
+{
+    Statistics statistics;
+    std::vector<std::unique_ptr<Client>> clients;
+    clients.reserve(options.clients);
+
+    for (int i = 0; i != options.clients; ++i)
+        clients.push_back(std::make_unique<Client>(options, i, statistics));
+
+    auto const server_pid = options.server_pid ? options.server_pid : server_pid_for(clients.front()->wayland_display());
+
+    if (options.ramp_seconds)
+    {
+        if (!server_pid || process_cpu_seconds(server_pid) < 0)
+            throw std::runtime_error{"--ramp needs the server's CPU time, which is unavailable"};
+
+        ramp(options, clients, server_pid);
+        return;
+    }
+
+    auto const server_cpu_before = server_pid ? process_cpu_seconds(server_pid) : -1;
+
+    auto const start = Clock::now();
+    for (auto const& client : clients)
+        client->schedule_first_commit(start);
+
+    drive(clients, clients.size(), start + std::chrono::seconds{options.seconds});
+
+    auto const elapsed = std::chrono::duration<double>{Clock::now() - start}.count();
+    auto const server_cpu_after = server_pid ? process_cpu_seconds(server_pid) : -1;
+
+    std::cout << options.clients << " clients, " << options.subsurfaces << " subsurfaces each, "
+              << options.width << 'x' << options.height << " buffers at " << options.commit_rate << "Hz for "
+              << std::fixed << std::setprecision(2) << elapsed << "s\n"
+              << statistics.commits << " commits (" << statistics.commits / elapsed << "/s), "
+              << statistics.throttled << " throttled\n";
+
+    if (server_cpu_before >= 0 && server_cpu_after >= 0)
+    {
+        auto const server_cpu = server_cpu_after - server_cpu_before;
+        std::cout << "server (pid " << server_pid << ") CPU: " << 100 * server_cpu / elapsed << "%\n";
+    }
+    else
+    {
+        std::cout << "server CPU: unavailable\n";
+    }
+
+    statistics.commit_to_frame.print(std::cout, "commit to frame callback");
+    statistics.commit_to_release.print(std::cout, "commit to buffer release");
+}
+
+void usage(char const* name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --clients <count>       clients to connect (default: 100)\n"
+              << "  --rate <hz>             commits per second per client (default: 60)\n"
+              << "  --size <w>x<h>          buffer size (default: 256x256)\n"
+              << "  --damage full|tile|none damage pattern of each commit (default: full)\n"
+              << "  --subsurfaces <depth>   nested subsurfaces per client (default: 0)\n"
+              << "  --seconds <duration>    length of the run (default: 10)\n"
+              << "  --server-pid <pid>      process to measure CPU of (default: the peer of the connection)\n"
+              << "  --ramp <seconds>        start clients one at a time, measuring the server CPU each adds\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--clients") && i+1 < argc)
+            options.clients = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i+1 < argc)
+            options.commit_rate = std::atof(argv[++i]);
+        else if (!strcmp(argv[i], "--size") && i+1 < argc && sscanf(argv[i+1], "%dx%d", &options.width, &options.height) == 2)
+            ++i;
+        else if (!strcmp(argv[i], "--damage") && i+1 < argc && !strcmp(argv[i+1], "full"))
+            options.damage = DamagePattern::full, ++i;
+        else if (!strcmp(argv[i], "--damage") && i+1 < argc && !strcmp(argv[i+1], "tile"))
+            options.damage = DamagePattern::tile, ++i;
+        else if (!strcmp(argv[i], "--damage") && i+1 < argc && !strcmp(argv[i+1], "none"))
+            options.damage = DamagePattern::none, ++i;
+        else if (!strcmp(argv[i], "--subsurfaces") && i+1 < argc)
+            options.subsurfaces = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seconds") && i+1 < argc)
+            options.seconds = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--server-pid") && i+1 < argc)
+            options.server_pid = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ramp") && i+1 < argc)
+            options.ramp_seconds = std::atoi(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (options.clients < 1 || options.commit_rate <= 0 || options.width < 1 || options.height < 1 ||
+        options.subsurfaces < 0 || options.seconds < 1 || options.ramp_seconds < 0)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    run(options);
+    return EXIT_SUCCESS;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}
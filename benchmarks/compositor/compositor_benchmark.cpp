@@ -0,0 +1,342 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the CPU cost of the compositor's per-frame work on synthetic scenes.
+ *
+ * Everything runs in-process on stub buffers and a stub display buffer, so no
+ * GPU or display hardware is needed. Rendering goes through a stub renderer,
+ * so the "submit" and "composite" phases measure the scene traversal and
+ * submission overhead around the renderer, not the cost of any real (GL)
+ * renderer. Results are written to stdout as tab
+ * separated "scene phase median_ns p95_ns" lines; a previous run can be given
+ * as a baseline, in which case the exit status reports any regression.
+ */
+
+#include "src/server/compositor/default_display_buffer_compositor.h"
+#include "src/server/compositor/occlusion.h"
+#include "src/server/scene/surface_stack.h"
+#include "src/server/scene/basic_surface.h"
+#include "src/server/report/null_report_factory.h"
+
+#include "mir/compositor/scene_element.h"
+#include "mir/graphics/renderable.h"
+#include "mir/renderer/renderer.h"
+#include "mir/scene/surface_creation_parameters.h"
+#include "mir/test/doubles/stub_buffer_stream.h"
+#include "mir/test/doubles/stub_display_buffer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+namespace mc = mir::compositor;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace mr = mir::report;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+namespace
+{
+geom::Rectangle const output_area{{0, 0}, {1920, 1080}};
+
+struct SceneShape
+{
+    std::string name;
+    int surface_count;
+    bool overlapping;
+    bool translucent;
+    bool transformed;
+};
+
+// Touches each renderable the way a real renderer would, but draws nothing
+class StubRenderer : public mir::renderer::Renderer
+{
+public:
+    void set_viewport(geom::Rectangle const& rect) override { viewport = rect; }
+    void set_output_transform(glm::mat2 const&) override {}
+    void suspend() override {}
+
+    void render(mg::RenderableList const& renderables) const override
+    {
+        for (auto const& renderable : renderables)
+        {
+            auto const buffer = renderable->buffer();
+            auto const position = renderable->screen_position();
+            auto const transformation = renderable->transformation();
+
+            if (!viewport.overlaps(position) || !buffer)
+                continue;
+
+            if (renderable->alpha() < 1.0f || renderable->shaped())
+                ++blended;
+
+            checksum += transformation[0][0] + position.size.width.as_int();
+        }
+    }
+
+    mutable unsigned blended = 0;
+    mutable float checksum = 0;
+
+private:
+    geom::Rectangle viewport;
+};
+
+auto make_scene(SceneShape const& shape, ms::SurfaceStack& stack) -> std::vector<std::shared_ptr<ms::BasicSurface>>
+{
+    // A fixed seed so that every run measures the same scenes
+    std::mt19937 random{static_cast<std::mt19937::result_type>(shape.surface_count)};
+    std::uniform_int_distribution<int> width{64, 800};
+    std::uniform_int_distribution<int> height{64, 600};
+
+    std::vector<std::shared_ptr<ms::BasicSurface>> surfaces;
+    ms::SurfaceCreationParameters const params;
+
+    int const columns = 16;
+    geom::Size const tile{output_area.size.width.as_int()/columns, output_area.size.height.as_int()/columns};
+
+    for (int i = 0; i != shape.surface_count; ++i)
+    {
+        geom::Rectangle rect;
+        if (shape.overlapping)
+        {
+            geom::Size const size{width(random), height(random)};
+            std::uniform_int_distribution<int> x{-size.width.as_int()/2, output_area.size.width.as_int()};
+            std::uniform_int_distribution<int> y{-size.height.as_int()/2, output_area.size.height.as_int()};
+            rect = {{x(random), y(random)}, size};
+        }
+        else
+        {
+            rect = {{(i % columns) * tile.width.as_int(), ((i / columns) % columns) * tile.height.as_int()}, tile};
+        }
+
+        auto const surface = std::make_shared<ms::BasicSurface>(
+            nullptr /* session */,
+            "benchmark",
+            rect,
+            mir_pointer_unconfined,
+            std::list<ms::StreamInfo>{{std::make_shared<mtd::StubBufferStream>(), {}, {}}},
+            std::shared_ptr<mg::CursorImage>(),
+            mr::null_scene_report());
+
+        if (shape.translucent)
+            surface->set_alpha(0.75f);
+
+        if (shape.transformed)
+            surface->set_transformation(glm::rotate(glm::mat4{1.0f}, 0.1f * (i % 8), glm::vec3{0.0f, 0.0f, 1.0f}));
+
+        stack.add_surface(surface, params.input_mode);
+        surfaces.push_back(surface);
+    }
+
+    return surfaces;
+}
+
+auto thread_cpu_ns() -> long long
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+struct Statistics
+{
+    long long median_ns;
+    long long p95_ns;
+};
+
+auto summarise(std::vector<long long>& samples) -> Statistics
+{
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[(samples.size() * 95) / 100]};
+}
+
+// Times the "measured" part of each frame; "prepare" runs untimed beforehand.
+template<typename Prepare, typename Measured>
+auto measure(int frames, Prepare prepare, Measured measured) -> Statistics
+{
+    std::vector<long long> samples;
+    samples.reserve(frames);
+
+    for (int frame = 0; frame != frames; ++frame)
+    {
+        auto input = prepare();
+        auto const start = thread_cpu_ns();
+        measured(input);
+        samples.push_back(thread_cpu_ns() - start);
+    }
+
+    return summarise(samples);
+}
+
+using Results = std::map<std::string, Statistics>;
+
+void run_scene(SceneShape const& shape, int frames, Results& results)
+{
+    ms::SurfaceStack stack{mr::null_scene_report()};
+    auto const surfaces = make_scene(shape, stack);
+
+    mtd::StubDisplayBuffer display_buffer{output_area};
+    auto const renderer = std::make_shared<StubRenderer>();
+    renderer->set_viewport(output_area);
+    mc::DefaultDisplayBufferCompositor compositor{display_buffer, renderer, mr::null_compositor_report()};
+    void const* const compositor_id = &compositor;
+
+    auto const no_input = [] { return 0; };
+    auto const scene_elements = [&] { return stack.scene_elements_for(compositor_id); };
+
+    results[shape.name + "\tscene_elements_for"] = measure(frames, no_input,
+        [&](int) { stack.scene_elements_for(compositor_id); });
+
+    results[shape.name + "\tfilter_occlusions_from"] = measure(frames, scene_elements,
+        [&](mc::SceneElementSequence& elements) { mc::filter_occlusions_from(elements, output_area); });
+
+    results[shape.name + "\tsubmit"] = measure(frames,
+        [&]
+        {
+            mg::RenderableList renderables;
+            for (auto const& element : stack.scene_elements_for(compositor_id))
+                renderables.push_back(element->renderable());
+            return renderables;
+        },
+        [&](mg::RenderableList& renderables) { renderer->render(renderables); });
+
+    results[shape.name + "\tcomposite"] = measure(frames, scene_elements,
+        [&](mc::SceneElementSequence& elements) { compositor.composite(std::move(elements)); });
+
+    for (auto const& surface : surfaces)
+        stack.remove_surface(surface);
+}
+
+auto read_results(std::string const& filename) -> Results
+{
+    Results results;
+    std::ifstream file{filename};
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields{line};
+        std::string scene, phase;
+        Statistics statistics;
+        if (fields >> scene >> phase >> statistics.median_ns >> statistics.p95_ns)
+            results[scene + "\t" + phase] = statistics;
+    }
+
+    if (results.empty())
+        throw std::runtime_error{"No benchmark results in baseline: " + filename};
+
+    return results;
+}
+
+void usage(char const* name)
+{
+    std::cerr << "Usage: " << name << " [--frames <count>] [--baseline <file> [--tolerance <fraction>]]\n"
+              << "  --frames     frames measured per scene and phase (default: 500)\n"
+              << "  --baseline   results of an earlier run to compare the median times against\n"
+              << "  --tolerance  allowed slowdown against the baseline (default: 0.15)\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    int frames = 500;
+    std::string baseline;
+    double tolerance = 0.15;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--frames") && i+1 < argc)
+            frames = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--baseline") && i+1 < argc)
+            baseline = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && i+1 < argc)
+            tolerance = std::atof(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (frames < 1)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<SceneShape> shapes;
+    for (auto const count : {10, 50, 200})
+    {
+        auto const n = std::to_string(count);
+        shapes.push_back({"tiled-" + n,       count, false, false, false});
+        shapes.push_back({"overlapping-" + n, count, true,  false, false});
+        shapes.push_back({"translucent-" + n, count, true,  true,  false});
+        shapes.push_back({"transformed-" + n, count, true,  false, true});
+    }
+
+    Results results;
+    for (auto const& shape : shapes)
+        run_scene(shape, frames, results);
+
+    std::cout << "# scene\tphase\tmedian_ns\tp95_ns\n";
+    for (auto const& result : results)
+        std::cout << result.first << '\t' << result.second.median_ns << '\t' << result.second.p95_ns << '\n';
+
+    if (baseline.empty())
+        return EXIT_SUCCESS;
+
+    int regressions = 0;
+    for (auto const& expected : read_results(baseline))
+    {
+        auto const actual = results.find(expected.first);
+        if (actual == results.end())
+            continue;
+
+        auto const limit = expected.second.median_ns * (1.0 + tolerance);
+        if (actual->second.median_ns > limit)
+        {
+            std::cerr << "REGRESSION: " << expected.first << " median " << actual->second.median_ns
+                      << "ns exceeds baseline " << expected.second.median_ns << "ns by more than "
+                      << tolerance * 100 << "%\n";
+            ++regressions;
+        }
+    }
+
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,709 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures touch latency through each stage of an in-process server.
+ *
+ * Touch events are injected through a fake input device at a fixed rate, each
+ * stamped with the time it was injected. The same event is then seen by a seat
+ * observer, by an observer on the target surface (after SurfaceInputDispatcher
+ * has chosen it), when the Wayland client's socket becomes readable and when
+ * the client's wl_touch listener runs. Events are matched across stages by
+ * their timestamp, which Wayland carries in milliseconds, so injection is
+ * limited to one event per millisecond.
+ *
+ * Optionally, a number of Wayland clients redraw continuously to load the
+ * compositor and the Wayland thread while the measurement runs.
+ */
+
+#include <miral/internal_client.h>
+#include <miral/minimal_window_manager.h>
+#include <miral/test_display_server.h>
+#include <miral/window_info.h>
+
+#include <mir/input/device.h>
+#include <mir/input/device_capability.h>
+#include <mir/input/input_device_hub.h>
+#include <mir/input/input_device_info.h>
+#include <mir/input/input_device_observer.h>
+#include <mir/input/seat_observer.h>
+#include <mir/observer_registrar.h>
+#include <mir/scene/null_surface_observer.h>
+#include <mir/scene/surface.h>
+#include <mir/server.h>
+#include <mir_toolkit/events/event.h>
+#include <mir_toolkit/events/input/input_event.h>
+
+#include <mir_test_framework/fake_input_device.h>
+#include <mir_test_framework/stub_server_platform_factory.h>
+#include <mir/test/event_factory.h>
+#include <mir/test/signal.h>
+
+#include <wayland-client.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+namespace ms = mir::scene;
+namespace mtf = mir_test_framework;
+namespace synthesis = mir::input::synthesis;
+using namespace std::chrono_literals;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+char const* const probe_title = "input-latency-probe";
+
+enum Stage
+{
+    injected,       // handed to the fake input device
+    seat,           // dispatched by the seat
+    surface,        // consumed by the target surface
+    delivered,      // the client's connection became readable
+    received,       // the client's wl_touch listener ran
+    stage_count
+};
+
+auto now() -> std::chrono::nanoseconds
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch());
+}
+
+// Wayland input events carry a 32 bit millisecond timestamp, derived from the Mir event time
+auto key_for(std::chrono::nanoseconds event_time) -> uint32_t
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(event_time).count();
+}
+
+class StageTimes
+{
+public:
+    void record(Stage stage, uint32_t key, std::chrono::nanoseconds time)
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+
+        // Ignore anything not injected by the benchmark (such as the initial touch down)
+        if (stage != injected && !records.count(key))
+            return;
+
+        auto& times = records[key];
+        if (times[stage] == std::chrono::nanoseconds::zero())
+            times[stage] = time;
+    }
+
+    void record_event(Stage stage, MirEvent const* event)
+    {
+        if (mir_event_get_type(event) != mir_event_type_input)
+            return;
+
+        auto const input_event = mir_event_get_input_event(event);
+        if (mir_input_event_get_type(input_event) != mir_input_event_type_touch)
+            return;
+
+        record(stage, key_for(std::chrono::nanoseconds{mir_input_event_get_event_time(input_event)}), now());
+    }
+
+    void print(std::ostream& out) const
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+
+        struct Interval { char const* name; Stage from; Stage to; };
+        Interval const intervals[] = {
+            {"platform-to-seat",       injected,  seat},
+            {"seat-to-surface",        seat,      surface},
+            {"surface-to-wayland",     surface,   delivered},
+            {"wayland-to-client",      delivered, received},
+            {"total",                  injected,  received}};
+
+        size_t incomplete = 0;
+        for (auto const& entry : records)
+        {
+            if (std::any_of(begin(entry.second), end(entry.second),
+                    [](auto time) { return time == std::chrono::nanoseconds::zero(); }))
+            {
+                ++incomplete;
+            }
+        }
+
+        out << "# " << records.size() << " events injected, " << incomplete << " not seen at every stage\n"
+            << "# stage\tcount\tp50_us\tp90_us\tp99_us\tmax_us\n";
+
+        for (auto const& interval : intervals)
+        {
+            std::vector<double> samples;
+            for (auto const& entry : records)
+            {
+                auto const& times = entry.second;
+                if (times[interval.from] != std::chrono::nanoseconds::zero() &&
+                    times[interval.to] != std::chrono::nanoseconds::zero())
+                {
+                    samples.push_back((times[interval.to] - times[interval.from]).count() / 1000.0);
+                }
+            }
+
+            out << interval.name << '\t' << samples.size();
+            if (samples.empty())
+            {
+                out << "\t-\t-\t-\t-\n";
+                continue;
+            }
+
+            std::sort(begin(samples), end(samples));
+            auto const percentile = [&](double p)
+                { return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))]; };
+
+            out << std::fixed << std::setprecision(1)
+                << '\t' << percentile(0.5) << '\t' << percentile(0.9) << '\t' << percentile(0.99)
+                << '\t' << samples.back() << '\n';
+        }
+    }
+
+private:
+    std::mutex mutable mutex;
+    std::map<uint32_t, std::array<std::chrono::nanoseconds, stage_count>> records;
+};
+
+struct SeatStage : mi::SeatObserver
+{
+    explicit SeatStage(StageTimes& times) : times{times} {}
+
+    void seat_dispatch_event(std::shared_ptr<MirEvent const> const& event) override
+    {
+        times.record_event(seat, event.get());
+    }
+
+    void seat_add_device(uint64_t) override {}
+    void seat_remove_device(uint64_t) override {}
+    void seat_set_key_state(uint64_t, std::vector<uint32_t> const&) override {}
+    void seat_set_pointer_state(uint64_t, unsigned) override {}
+    void seat_set_cursor_position(float, float) override {}
+    void seat_set_confinement_region_called(mir::geometry::Rectangles const&) override {}
+    void seat_reset_confinement_regions() override {}
+
+    StageTimes& times;
+};
+
+struct SurfaceStage : ms::NullSurfaceObserver
+{
+    explicit SurfaceStage(StageTimes& times) : times{times} {}
+
+    void input_consumed(ms::Surface const*, MirEvent const* event) override
+    {
+        times.record_event(surface, event);
+    }
+
+    StageTimes& times;
+};
+
+// Attaches the surface stage observer to the probe window as it is created
+class ProbeObservingPolicy : public miral::MinimalWindowManager
+{
+public:
+    ProbeObservingPolicy(miral::WindowManagerTools const& tools, std::shared_ptr<SurfaceStage> const& observer) :
+        MinimalWindowManager{tools},
+        observer{observer}
+    {
+    }
+
+    void advise_new_window(miral::WindowInfo const& window_info) override
+    {
+        MinimalWindowManager::advise_new_window(window_info);
+
+        if (window_info.name() == probe_title)
+        {
+            std::shared_ptr<ms::Surface> const surface{window_info.window()};
+            surface->add_observer(observer);
+        }
+    }
+
+private:
+    std::shared_ptr<SurfaceStage> const observer;
+};
+
+struct DeviceAdded : mi::InputDeviceObserver
+{
+    void device_added(std::shared_ptr<mi::Device> const&) override { added.raise(); }
+    void device_changed(std::shared_ptr<mi::Device> const&) override {}
+    void device_removed(std::shared_ptr<mi::Device> const&) override {}
+    void changes_complete() override {}
+
+    mir::test::Signal added;
+};
+
+auto make_shm_buffer(wl_shm* shm, int width, int height, uint32_t colour) -> wl_buffer*
+{
+    auto const stride = width * 4;
+    auto const size = stride * height;
+
+    char template_filename[] = "/dev/shm/mir-input-latency-XXXXXX";
+    auto const fd = mkostemp(template_filename, O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    unlink(template_filename);
+
+    if (posix_fallocate(fd, 0, size) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    auto const data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data != MAP_FAILED)
+    {
+        std::fill_n(static_cast<uint32_t*>(data), width * height, colour);
+        munmap(data, size);
+    }
+
+    auto const pool = wl_shm_create_pool(shm, fd, size);
+    auto const buffer = wl_shm_pool_create_buffer(pool, 0, width, height, stride, WL_SHM_FORMAT_ARGB8888);
+    wl_shm_pool_destroy(pool);
+    close(fd);
+
+    return buffer;
+}
+
+// The globals every client binds, and a window built from them
+class WaylandWindow
+{
+public:
+    WaylandWindow(wl_display* display, char const* title, bool fullscreen) :
+        display{display}
+    {
+        auto const registry = wl_display_get_registry(display);
+        wl_registry_add_listener(registry, &registry_listener, this);
+        wl_display_roundtrip(display);
+        wl_registry_destroy(registry);
+
+        surface = wl_compositor_create_surface(compositor);
+        shell_surface = wl_shell_get_shell_surface(shell, surface);
+        wl_shell_surface_add_listener(shell_surface, &shell_surface_listener, this);
+        wl_shell_surface_set_title(shell_surface, title);
+
+        if (fullscreen)
+            wl_shell_surface_set_fullscreen(shell_surface, WL_SHELL_SURFACE_FULLSCREEN_METHOD_DEFAULT, 0, nullptr);
+        else
+            wl_shell_surface_set_toplevel(shell_surface);
+
+        wl_display_roundtrip(display);
+
+        buffers[0] = make_shm_buffer(shm, width, height, 0xff303030);
+        buffers[1] = make_shm_buffer(shm, width, height, 0xff606060);
+    }
+
+    ~WaylandWindow()
+    {
+        for (auto const buffer : buffers)
+        {
+            if (buffer)
+                wl_buffer_destroy(buffer);
+        }
+
+        wl_shell_surface_destroy(shell_surface);
+        wl_surface_destroy(surface);
+
+        if (seat_)
+            wl_seat_destroy(seat_);
+        wl_shell_destroy(shell);
+        wl_shm_destroy(shm);
+        wl_compositor_destroy(compositor);
+    }
+
+    WaylandWindow(WaylandWindow const&) = delete;
+    WaylandWindow& operator=(WaylandWindow const&) = delete;
+
+    // Attaches the next buffer, alternating so that each commit has new content
+    void draw(wl_callback_listener const* frame_listener, void* data)
+    {
+        if (frame_listener)
+        {
+            auto const frame = wl_surface_frame(surface);
+            wl_callback_add_listener(frame, frame_listener, data);
+        }
+
+        wl_surface_attach(surface, buffers[next_buffer], 0, 0);
+        wl_surface_damage(surface, 0, 0, width, height);
+        wl_surface_commit(surface);
+        next_buffer = (next_buffer + 1) % buffers.size();
+    }
+
+    auto seat() const -> wl_seat* { return seat_; }
+
+private:
+    static void new_global(void* data, wl_registry* registry, uint32_t id, char const* interface, uint32_t)
+    {
+        auto const self = static_cast<WaylandWindow*>(data);
+
+        if (strcmp(interface, wl_compositor_interface.name) == 0)
+            self->compositor = static_cast<wl_compositor*>(wl_registry_bind(registry, id, &wl_compositor_interface, 1));
+        else if (strcmp(interface, wl_shm_interface.name) == 0)
+            self->shm = static_cast<wl_shm*>(wl_registry_bind(registry, id, &wl_shm_interface, 1));
+        else if (strcmp(interface, wl_shell_interface.name) == 0)
+            self->shell = static_cast<wl_shell*>(wl_registry_bind(registry, id, &wl_shell_interface, 1));
+        else if (strcmp(interface, wl_seat_interface.name) == 0 && !self->seat_)
+            self->seat_ = static_cast<wl_seat*>(wl_registry_bind(registry, id, &wl_seat_interface, 1));
+    }
+
+    static void remove_global(void*, wl_registry*, uint32_t) {}
+
+    static void ping(void*, wl_shell_surface* shell_surface, uint32_t serial)
+    {
+        wl_shell_surface_pong(shell_surface, serial);
+    }
+
+    static void configure(void* data, wl_shell_surface*, uint32_t, int32_t width, int32_t height)
+    {
+        auto const self = static_cast<WaylandWindow*>(data);
+        if (width > 0 && height > 0 && !self->buffers[0])
+        {
+            self->width = width;
+            self->height = height;
+        }
+    }
+
+    static void popup_done(void*, wl_shell_surface*) {}
+
+    static wl_registry_listener const registry_listener;
+    static wl_shell_surface_listener const shell_surface_listener;
+
+    wl_display* const display;
+    wl_compositor* compositor = nullptr;
+    wl_shm* shm = nullptr;
+    wl_shell* shell = nullptr;
+    wl_seat* seat_ = nullptr;
+    wl_surface* surface = nullptr;
+    wl_shell_surface* shell_surface = nullptr;
+    int width = 400;
+    int height = 400;
+    std::array<wl_buffer*, 2> buffers{};
+    size_t next_buffer = 0;
+};
+
+wl_registry_listener const WaylandWindow::registry_listener = {&new_global, &remove_global};
+wl_shell_surface_listener const WaylandWindow::shell_surface_listener = {&ping, &configure, &popup_done};
+
+// A fullscreen window that records when touch events reach the client
+class ProbeClient
+{
+public:
+    ProbeClient(StageTimes& times, std::atomic<bool> const& stopping) :
+        times{times},
+        stopping{stopping}
+    {
+    }
+
+    void operator()(wl_display* display)
+    {
+        WaylandWindow window{display, probe_title, true};
+        wl_seat_add_listener(window.seat(), &seat_listener, this);
+        window.draw(nullptr, nullptr);
+        wl_display_roundtrip(display);
+        ready_.raise();
+
+        pollfd fd{wl_display_get_fd(display), POLLIN, 0};
+        while (!stopping)
+        {
+            while (wl_display_prepare_read(display) != 0)
+                wl_display_dispatch_pending(display);
+            wl_display_flush(display);
+
+            if (poll(&fd, 1, 100) > 0)
+            {
+                // The server has written to the socket: this is when the event was delivered
+                woken = now();
+                wl_display_read_events(display);
+            }
+            else
+            {
+                wl_display_cancel_read(display);
+            }
+            wl_display_dispatch_pending(display);
+        }
+
+        if (touch)
+            wl_touch_destroy(touch);
+    }
+
+    void operator()(std::weak_ptr<ms::Session> const&) {}
+
+    auto ready() -> mir::test::Signal& { return ready_; }
+
+private:
+    void touched(uint32_t time)
+    {
+        times.record(delivered, time, woken);
+        times.record(received, time, now());
+    }
+
+    static void seat_capabilities(void* data, wl_seat* seat, uint32_t capabilities)
+    {
+        auto const self = static_cast<ProbeClient*>(data);
+        if ((capabilities & WL_SEAT_CAPABILITY_TOUCH) && !self->touch)
+        {
+            self->touch = wl_seat_get_touch(seat);
+            wl_touch_add_listener(self->touch, &touch_listener, self);
+        }
+    }
+
+    static void seat_name(void*, wl_seat*, char const*) {}
+
+    static void touch_down(void* data, wl_touch*, uint32_t, uint32_t time, wl_surface*, int32_t, wl_fixed_t, wl_fixed_t)
+    {
+        static_cast<ProbeClient*>(data)->touched(time);
+    }
+
+    static void touch_up(void* data, wl_touch*, uint32_t, uint32_t time, int32_t)
+    {
+        static_cast<ProbeClient*>(data)->touched(time);
+    }
+
+    static void touch_motion(void* data, wl_touch*, uint32_t time, int32_t, wl_fixed_t, wl_fixed_t)
+    {
+        static_cast<ProbeClient*>(data)->touched(time);
+    }
+
+    static void touch_frame(void*, wl_touch*) {}
+    static void touch_cancel(void*, wl_touch*) {}
+
+    static wl_seat_listener const seat_listener;
+    static wl_touch_listener const touch_listener;
+
+    StageTimes& times;
+    std::atomic<bool> const& stopping;
+    mir::test::Signal ready_;
+    wl_touch* touch = nullptr;
+    std::chrono::nanoseconds woken{};
+};
+
+wl_seat_listener const ProbeClient::seat_listener = {&seat_capabilities, &seat_name};
+wl_touch_listener const ProbeClient::touch_listener = []
+    {
+        // Newer versions of libwayland add members for later versions of wl_touch, which we don't bind
+        wl_touch_listener listener{};
+        listener.down = &touch_down;
+        listener.up = &touch_up;
+        listener.motion = &touch_motion;
+        listener.frame = &touch_frame;
+        listener.cancel = &touch_cancel;
+        return listener;
+    }();
+
+// A window that redraws on every frame callback, to keep the compositor busy
+class LoadClient
+{
+public:
+    explicit LoadClient(std::atomic<bool> const& stopping) : stopping{stopping} {}
+
+    void operator()(wl_display* display)
+    {
+        WaylandWindow window{display, "input-latency-load", false};
+        this->window = &window;
+        window.draw(&frame_listener, this);
+
+        while (!stopping && wl_display_dispatch(display) != -1)
+            ;
+
+        this->window = nullptr;
+    }
+
+    void operator()(std::weak_ptr<ms::Session> const&) {}
+
+private:
+    static void frame_done(void* data, wl_callback* callback, uint32_t)
+    {
+        auto const self = static_cast<LoadClient*>(data);
+        wl_callback_destroy(callback);
+        if (self->window)
+            self->window->draw(&frame_listener, self);
+    }
+
+    static wl_callback_listener const frame_listener;
+
+    std::atomic<bool> const& stopping;
+    WaylandWindow* window = nullptr;
+};
+
+wl_callback_listener const LoadClient::frame_listener = {&frame_done};
+
+struct Options
+{
+    int events = 1000;
+    double rate = 120.0;
+    int load_clients = 0;
+};
+
+class InputLatencyBenchmark : public miral::TestDisplayServer
+{
+public:
+    InputLatencyBenchmark()
+    {
+        add_server_init(launcher);
+        add_server_init([this](mir::Server& server)
+            {
+                server.add_init_callback([this, &server]
+                    {
+                        this->server = &server;
+                        server.the_seat_observer_registrar()->register_interest(seat_stage);
+                    });
+            });
+    }
+
+    auto build_window_manager_policy(miral::WindowManagerTools const& tools)
+    -> std::unique_ptr<miral::WindowManagementPolicy> override
+    {
+        return std::make_unique<ProbeObservingPolicy>(tools, surface_stage);
+    }
+
+    void run(Options const& options)
+    {
+        start_server();
+
+        std::vector<std::unique_ptr<LoadClient>> load;
+        for (int i = 0; i != options.load_clients; ++i)
+        {
+            load.push_back(std::make_unique<LoadClient>(stopping));
+            launcher.launch(*load.back());
+        }
+
+        ProbeClient probe{times, stopping};
+        launcher.launch(probe);
+        if (!probe.ready().wait_for(10s))
+            throw std::runtime_error{"Probe client did not start"};
+
+        auto const device_added = std::make_shared<DeviceAdded>();
+        server->the_input_device_hub()->add_observer(device_added);
+        auto const touchscreen = mtf::add_fake_input_device(
+            mi::InputDeviceInfo{"touchscreen", "input-latency-touchscreen", mi::DeviceCapability::touchscreen});
+        if (!device_added->added.wait_for(10s))
+            throw std::runtime_error{"Fake touchscreen was not added"};
+        server->the_input_device_hub()->remove_observer(device_added);
+
+        inject(*touchscreen, options);
+
+        // Allow the last events to reach the client before stopping it
+        std::this_thread::sleep_for(500ms);
+        stopping = true;
+        std::this_thread::sleep_for(200ms);
+
+        stop_server();
+
+        times.print(std::cout);
+    }
+
+private:
+    void inject(mtf::FakeInputDevice& touchscreen, Options const& options)
+    {
+        mir::geometry::Point const centre{800, 800};
+        touchscreen.emit_event(synthesis::a_touch_event()
+            .with_action(synthesis::TouchParameters::Action::Tap)
+            .at_position(centre));
+
+        auto const period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{1.0 / options.rate});
+        auto const start = Clock::now() + 100ms;
+        uint32_t last_key = 0;
+
+        for (int i = 0; i != options.events; ++i)
+        {
+            std::this_thread::sleep_until(start + i * period);
+
+            // Events are identified by their millisecond timestamp on the client, which must be unique
+            auto event_time = now();
+            while (key_for(event_time) == last_key)
+            {
+                std::this_thread::sleep_for(100us);
+                event_time = now();
+            }
+            last_key = key_for(event_time);
+
+            times.record(injected, last_key, event_time);
+            touchscreen.emit_event(synthesis::a_touch_event()
+                .with_action(synthesis::TouchParameters::Action::Move)
+                .at_position(centre + mir::geometry::Displacement{i % 2, 0})
+                .with_event_time(event_time));
+        }
+
+        touchscreen.emit_event(synthesis::a_touch_event()
+            .with_action(synthesis::TouchParameters::Action::Release)
+            .at_position(centre));
+    }
+
+    miral::InternalClientLauncher launcher;
+    StageTimes times;
+    std::shared_ptr<SeatStage> const seat_stage{std::make_shared<SeatStage>(times)};
+    std::shared_ptr<SurfaceStage> const surface_stage{std::make_shared<SurfaceStage>(times)};
+    std::atomic<bool> stopping{false};
+    mir::Server* server = nullptr;
+};
+
+void usage(char const* name)
+{
+    std::cerr << "Usage: " << name << " [--events <count>] [--rate <hz>] [--load-clients <count>]\n"
+              << "  --events        touch events to inject (default: 1000)\n"
+              << "  --rate          events per second, at most 1000 (default: 120)\n"
+              << "  --load-clients  continuously redrawing clients to run alongside (default: 0)\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--events") && i+1 < argc)
+            options.events = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i+1 < argc)
+            options.rate = std::atof(argv[++i]);
+        else if (!strcmp(argv[i], "--load-clients") && i+1 < argc)
+            options.load_clients = std::atoi(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (options.events < 1 || options.rate <= 0 || options.rate > 1000 || options.load_clients < 0)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    InputLatencyBenchmark{}.run(options);
+    return EXIT_SUCCESS;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "headless_window_manager.h"
+
+#include <miral/minimal_window_manager.h>
+
+#include "mir/graphics/display_configuration_observer.h"
+#include <mir/scene/surface_creation_parameters.h>
+#include <mir/scene/surface_observer.h>
+#include <mir/shell/display_layout.h>
+#include <mir/shell/focus_controller.h>
+#include <mir/shell/persistent_surface_store.h>
+
+#include <mir/test/doubles/stub_display_configuration.h>
+#include <mir/test/doubles/stub_session.h>
+#include <mir/test/doubles/stub_surface.h>
+#include <mir/test/fake_shared.h>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace mb = mir::benchmark;
+namespace mg = mir::graphics;
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+namespace
+{
+/// Cycles through the sessions in the order they were added
+struct CyclingFocusController : msh::FocusController
+{
+    void focus_next_session() override { step(+1); }
+    void focus_prev_session() override { step(-1); }
+
+    auto focused_session() const -> std::shared_ptr<ms::Session> override { return focus_session.lock(); }
+
+    void set_focus_to(
+        std::shared_ptr<ms::Session> const& session,
+        std::shared_ptr<ms::Surface> const& surface) override
+    {
+        focus_session = session;
+        focus_surface = surface;
+    }
+
+    auto focused_surface() const -> std::shared_ptr<ms::Surface> override { return focus_surface.lock(); }
+
+    void raise(msh::SurfaceSet const& /*windows*/) override {}
+
+    void apply_atomically(std::function<void()> const& changes) override { changes(); }
+
+    auto surface_at(geom::Point /*cursor*/) const -> std::shared_ptr<ms::Surface> override { return {}; }
+
+    void set_drag_and_drop_handle(std::vector<uint8_t> const& /*handle*/) override {}
+
+    void clear_drag_and_drop_handle() override {}
+
+    void step(int direction)
+    {
+        if (sessions.empty())
+            return;
+
+        auto const current = std::find(begin(sessions), end(sessions), focused_session());
+        auto const size = static_cast<int>(sessions.size());
+        auto const index = current == end(sessions) ? 0 : current - begin(sessions) + direction;
+        focus_session = sessions[(index + size) % size];
+        focus_surface.reset();
+    }
+
+    std::vector<std::shared_ptr<ms::Session>> sessions;
+    std::weak_ptr<ms::Session> focus_session;
+    std::weak_ptr<ms::Surface> focus_surface;
+};
+
+struct StubDisplayLayout : msh::DisplayLayout
+{
+    void clip_to_output(geom::Rectangle& /*rect*/) override {}
+
+    void size_to_output(geom::Rectangle& /*rect*/) override {}
+
+    bool place_in_output(mg::DisplayConfigurationOutputId /*id*/, geom::Rectangle& /*rect*/) override
+        { return false; }
+};
+
+struct StubPersistentSurfaceStore : msh::PersistentSurfaceStore
+{
+    Id id_for_surface(std::shared_ptr<ms::Surface> const& /*surface*/) override { return {}; }
+
+    auto surface_for_id(Id const& /*id*/) const -> std::shared_ptr<ms::Surface> override { return {}; }
+};
+
+struct DisplayConfigurationObservers : mir::ObserverRegistrar<mg::DisplayConfigurationObserver>
+{
+    void register_interest(std::weak_ptr<mg::DisplayConfigurationObserver> const& o) override
+    {
+        observer = o;
+    }
+
+    void register_interest(std::weak_ptr<mg::DisplayConfigurationObserver> const& o, mir::Executor&) override
+    {
+        observer = o;
+    }
+
+    void unregister_interest(mg::DisplayConfigurationObserver const& /*o*/) override
+    {
+        observer.reset();
+    }
+
+    std::weak_ptr<mg::DisplayConfigurationObserver> observer;
+};
+
+/// Keeps the state the window manager sets, as the window manager reads it back
+struct StatefulSurface : mtd::StubSurface
+{
+    explicit StatefulSurface(ms::SurfaceCreationParameters const& params)
+        : name_{params.name},
+          type_{params.type.is_set() ? params.type.value() : mir_window_type_normal},
+          top_left_{params.top_left},
+          size_{params.size},
+          depth_layer_{params.depth_layer.is_set() ? params.depth_layer.value() : mir_depth_layer_application}
+    {
+    }
+
+    std::string name() const override { return name_; }
+    MirWindowType type() const override { return type_; }
+
+    geom::Point top_left() const override { return top_left_; }
+    void move_to(geom::Point const& top_left) override { top_left_ = top_left; }
+
+    geom::Size window_size() const override { return size_; }
+    geom::Size content_size() const override { return size_; }
+    void resize(geom::Size const& size) override { size_ = size; }
+
+    auto state() const -> MirWindowState override { return state_; }
+    auto configure(MirWindowAttrib attrib, int value) -> int override
+    {
+        if (attrib == mir_window_attrib_state)
+            state_ = MirWindowState(value);
+        return value;
+    }
+
+    bool visible() const override { return state_ != mir_window_state_hidden; }
+
+    void add_observer(std::shared_ptr<ms::SurfaceObserver> const& observer) override
+    {
+        observers.push_back(observer);
+    }
+
+    void remove_observer(std::weak_ptr<ms::SurfaceObserver> const& observer) override
+    {
+        auto const o = observer.lock();
+        observers.erase(std::remove(begin(observers), end(observers), o), end(observers));
+    }
+
+    void post_first_frame()
+    {
+        // Observers may remove themselves when notified
+        auto const notify = observers;
+        for (auto const& observer : notify)
+            observer->frame_posted(this, 1, size_);
+    }
+
+    auto depth_layer() const -> MirDepthLayer override { return depth_layer_; }
+    void set_depth_layer(MirDepthLayer depth_layer) override { depth_layer_ = depth_layer; }
+
+    std::string const name_;
+    MirWindowType const type_;
+    geom::Point top_left_;
+    geom::Size size_;
+    MirWindowState state_{mir_window_state_restored};
+    MirDepthLayer depth_layer_;
+    std::vector<std::shared_ptr<ms::SurfaceObserver>> observers;
+};
+
+/// Owns its surfaces, as miral::Window only holds weak references to them
+struct Application : mtd::StubSession
+{
+    explicit Application(std::string const& name) : name_{name} {}
+
+    std::string name() const override { return name_; }
+
+    auto create_surface(
+        std::shared_ptr<ms::Session> const& /*session*/,
+        ms::SurfaceCreationParameters const& params,
+        std::shared_ptr<ms::SurfaceObserver> const& /*observer*/) -> std::shared_ptr<ms::Surface> override
+    {
+        auto const surface = std::make_shared<StatefulSurface>(params);
+        surfaces.insert(surface);
+        return surface;
+    }
+
+    void destroy_surface(std::shared_ptr<ms::Surface> const& surface) override
+    {
+        surfaces.erase(surface);
+    }
+
+    std::string const name_;
+    std::unordered_set<std::shared_ptr<ms::Surface>> surfaces;
+};
+
+auto minimal_window_manager(miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+{
+    return std::make_unique<miral::MinimalWindowManager>(tools);
+}
+}
+
+struct mb::HeadlessWindowManager::Self
+{
+    Self(std::vector<geom::Rectangle> const& outputs, miral::WindowManagementPolicyBuilder const& build_policy)
+        : window_manager{
+            &focus_controller,
+            mir::test::fake_shared(display_layout),
+            mir::test::fake_shared(persistent_surface_store),
+            display_configuration_observers,
+            build_policy}
+    {
+        configure_outputs(outputs);
+    }
+
+    void configure_outputs(std::vector<geom::Rectangle> const& outputs)
+    {
+        if (auto const observer = display_configuration_observers.observer.lock())
+            observer->configuration_applied(std::make_shared<mtd::StubDisplayConfig>(outputs));
+    }
+
+    CyclingFocusController focus_controller;
+    StubDisplayLayout display_layout;
+    StubPersistentSurfaceStore persistent_surface_store;
+    DisplayConfigurationObservers display_configuration_observers;
+    miral::BasicWindowManager window_manager;
+};
+
+mb::HeadlessWindowManager::HeadlessWindowManager(std::vector<geom::Rectangle> const& outputs)
+    : HeadlessWindowManager{outputs, &minimal_window_manager}
+{
+}
+
+mb::HeadlessWindowManager::HeadlessWindowManager(
+    std::vector<geom::Rectangle> const& outputs,
+    miral::WindowManagementPolicyBuilder const& build_policy)
+    : self{std::make_unique<Self>(outputs, build_policy)}
+{
+}
+
+mb::HeadlessWindowManager::~HeadlessWindowManager() = default;
+
+auto mb::HeadlessWindowManager::add_application(std::string const& name) -> std::shared_ptr<ms::Session>
+{
+    auto const application = std::make_shared<Application>(name);
+    self->focus_controller.sessions.push_back(application);
+    self->window_manager.add_session(application);
+    return application;
+}
+
+void mb::HeadlessWindowManager::remove_application(std::shared_ptr<ms::Session> const& application)
+{
+    self->window_manager.remove_session(application);
+
+    auto& sessions = self->focus_controller.sessions;
+    sessions.erase(std::remove(begin(sessions), end(sessions), application), end(sessions));
+}
+
+auto mb::HeadlessWindowManager::add_window(
+    std::shared_ptr<ms::Session> const& application,
+    ms::SurfaceCreationParameters const& params) -> miral::Window
+{
+    auto const surface = self->window_manager.add_surface(application, params,
+        [](std::shared_ptr<ms::Session> const& session, ms::SurfaceCreationParameters const& params)
+        {
+            return session->create_surface(session, params, nullptr);
+        });
+
+    // Windows compare by identity, so hand out the window manager's own
+    return self->window_manager.info_for(surface).window();
+}
+
+void mb::HeadlessWindowManager::remove_window(miral::Window const& window)
+{
+    std::shared_ptr<ms::Surface> const surface{window};
+    auto const application = window.application();
+
+    self->window_manager.remove_surface(application, surface);
+    application->destroy_surface(surface);
+}
+
+void mb::HeadlessWindowManager::post_first_frame(miral::Window const& window)
+{
+    std::static_pointer_cast<StatefulSurface>(std::shared_ptr<ms::Surface>{window})->post_first_frame();
+}
+
+void mb::HeadlessWindowManager::configure_outputs(std::vector<geom::Rectangle> const& outputs)
+{
+    self->configure_outputs(outputs);
+}
+
+auto mb::HeadlessWindowManager::window_manager() -> miral::BasicWindowManager&
+{
+    return self->window_manager;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_BENCHMARKS_HEADLESS_WINDOW_MANAGER_H_
+#define MIR_BENCHMARKS_HEADLESS_WINDOW_MANAGER_H_
+
+#include "basic_window_manager.h"
+
+#include <miral/window.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace benchmark
+{
+/**
+ * A miral::BasicWindowManager driven without a server: sessions and surfaces
+ * are stubs that remember the state the window manager gives them, and focus
+ * cycles through the sessions in the order they were added.
+ */
+class HeadlessWindowManager
+{
+public:
+    /// Uses miral::MinimalWindowManager as the policy
+    explicit HeadlessWindowManager(std::vector<geometry::Rectangle> const& outputs);
+    HeadlessWindowManager(
+        std::vector<geometry::Rectangle> const& outputs,
+        miral::WindowManagementPolicyBuilder const& build_policy);
+    ~HeadlessWindowManager();
+
+    auto add_application(std::string const& name) -> std::shared_ptr<scene::Session>;
+    void remove_application(std::shared_ptr<scene::Session> const& application);
+
+    auto add_window(
+        std::shared_ptr<scene::Session> const& application,
+        scene::SurfaceCreationParameters const& params) -> miral::Window;
+    void remove_window(miral::Window const& window);
+
+    /// Posts the window's first frame, as its client does once the window is ready to be shown
+    void post_first_frame(miral::Window const& window);
+
+    /// Applies a display configuration with these outputs in place of the current one
+    void configure_outputs(std::vector<geometry::Rectangle> const& outputs);
+
+    auto window_manager() -> miral::BasicWindowManager&;
+
+private:
+    struct Self;
+    std::unique_ptr<Self> const self;
+};
+}
+}
+
+#endif /* MIR_BENCHMARKS_HEADLESS_WINDOW_MANAGER_H_ */
@@ -0,0 +1,262 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trace_replay.h"
+
+#include <mir/events/event_builders.h>
+#include <mir/scene/surface_creation_parameters.h>
+#include <mir/shell/surface_specification.h>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace mb = mir::benchmark;
+namespace mev = mir::events;
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+namespace geom = mir::geometry;
+
+using miral::WindowManagementTraceRecord;
+
+namespace
+{
+/// Until the trace says otherwise
+geom::Rectangle const default_output{{0, 0}, {1920, 1080}};
+
+std::vector<uint8_t> const no_cookie;
+
+auto rectangle_of(WindowManagementTraceRecord const& record) -> geom::Rectangle
+{
+    return {
+        {record.integer_field("x"), record.integer_field("y")},
+        {record.integer_field("width"), record.integer_field("height")}};
+}
+}
+
+mb::TraceReplay::TraceReplay(miral::WindowManagementPolicyBuilder const& build_policy)
+    : headless{{default_output}, build_policy}
+{
+}
+
+bool mb::TraceReplay::apply(WindowManagementTraceRecord const& record)
+{
+    auto& window_manager = headless.window_manager();
+    auto const& operation = record.operation;
+
+    if (operation == "advise_output_create" || operation == "advise_output_update")
+    {
+        outputs[record.integer_field("output")] = rectangle_of(record);
+        configure_outputs();
+    }
+    else if (operation == "advise_output_delete")
+    {
+        outputs.erase(record.integer_field("output"));
+        configure_outputs();
+    }
+    else if (operation == "advise_new_app")
+    {
+        applications[record.field("app")] = headless.add_application(record.field("name"));
+    }
+    else if (operation == "advise_delete_app")
+    {
+        auto const application = applications.find(record.field("app"));
+        if (application == applications.end())
+            return false;
+
+        headless.remove_application(application->second);
+        applications.erase(application);
+    }
+    else if (operation == "advise_new_window")
+    {
+        if (applications.find(record.field("app")) == applications.end())
+            return false;
+
+        add_window(record);
+    }
+    else if (operation == "handle_keyboard_event")
+    {
+        handle_event(*mev::make_event(0, event_time(record), no_cookie,
+            MirKeyboardAction(record.integer_field("action")),
+            record.integer_field("keysym"),
+            record.integer_field("scancode"),
+            MirInputEventModifiers(record.integer_field("modifiers"))));
+    }
+    else if (operation == "handle_pointer_event")
+    {
+        handle_event(*mev::make_event(0, event_time(record), no_cookie,
+            MirInputEventModifiers(record.integer_field("modifiers")),
+            MirPointerAction(record.integer_field("action")),
+            MirPointerButtons(record.integer_field("buttons")),
+            record.number_field("x"), record.number_field("y"),
+            record.number_field("hscroll"), record.number_field("vscroll"),
+            record.number_field("dx"), record.number_field("dy")));
+    }
+    else if (operation == "handle_touch_event")
+    {
+        auto const touch = mev::make_event(0, event_time(record), no_cookie,
+            MirInputEventModifiers(record.integer_field("modifiers")));
+
+        for (auto i = 0; i != record.integer_field("touches"); ++i)
+        {
+            auto const suffix = "." + std::to_string(i);
+            mev::add_touch(*touch,
+                record.integer_field("id" + suffix),
+                MirTouchAction(record.integer_field("action" + suffix)),
+                MirTouchTooltype(record.integer_field("tool" + suffix)),
+                record.number_field("x" + suffix), record.number_field("y" + suffix),
+                1.0f, 0.0f, 0.0f, 0.0f);
+        }
+
+        handle_event(*touch);
+    }
+    else if (!record.has_field("window") || !known(record))
+    {
+        return false;
+    }
+    else if (operation == "advise_delete_window")
+    {
+        headless.remove_window(windows.at(record.field("window")));
+        windows.erase(record.field("window"));
+    }
+    else if (operation == "handle_window_ready")
+    {
+        headless.post_first_frame(windows.at(record.field("window")));
+    }
+    else if (operation == "handle_modify_window")
+    {
+        modify_window(record);
+    }
+    else if (operation == "handle_raise_window")
+    {
+        window_manager.handle_raise_surface(application_of(record), surface_of(record), last_input_time.count());
+    }
+    else if (operation == "handle_request_drag_and_drop")
+    {
+        window_manager.handle_request_drag_and_drop(
+            application_of(record), surface_of(record), last_input_time.count());
+    }
+    else if (operation == "handle_request_move")
+    {
+        window_manager.handle_request_move(application_of(record), surface_of(record), event_time(record).count());
+    }
+    else if (operation == "handle_request_resize")
+    {
+        window_manager.handle_request_resize(
+            application_of(record), surface_of(record), event_time(record).count(),
+            MirResizeEdge(record.integer_field("edge")));
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void mb::TraceReplay::configure_outputs()
+{
+    std::vector<geom::Rectangle> areas;
+    for (auto const& output : outputs)
+        areas.push_back(output.second);
+
+    headless.configure_outputs(areas);
+}
+
+void mb::TraceReplay::add_window(WindowManagementTraceRecord const& record)
+{
+    ms::SurfaceCreationParameters params;
+    params.name = record.field("name");
+    params.type = MirWindowType(record.integer_field("type"));
+    params.state = MirWindowState(record.integer_field("state"));
+
+    auto const placement = rectangle_of(record);
+    params.top_left = placement.top_left;
+    params.size = placement.size;
+
+    if (record.has_field("parent"))
+    {
+        auto const parent = windows.find(record.field("parent"));
+        if (parent != windows.end())
+            params.parent = std::shared_ptr<ms::Surface>(parent->second);
+    }
+
+    windows[record.field("window")] = headless.add_window(applications.at(record.field("app")), params);
+}
+
+void mb::TraceReplay::modify_window(WindowManagementTraceRecord const& record)
+{
+    msh::SurfaceSpecification modifications;
+
+    if (record.has_field("name"))
+        modifications.name = record.field("name");
+    if (record.has_field("state"))
+        modifications.state = MirWindowState(record.integer_field("state"));
+    if (record.has_field("x"))
+        modifications.top_left = geom::Point{record.integer_field("x"), record.integer_field("y")};
+    if (record.has_field("width"))
+    {
+        modifications.width = geom::Width{record.integer_field("width")};
+        modifications.height = geom::Height{record.integer_field("height")};
+    }
+
+    headless.window_manager().modify_surface(application_of(record), surface_of(record), modifications);
+}
+
+void mb::TraceReplay::handle_event(MirEvent const& event)
+{
+    auto const input_event = mir_event_get_input_event(&event);
+    auto& window_manager = headless.window_manager();
+
+    switch (mir_input_event_get_type(input_event))
+    {
+    case mir_input_event_type_key:
+        window_manager.handle_keyboard_event(mir_input_event_get_keyboard_event(input_event));
+        break;
+
+    case mir_input_event_type_touch:
+        window_manager.handle_touch_event(mir_input_event_get_touch_event(input_event));
+        break;
+
+    case mir_input_event_type_pointer:
+        window_manager.handle_pointer_event(mir_input_event_get_pointer_event(input_event));
+        break;
+
+    default:
+        break;
+    }
+}
+
+auto mb::TraceReplay::event_time(WindowManagementTraceRecord const& record) -> std::chrono::nanoseconds
+{
+    last_input_time = std::chrono::nanoseconds{record.integer_field("time")};
+    return last_input_time;
+}
+
+auto mb::read_trace(std::string const& path) -> std::vector<WindowManagementTraceRecord>
+{
+    std::ifstream in{path};
+    if (!in)
+        throw std::runtime_error("Cannot read trace: " + path);
+
+    std::vector<WindowManagementTraceRecord> records;
+    for (std::string line; std::getline(in, line);)
+    {
+        if (!line.empty())
+            records.push_back(WindowManagementTraceRecord::from_line(line));
+    }
+
+    return records;
+}
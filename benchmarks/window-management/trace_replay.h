@@ -0,0 +1,74 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_BENCHMARKS_TRACE_REPLAY_H_
+#define MIR_BENCHMARKS_TRACE_REPLAY_H_
+
+#include "headless_window_manager.h"
+#include "window_management_trace_record.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace benchmark
+{
+/**
+ * Replays the records of a window management trace, as written by a MirAL shell run with
+ * --window-management-trace-file, against a HeadlessWindowManager. The applications, windows
+ * and outputs in the trace are mapped to their counterparts in the replay.
+ */
+class TraceReplay
+{
+public:
+    explicit TraceReplay(miral::WindowManagementPolicyBuilder const& build_policy);
+
+    /// Returns false if record is of an unknown operation or refers to something the replay lacks
+    bool apply(miral::WindowManagementTraceRecord const& record);
+
+private:
+    void configure_outputs();
+    void add_window(miral::WindowManagementTraceRecord const& record);
+    void modify_window(miral::WindowManagementTraceRecord const& record);
+    void handle_event(MirEvent const& event);
+    auto event_time(miral::WindowManagementTraceRecord const& record) -> std::chrono::nanoseconds;
+
+    bool known(miral::WindowManagementTraceRecord const& record) const
+        { return windows.find(record.field("window")) != windows.end(); }
+
+    auto surface_of(miral::WindowManagementTraceRecord const& record) -> std::shared_ptr<scene::Surface>
+        { return windows.at(record.field("window")); }
+
+    auto application_of(miral::WindowManagementTraceRecord const& record) -> std::shared_ptr<scene::Session>
+        { return windows.at(record.field("window")).application(); }
+
+    HeadlessWindowManager headless;
+    std::map<std::string, std::shared_ptr<scene::Session>> applications;
+    std::map<std::string, miral::Window> windows;
+    std::map<long long, geometry::Rectangle> outputs;
+    std::chrono::nanoseconds last_input_time{0};
+};
+
+/// \throws std::runtime_error if path cannot be read or holds a line that is not a record
+auto read_trace(std::string const& path) -> std::vector<miral::WindowManagementTraceRecord>;
+}
+}
+
+#endif /* MIR_BENCHMARKS_TRACE_REPLAY_H_ */
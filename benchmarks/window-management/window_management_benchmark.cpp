@@ -0,0 +1,297 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measures the cost of window management operations as the number of windows
+ * and applications grows.
+ *
+ * The window manager runs headless on stub sessions and surfaces, so only the
+ * bookkeeping in miral::BasicWindowManager is measured. Results are written to
+ * stdout as tab separated "scene operation median_ns p95_ns" lines.
+ *
+ * The "contended" lines are taken while other threads query the model through
+ * invoke_under_shared_lock() (or, for comparison, invoke_under_lock()). They are
+ * wall clock times, as time spent waiting for the window management lock is
+ * what they show.
+ */
+
+#include "headless_window_manager.h"
+
+#include <mir/events/event_builders.h>
+#include <mir/scene/surface_creation_parameters.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <time.h>
+
+namespace mb = mir::benchmark;
+namespace mev = mir::events;
+namespace ms = mir::scene;
+namespace geom = mir::geometry;
+
+namespace
+{
+geom::Rectangle const output_area{{0, 0}, {1920, 1080}};
+
+auto thread_cpu_ns() -> long long
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+struct Statistics
+{
+    long long median_ns;
+    long long p95_ns;
+};
+
+auto wall_ns() -> long long
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+auto summarise(std::vector<long long>& samples) -> Statistics
+{
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[(samples.size() * 95) / 100]};
+}
+
+auto measure(int count, std::function<void(int)> const& operation, long long (*clock)() = &thread_cpu_ns)
+    -> Statistics
+{
+    std::vector<long long> samples;
+    samples.reserve(count);
+
+    for (int i = 0; i != count; ++i)
+    {
+        auto const start = clock();
+        operation(i);
+        samples.push_back(clock() - start);
+    }
+
+    return summarise(samples);
+}
+
+void report(std::string const& scene, std::string const& operation, Statistics const& statistics)
+{
+    std::cout << scene << '\t' << operation << '\t' << statistics.median_ns << '\t' << statistics.p95_ns << '\n';
+}
+
+auto pointer_event(MirPointerAction action, std::chrono::nanoseconds timestamp) -> mir::EventUPtr
+{
+    return mev::make_event(0, timestamp, std::vector<uint8_t>{}, mir_input_event_modifier_none, action,
+        action == mir_pointer_action_button_down ? mir_pointer_button_primary : 0, 100.0f, 100.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void handle(miral::BasicWindowManager& window_manager, mir::EventUPtr const& event)
+{
+    window_manager.handle_pointer_event(mir_input_event_get_pointer_event(mir_event_get_input_event(event.get())));
+}
+
+using InvokeUnderLock = void (miral::BasicWindowManager::*)(std::function<void()> const& callback);
+
+/// Measures input handling, and the queries themselves, while querier threads query the model under lock_type
+void run_contended(
+    std::string const& scene,
+    std::string const& lock_type,
+    InvokeUnderLock invoke_under_lock,
+    miral::BasicWindowManager& window_manager,
+    std::vector<miral::Window> const& windows,
+    int queriers,
+    int operations)
+{
+    std::atomic<bool> done{false};
+    std::atomic<int> querying{0};
+    std::vector<std::vector<long long>> query_samples(queriers);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i != queriers; ++i)
+    {
+        threads.emplace_back([&, i]
+            {
+                std::mt19937 random(i);
+                std::uniform_int_distribution<std::size_t> any_window{0, windows.size() - 1};
+
+                while (!done)
+                {
+                    auto const& window = windows[any_window(random)];
+                    auto const start = wall_ns();
+                    (window_manager.*invoke_under_lock)([&]
+                        {
+                            window_manager.window_at(window_manager.info_for(window).window().top_left());
+                        });
+                    query_samples[i].push_back(wall_ns() - start);
+
+                    if (query_samples[i].size() == 1)
+                        ++querying;
+                }
+            });
+    }
+
+    while (querying != queriers)
+        std::this_thread::yield();
+
+    // Requests made before the latest button press are for earlier input, and are dropped
+    auto const timestamp = std::chrono::nanoseconds{wall_ns()};
+    handle(window_manager, pointer_event(mir_pointer_action_button_down, timestamp));
+    handle(window_manager, pointer_event(mir_pointer_action_button_up, timestamp));
+
+    auto const motion = pointer_event(mir_pointer_action_motion, timestamp);
+    auto const contended = "+" + lock_type + "_queries";
+
+    report(scene, "pointer_event" + contended, measure(operations, [&](int)
+        { handle(window_manager, motion); }, &wall_ns));
+
+    auto const& stale = windows.front();
+    report(scene, "stale_raise_request" + contended, measure(operations, [&](int)
+        { window_manager.handle_raise_surface(stale.application(), stale, timestamp.count() - 1); }, &wall_ns));
+
+    done = true;
+    std::vector<long long> samples;
+    for (auto& thread : threads)
+        thread.join();
+    for (auto const& querier_samples : query_samples)
+        samples.insert(end(samples), begin(querier_samples), end(querier_samples));
+
+    report(scene, lock_type + "_query+input", summarise(samples));
+}
+
+void run_scene(int window_count, int application_count, int operations, int queriers, std::mt19937& random)
+{
+    auto const scene = std::to_string(window_count) + "x" + std::to_string(application_count);
+
+    mb::HeadlessWindowManager headless{{output_area}};
+    auto& window_manager = headless.window_manager();
+
+    std::vector<std::shared_ptr<ms::Session>> applications;
+    for (int i = 0; i != application_count; ++i)
+        applications.push_back(headless.add_application("application-" + std::to_string(i)));
+
+    std::vector<miral::Window> windows;
+    windows.reserve(window_count);
+    report(scene, "add_window", measure(window_count, [&](int i)
+        {
+            ms::SurfaceCreationParameters params;
+            params.name = "window-" + std::to_string(i);
+            params.type = mir_window_type_normal;
+            params.size = geom::Size{640, 480};
+            windows.push_back(headless.add_window(applications[i % application_count], params));
+        }));
+
+    std::uniform_int_distribution<std::size_t> any_window{0, windows.size() - 1};
+
+    report(scene, "info_for", measure(operations, [&](int)
+        { window_manager.info_for(windows[any_window(random)]); }));
+
+    report(scene, "select_active_window", measure(operations, [&](int)
+        { window_manager.select_active_window(windows[any_window(random)]); }));
+
+    report(scene, "raise_tree", measure(operations, [&](int)
+        { window_manager.raise_tree(windows[any_window(random)]); }));
+
+    report(scene, "focus_next_application", measure(operations, [&](int)
+        { window_manager.focus_next_application(); }));
+
+    report(scene, "focus_next_within_application", measure(operations, [&](int)
+        { window_manager.focus_next_within_application(); }));
+
+    if (queriers)
+    {
+        run_contended(scene, "shared", &miral::BasicWindowManager::invoke_under_shared_lock,
+            window_manager, windows, queriers, operations);
+        run_contended(scene, "exclusive", &miral::BasicWindowManager::invoke_under_lock,
+            window_manager, windows, queriers, operations);
+    }
+
+    std::shuffle(begin(windows), end(windows), random);
+    report(scene, "remove_window", measure(window_count, [&](int i)
+        { headless.remove_window(windows[i]); }));
+
+    for (auto const& application : applications)
+        headless.remove_application(application);
+}
+
+void usage(char const* name)
+{
+    std::cerr << "Usage: " << name << " [--windows <count>] [--applications <count>] [--operations <count>]"
+                 " [--queriers <count>]\n"
+              << "  --windows       windows in the scene (default: 10, 100, 1000 and 5000 in turn)\n"
+              << "  --applications  applications owning the windows (default: a tenth of the windows)\n"
+              << "  --operations    times each lookup and focus operation is measured (default: 2000)\n"
+              << "  --queriers      threads querying the model during the contended measurements (default: 3, 0 skips them)\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    std::vector<int> window_counts{10, 100, 1000, 5000};
+    int application_count = 0;
+    int operations = 2000;
+    int queriers = 3;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--windows") && i+1 < argc)
+            window_counts = {std::atoi(argv[++i])};
+        else if (!strcmp(argv[i], "--applications") && i+1 < argc)
+            application_count = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--operations") && i+1 < argc)
+            operations = std::atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--queriers") && i+1 < argc)
+            queriers = std::atoi(argv[++i]);
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (window_counts.front() < 1 || application_count < 0 || operations < 1 || queriers < 0)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // A fixed seed, so that runs are comparable
+    std::mt19937 random{42};
+
+    std::cout << "# scene\toperation\tmedian_ns\tp95_ns\n";
+    for (auto const window_count : window_counts)
+    {
+        auto const applications = application_count ? application_count : std::max(1, window_count / 10);
+        run_scene(window_count, std::min(applications, window_count), operations, queriers, random);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}
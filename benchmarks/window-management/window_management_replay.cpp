@@ -0,0 +1,175 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replays a window management trace, as written by a MirAL shell run with
+ * --window-management-trace-file, against a headless window manager and
+ * reports how long the window manager spent on each kind of traced call.
+ *
+ * Applications, windows, client requests, input events and output changes are
+ * replayed in order, as fast as possible, so that a session reported as slow
+ * in the field can be rerun and profiled at will. Results are written to stdout
+ * as tab separated "operation count median_ns p95_ns max_ns" lines.
+ */
+
+#include "trace_replay.h"
+
+#include <miral/canonical_window_manager.h>
+#include <miral/minimal_window_manager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mb = mir::benchmark;
+
+using miral::WindowManagementTraceRecord;
+
+namespace
+{
+using Samples = std::map<std::string, std::vector<long long>>;
+
+void replay(
+    std::vector<WindowManagementTraceRecord> const& records,
+    miral::WindowManagementPolicyBuilder const& build_policy,
+    Samples& samples,
+    std::map<std::string, int>& skipped)
+{
+    mb::TraceReplay replay{build_policy};
+
+    for (auto const& record : records)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const applied = replay.apply(record);
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        if (applied)
+            samples[record.operation].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        else
+            ++skipped[record.operation];
+    }
+}
+
+void report(Samples& samples)
+{
+    std::cout << "# operation\tcount\tmedian_ns\tp95_ns\tmax_ns\n";
+
+    for (auto& operation : samples)
+    {
+        auto& durations = operation.second;
+        std::sort(begin(durations), end(durations));
+
+        std::cout << operation.first << '\t' << durations.size()
+                  << '\t' << durations[durations.size() / 2]
+                  << '\t' << durations[(durations.size() * 95) / 100]
+                  << '\t' << durations.back() << '\n';
+    }
+}
+
+auto minimal_window_manager(miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+{
+    return std::make_unique<miral::MinimalWindowManager>(tools);
+}
+
+/// CanonicalWindowManagerPolicy leaves input handling to the shell, this one ignores it
+struct CanonicalWindowManager : miral::CanonicalWindowManagerPolicy
+{
+    using miral::CanonicalWindowManagerPolicy::CanonicalWindowManagerPolicy;
+
+    bool handle_keyboard_event(MirKeyboardEvent const*) override { return false; }
+    bool handle_touch_event(MirTouchEvent const*) override { return false; }
+    bool handle_pointer_event(MirPointerEvent const*) override { return false; }
+    void handle_request_move(miral::WindowInfo&, MirInputEvent const*) override {}
+    void handle_request_resize(miral::WindowInfo&, MirInputEvent const*, MirResizeEdge) override {}
+};
+
+auto canonical_window_manager(miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+{
+    return std::make_unique<CanonicalWindowManager>(tools);
+}
+
+void usage(char const* name)
+{
+    std::cerr << "Usage: " << name << " [--policy minimal|canonical] [--repeat <count>] <trace-file>\n"
+              << "  --policy  the window management policy to replay against (default: minimal)\n"
+              << "  --repeat  times to replay the trace, each time from scratch (default: 1)\n";
+}
+}
+
+int main(int argc, char** argv)
+try
+{
+    miral::WindowManagementPolicyBuilder build_policy = &minimal_window_manager;
+    int repeat = 1;
+    std::string trace_file;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--policy") && i+1 < argc)
+        {
+            std::string const policy{argv[++i]};
+
+            if (policy == "minimal")
+                build_policy = &minimal_window_manager;
+            else if (policy == "canonical")
+                build_policy = &canonical_window_manager;
+            else
+            {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (!strcmp(argv[i], "--repeat") && i+1 < argc)
+            repeat = std::atoi(argv[++i]);
+        else if (argv[i][0] != '-' && trace_file.empty())
+            trace_file = argv[i];
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (trace_file.empty() || repeat < 1)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto const records = mb::read_trace(trace_file);
+
+    Samples samples;
+    std::map<std::string, int> skipped;
+    for (int i = 0; i != repeat; ++i)
+        replay(records, build_policy, samples, skipped);
+
+    report(samples);
+
+    for (auto const& operation : skipped)
+        std::cerr << "Skipped " << operation.second << " " << operation.first << " records\n";
+
+    return EXIT_SUCCESS;
+}
+catch (std::exception const& error)
+{
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+}
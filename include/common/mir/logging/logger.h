@@ -63,6 +63,7 @@ protected:
 };
 
 void log(Severity severity, const std::string& message, const std::string& component);
+void log(Severity severity, char const* message, char const* component);
 void set_logger(std::shared_ptr<Logger> const& new_logger);
 
 }
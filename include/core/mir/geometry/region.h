@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GEOMETRY_REGION_H_
+#define MIR_GEOMETRY_REGION_H_
+
+#include "mir/geometry/displacement.h"
+#include "mir/geometry/rectangle.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace mir
+{
+namespace geometry
+{
+
+/**
+ * An area of the plane: a set of points, rather than a collection of rectangles.
+ *
+ * The area is kept as non-overlapping rectangles in y-x banded form: rectangles are
+ * sorted by top then left, rectangles in the same horizontal band share their top and
+ * bottom, and vertically adjacent bands with identical spans are merged. This form is
+ * canonical, so equal areas compare equal and point queries are binary searches.
+ */
+class Region
+{
+public:
+    Region() = default;
+    Region(Rectangle const& rect);
+    explicit Region(std::vector<Rectangle> const& rects);
+    /* We want to keep implicit copy and move methods */
+
+    void add(Rectangle const& rect);
+    void add(Region const& region);
+    void subtract(Rectangle const& rect);
+    void subtract(Region const& region);
+    void intersect(Rectangle const& rect);
+    void intersect(Region const& region);
+    void translate(Displacement const& displacement);
+    void clear();
+
+    bool empty() const;
+    /// O(log n) in the number of rectangles
+    bool contains(Point const& point) const;
+    Rectangle bounding_rectangle() const;
+
+    typedef std::vector<Rectangle>::const_iterator const_iterator;
+    typedef std::vector<Rectangle>::size_type size_type;
+    const_iterator begin() const;
+    const_iterator end() const;
+    size_type size() const;
+
+    bool operator==(Region const& region) const;
+    bool operator!=(Region const& region) const;
+
+private:
+    std::vector<Rectangle> rectangles;
+};
+
+std::ostream& operator<<(std::ostream& out, Region const& value);
+
+}
+}
+
+#endif /* MIR_GEOMETRY_REGION_H_ */
@@ -27,6 +27,8 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace mir
 {
@@ -190,6 +192,14 @@ public:
     /// Apply modifications to a window
     void modify_window(Window const& window, WindowSpecification const& modifications);
 
+    /** Apply modifications to several windows as one change to the scene.
+     * Every modification is checked before any is applied: if one is invalid an
+     * exception is thrown and no window is modified. Each window may appear only once.
+     * \remark Since MirAL 2.9
+     * @param modifications each window with the modifications to apply to it
+     */
+    void modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications);
+
     /// Set a default size and position to reflect state change
     void place_and_size_for_state(WindowSpecification& modifications, WindowInfo const& window_info) const;
 
@@ -252,6 +262,14 @@ public:
      */
     void invoke_under_lock(std::function<void()> const& callback);
 
+    /** Multi-thread support for queries
+     *  As invoke_under_lock(), but callbacks on different threads may run concurrently. The callback
+     *  may only call "Query & Update Model" functions that do not update the model (such as
+     *  info_for(), active_window() and window_at()).
+     *  \remark Since MirAL 2.9
+     */
+    void invoke_under_shared_lock(std::function<void()> const& callback);
+
 private:
     WindowManagerToolsImplementation* tools;
 };
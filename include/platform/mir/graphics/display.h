@@ -127,6 +127,26 @@ public:
      */
     virtual bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) = 0;
 
+    /**
+     * Applying a display configuration only replacing the DisplaySyncGroups it changes
+     *
+     * DisplaySyncGroups whose outputs are unaffected by \p conf are kept, and the
+     * references to them (and to their DisplayBuffers) remain valid. Before any other
+     * DisplaySyncGroup is destroyed \p remove_sync_group is called with it; this must
+     * not call back into the Display.
+     *
+     * If this function returns \c false then the new display configuration has not been
+     * applied (and \p remove_sync_group has not been called) as the platform can only
+     * apply it by configure().
+     *
+     * \param conf              [in] Configuration to possibly apply.
+     * \param remove_sync_group [in] Called for each DisplaySyncGroup about to be destroyed.
+     * \return      \c true if \p conf has been applied as the new output configuration.
+     */
+    virtual bool apply_if_configuration_preserves_unchanged_sync_groups(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& remove_sync_group) = 0;
+
     /**
      * Sets a new output configuration.
      */
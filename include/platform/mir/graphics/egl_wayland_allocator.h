@@ -48,6 +48,13 @@ namespace wayland
 {
 void bind_display(EGLDisplay egl_dpy, wl_display* wl_dpy, EGLExtensions const& extensions);
 
+/**
+ * Wraps a commit of a hardware wl_buffer as a Buffer.
+ *
+ * The wl_buffer is imported into a texture the first time it is committed, making \a ctx
+ * current to do so; the texture is kept until the wl_buffer is destroyed, so later commits
+ * of the same wl_buffer create no EGL or GL objects and need no current context.
+ */
 auto buffer_from_resource(
     wl_resource* buffer,
     std::function<void()>&& on_consumed,
@@ -52,6 +52,11 @@ extern char const* const enable_key_repeat_opt;
 extern char const* const x11_display_opt;
 extern char const* const wayland_extensions_opt;
 extern char const* const enable_mirclient_opt;
+extern char const* const wayland_request_profile_opt;
+extern char const* const async_logging_opt;
+extern char const* const flight_recorder_opt;
+extern char const* const flight_recorder_file_opt;
+extern char const* const gl_program_cache_opt;
 
 extern char const* const name_opt;
 extern char const* const offscreen_opt;
@@ -65,6 +70,7 @@ extern char const* const lttng_opt_value;
 extern char const* const platform_graphics_lib;
 extern char const* const platform_input_lib;
 extern char const* const platform_path;
+extern char const* const platform_probe_cache;
 
 extern char const* const console_provider;
 extern char const* const logind_console;
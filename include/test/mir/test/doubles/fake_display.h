@@ -51,6 +51,9 @@ public:
         mir::graphics::DisplayConfigurationChangeHandler const& handler) override;
 
     bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const&) override;
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        graphics::DisplayConfiguration const&,
+        std::function<void(graphics::DisplaySyncGroup&)> const&) override;
     void configure(mir::graphics::DisplayConfiguration const&) override;
 
     void emit_configuration_change_event(
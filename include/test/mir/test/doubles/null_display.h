@@ -52,6 +52,12 @@ class NullDisplay : public graphics::Display,
     {
         return false;
     }
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        graphics::DisplayConfiguration const&,
+        std::function<void(graphics::DisplaySyncGroup&)> const&) override
+    {
+        return false;
+    }
     void configure(graphics::DisplayConfiguration const&)  override{}
     void register_configuration_change_handler(
         graphics::EventHandlerRegister&,
@@ -19,6 +19,10 @@
 #ifndef MIR_WAYLAND_OBJECT_H_
 #define MIR_WAYLAND_OBJECT_H_
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
 struct wl_resource;
 struct wl_global;
 struct wl_client;
@@ -64,6 +68,47 @@ public:
 
 void internal_error_processing_request(wl_client* client, char const* method_name);
 
+/// Observes how long each Wayland request takes to handle
+class RequestReport
+{
+public:
+    RequestReport() = default;
+    virtual ~RequestReport() = default;
+
+    /// Called on the Wayland thread once the request has been handled
+    virtual void request_handled(
+        wl_client* client,
+        char const* interface_name,
+        uint32_t opcode,
+        char const* request_name,
+        std::chrono::steady_clock::duration handling_time) = 0;
+
+    RequestReport(RequestReport const&) = delete;
+    RequestReport& operator=(RequestReport const&) = delete;
+};
+
+/// Sets the report for requests handled by all generated wrappers (nullptr to stop reporting)
+void set_request_report(std::shared_ptr<RequestReport> const& report);
+
+/// Used by the generated request thunks to time themselves, if there is a report
+class RequestTimer
+{
+public:
+    RequestTimer(wl_client* client, char const* interface_name, uint32_t opcode, char const* request_name);
+    ~RequestTimer();
+
+    RequestTimer(RequestTimer const&) = delete;
+    RequestTimer& operator=(RequestTimer const&) = delete;
+
+private:
+    std::shared_ptr<RequestReport> const report;
+    wl_client* const client;
+    char const* const interface_name;
+    uint32_t const opcode;
+    char const* const request_name;
+    std::chrono::steady_clock::time_point const start;
+};
+
 }
 }
 
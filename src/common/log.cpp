@@ -35,7 +35,6 @@ void logv(logging::Severity sev, char const* component,
         len = max;
     message[len] = '\0';
 
-    // Suboptimal: Constructing a std::string for message/component.
     logging::log(sev, message, component);
 }
 
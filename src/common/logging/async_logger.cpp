@@ -0,0 +1,285 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/logging/async_logger.h"
+#include "mir/thread_name.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace ml = mir::logging;
+
+namespace
+{
+// Long enough for almost every message we log, short enough that a ring stays small
+size_t const slot_text_size = 496;
+}
+
+/// A single-producer, single-consumer queue of formatted messages from one thread
+struct ml::AsyncLogger::Ring : PerThreadRing
+{
+    struct Slot
+    {
+        Severity severity;
+        size_t component_length;
+        bool spilled;
+        char text[slot_text_size];  ///< The component, a NUL, then the message
+        std::string spilled_text;   ///< Used instead of text when the message doesn't fit
+    };
+
+    explicit Ring(size_t size) : slots(size) {}
+
+    auto empty() const -> bool { return head.load() == tail.load(); }
+
+    std::vector<Slot> slots;
+    std::atomic<size_t> head{0};        ///< Messages written, advanced by the logging thread
+    std::atomic<size_t> tail{0};        ///< Messages read, advanced by the writer thread
+    std::atomic<uint64_t> dropped{0};
+    uint64_t reported_dropped{0};       ///< Only used on the writer thread
+};
+
+ml::AsyncLogger::AsyncLogger(std::shared_ptr<Logger> const& sink, size_t ring_size) :
+    sink{sink},
+    ring_size{ring_size > 0 ? ring_size : 1},
+    writer{[this]
+        {
+            mir::set_thread_name("Mir/Logger");
+            write_pending();
+        }}
+{
+}
+
+ml::AsyncLogger::~AsyncLogger()
+{
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        stopping = true;
+        for (auto const& ring : rings)
+            ring->owner_destroyed = true;
+    }
+    wakeup.notify_one();
+    writer.join();
+}
+
+void ml::AsyncLogger::log(Severity severity, std::string const& message, std::string const& component)
+{
+    log(component.c_str(), severity, "%s", message.c_str());
+}
+
+void ml::AsyncLogger::log(char const* component, Severity severity, char const* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+
+    // Whatever the sink logs itself can't wait for the writer thread
+    if (std::this_thread::get_id() == writer.get_id())
+    {
+        char message[slot_text_size];
+        vsnprintf(message, sizeof message, format, args);
+        va_end(args);
+        sink->log(severity, message, component);
+        return;
+    }
+
+    auto& ring = ring_for_this_thread();
+    auto const head = ring.head.load(std::memory_order_relaxed);
+
+    while (head - ring.tail.load(std::memory_order_acquire) == ring.slots.size())
+    {
+        wake_writer();
+        if (severity > Severity::error)
+        {
+            va_end(args);
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    auto& slot = ring.slots[head % ring.slots.size()];
+    slot.severity = severity;
+    slot.component_length = strlen(component);
+    slot.spilled = slot.component_length >= slot_text_size;
+
+    if (!slot.spilled)
+    {
+        memcpy(slot.text, component, slot.component_length + 1);
+        auto const space = slot_text_size - slot.component_length - 1;
+
+        va_list attempt;
+        va_copy(attempt, args);
+        auto const length = vsnprintf(slot.text + slot.component_length + 1, space, format, attempt);
+        va_end(attempt);
+
+        slot.spilled = length > 0 && static_cast<size_t>(length) >= space;
+    }
+
+    if (slot.spilled)
+    {
+        va_list measure;
+        va_copy(measure, args);
+        auto const length = std::max(vsnprintf(nullptr, 0, format, measure), 0);
+        va_end(measure);
+
+        slot.spilled_text.assign(component, slot.component_length + 1);
+        slot.spilled_text.resize(slot.component_length + 1 + length + 1);
+        vsnprintf(&slot.spilled_text[slot.component_length + 1], length + 1, format, args);
+    }
+
+    va_end(args);
+
+    // Sequentially consistent, so that either we see the writer waiting or it sees this message
+    ring.head.store(head + 1);
+    if (writer_waiting.load())
+        wake_writer();
+
+    // Critical messages commonly precede an abort, so don't leave them in the ring
+    if (severity == Severity::critical)
+        flush();
+}
+
+void ml::AsyncLogger::flush()
+{
+    if (std::this_thread::get_id() == writer.get_id())
+        return;
+
+    std::unique_lock<decltype(mutex)> lock{mutex};
+
+    // The next pass to start sees everything logged so far, including any drops to report
+    auto const pass = passes_started + 1;
+    flush_pass = std::max(flush_pass, pass);
+
+    if (writer_waiting.exchange(false))
+        wakeup.notify_one();
+
+    written.wait(lock, [&] { return passes_completed >= pass; });
+}
+
+auto ml::AsyncLogger::dropped_messages() const -> uint64_t
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    auto result = dropped_by_removed_rings;
+    for (auto const& ring : rings)
+        result += ring->dropped.load(std::memory_order_relaxed);
+    return result;
+}
+
+auto ml::AsyncLogger::ring_for_this_thread() -> Ring&
+{
+    return thread_rings.for_this_thread([this]
+        {
+            auto const ring = std::make_shared<Ring>(ring_size);
+            std::lock_guard<decltype(mutex)> lock{mutex};
+            rings.push_back(ring);
+            return ring;
+        });
+}
+
+void ml::AsyncLogger::wake_writer()
+{
+    if (writer_waiting.exchange(false))
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        wakeup.notify_one();
+    }
+}
+
+void ml::AsyncLogger::write_pending()
+{
+    std::unique_lock<decltype(mutex)> lock{mutex};
+
+    for (;;)
+    {
+        auto const current = rings;
+        ++passes_started;
+        lock.unlock();
+
+        bool wrote = false;
+        for (auto const& ring : current)
+            wrote = drain(*ring) || wrote;
+
+        lock.lock();
+
+        for (auto ring = rings.begin(); ring != rings.end();)
+        {
+            if ((*ring)->thread_exited && (*ring)->empty())
+            {
+                // The thread may have dropped messages since we drained its ring
+                drain(**ring);
+                dropped_by_removed_rings += (*ring)->dropped;
+                ring = rings.erase(ring);
+            }
+            else
+            {
+                ++ring;
+            }
+        }
+
+        ++passes_completed;
+        written.notify_all();
+
+        if (wrote || passes_completed < flush_pass)
+            continue;
+
+        if (stopping)
+            break;
+
+        writer_waiting = true;
+
+        bool pending = false;
+        for (auto const& ring : rings)
+            pending = pending || !ring->empty();
+
+        if (pending)
+        {
+            writer_waiting = false;
+            continue;
+        }
+
+        wakeup.wait(lock, [this] { return !writer_waiting || stopping; });
+    }
+}
+
+auto ml::AsyncLogger::drain(Ring& ring) -> bool
+{
+    auto const head = ring.head.load(std::memory_order_acquire);
+    auto tail = ring.tail.load(std::memory_order_relaxed);
+    bool const wrote = tail != head;
+
+    for (; tail != head; ++tail)
+    {
+        auto const& slot = ring.slots[tail % ring.slots.size()];
+        auto const text = slot.spilled ? slot.spilled_text.c_str() : slot.text;
+
+        sink->log(slot.severity, text + slot.component_length + 1, std::string{text, slot.component_length});
+        ring.tail.store(tail + 1, std::memory_order_release);
+    }
+
+    auto const dropped = ring.dropped.load(std::memory_order_relaxed);
+    if (dropped != ring.reported_dropped)
+    {
+        char message[128];
+        snprintf(message, sizeof message, "%llu messages dropped: the logging thread got too far ahead",
+                 static_cast<unsigned long long>(dropped - ring.reported_dropped));
+        sink->log(Severity::warning, message, "logging");
+        ring.reported_dropped = dropped;
+    }
+
+    return wrote;
+}
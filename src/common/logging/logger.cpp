@@ -19,7 +19,7 @@
 #include "mir/logging/dumb_console_logger.h"
 #include "mir/logging/logger.h"
 
-#include <mutex>
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 
@@ -40,17 +40,22 @@ void ml::Logger::log(char const* component, Severity severity, char const* forma
 
 namespace
 {
-std::mutex log_mutex;
+// Read on every log call, so use atomic access rather than a lock that all logging threads contend on
 std::shared_ptr<ml::Logger> the_logger;
 
 std::shared_ptr<ml::Logger> get_logger()
 {
-    std::lock_guard<decltype(log_mutex)> lock{log_mutex};
+    auto logger = std::atomic_load(&the_logger);
 
-    if (!the_logger)
-        the_logger = std::make_shared<ml::DumbConsoleLogger>();
+    if (!logger)
+    {
+        auto const fallback = std::make_shared<ml::DumbConsoleLogger>();
+        std::atomic_compare_exchange_strong(&the_logger, &logger, std::shared_ptr<ml::Logger>{fallback});
+        if (!logger)
+            logger = fallback;
+    }
 
-    return the_logger;
+    return logger;
 }
 }
 
@@ -61,12 +66,18 @@ void ml::log(ml::Severity severity, const std::string& message, const std::strin
     logger->log(severity, message, component);
 }
 
+void ml::log(ml::Severity severity, char const* message, char const* component)
+{
+    auto const logger = get_logger();
+
+    logger->log(component, severity, "%s", message);
+}
+
 void ml::set_logger(std::shared_ptr<Logger> const& new_logger)
 {
     if (new_logger)
     {
-        std::lock_guard<decltype(log_mutex)> lock{log_mutex};
-        the_logger = new_logger;
+        std::atomic_store(&the_logger, new_logger);
     }
 }
 
@@ -0,0 +1,363 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/geometry/region.h"
+
+#include <algorithm>
+
+namespace geom = mir::geometry;
+
+namespace
+{
+struct Span
+{
+    int left;
+    int right;
+};
+
+bool operator==(Span const& lhs, Span const& rhs)
+{
+    return lhs.left == rhs.left && lhs.right == rhs.right;
+}
+
+using Spans = std::vector<Span>;
+
+enum class Operation { unite, intersect, subtract };
+
+auto is_empty(geom::Rectangle const& rect) -> bool
+{
+    return rect.size.width.as_int() <= 0 || rect.size.height.as_int() <= 0;
+}
+
+/// Builds banded rectangles one band at a time, merging bands that continue the one above
+class BandBuilder
+{
+public:
+    explicit BandBuilder(std::vector<geom::Rectangle>& result)
+        : result{result}
+    {
+        result.clear();
+    }
+
+    void append(int top, int bottom, Spans const& spans)
+    {
+        if (spans.empty())
+            return;
+
+        if (!result.empty() && previous_bottom == top && spans == previous_spans)
+        {
+            for (auto i = previous_start; i != result.size(); ++i)
+                result[i].size.height = geom::Height{bottom - result[i].top().as_int()};
+        }
+        else
+        {
+            previous_start = result.size();
+            for (auto const& span : spans)
+                result.push_back({{span.left, top}, {span.right - span.left, bottom - top}});
+            previous_spans = spans;
+        }
+        previous_bottom = bottom;
+    }
+
+private:
+    std::vector<geom::Rectangle>& result;
+    size_t previous_start{0};
+    int previous_bottom{0};
+    Spans previous_spans;
+};
+
+/// The top and bottom of every rectangle, in order
+void add_edges(std::vector<geom::Rectangle> const& rects, std::vector<int>& edges)
+{
+    for (auto const& rect : rects)
+    {
+        edges.push_back(rect.top().as_int());
+        edges.push_back(rect.bottom().as_int());
+    }
+}
+
+void sort_unique(std::vector<int>& values)
+{
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/// The spans of the band of banded rects covering y. Bands ending above y are skipped
+/// by advancing index, so successive calls must be for increasing y.
+void spans_at(std::vector<geom::Rectangle> const& rects, size_t& index, int y, Spans& spans)
+{
+    spans.clear();
+
+    while (index != rects.size() && rects[index].bottom().as_int() <= y)
+        ++index;
+
+    if (index == rects.size() || rects[index].top().as_int() > y)
+        return;
+
+    auto const top = rects[index].top();
+    for (auto i = index; i != rects.size() && rects[i].top() == top; ++i)
+        spans.push_back({rects[i].left().as_int(), rects[i].right().as_int()});
+}
+
+void combine(Spans const& a, Spans const& b, Operation operation, std::vector<int>& edges, Spans& result)
+{
+    result.clear();
+    edges.clear();
+    for (auto const& spans : {&a, &b})
+    {
+        for (auto const& span : *spans)
+        {
+            edges.push_back(span.left);
+            edges.push_back(span.right);
+        }
+    }
+    sort_unique(edges);
+
+    size_t index_a = 0;
+    size_t index_b = 0;
+    for (size_t i = 0; i + 1 < edges.size(); ++i)
+    {
+        auto const left = edges[i];
+        auto const right = edges[i + 1];
+
+        while (index_a != a.size() && a[index_a].right <= left)
+            ++index_a;
+        while (index_b != b.size() && b[index_b].right <= left)
+            ++index_b;
+
+        bool const in_a = index_a != a.size() && a[index_a].left <= left;
+        bool const in_b = index_b != b.size() && b[index_b].left <= left;
+
+        bool included = false;
+        switch (operation)
+        {
+        case Operation::unite:     included = in_a || in_b; break;
+        case Operation::intersect: included = in_a && in_b; break;
+        case Operation::subtract:  included = in_a && !in_b; break;
+        }
+
+        if (!included)
+            continue;
+
+        if (!result.empty() && result.back().right == left)
+            result.back().right = right;
+        else
+            result.push_back({left, right});
+    }
+}
+
+auto combine(
+    std::vector<geom::Rectangle> const& a,
+    std::vector<geom::Rectangle> const& b,
+    Operation operation) -> std::vector<geom::Rectangle>
+{
+    std::vector<int> y_edges;
+    add_edges(a, y_edges);
+    add_edges(b, y_edges);
+    sort_unique(y_edges);
+
+    std::vector<geom::Rectangle> result;
+    BandBuilder builder{result};
+
+    size_t index_a = 0;
+    size_t index_b = 0;
+    Spans spans_a, spans_b, spans;
+    std::vector<int> x_edges;
+    for (size_t i = 0; i + 1 < y_edges.size(); ++i)
+    {
+        spans_at(a, index_a, y_edges[i], spans_a);
+        spans_at(b, index_b, y_edges[i], spans_b);
+        combine(spans_a, spans_b, operation, x_edges, spans);
+        builder.append(y_edges[i], y_edges[i + 1], spans);
+    }
+
+    return result;
+}
+}
+
+geom::Region::Region(Rectangle const& rect)
+{
+    if (!is_empty(rect))
+        rectangles.push_back(rect);
+}
+
+geom::Region::Region(std::vector<Rectangle> const& rects)
+{
+    std::vector<Rectangle> by_top;
+    std::copy_if(rects.begin(), rects.end(), back_inserter(by_top), [](auto const& rect) { return !is_empty(rect); });
+    std::sort(by_top.begin(), by_top.end(),
+              [](Rectangle const& lhs, Rectangle const& rhs) { return lhs.top() < rhs.top(); });
+
+    std::vector<int> y_edges;
+    add_edges(by_top, y_edges);
+    sort_unique(y_edges);
+
+    // A single sweep down the bands: each band only looks at the rectangles crossing it, which
+    // are kept sorted by left edge so that overlapping spans are adjacent
+    std::vector<Rectangle> crossing;
+    auto next = by_top.begin();
+
+    BandBuilder builder{rectangles};
+    Spans spans;
+    for (size_t i = 0; i + 1 < y_edges.size(); ++i)
+    {
+        auto const top = y_edges[i];
+
+        crossing.erase(
+            std::remove_if(crossing.begin(), crossing.end(),
+                           [top](Rectangle const& rect) { return rect.bottom().as_int() <= top; }),
+            crossing.end());
+
+        for (; next != by_top.end() && next->top().as_int() <= top; ++next)
+        {
+            auto const position = std::upper_bound(crossing.begin(), crossing.end(), *next,
+                [](Rectangle const& lhs, Rectangle const& rhs) { return lhs.left() < rhs.left(); });
+            crossing.insert(position, *next);
+        }
+
+        spans.clear();
+        for (auto const& rect : crossing)
+        {
+            auto const left = rect.left().as_int();
+            auto const right = rect.right().as_int();
+            if (!spans.empty() && spans.back().right >= left)
+                spans.back().right = std::max(spans.back().right, right);
+            else
+                spans.push_back({left, right});
+        }
+
+        builder.append(top, y_edges[i + 1], spans);
+    }
+}
+
+void geom::Region::add(Rectangle const& rect)
+{
+    add(Region{rect});
+}
+
+void geom::Region::add(Region const& region)
+{
+    if (region.empty())
+        return;
+
+    rectangles = combine(rectangles, region.rectangles, Operation::unite);
+}
+
+void geom::Region::subtract(Rectangle const& rect)
+{
+    subtract(Region{rect});
+}
+
+void geom::Region::subtract(Region const& region)
+{
+    if (region.empty() || empty())
+        return;
+
+    rectangles = combine(rectangles, region.rectangles, Operation::subtract);
+}
+
+void geom::Region::intersect(Rectangle const& rect)
+{
+    intersect(Region{rect});
+}
+
+void geom::Region::intersect(Region const& region)
+{
+    rectangles = combine(rectangles, region.rectangles, Operation::intersect);
+}
+
+void geom::Region::translate(Displacement const& displacement)
+{
+    for (auto& rect : rectangles)
+        rect.top_left = rect.top_left + displacement;
+}
+
+void geom::Region::clear()
+{
+    rectangles.clear();
+}
+
+bool geom::Region::empty() const
+{
+    return rectangles.empty();
+}
+
+bool geom::Region::contains(Point const& point) const
+{
+    auto const x = point.x.as_int();
+    auto const y = point.y.as_int();
+
+    // Bands don't overlap, so bottoms never decrease: the first band ending below y is the only candidate
+    auto const band = std::upper_bound(
+        rectangles.begin(), rectangles.end(), y,
+        [](int y, Rectangle const& rect) { return y < rect.bottom().as_int(); });
+
+    if (band == rectangles.end() || band->top().as_int() > y)
+        return false;
+
+    auto const band_end = std::upper_bound(
+        band, rectangles.end(), band->top(),
+        [](Y top, Rectangle const& rect) { return top < rect.top(); });
+
+    auto const rect = std::upper_bound(
+        band, band_end, x,
+        [](int x, Rectangle const& rect) { return x < rect.right().as_int(); });
+
+    return rect != band_end && rect->left().as_int() <= x;
+}
+
+geom::Rectangle geom::Region::bounding_rectangle() const
+{
+    if (rectangles.empty())
+        return {};
+
+    auto left = rectangles.front().left();
+    auto right = rectangles.front().right();
+    for (auto const& rect : rectangles)
+    {
+        left = std::min(left, rect.left());
+        right = std::max(right, rect.right());
+    }
+
+    auto const top = rectangles.front().top();
+    auto const bottom = rectangles.back().bottom();
+    return {{left, top}, {right.as_int() - left.as_int(), bottom.as_int() - top.as_int()}};
+}
+
+geom::Region::const_iterator geom::Region::begin() const
+{
+    return rectangles.begin();
+}
+
+geom::Region::const_iterator geom::Region::end() const
+{
+    return rectangles.end();
+}
+
+geom::Region::size_type geom::Region::size() const
+{
+    return rectangles.size();
+}
+
+bool geom::Region::operator==(Region const& region) const
+{
+    return rectangles == region.rectangles;
+}
+
+bool geom::Region::operator!=(Region const& region) const
+{
+    return rectangles != region.rectangles;
+}
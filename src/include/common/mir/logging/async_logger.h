@@ -0,0 +1,88 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_LOGGING_ASYNC_LOGGER_H_
+#define MIR_LOGGING_ASYNC_LOGGER_H_
+
+#include "mir/logging/logger.h"
+#include "mir/per_thread_rings.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mir
+{
+namespace logging
+{
+/**
+ * A Logger that hands messages to another Logger on a background thread.
+ *
+ * Each logging thread formats into a preallocated slot of its own single-producer
+ * ring, so logging takes no locks and does no I/O. When a thread's ring is full,
+ * warning, informational and debug messages are dropped (and counted); errors wait
+ * for space, and critical messages are flushed before log() returns.
+ */
+class AsyncLogger : public Logger
+{
+public:
+    /// \param sink         receives the messages, on the writer thread
+    /// \param ring_size    the number of messages each thread may have pending
+    AsyncLogger(std::shared_ptr<Logger> const& sink, size_t ring_size = 1024);
+    ~AsyncLogger();
+
+    void log(Severity severity, std::string const& message, std::string const& component) override;
+    void log(char const* component, Severity severity, char const* format, ...) override
+        __attribute__ ((format (printf, 4, 5)));
+
+    /// Waits until every message logged before the call has been passed to the sink
+    void flush();
+
+    /// The number of messages discarded because the logging thread's ring was full
+    auto dropped_messages() const -> uint64_t;
+
+    struct Ring;
+
+private:
+    auto ring_for_this_thread() -> Ring&;
+    void wake_writer();
+    void write_pending();
+    auto drain(Ring& ring) -> bool;
+
+    std::shared_ptr<Logger> const sink;
+    size_t const ring_size;
+    PerThreadRings<Ring> thread_rings;
+
+    std::mutex mutable mutex;
+    std::condition_variable wakeup;
+    std::condition_variable written;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::atomic<bool> writer_waiting{false};
+    bool stopping{false};
+    uint64_t passes_started{0};
+    uint64_t passes_completed{0};
+    uint64_t flush_pass{0};
+    uint64_t dropped_by_removed_rings{0};
+
+    std::thread writer;
+};
+}
+}
+
+#endif // MIR_LOGGING_ASYNC_LOGGER_H_
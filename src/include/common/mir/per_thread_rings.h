@@ -0,0 +1,103 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_PER_THREAD_RINGS_H_
+#define MIR_PER_THREAD_RINGS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mir
+{
+/// The state a thread and the owner of its ring use to tell each other they have gone
+struct PerThreadRing
+{
+    std::atomic<bool> thread_exited{false};     ///< Set once the thread has exited
+    std::atomic<bool> owner_destroyed{false};   ///< Set by the owner as it is destroyed
+};
+
+/**
+ * Gives each thread that uses an owner (a logger, a recorder...) a Ring of its own, found
+ * again through a thread_local list, so that the thread can write to it without taking a lock.
+ *
+ * The owner keeps its own list of the rings (under its own lock) to read from, and must set
+ * owner_destroyed on each as it is destroyed: the thread then forgets the ring the next
+ * time it looks one up. Once thread_exited is set the owner may drop the ring.
+ *
+ * Ring must derive from PerThreadRing.
+ */
+template<typename Ring>
+class PerThreadRings
+{
+public:
+    PerThreadRings() : id{next_id()} {}
+
+    PerThreadRings(PerThreadRings const&) = delete;
+    PerThreadRings& operator=(PerThreadRings const&) = delete;
+
+    /// The ring of the calling thread, made by \a create (which should add it to the owner's list) on first use
+    template<typename Create>
+    auto for_this_thread(Create&& create) -> Ring&
+    {
+        auto& entries = thread_entries().entries;
+        for (auto entry = entries.begin(); entry != entries.end();)
+        {
+            if (entry->first == id)
+                return *entry->second;
+
+            if (entry->second->owner_destroyed)
+                entry = entries.erase(entry);
+            else
+                ++entry;
+        }
+
+        std::shared_ptr<Ring> const ring = create();
+        entries.emplace_back(id, ring);
+        return *ring;
+    }
+
+private:
+    struct ThreadEntries
+    {
+        ~ThreadEntries()
+        {
+            for (auto const& entry : entries)
+                entry.second->thread_exited = true;
+        }
+
+        std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> entries;
+    };
+
+    static auto next_id() -> uint64_t
+    {
+        static std::atomic<uint64_t> next{1};
+        return next++;
+    }
+
+    static auto thread_entries() -> ThreadEntries&
+    {
+        static thread_local ThreadEntries entries;
+        return entries;
+    }
+
+    uint64_t const id;
+};
+}
+
+#endif // MIR_PER_THREAD_RINGS_H_
@@ -0,0 +1,158 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_LINUX_DMABUF_H_
+#define MIR_GRAPHICS_LINUX_DMABUF_H_
+
+#include "mir/fd.h"
+
+#include <EGL/egl.h>
+#include <sys/types.h>
+
+#include <array>
+#include <cstdint>
+#include <experimental/optional>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+struct wl_display;
+struct wl_resource;
+
+namespace mir
+{
+class Executor;
+
+namespace renderer
+{
+namespace gl
+{
+class Context;
+}
+}
+
+namespace graphics
+{
+class Buffer;
+struct EGLExtensions;
+
+/// The DRM format and modifier pairs that clients may share buffers in
+class DmaBufFormats
+{
+public:
+    /// DRM_FORMAT_MOD_INVALID: the buffer's layout is implied by its driver
+    static uint64_t const implicit_modifier = 0x00ffffffffffffffULL;
+
+    struct Entry
+    {
+        uint32_t format;
+        uint64_t modifier;
+        bool external_only;     ///< Can only be sampled through GL_TEXTURE_EXTERNAL_OES
+    };
+
+    void add(uint32_t format, uint64_t modifier, bool external_only);
+
+    /// The entry for the pair, or nullptr if buffers in it can't be imported
+    auto find(uint32_t format, uint64_t modifier) const -> Entry const*;
+
+    /// In the order added, which is the order of zwp_linux_dmabuf_feedback_v1's format table
+    auto entries() const -> std::vector<Entry> const&;
+
+private:
+    std::vector<Entry> entries_;
+};
+
+/**
+ * The planes of a buffer being described through zwp_linux_buffer_params_v1.
+ *
+ * The checks the protocol asks of the compositor are made here, before anything reaches
+ * EGL, so they don't need a GPU: any file that can be mapped (a memfd, or a vgem or
+ * udmabuf dmabuf) will do as a plane.
+ */
+class DmaBufParams
+{
+public:
+    /// A breach of the protocol; code is a zwp_linux_buffer_params_v1 error
+    class ProtocolError : public std::runtime_error
+    {
+    public:
+        ProtocolError(uint32_t code, std::string const& message);
+
+        uint32_t const code;
+    };
+
+    struct Plane
+    {
+        Fd fd;
+        uint32_t offset;
+        uint32_t stride;
+    };
+
+    static size_t const max_planes = 4;
+
+    /// \throws ProtocolError if the plane is out of range or already set
+    void add(Fd fd, uint32_t plane_idx, uint32_t offset, uint32_t stride, uint64_t modifier);
+
+    /// \throws ProtocolError if the planes can't hold a buffer of this size and format
+    void check(int32_t width, int32_t height, uint32_t format, DmaBufFormats const& formats) const;
+
+    /// The planes in order; only meaningful once check() has passed
+    auto planes() const -> std::vector<Plane>;
+    auto modifier() const -> uint64_t;
+
+private:
+    std::array<std::experimental::optional<Plane>, max_planes> planes_;
+    std::experimental::optional<uint64_t> modifier_;
+};
+
+/**
+ * The zwp_linux_dmabuf_v1 global, and the wl_buffers its clients create.
+ *
+ * Each wl_buffer is imported into a texture when it is created, so that a client learns
+ * of buffers the GPU can't read, and committing it never creates EGL or GL objects.
+ */
+class LinuxDmaBufUnstable
+{
+public:
+    /**
+     * \param main_device   the dev_t of the DRM device buffers should be allocated on
+     * \throws std::runtime_error if dpy can't import dmabufs
+     */
+    LinuxDmaBufUnstable(
+        wl_display* display,
+        EGLDisplay dpy,
+        std::shared_ptr<EGLExtensions> egl_extensions,
+        std::shared_ptr<renderer::gl::Context> ctx,
+        std::shared_ptr<Executor> wayland_executor,
+        dev_t main_device);
+    ~LinuxDmaBufUnstable();
+
+    /// A Buffer for a commit of buffer, or nullptr if it wasn't created through this global
+    auto buffer_from_resource(
+        wl_resource* buffer,
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release) -> std::shared_ptr<Buffer>;
+
+    class Global;
+
+private:
+    std::unique_ptr<Global> const global;
+};
+}
+}
+
+#endif // MIR_GRAPHICS_LINUX_DMABUF_H_
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
+#define MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
+
+#include "mir/graphics/buffer_basic.h"
+#include "mir/graphics/texture.h"
+#include "mir/renderer/sw/pixel_source.h"
+
+#include <cstdint>
+#include <string>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * A 1x1 buffer of a single color, to be stretched over any area.
+ *
+ * The GL renderer draws it with a constant-color shader, so it has no texture
+ * to allocate or upload. For renderers that need pixels it is also a (one
+ * pixel) PixelSource.
+ */
+class SolidColorBuffer
+    : public BufferBasic,
+      public NativeBufferBase,
+      public gl::Texture,
+      public renderer::software::PixelSource
+{
+public:
+    /// \param [in] argb    A non-premultiplied color, alpha in the most significant byte
+    explicit SolidColorBuffer(uint32_t argb);
+
+    auto argb() const -> uint32_t { return argb_; }
+
+    std::shared_ptr<NativeBuffer> native_buffer_handle() const override;
+    geometry::Size size() const override;
+    MirPixelFormat pixel_format() const override;
+    NativeBufferBase* native_buffer_base() override;
+
+    gl::Program const& shader(gl::ProgramFactory& factory) const override;
+    Layout layout() const override;
+    void bind() override;
+    void add_syncpoint() override;
+
+    /// Throws: the color is fixed at construction
+    void write(unsigned char const* pixels, size_t size) override;
+    void read(std::function<void(unsigned char const*)> const& do_with_pixels) override;
+    geometry::Stride stride() const override;
+
+private:
+    uint32_t const argb_;
+    uint32_t const premultiplied;
+};
+
+/// The fragment-shader fragment (\see ProgramFactory::compile_fragment_shader()) drawing argb
+auto solid_color_fragment_shader(uint32_t argb) -> std::string;
+}
+}
+
+#endif // MIR_GRAPHICS_SOLID_COLOR_BUFFER_H_
@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_YUV_SHADER_H_
+#define MIR_GRAPHICS_YUV_SHADER_H_
+
+#include "mir/geometry/size.h"
+
+#include <array>
+#include <string>
+
+namespace mir
+{
+namespace graphics
+{
+namespace gl
+{
+class Program;
+class ProgramFactory;
+
+/// Where a YUV shader finds each component among the textures bound to tex[0], tex[1], …
+enum class YuvPlanes
+{
+    y_u_v,      ///< Y, U and V each in the red channel of tex[0], tex[1] and tex[2]
+    y_uv,       ///< Y in tex[0].r; U and V in tex[1].r and tex[1].g (a GR88 chroma plane)
+    y_uv_la,    ///< Y in tex[0].r; U and V in tex[1].r and tex[1].a (a GL_LUMINANCE_ALPHA chroma plane)
+    y_xuxv,     ///< Y in tex[0].r; U and V in tex[1].g and tex[1].a (YUYV sampled at full and half width)
+};
+
+/// The number of textures a shader for planes samples
+auto texture_count(YuvPlanes planes) -> unsigned;
+
+struct YuvEncoding
+{
+    enum class Matrix
+    {
+        bt601,
+        bt709
+    };
+
+    enum class Range
+    {
+        limited,    ///< Y in [16, 235], U and V in [16, 240]
+        full        ///< Y, U and V in [0, 255]
+    };
+
+    Matrix matrix;
+    Range range;
+};
+
+/**
+ * The encoding to assume for a buffer whose client hasn't said.
+ *
+ * As video players and decoders conventionally do, this is limited range, with
+ * BT.709 for HD and larger and BT.601 below.
+ */
+auto default_yuv_encoding(geometry::Size const& size) -> YuvEncoding;
+
+/// rgb = matrix * (yuv - offset), with matrix in column-major order as GLSL expects
+struct YuvToRgb
+{
+    std::array<float, 9> matrix;
+    std::array<float, 3> offset;
+};
+
+auto yuv_to_rgb(YuvEncoding encoding) -> YuvToRgb;
+
+/// The fragment-shader fragment (\see ProgramFactory::compile_fragment_shader()) for planes in encoding
+auto yuv_fragment_shader(YuvPlanes planes, YuvEncoding encoding) -> std::string;
+
+/**
+ * The Program for planes in encoding.
+ *
+ * Each variant is compiled the first time it is asked for and shared from then on.
+ */
+auto yuv_program(ProgramFactory& factory, YuvPlanes planes, YuvEncoding encoding) -> Program const&;
+}
+}
+}
+
+#endif // MIR_GRAPHICS_YUV_SHADER_H_
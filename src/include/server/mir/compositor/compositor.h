@@ -21,6 +21,10 @@
 
 namespace mir
 {
+namespace graphics
+{
+class DisplaySyncGroup;
+}
 namespace compositor
 {
 
@@ -32,6 +36,13 @@ public:
     virtual void start() = 0;
     virtual void stop() = 0;
 
+    /// Stops compositing to a DisplaySyncGroup the Display is about to destroy,
+    /// the remaining DisplaySyncGroups continue to be composited.
+    virtual void remove_display_sync_group(graphics::DisplaySyncGroup& group) = 0;
+
+    /// Starts compositing to any DisplaySyncGroup of the Display not yet being composited.
+    virtual void add_new_display_sync_groups() = 0;
+
 protected:
     Compositor() = default;
     Compositor(Compositor const&) = delete;
@@ -161,6 +161,7 @@ class Configuration;
 namespace report
 {
 class ReportFactory;
+namespace flight_recorder { class Recorder; }
 }
 
 namespace renderer
@@ -365,6 +366,8 @@ public:
 
     virtual std::shared_ptr<ConsoleServices> the_console_services();
     auto default_reports() -> std::shared_ptr<void>;
+    /// The recorder of recent frame and input timing, or null if it's disabled
+    auto the_flight_recorder() -> std::shared_ptr<report::flight_recorder::Recorder>;
 
 private:
     // We need to ensure the platform library is destroyed last as the
@@ -489,6 +492,7 @@ private:
     std::shared_ptr<scene::BroadcastingSessionEventSink> the_broadcasting_session_event_sink();
 
     auto report_factory(char const* report_opt) -> std::unique_ptr<report::ReportFactory>;
+    CachedPtr<report::flight_recorder::Recorder> flight_recorder;
 
     CachedPtr<shell::detail::FrontendShell> frontend_shell;
     std::vector<mir::ExtensionDescription> the_extensions();
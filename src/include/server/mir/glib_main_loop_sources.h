@@ -73,12 +73,51 @@ void add_server_action_gsource(
     std::function<void()> const& action,
     std::function<bool(void const*)> const& should_dispatch);
 
-GSourceHandle add_timer_gsource(
-    GMainContext* main_context,
-    std::shared_ptr<time::Clock> const& clock,
-    std::shared_ptr<LockableCallback> const& handler,
-    std::function<void()> const& exception_handler,
-    time::Timestamp target_time);
+/**
+ * The one GSource that dispatches all of a main loop's timers.
+ *
+ * Timers wait in a time::TimerWheel and the source polls a timerfd armed for
+ * the wheel's next event, so the cost of a main loop iteration doesn't grow
+ * with the number of timers. Timers due within the same tick of resolution are
+ * dispatched together.
+ */
+class TimerSource
+{
+public:
+    class Timer
+    {
+    public:
+        virtual ~Timer() = default;
+
+        /// Replaces any previous schedule; a dispatch already under way still completes
+        virtual void schedule(time::Timestamp target_time) = 0;
+        /// Cancels any schedule and returns once no dispatch is under way on another thread
+        virtual void ensure_no_further_dispatch() = 0;
+
+    protected:
+        Timer() = default;
+        Timer(Timer const&) = delete;
+        Timer& operator=(Timer const&) = delete;
+    };
+
+    TimerSource(
+        GMainContext* main_context,
+        std::shared_ptr<time::Clock> const& clock,
+        time::Duration resolution);
+    ~TimerSource();
+
+    auto create_timer(
+        std::shared_ptr<LockableCallback> const& handler,
+        std::function<void()> const& exception_handler) -> std::unique_ptr<Timer>;
+
+private:
+    struct TimerQueue;
+    struct TimerImpl;
+    struct TimerGSource;
+
+    std::shared_ptr<TimerQueue> const queue;
+    GSourceHandle gsource;
+};
 
 class FdSources
 {
@@ -25,6 +25,10 @@
 
 namespace mir
 {
+namespace geometry
+{
+struct Rectangle;
+}
 namespace scene
 {
 class Observer;
@@ -59,6 +63,10 @@ public:
     // TODO: How can something like SurfaceObserver be adapted to work with non surface renderables?
     virtual void emit_scene_changed() = 0;
 
+    // For input visualizations that only change a known area of the screen (e.g. a moving cursor)
+    // this triggers recomposition of just the outputs overlapping the damaged area.
+    virtual void emit_scene_damaged(geometry::Rectangle const& damage) = 0;
+
 protected:
     Scene() = default;
     Scene(Scene const&) = delete;
@@ -23,6 +23,10 @@
 
 namespace mir
 {
+namespace geometry
+{
+struct Rectangle;
+}
 namespace scene
 {
 class Surface;
@@ -41,6 +45,11 @@ public:
     /// and will require full recomposition.
     virtual void scene_changed() = 0;
 
+    /// Used to indicate something other than a surface (e.g. an input visualization)
+    /// has changed only within the damaged area. Recomposition of outputs not
+    /// overlapping the damage is not required.
+    virtual void scene_damaged(geometry::Rectangle const& damage) = 0;
+
     /// Called at observer registration to notify of already existing surfaces.
     virtual void surface_exists(std::shared_ptr<Surface> const& surface) = 0;
 
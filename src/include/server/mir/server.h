@@ -59,6 +59,7 @@ class HostLifecycleEventListener;
 class InputTargeter;
 class PersistentSurfaceStore;
 class Shell;
+class ShellReport;
 class SurfaceStack;
 }
 namespace scene
@@ -404,6 +405,9 @@ public:
     /// \return the display layout.
     auto the_shell_display_layout() const -> std::shared_ptr<shell::DisplayLayout>;
 
+    /// \return the shell report.
+    auto the_shell_report() const -> std::shared_ptr<shell::ShellReport>;
+
     /// \return the buffer stream factory
     auto the_buffer_stream_factory() const -> std::shared_ptr<scene::BufferStreamFactory>;
 
@@ -142,6 +142,8 @@ public:
     auto surface_at(geometry::Point cursor) const -> std::shared_ptr<scene::Surface> override;
 
     void raise(SurfaceSet const& surfaces) override;
+
+    void apply_atomically(std::function<void()> const& changes) override;
 /** @} */
 
     void add_display(geometry::Rectangle const& area) override;
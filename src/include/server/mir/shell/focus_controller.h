@@ -20,6 +20,7 @@
 #define MIR_SHELL_FOCUS_CONTROLLER_H_
 
 #include <stddef.h>
+#include <functional>
 #include <memory>
 #include <set>
 #include <vector>
@@ -53,6 +54,9 @@ public:
 
     virtual void raise(SurfaceSet const& surfaces) = 0;
 
+    /// Makes the changes to the scene as one: nothing is composited part way through them
+    virtual void apply_atomically(std::function<void()> const& changes) = 0;
+
     virtual void set_drag_and_drop_handle(std::vector<uint8_t> const& handle) = 0;
     virtual void clear_drag_and_drop_handle() = 0;
 
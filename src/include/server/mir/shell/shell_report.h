@@ -22,6 +22,7 @@
 #include "mir/frontend/surface_id.h"
 #include "mir_toolkit/common.h"
 
+#include <chrono>
 #include <memory>
 #include <set>
 
@@ -37,6 +38,16 @@ struct SurfaceSpecification;
 using SurfaceSet = std::set<std::weak_ptr<scene::Surface>, std::owner_less<std::weak_ptr<scene::Surface>>>;
 /// @endcond
 
+/// Running totals for the lock guarding window management state
+struct LockContention
+{
+    unsigned long long exclusive_acquisitions;
+    unsigned long long exclusive_contended;     ///< Exclusive acquisitions that had to wait
+    unsigned long long shared_acquisitions;
+    unsigned long long shared_contended;        ///< Shared acquisitions that had to wait
+    std::chrono::nanoseconds time_waiting;      ///< Total time spent waiting for the lock
+};
+
 class ShellReport
 {
 public:
@@ -83,6 +94,8 @@ public:
 
     virtual void surfaces_raised(SurfaceSet const& surfaces) = 0;
 
+    virtual void window_management_lock_contention(LockContention const& contention) = 0;
+
     ShellReport() = default;
     virtual ~ShellReport() = default;
     ShellReport(ShellReport const&) = delete;
@@ -45,6 +45,8 @@ public:
 
     void raise(SurfaceSet const& surfaces) override;
 
+    void apply_atomically(std::function<void()> const& changes) override;
+
     auto open_session(
         pid_t client_pid,
         std::string const& name,
@@ -20,6 +20,7 @@
 #ifndef MIR_SHELL_SURFACE_COORDINATOR_H_
 #define MIR_SHELL_SURFACE_COORDINATOR_H_
 
+#include <functional>
 #include <memory>
 #include <set>
 
@@ -54,6 +55,9 @@ public:
 
     virtual auto surface_at(geometry::Point) const -> std::shared_ptr<scene::Surface> = 0;
 
+    /// Makes the changes to the scene as one: nothing is composited part way through them
+    virtual void apply_atomically(std::function<void()> const& changes) = 0;
+
 protected:
     SurfaceStack() = default;
     virtual ~SurfaceStack() = default;
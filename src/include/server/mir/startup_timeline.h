@@ -0,0 +1,36 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_STARTUP_TIMELINE_H_
+#define MIR_STARTUP_TIMELINE_H_
+
+namespace mir
+{
+/// Logs how long each phase of server startup takes, from run_mir() to the first frame posted
+namespace startup_timeline
+{
+/// Starts (or restarts) the timeline
+void started();
+
+/// Logs the time since the previous phase completed. Ignored once the first frame has been posted.
+void phase_completed(char const* phase);
+
+/// Completes the timeline. Cheap to call on every frame.
+void first_frame_posted();
+}
+}
+
+#endif /* MIR_STARTUP_TIMELINE_H_ */
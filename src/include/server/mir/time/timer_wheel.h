@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_TIME_TIMER_WHEEL_H_
+#define MIR_TIME_TIMER_WHEEL_H_
+
+#include "mir/time/types.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mir
+{
+namespace time
+{
+/**
+ * Timers ordered by expiry in a hierarchical timing wheel.
+ *
+ * Expiry times are rounded up to whole ticks of resolution, so timers expiring
+ * within the same tick come due together. Scheduling and cancelling are O(1);
+ * on its way to expiring a timer moves down at most once per level.
+ *
+ * Not thread safe: callers serialise access.
+ */
+class TimerWheel
+{
+public:
+    /// Intrusively linked into the wheel; must be cancelled before it is destroyed
+    class Timer
+    {
+    public:
+        Timer() = default;
+
+        bool is_scheduled() const { return bucket != unscheduled; }
+
+    private:
+        friend class TimerWheel;
+        static int const unscheduled = -1;
+
+        Timer(Timer const&) = delete;
+        Timer& operator=(Timer const&) = delete;
+
+        Timer* prev{nullptr};
+        Timer* next{nullptr};
+        uint64_t expiry{0};
+        int bucket{unscheduled};
+    };
+
+    TimerWheel(Timestamp origin, Duration resolution);
+
+    /// Schedules timer to expire at expiry, replacing any previous schedule
+    void schedule(Timer& timer, Timestamp expiry);
+
+    void cancel(Timer& timer);
+
+    /// When advance_to() next has work to do, or Timestamp::max() if nothing is scheduled
+    auto next_event() const -> Timestamp;
+
+    /// Moves the wheel on to now and returns the timers that came due, in order of expiry
+    auto advance_to(Timestamp now) -> std::vector<Timer*>;
+
+private:
+    static int const bits_per_level = 6;
+    static int const slots_per_level = 1 << bits_per_level;
+    static int const levels = (64 + bits_per_level - 1) / bits_per_level;
+    static int const due_bucket = levels * slots_per_level;
+
+    auto tick_of(Timestamp time, bool round_up) const -> uint64_t;
+    auto time_of(uint64_t tick) const -> Timestamp;
+    /// The tick at which the earliest occupied slot is next processed, or current if timers are due
+    auto next_tick() const -> uint64_t;
+
+    void insert(Timer& timer);
+    void link(Timer& timer, int bucket);
+    void unlink(Timer& timer);
+
+    Timestamp const origin;
+    Duration const resolution;
+    uint64_t current{0};
+    std::array<uint64_t, levels> occupied{};
+    std::array<Timer*, due_bucket + 1> buckets{};
+};
+}
+}
+
+#endif /* MIR_TIME_TIMER_WHEEL_H_ */
@@ -27,6 +27,7 @@
 #include <mir/scene/surface_creation_parameters.h>
 #include <mir/shell/display_layout.h>
 #include <mir/shell/persistent_surface_store.h>
+#include <mir/shell/shell_report.h>
 #include <mir/shell/surface_ready_observer.h>
 
 #include <boost/throw_exception.hpp>
@@ -45,12 +46,12 @@ struct miral::BasicWindowManager::Locker
         policy->advise_end();
     }
 
-    std::lock_guard<std::mutex> const lock;
+    std::unique_lock<mir::PosixRWMutex> const lock;
     WindowManagementPolicy* const policy;
 };
 
 miral::BasicWindowManager::Locker::Locker(BasicWindowManager* self) :
-    lock{self->mutex},
+    lock{self->lock_exclusively()},
     policy{self->policy.get()}
 {
     policy->advise_begin();
@@ -70,11 +71,29 @@ miral::BasicWindowManager::BasicWindowManager(
     std::shared_ptr<mir::shell::PersistentSurfaceStore> const& persistent_surface_store,
     mir::ObserverRegistrar<mir::graphics::DisplayConfigurationObserver>& display_configuration_observers,
     WindowManagementPolicyBuilder const& build) :
+    BasicWindowManager(
+        focus_controller,
+        display_layout,
+        persistent_surface_store,
+        display_configuration_observers,
+        build,
+        nullptr)
+{
+}
+
+miral::BasicWindowManager::BasicWindowManager(
+    shell::FocusController* focus_controller,
+    std::shared_ptr<shell::DisplayLayout> const& display_layout,
+    std::shared_ptr<mir::shell::PersistentSurfaceStore> const& persistent_surface_store,
+    mir::ObserverRegistrar<mir::graphics::DisplayConfigurationObserver>& display_configuration_observers,
+    WindowManagementPolicyBuilder const& build,
+    std::shared_ptr<mir::shell::ShellReport> const& report) :
     focus_controller(focus_controller),
     display_layout(display_layout),
     persistent_surface_store{persistent_surface_store},
     policy(build(WindowManagerTools{this})),
     policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())},
+    report{report},
     display_config_monitor{std::make_shared<DisplayConfigurationListeners>()}
 {
     display_config_monitor->add_listener(this);
@@ -91,13 +110,13 @@ miral::BasicWindowManager::~BasicWindowManager()
 void miral::BasicWindowManager::add_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    policy->advise_new_app(app_info[session] = ApplicationInfo(session));
+    policy->advise_new_app(app_info[session.get()] = ApplicationInfo(session));
 }
 
 void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> const& session)
 {
     Locker lock{this};
-    auto info = app_info.find(session);
+    auto info = app_info.find(session.get());
     if (info == app_info.end())
     {
         log_debug(
@@ -107,7 +126,7 @@ void miral::BasicWindowManager::remove_session(std::shared_ptr<scene::Session> c
         return;
     }
     policy->advise_delete_app(info->second);
-    app_info.erase(session);
+    app_info.erase(info);
 }
 
 auto miral::BasicWindowManager::add_surface(
@@ -132,7 +151,7 @@ auto miral::BasicWindowManager::add_surface(
     spec.update(parameters);
     auto const surface = build(session, parameters);
     Window const window{session, surface};
-    auto& window_info = this->window_info.emplace(window, WindowInfo{window, spec}).first->second;
+    auto& window_info = this->window_info.emplace(surface.get(), WindowInfo{window, spec}).first->second;
 
     if (spec.parent().is_set() && spec.parent().value().lock())
         window_info.parent(info_for(spec.parent().value()).window());
@@ -196,7 +215,7 @@ void miral::BasicWindowManager::remove_surface(
     std::weak_ptr<scene::Surface> const& surface)
 {
     Locker lock{this};
-    if (app_info.find(session) == app_info.end())
+    if (app_info.find(session.get()) == app_info.end())
     {
         log_debug(
             "BasicWindowManager::remove_surface() called with unknown or already removed session %s (PID: %d)",
@@ -213,6 +232,8 @@ void miral::BasicWindowManager::remove_surface(
 
 void miral::BasicWindowManager::remove_window(Application const& application, miral::WindowInfo const& info)
 {
+    // The records are keyed by the surface, so keep it alive until they're erased
+    std::shared_ptr<scene::Surface> const surface{info.window()};
     bool const is_active_window{mru_active_windows.top() == info.window()};
     auto const workspaces_containing_window = workspaces_containing(info.window());
 
@@ -318,7 +339,7 @@ void miral::BasicWindowManager::erase(miral::WindowInfo const& info)
     for (auto& child : info.children())
         info_for(child).parent({});
 
-    window_info.erase(info.window());
+    window_info.erase(std::shared_ptr<scene::Surface>(info.window()).get());
 }
 
 #pragma GCC diagnostic push
@@ -350,6 +371,7 @@ bool miral::BasicWindowManager::handle_touch_event(MirTouchEvent const* event)
 
 bool miral::BasicWindowManager::handle_pointer_event(MirPointerEvent const* event)
 {
+    // The policy may focus, move or resize windows in response to any event, so this can't share the lock
     Locker lock{this};
     update_event_timestamp(event);
 
@@ -365,12 +387,12 @@ void miral::BasicWindowManager::handle_raise_surface(
     std::shared_ptr<scene::Surface> const& surface,
     uint64_t timestamp)
 {
-    Locker lock{this};
-
-    if (!surface_known(surface, "raise"))
+    if (!screen_request(surface, timestamp, "raise"))
         return;
 
-    if (timestamp >= last_input_event_timestamp)
+    Locker lock{this};
+
+    if (request_is_current(surface, timestamp, "raise"))
         policy->handle_raise_window(info_for(surface));
 }
 
@@ -379,12 +401,12 @@ void miral::BasicWindowManager::handle_request_drag_and_drop(
     std::shared_ptr<mir::scene::Surface> const& surface,
     uint64_t timestamp)
 {
-    Locker lock{this};
-
-    if (!surface_known(surface, "drag-and-drop"))
+    if (!screen_request(surface, timestamp, "drag-and-drop"))
         return;
 
-    if (timestamp >= last_input_event_timestamp)
+    Locker lock{this};
+
+    if (request_is_current(surface, timestamp, "drag-and-drop"))
         policy->handle_request_drag_and_drop(info_for(surface));
 }
 
@@ -393,12 +415,12 @@ void miral::BasicWindowManager::handle_request_move(
     std::shared_ptr<mir::scene::Surface> const& surface,
     uint64_t timestamp)
 {
-    std::lock_guard<decltype(mutex)> lock(mutex);
-
-    if (!surface_known(surface, "move"))
+    if (!screen_request(surface, timestamp, "move"))
         return;
 
-    if (timestamp >= last_input_event_timestamp && last_input_event)
+    auto const lock = lock_exclusively();
+
+    if (request_is_current(surface, timestamp, "move") && last_input_event)
     {
         policy->handle_request_move(info_for(surface), mir_event_get_input_event(last_input_event));
     }
@@ -410,12 +432,12 @@ void miral::BasicWindowManager::handle_request_resize(
     uint64_t timestamp,
     MirResizeEdge edge)
 {
-    std::lock_guard<decltype(mutex)> lock(mutex);
-
-    if (!surface_known(surface, "resize"))
+    if (!screen_request(surface, timestamp, "resize"))
         return;
 
-    if (timestamp >= last_input_event_timestamp && last_input_event)
+    auto const lock = lock_exclusively();
+
+    if (request_is_current(surface, timestamp, "resize") && last_input_event)
     {
         policy->handle_request_resize(info_for(surface), mir_event_get_input_event(last_input_event), edge);
     }
@@ -506,7 +528,7 @@ auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationI
     {
         if (predicate(info.second))
         {
-            return Application{info.first};
+            return info.second.application();
         }
     }
 
@@ -516,19 +538,19 @@ auto miral::BasicWindowManager::find_application(std::function<bool(ApplicationI
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Session> const& session) const
 -> ApplicationInfo&
 {
-    return const_cast<ApplicationInfo&>(app_info.at(session));
+    return const_cast<ApplicationInfo&>(app_info.at(session.lock().get()));
 }
 
 auto miral::BasicWindowManager::info_for(std::weak_ptr<scene::Surface> const& surface) const
 -> WindowInfo&
 {
-    return const_cast<WindowInfo&>(window_info.at(surface));
+    return const_cast<WindowInfo&>(window_info.at(surface.lock().get()));
 }
 
 auto miral::BasicWindowManager::info_for(Window const& window) const
 -> WindowInfo&
 {
-    return info_for(std::weak_ptr<mir::scene::Surface>(window));
+    return const_cast<WindowInfo&>(window_info.at(std::shared_ptr<mir::scene::Surface>(window).get()));
 }
 
 void miral::BasicWindowManager::ask_client_to_close(Window const& window)
@@ -950,10 +972,9 @@ void miral::BasicWindowManager::set_tree_depth_layer(miral::WindowInfo& root, Mi
     }
 }
 
-void miral::BasicWindowManager::modify_window(WindowInfo& window_info, WindowSpecification const& modifications)
+void miral::BasicWindowManager::copy_modifications(
+    WindowSpecification const& modifications, WindowInfo const& window_info, WindowInfo& window_info_tmp) const
 {
-    WindowInfo window_info_tmp{window_info};
-
 #define COPY_IF_SET(field)\
     if (modifications.field().is_set())\
         window_info_tmp.field(modifications.field().value())
@@ -1015,6 +1036,12 @@ void miral::BasicWindowManager::modify_window(WindowInfo& window_info, WindowSpe
                 throw std::runtime_error("Target window type requires parent");
         }
     }
+}
+
+void miral::BasicWindowManager::modify_window(WindowInfo& window_info, WindowSpecification const& modifications)
+{
+    WindowInfo window_info_tmp{window_info};
+    copy_modifications(modifications, window_info, window_info_tmp);
 
     bool application_zones_need_update = false;
     if (window_info.state() == mir_window_state_attached ||
@@ -1153,6 +1180,35 @@ void miral::BasicWindowManager::modify_window(WindowInfo& window_info, WindowSpe
         std::shared_ptr<scene::Surface>(window)->set_confine_pointer_state(modifications.confine_pointer().value());
 }
 
+void miral::BasicWindowManager::modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications)
+{
+    // Check everything that can throw before changing anything, so the batch is all or nothing
+    std::vector<std::reference_wrapper<WindowInfo>> window_infos;
+    window_infos.reserve(modifications.size());
+
+    for (auto const& modification : modifications)
+    {
+        auto& window_info = info_for(modification.first);
+
+        // A later modification of the same window would be checked against the state before the earlier one
+        for (WindowInfo const& checked : window_infos)
+        {
+            if (&checked == &window_info)
+                BOOST_THROW_EXCEPTION(std::runtime_error{"Window modified more than once in the same batch"});
+        }
+
+        WindowInfo unused{window_info};
+        copy_modifications(modification.second, window_info, unused);
+        window_infos.push_back(window_info);
+    }
+
+    focus_controller->apply_atomically([&]
+        {
+            for (auto i = 0u; i != modifications.size(); ++i)
+                modify_window(window_infos[i], modifications[i].second);
+        });
+}
+
 auto miral::BasicWindowManager::info_for_window_id(std::string const& id) const -> WindowInfo&
 {
     auto surface = persistent_surface_store->surface_for_id(mir::shell::PersistentSurfaceStore::Id{id});
@@ -1529,6 +1585,64 @@ void miral::BasicWindowManager::invoke_under_lock(std::function<void()> const& c
     callback();
 }
 
+void miral::BasicWindowManager::invoke_under_shared_lock(std::function<void()> const& callback)
+{
+    auto const lock = lock_shared();
+    callback();
+}
+
+auto miral::BasicWindowManager::lock_contention() const -> mir::shell::LockContention
+{
+    return {
+        lock_counters.exclusive_acquisitions,
+        lock_counters.exclusive_contended,
+        lock_counters.shared_acquisitions,
+        lock_counters.shared_contended,
+        std::chrono::nanoseconds{lock_counters.nanoseconds_waiting}};
+}
+
+auto miral::BasicWindowManager::lock_exclusively() -> std::unique_lock<mir::PosixRWMutex>
+{
+    std::unique_lock<mir::PosixRWMutex> lock{mutex, std::try_to_lock};
+
+    if (!lock.owns_lock())
+    {
+        auto const start = std::chrono::steady_clock::now();
+        lock.lock();
+        count_wait(lock_counters.exclusive_contended, std::chrono::steady_clock::now() - start);
+    }
+
+    ++lock_counters.exclusive_acquisitions;
+    return lock;
+}
+
+auto miral::BasicWindowManager::lock_shared() -> std::shared_lock<mir::PosixRWMutex>
+{
+    std::shared_lock<mir::PosixRWMutex> lock{mutex, std::try_to_lock};
+
+    if (!lock.owns_lock())
+    {
+        auto const start = std::chrono::steady_clock::now();
+        lock.lock();
+        count_wait(lock_counters.shared_contended, std::chrono::steady_clock::now() - start);
+    }
+
+    ++lock_counters.shared_acquisitions;
+    return lock;
+}
+
+void miral::BasicWindowManager::count_wait(
+    std::atomic<unsigned long long>& contended, std::chrono::steady_clock::duration waited)
+{
+    // Reporting every wait would flood the report on a busy server
+    unsigned long long const report_interval = 256;
+
+    lock_counters.nanoseconds_waiting += std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count();
+
+    if (++contended % report_interval == 0 && report)
+        report->window_management_lock_contention(lock_contention());
+}
+
 auto miral::BasicWindowManager::select_active_window(Window const& hint) -> miral::Window
 {
     auto const prev_window = active_window();
@@ -1655,7 +1769,7 @@ auto miral::BasicWindowManager::surface_known(
     std::weak_ptr<scene::Surface> const& surface,
     std::string const& action) -> bool
 {
-    if (window_info.find(surface) != window_info.end())
+    if (window_info.find(surface.lock().get()) != window_info.end())
     {
         return true;
     }
@@ -1677,15 +1791,37 @@ auto miral::BasicWindowManager::surface_known(
     }
 }
 
+auto miral::BasicWindowManager::request_is_current(
+    std::weak_ptr<scene::Surface> const& surface,
+    uint64_t timestamp,
+    std::string const& action) -> bool
+{
+    return surface_known(surface, action) && timestamp >= last_input_event_timestamp;
+}
+
+auto miral::BasicWindowManager::screen_request(
+    std::weak_ptr<scene::Surface> const& surface,
+    uint64_t timestamp,
+    std::string const& action) -> bool
+{
+    auto const lock = lock_shared();
+    return request_is_current(surface, timestamp, action);
+}
+
 auto miral::BasicWindowManager::can_activate_window_for_session(miral::Application const& session) -> bool
 {
+    auto const info = app_info.find(session.get());
+    if (info == app_info.end())
+        return false;
+
     miral::Window new_focus;
 
-    mru_active_windows.enumerate([&](miral::Window& window)
+    // Only the session's own windows need visiting, not the whole MRU list
+    mru_active_windows.enumerate(info->second.windows(), [&](miral::Window& window)
         {
             // select_active_window() calls set_focus_to() which updates mru_active_windows and changes window
             auto const w = window;
-            return w.application() != session || !(new_focus = select_active_window(w));
+            return !(new_focus = select_active_window(w));
         });
 
     return new_focus;
@@ -1695,16 +1831,17 @@ auto miral::BasicWindowManager::can_activate_window_for_session_in_workspace(
     Application const& session,
     std::vector<std::shared_ptr<Workspace>> const& workspaces) -> bool
 {
+    auto const info = app_info.find(session.get());
+    if (info == app_info.end())
+        return false;
+
     miral::Window new_focus;
 
-    mru_active_windows.enumerate([&](miral::Window& window)
+    mru_active_windows.enumerate(info->second.windows(), [&](miral::Window& window)
         {
             // select_active_window() calls set_focus_to() which updates mru_active_windows and changes window
             auto const w = window;
 
-            if (w.application() != session)
-                return true;
-
             for (auto const& workspace : workspaces_containing(w))
             {
                 for (auto const& ww : workspaces)
@@ -32,6 +32,7 @@
 
 #include <mir/geometry/rectangles.h>
 #include <mir/observer_registrar.h>
+#include <mir/posix_rw_mutex.h>
 #include <mir/shell/abstract_shell.h>
 #include <mir/shell/window_manager.h>
 
@@ -39,12 +40,16 @@
 #include <boost/bimap/multiset_of.hpp>
 #include <experimental/optional>
 
+#include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace mir
 {
-namespace shell { class DisplayLayout; class PersistentSurfaceStore; }
+namespace shell { class DisplayLayout; class PersistentSurfaceStore; class ShellReport; struct LockContention; }
 namespace graphics { class DisplayConfigurationObserver; }
 }
 
@@ -69,6 +74,14 @@ public:
         std::shared_ptr<mir::shell::PersistentSurfaceStore> const& persistent_surface_store,
         mir::ObserverRegistrar<mir::graphics::DisplayConfigurationObserver>& display_configuration_observers,
         WindowManagementPolicyBuilder const& build);
+    /// Reports contention for the window management lock to report (if not null)
+    BasicWindowManager(
+        mir::shell::FocusController* focus_controller,
+        std::shared_ptr<mir::shell::DisplayLayout> const& display_layout,
+        std::shared_ptr<mir::shell::PersistentSurfaceStore> const& persistent_surface_store,
+        mir::ObserverRegistrar<mir::graphics::DisplayConfigurationObserver>& display_configuration_observers,
+        WindowManagementPolicyBuilder const& build,
+        std::shared_ptr<mir::shell::ShellReport> const& report);
     ~BasicWindowManager();
 
     void add_session(std::shared_ptr<mir::scene::Session> const& session) override;
@@ -188,6 +201,8 @@ public:
 
     void modify_window(WindowInfo& window_info, WindowSpecification const& modifications) override;
 
+    void modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications) override;
+
     auto info_for_window_id(std::string const& id) const -> WindowInfo& override;
 
     auto id_for_window(Window const& window) const -> std::string override;
@@ -195,6 +210,11 @@ public:
 
     void invoke_under_lock(std::function<void()> const& callback) override;
 
+    void invoke_under_shared_lock(std::function<void()> const& callback) override;
+
+    /// Running totals for the window management lock
+    auto lock_contention() const -> mir::shell::LockContention;
+
 private:
     /// An area for windows to be placed in
     struct DisplayArea
@@ -218,8 +238,10 @@ private:
         std::set<Window> attached_windows; ///< Maximized/anchored/etc windows attached to this area
     };
 
-    using SurfaceInfoMap = std::map<std::weak_ptr<mir::scene::Surface>, WindowInfo, std::owner_less<std::weak_ptr<mir::scene::Surface>>>;
-    using SessionInfoMap = std::map<std::weak_ptr<mir::scene::Session>, ApplicationInfo, std::owner_less<std::weak_ptr<mir::scene::Session>>>;
+    /// Records are hashed by the address of their surface (or session). They are nodes, so references
+    /// to them stay valid until they are erased, however many other records come and go.
+    using SurfaceInfoMap = std::unordered_map<mir::scene::Surface const*, WindowInfo>;
+    using SessionInfoMap = std::unordered_map<mir::scene::Session const*, ApplicationInfo>;
 
     mir::shell::FocusController* const focus_controller;
     std::shared_ptr<mir::shell::DisplayLayout> const display_layout;
@@ -237,7 +259,20 @@ private:
     std::unique_ptr<WindowManagementPolicy> const policy;
     WindowManagementPolicy::ApplicationZoneAddendum* const policy_application_zone_addendum;
 
-    std::mutex mutex;
+    /// Held exclusively by anything that may update the model, shared by invoke_under_shared_lock() and
+    /// by the screening of client requests. Writers are preferred, so a stream of queries can't hold off input.
+    mir::PosixRWMutex mutex{mir::PosixRWMutex::Type::PreferWriterNonRecursive};
+    std::shared_ptr<mir::shell::ShellReport> const report;
+
+    struct LockCounters
+    {
+        std::atomic<unsigned long long> exclusive_acquisitions{0};
+        std::atomic<unsigned long long> exclusive_contended{0};
+        std::atomic<unsigned long long> shared_acquisitions{0};
+        std::atomic<unsigned long long> shared_contended{0};
+        std::atomic<long long> nanoseconds_waiting{0};
+    } lock_counters;
+
     SessionInfoMap app_info;
     SurfaceInfoMap window_info;
     mir::geometry::Rectangles outputs;
@@ -259,6 +294,10 @@ private:
 
     struct Locker;
 
+    auto lock_exclusively() -> std::unique_lock<mir::PosixRWMutex>;
+    auto lock_shared() -> std::shared_lock<mir::PosixRWMutex>;
+    void count_wait(std::atomic<unsigned long long>& contended, std::chrono::steady_clock::duration waited);
+
     void update_event_timestamp(MirKeyboardEvent const* kev);
     void update_event_timestamp(MirPointerEvent const* pev);
     void update_event_timestamp(MirTouchEvent const* tev);
@@ -266,6 +305,16 @@ private:
 
     auto surface_known(std::weak_ptr<mir::scene::Surface> const& surface, std::string const& action) -> bool;
 
+    /// Whether a client request for surface, made at timestamp, is for a known surface and no older than the
+    /// latest input. This only reads the model, so it may be called under the shared lock.
+    auto request_is_current(
+        std::weak_ptr<mir::scene::Surface> const& surface, uint64_t timestamp, std::string const& action) -> bool;
+
+    /// Checks request_is_current() under the shared lock, so that requests to be dropped don't exclude queries.
+    /// A request that passes must be checked again once the exclusive lock is held.
+    auto screen_request(
+        std::weak_ptr<mir::scene::Surface> const& surface, uint64_t timestamp, std::string const& action) -> bool;
+
     auto can_activate_window_for_session(miral::Application const& session) -> bool;
     auto can_activate_window_for_session_in_workspace(
         miral::Application const& session,
@@ -279,6 +328,9 @@ private:
     void set_tree_depth_layer(miral::WindowInfo& root, MirDepthLayer new_layer);
     void erase(miral::WindowInfo const& info);
     void validate_modification_request(WindowSpecification const& modifications, WindowInfo const& window_info) const;
+    /// Copies modifications to window_info_tmp (a copy of window_info), throwing if they are invalid for it
+    void copy_modifications(
+        WindowSpecification const& modifications, WindowInfo const& window_info, WindowInfo& window_info_tmp) const;
     void place_and_size(WindowInfo& root, Point const& new_pos, Size const& new_size);
     void place_attached_to_zone(
         WindowInfo& info,
@@ -29,17 +29,35 @@ bool visible(miral::Window const& window)
     std::shared_ptr<mir::scene::Surface> const& surface{window};
     return surface->state() != mir_window_state_hidden;
 }
+
+auto key_of(miral::Window const& window) -> mir::scene::Surface const*
+{
+    return std::shared_ptr<mir::scene::Surface>(window).get();
+}
 }
 
 void miral::MRUWindowList::push(Window const& window)
 {
-    windows.erase(remove(begin(windows), end(windows), window), end(windows));
-    windows.push_back(window);
+    auto const entry = index.find(key_of(window));
+    if (entry != index.end())
+    {
+        windows.splice(end(windows), windows, entry->second.position);
+        entry->second.last_pushed = ++pushes;
+    }
+    else
+    {
+        index.emplace(key_of(window), Entry{windows.insert(end(windows), window), ++pushes});
+    }
 }
 
 void miral::MRUWindowList::erase(Window const& window)
 {
-    windows.erase(remove(begin(windows), end(windows), window), end(windows));
+    auto const entry = index.find(key_of(window));
+    if (entry != index.end())
+    {
+        windows.erase(entry->second.position);
+        index.erase(entry);
+    }
 }
 
 auto miral::MRUWindowList::top() const -> Window
@@ -55,3 +73,23 @@ void miral::MRUWindowList::enumerate(Enumerator const& enumerator) const
             if (!enumerator(const_cast<Window&>(*i)))
                 break;
 }
+
+void miral::MRUWindowList::enumerate(std::vector<Window> const& candidates, Enumerator const& enumerator) const
+{
+    std::vector<std::pair<uint64_t, Window>> found;
+    found.reserve(candidates.size());
+
+    for (auto const& candidate : candidates)
+    {
+        auto const entry = index.find(key_of(candidate));
+        if (entry != index.end())
+            found.emplace_back(entry->second.last_pushed, *entry->second.position);
+    }
+
+    std::sort(begin(found), end(found), [](auto const& a, auto const& b) { return a.first > b.first; });
+
+    for (auto& window : found)
+        if (visible(window.second))
+            if (!enumerator(window.second))
+                break;
+}
@@ -22,10 +22,17 @@
 #include <miral/window.h>
 
 #include <functional>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
+namespace mir { namespace scene { class Surface; } }
+
 namespace miral
 {
+/// Windows in most recently used order
+/// Pushing (to promote a window to the top) and erasing are O(1): windows are held in a
+/// list indexed by their surface.
 class MRUWindowList
 {
 public:
@@ -38,8 +45,20 @@ public:
 
     void enumerate(Enumerator const& enumerator) const;
 
+    /// Enumerates those of candidates that are in the list, in the same order as enumerate()
+    /// This visits only the candidates (typically the windows of one application), not the whole list
+    void enumerate(std::vector<Window> const& candidates, Enumerator const& enumerator) const;
+
 private:
-    std::vector<Window> windows;
+    struct Entry
+    {
+        std::list<Window>::iterator position;
+        uint64_t last_pushed;
+    };
+
+    std::list<Window> windows; ///< least recently used first
+    std::unordered_map<mir::scene::Surface const*, Entry> index;
+    uint64_t pushes{0};
 };
 }
 
@@ -28,6 +28,7 @@ namespace msh = mir::shell;
 namespace
 {
 char const* const trace_option = "window-management-trace";
+char const* const trace_file_option = "window-management-trace-file";
 }
 
 miral::SetWindowManagementPolicy::SetWindowManagementPolicy(WindowManagementPolicyBuilder const& builder) :
@@ -40,6 +41,8 @@ miral::SetWindowManagementPolicy::~SetWindowManagementPolicy() = default;
 void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
 {
     server.add_configuration_option(trace_option, "log trace message", mir::OptionType::null);
+    server.add_configuration_option(trace_file_option, "write a replayable window management trace to file",
+                                    mir::OptionType::string);
 
     server.override_the_window_manager_builder([this, &server](msh::FocusController* focus_controller)
         -> std::shared_ptr<msh::WindowManager>
@@ -48,11 +51,24 @@ void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
 
             auto const persistent_surface_store = server.the_persistent_surface_store();
 
-            if (server.get_options()->is_set(trace_option))
+            auto const shell_report = server.the_shell_report();
+
+            auto const options = server.get_options();
+
+            if (options->is_set(trace_option) || options->is_set(trace_file_option))
             {
-                auto trace_builder = [this](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                auto const log_messages = options->is_set(trace_option);
+                auto const trace_file = options->is_set(trace_file_option) ?
+                    options->get<std::string>(trace_file_option) : std::string{};
+
+                auto trace_builder = [this, log_messages, trace_file](WindowManagerTools const& tools)
+                    -> std::unique_ptr<miral::WindowManagementPolicy>
                     {
-                        return std::make_unique<WindowManagementTrace>(tools, builder);
+                        return std::make_unique<WindowManagementTrace>(
+                            tools,
+                            builder,
+                            log_messages,
+                            WindowManagementTrace::open_trace_records(trace_file));
                     };
 
                 return std::make_shared<BasicWindowManager>(
@@ -60,7 +76,8 @@ void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
                     display_layout,
                     persistent_surface_store,
                     *server.the_display_configuration_observer_registrar(),
-                    trace_builder);
+                    trace_builder,
+                    shell_report);
             }
 
             return std::make_shared<BasicWindowManager>(
@@ -68,6 +85,7 @@ void miral::SetWindowManagementPolicy::operator()(mir::Server& server) const
                 display_layout,
                 persistent_surface_store,
                 *server.the_display_configuration_observer_registrar(),
-                builder);
+                builder,
+                shell_report);
         });
 }
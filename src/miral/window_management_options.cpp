@@ -33,6 +33,7 @@ namespace
 {
 char const* const wm_option = "window-manager";
 char const* const trace_option = "window-management-trace";
+char const* const trace_file_option = "window-management-trace-file";
 }
 
 void miral::WindowManagerOptions::operator()(mir::Server& server) const
@@ -52,6 +53,8 @@ void miral::WindowManagerOptions::operator()(mir::Server& server) const
 
     server.add_configuration_option(wm_option, description, policies.begin()->name);
     server.add_configuration_option(trace_option, "log trace message", mir::OptionType::null);
+    server.add_configuration_option(trace_file_option, "write a replayable window management trace to file",
+                                    mir::OptionType::string);
 
     server.override_the_window_manager_builder([this, &server](msh::FocusController* focus_controller)
         -> std::shared_ptr<msh::WindowManager>
@@ -66,11 +69,20 @@ void miral::WindowManagerOptions::operator()(mir::Server& server) const
             {
                 if (selection == option.name)
                 {
-                    if (server.get_options()->is_set(trace_option))
+                    if (options->is_set(trace_option) || options->is_set(trace_file_option))
                     {
-                        auto trace_builder = [&option](WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+                        auto const log_messages = options->is_set(trace_option);
+                        auto const trace_file = options->is_set(trace_file_option) ?
+                            options->get<std::string>(trace_file_option) : std::string{};
+
+                        auto trace_builder = [&option, log_messages, trace_file](WindowManagerTools const& tools)
+                            -> std::unique_ptr<miral::WindowManagementPolicy>
                             {
-                                return std::make_unique<WindowManagementTrace>(tools, option.build);
+                                return std::make_unique<WindowManagementTrace>(
+                                    tools,
+                                    option.build,
+                                    log_messages,
+                                    WindowManagementTrace::open_trace_records(trace_file));
                             };
 
                         return std::make_shared<BasicWindowManager>(
@@ -17,6 +17,7 @@
  */
 
 #include "window_management_trace.h"
+#include "window_management_trace_record.h"
 #include "window_info_defaults.h"
 
 #include <miral/application_info.h>
@@ -24,10 +25,15 @@
 #include <miral/zone.h>
 #include <miral/window_info.h>
 
+#include <mir/abnormal_exit.h>
+#include <mir/raii.h>
 #include <mir/scene/session.h>
 #include <mir/scene/surface.h>
 #include <mir/event_printer.h>
 
+#include <boost/throw_exception.hpp>
+
+#include <fstream>
 #include <iomanip>
 #include <sstream>
 
@@ -223,6 +229,20 @@ auto dump_of(std::vector<miral::Window> const& windows) -> std::string
     return out.str();
 }
 
+auto dump_of(std::vector<std::pair<miral::Window, miral::WindowSpecification>> const& modifications) -> std::string
+{
+    std::stringstream out;
+
+    {
+        BracedItemStream bout{out};
+
+        for (auto const& modification: modifications)
+            bout.append(dump_of(modification.first) + "=" + dump_of(modification.second));
+    }
+
+    return out.str();
+}
+
 auto dump_of(miral::ApplicationInfo const& app_info) -> std::string
 {
     std::stringstream out;
@@ -356,22 +376,108 @@ auto dump_of(miral::Zone const& zone) -> std::string
 {
     return dump_of(zone.extents());
 }
+
+/// Identifies an object in trace records for as long as it lives
+auto id_of(void const* object) -> std::string
+{
+    std::stringstream out;
+    out << std::hex << reinterpret_cast<uintptr_t>(object);
+    return out.str();
+}
+
+auto id_of(miral::Window const& window) -> std::string
+{
+    return id_of(std::shared_ptr<mir::scene::Surface>(window).get());
+}
+
+auto id_of(miral::Application const& application) -> std::string
+{
+    return id_of(application.get());
+}
+
+auto number(double value) -> std::string
+{
+    std::stringstream out;
+    out << value;
+    return out.str();
+}
+
+auto rectangle_fields(mir::geometry::Rectangle const& rect) -> std::map<std::string, std::string>
+{
+    return {
+        {"x", std::to_string(rect.top_left.x.as_int())},
+        {"y", std::to_string(rect.top_left.y.as_int())},
+        {"width", std::to_string(rect.size.width.as_int())},
+        {"height", std::to_string(rect.size.height.as_int())}};
+}
 }
 
 miral::WindowManagementTrace::WindowManagementTrace(
     WindowManagerTools const& wrapped,
     WindowManagementPolicyBuilder const& builder) :
+    WindowManagementTrace{wrapped, builder, true, {}}
+{
+}
+
+miral::WindowManagementTrace::WindowManagementTrace(
+    WindowManagerTools const& wrapped,
+    WindowManagementPolicyBuilder const& builder,
+    bool log_messages,
+    std::unique_ptr<std::ostream> records) :
     wrapped{wrapped},
     policy(builder(WindowManagerTools{this})),
-    policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())}
+    policy_application_zone_addendum{WindowManagementPolicy::ApplicationZoneAddendum::from(policy.get())},
+    log_messages{log_messages},
+    records{std::move(records)},
+    trace_start{std::chrono::steady_clock::now()}
+{
+}
+
+auto miral::WindowManagementTrace::open_trace_records(std::string const& path) -> std::unique_ptr<std::ostream>
 {
+    if (path.empty())
+        return {};
+
+    std::unique_ptr<std::ostream> records = std::make_unique<std::ofstream>(path);
+
+    if (!*records)
+        BOOST_THROW_EXCEPTION(mir::AbnormalExit("Cannot write window management trace to: " + path));
+
+    return records;
+}
+
+void miral::WindowManagementTrace::record(char const* operation, std::map<std::string, std::string> fields)
+{
+    WindowManagementTraceRecord const record{
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - trace_start),
+        operation,
+        std::move(fields)};
+
+    *records << record.to_line() << '\n';
+}
+
+void miral::WindowManagementTrace::log_input_on_query(std::function<void()> log)
+{
+    std::lock_guard<std::mutex> lock{input_log_mutex};
+    input_log = std::move(log);
+}
+
+void miral::WindowManagementTrace::log_input() const
+{
+    std::function<void()> log;
+    {
+        std::lock_guard<std::mutex> lock{input_log_mutex};
+        std::swap(log, input_log);
+    }
+
+    if (log) log();
 }
 
 auto miral::WindowManagementTrace::count_applications() const -> unsigned int
 try {
     log_input();
     auto const result = wrapped.count_applications();
-    mir::log_info("%s -> %d", __func__, result);
+    if (log_messages) mir::log_info("%s -> %d", __func__, result);
     trace_count++;
     return result;
 }
@@ -380,7 +486,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::for_each_application(std::function<void(miral::ApplicationInfo&)> const& functor)
 try {
     log_input();
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     trace_count++;
     wrapped.for_each_application(functor);
 }
@@ -391,7 +497,7 @@ auto miral::WindowManagementTrace::find_application(std::function<bool(Applicati
 try {
     log_input();
     auto result = wrapped.find_application(predicate);
-    mir::log_info("%s -> %s", __func__, dump_of(result).c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, dump_of(result).c_str());
     trace_count++;
     return result;
 }
@@ -401,7 +507,7 @@ auto miral::WindowManagementTrace::info_for(std::weak_ptr<mir::scene::Session> c
 try {
     log_input();
     auto& result = wrapped.info_for(session);
-    mir::log_info("%s -> %s", __func__, result.application()->name().c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, result.application()->name().c_str());
     trace_count++;
     return result;
 }
@@ -411,7 +517,7 @@ auto miral::WindowManagementTrace::info_for(std::weak_ptr<mir::scene::Surface> c
 try {
     log_input();
     auto& result = wrapped.info_for(surface);
-    mir::log_info("%s -> %s", __func__, result.name().c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, result.name().c_str());
     trace_count++;
     return result;
 }
@@ -421,7 +527,7 @@ auto miral::WindowManagementTrace::info_for(Window const& window) const -> Windo
 try {
     log_input();
     auto& result = wrapped.info_for(window);
-    mir::log_info("%s -> %s", __func__, result.name().c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, result.name().c_str());
     trace_count++;
     return result;
 }
@@ -430,7 +536,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::ask_client_to_close(miral::Window const& window)
 try {
     log_input();
-    mir::log_info("%s -> %s", __func__, dump_of(window).c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, dump_of(window).c_str());
     trace_count++;
     wrapped.ask_client_to_close(window);
 }
@@ -439,7 +545,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::force_close(miral::Window const& window)
 try {
     log_input();
-    mir::log_info("%s -> %s", __func__, dump_of(window).c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, dump_of(window).c_str());
     trace_count++;
     wrapped.force_close(window);
 }
@@ -449,7 +555,7 @@ auto miral::WindowManagementTrace::active_window() const -> Window
 try {
     log_input();
     auto result = wrapped.active_window();
-    mir::log_info("%s -> %s", __func__, dump_of(result).c_str());
+    if (log_messages) mir::log_info("%s -> %s", __func__, dump_of(result).c_str());
     trace_count++;
     return result;
 }
@@ -459,7 +565,7 @@ auto miral::WindowManagementTrace::select_active_window(Window const& hint) -> W
 try {
     log_input();
     auto result = wrapped.select_active_window(hint);
-    mir::log_info("%s hint=%s -> %s", __func__, dump_of(hint).c_str(), dump_of(result).c_str());
+    if (log_messages) mir::log_info("%s hint=%s -> %s", __func__, dump_of(hint).c_str(), dump_of(result).c_str());
     trace_count++;
     return result;
 }
@@ -471,7 +577,7 @@ try {
     auto result = wrapped.window_at(cursor);
     std::stringstream out;
     out << cursor << " -> " << dump_of(result);
-    mir::log_info("%s cursor=%s", __func__, out.str().c_str());
+    if (log_messages) mir::log_info("%s cursor=%s", __func__, out.str().c_str());
     trace_count++;
     return result;
 }
@@ -483,7 +589,7 @@ try {
     auto result = wrapped.active_output();
     std::stringstream out;
     out << result;
-    mir::log_info("%s -> ", __func__, out.str().c_str());
+    if (log_messages) mir::log_info("%s -> ", __func__, out.str().c_str());
     trace_count++;
     return result;
 }
@@ -493,7 +599,7 @@ auto miral::WindowManagementTrace::info_for_window_id(std::string const& id) con
 try {
     log_input();
     auto& result = wrapped.info_for_window_id(id);
-    mir::log_info("%s id=%s -> %s", __func__, id.c_str(), dump_of(result).c_str());
+    if (log_messages) mir::log_info("%s id=%s -> %s", __func__, id.c_str(), dump_of(result).c_str());
     trace_count++;
     return result;
 }
@@ -503,7 +609,7 @@ auto miral::WindowManagementTrace::id_for_window(Window const& window) const ->
 try {
     log_input();
     auto result = wrapped.id_for_window(window);
-    mir::log_info("%s window=%s -> %s", __func__, dump_of(window).c_str(), result.c_str());
+    if (log_messages) mir::log_info("%s window=%s -> %s", __func__, dump_of(window).c_str(), result.c_str());
     trace_count++;
     return result;
 }
@@ -513,7 +619,7 @@ void miral::WindowManagementTrace::place_and_size_for_state(
     WindowSpecification& modifications, WindowInfo const& window_info) const
 try {
     log_input();
-    mir::log_info("%s modifications=%s window_info=%s", __func__, dump_of(modifications).c_str(), dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s modifications=%s window_info=%s", __func__, dump_of(modifications).c_str(), dump_of(window_info).c_str());
     wrapped.place_and_size_for_state(modifications, window_info);
 }
 MIRAL_TRACE_EXCEPTION
@@ -523,7 +629,7 @@ try {
     log_input();
     std::stringstream out;
     out << movement;
-    mir::log_info("%s movement=%s", __func__, out.str().c_str());
+    if (log_messages) mir::log_info("%s movement=%s", __func__, out.str().c_str());
     trace_count++;
     wrapped.drag_active_window(movement);
 }
@@ -534,7 +640,7 @@ try {
     log_input();
     std::stringstream out;
     out << movement;
-    mir::log_info("%s window=%s -> %s", __func__, dump_of(window).c_str(), out.str().c_str());
+    if (log_messages) mir::log_info("%s window=%s -> %s", __func__, dump_of(window).c_str(), out.str().c_str());
     trace_count++;
     wrapped.drag_window(window, movement);
 }
@@ -543,7 +649,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::focus_next_application()
 try {
     log_input();
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     trace_count++;
     wrapped.focus_next_application();
 }
@@ -552,7 +658,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::focus_prev_application()
 try {
     log_input();
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     trace_count++;
     wrapped.focus_next_application();
 }
@@ -561,7 +667,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::focus_next_within_application()
 try {
     log_input();
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     trace_count++;
     wrapped.focus_next_within_application();
 }
@@ -570,7 +676,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::focus_prev_within_application()
 try {
     log_input();
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     trace_count++;
     wrapped.focus_prev_within_application();
 }
@@ -579,7 +685,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::raise_tree(miral::Window const& root)
 try {
     log_input();
-    mir::log_info("%s root=%s", __func__, dump_of(root).c_str());
+    if (log_messages) mir::log_info("%s root=%s", __func__, dump_of(root).c_str());
     trace_count++;
     wrapped.raise_tree(root);
 }
@@ -588,7 +694,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::start_drag_and_drop(miral::WindowInfo& window_info, std::vector<uint8_t> const& handle)
 try {
     log_input();
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
     trace_count++;
     wrapped.start_drag_and_drop(window_info, handle);
 }
@@ -597,7 +703,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::end_drag_and_drop()
 try {
     log_input();
-    mir::log_info("%s window_info=%s", __func__);
+    if (log_messages) mir::log_info("%s window_info=%s", __func__);
     trace_count++;
     wrapped.end_drag_and_drop();
 }
@@ -607,23 +713,41 @@ void miral::WindowManagementTrace::modify_window(
     miral::WindowInfo& window_info, miral::WindowSpecification const& modifications)
 try {
     log_input();
-    mir::log_info("%s window_info=%s, modifications=%s",
-                  __func__, dump_of(window_info).c_str(), dump_of(modifications).c_str());
+    if (log_messages)
+        mir::log_info("%s window_info=%s, modifications=%s",
+                      __func__, dump_of(window_info).c_str(), dump_of(modifications).c_str());
     trace_count++;
     wrapped.modify_window(window_info, modifications);
 }
 MIRAL_TRACE_EXCEPTION
 
+void miral::WindowManagementTrace::modify_windows(
+    std::vector<std::pair<Window, WindowSpecification>> const& modifications)
+try {
+    log_input();
+    if (log_messages) mir::log_info("%s modifications=%s", __func__, dump_of(modifications).c_str());
+    trace_count++;
+    wrapped.modify_windows(modifications);
+}
+MIRAL_TRACE_EXCEPTION
+
 void miral::WindowManagementTrace::invoke_under_lock(std::function<void()> const& callback)
 try {
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     wrapped.invoke_under_lock(callback);
 }
 MIRAL_TRACE_EXCEPTION
 
+void miral::WindowManagementTrace::invoke_under_shared_lock(std::function<void()> const& callback)
+try {
+    if (log_messages) mir::log_info("%s", __func__);
+    wrapped.invoke_under_shared_lock(callback);
+}
+MIRAL_TRACE_EXCEPTION
+
 auto miral::WindowManagementTrace::create_workspace() -> std::shared_ptr<Workspace>
 try {
-    mir::log_info("%s", __func__);
+    if (log_messages) mir::log_info("%s", __func__);
     return wrapped.create_workspace();
 }
 MIRAL_TRACE_EXCEPTION
@@ -631,7 +755,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::add_tree_to_workspace(
     miral::Window const& window, std::shared_ptr<miral::Workspace> const& workspace)
 try {
-    mir::log_info("%s window=%s, workspace =%p", __func__, dump_of(window).c_str(), workspace.get());
+    if (log_messages) mir::log_info("%s window=%s, workspace =%p", __func__, dump_of(window).c_str(), workspace.get());
     wrapped.add_tree_to_workspace(window, workspace);
 }
 MIRAL_TRACE_EXCEPTION
@@ -639,7 +763,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::remove_tree_from_workspace(
     miral::Window const& window, std::shared_ptr<miral::Workspace> const& workspace)
 try {
-    mir::log_info("%s window=%s, workspace =%p", __func__, dump_of(window).c_str(), workspace.get());
+    if (log_messages) mir::log_info("%s window=%s, workspace =%p", __func__, dump_of(window).c_str(), workspace.get());
     wrapped.remove_tree_from_workspace(window, workspace);
 }
 MIRAL_TRACE_EXCEPTION
@@ -647,7 +771,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::move_workspace_content_to_workspace(
     std::shared_ptr<Workspace> const& to_workspace, std::shared_ptr<Workspace> const& from_workspace)
 try {
-    mir::log_info("%s to_workspace=%p, from_workspace=%p", __func__, to_workspace.get(), from_workspace.get());
+    if (log_messages) mir::log_info("%s to_workspace=%p, from_workspace=%p", __func__, to_workspace.get(), from_workspace.get());
     wrapped.move_workspace_content_to_workspace(to_workspace, from_workspace);
 }
 MIRAL_TRACE_EXCEPTION
@@ -655,7 +779,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::for_each_workspace_containing(
     miral::Window const& window, std::function<void(std::shared_ptr<miral::Workspace> const&)> const& callback)
 try {
-    mir::log_info("%s window=%s", __func__, dump_of(window).c_str());
+    if (log_messages) mir::log_info("%s window=%s", __func__, dump_of(window).c_str());
     wrapped.for_each_workspace_containing(window, callback);
 }
 MIRAL_TRACE_EXCEPTION
@@ -663,7 +787,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::for_each_window_in_workspace(
     std::shared_ptr<miral::Workspace> const& workspace, std::function<void(miral::Window const&)> const& callback)
 try {
-    mir::log_info("%s workspace =%p", __func__, workspace.get());
+    if (log_messages) mir::log_info("%s workspace =%p", __func__, workspace.get());
     wrapped.for_each_window_in_workspace(workspace, callback);
 }
 MIRAL_TRACE_EXCEPTION
@@ -673,15 +797,17 @@ auto miral::WindowManagementTrace::place_new_window(
     WindowSpecification const& requested_specification) -> WindowSpecification
 try {
     auto const result = policy->place_new_window(app_info, requested_specification);
-    mir::log_info("%s app_info=%s, requested_specification=%s -> %s",
-              __func__, dump_of(app_info).c_str(), dump_of(requested_specification).c_str(), dump_of(result).c_str());
+    if (log_messages)
+        mir::log_info("%s app_info=%s, requested_specification=%s -> %s",
+                  __func__, dump_of(app_info).c_str(), dump_of(requested_specification).c_str(), dump_of(result).c_str());
     return result;
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::handle_window_ready(miral::WindowInfo& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (records) record(__func__, {{"window", id_of(window_info.window())}});
     policy->handle_window_ready(window_info);
 }
 MIRAL_TRACE_EXCEPTION
@@ -689,26 +815,64 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::handle_modify_window(
     miral::WindowInfo& window_info, miral::WindowSpecification const& modifications)
 try {
-    mir::log_info("%s window_info=%s, modifications=%s",
-                  __func__, dump_of(window_info).c_str(), dump_of(modifications).c_str());
+    if (log_messages)
+        mir::log_info("%s window_info=%s, modifications=%s",
+                      __func__, dump_of(window_info).c_str(), dump_of(modifications).c_str());
+
+    if (records)
+    {
+        std::map<std::string, std::string> fields{{"window", id_of(window_info.window())}};
+
+        if (modifications.name().is_set())
+            fields["name"] = modifications.name().value();
+        if (modifications.state().is_set())
+            fields["state"] = std::to_string(modifications.state().value());
+        if (modifications.top_left().is_set())
+        {
+            fields["x"] = std::to_string(modifications.top_left().value().x.as_int());
+            fields["y"] = std::to_string(modifications.top_left().value().y.as_int());
+        }
+        if (modifications.size().is_set())
+        {
+            fields["width"] = std::to_string(modifications.size().value().width.as_int());
+            fields["height"] = std::to_string(modifications.size().value().height.as_int());
+        }
+
+        record(__func__, std::move(fields));
+    }
+
     policy->handle_modify_window(window_info, modifications);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::handle_raise_window(miral::WindowInfo& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (records) record(__func__, {{"window", id_of(window_info.window())}});
     policy->handle_raise_window(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 bool miral::WindowManagementTrace::handle_keyboard_event(MirKeyboardEvent const* event)
 try {
-    log_input = [event, this]
+    // The event is only valid during this call, so mustn't be logged after it
+    auto const input_logged_on_query = mir::raii::paired_calls(
+        [event, this]
         {
-            mir::log_info("handle_keyboard_event event=%s", dump_of(event).c_str());
-            log_input = []{};
-        };
+            if (log_messages)
+                log_input_on_query([event] { mir::log_info("handle_keyboard_event event=%s", dump_of(event).c_str()); });
+        },
+        [this] { log_input_on_query({}); });
+
+    if (records)
+    {
+        record(__func__, {
+            {"time", std::to_string(mir_input_event_get_event_time(mir_keyboard_event_input_event(event)))},
+            {"action", std::to_string(mir_keyboard_event_action(event))},
+            {"keysym", std::to_string(mir_keyboard_event_key_code(event))},
+            {"scancode", std::to_string(mir_keyboard_event_scan_code(event))},
+            {"modifiers", std::to_string(mir_keyboard_event_modifiers(event))}});
+    }
 
     return policy->handle_keyboard_event(event);
 }
@@ -716,11 +880,35 @@ MIRAL_TRACE_EXCEPTION
 
 bool miral::WindowManagementTrace::handle_touch_event(MirTouchEvent const* event)
 try {
-    log_input = [event, this]
+    // The event is only valid during this call, so mustn't be logged after it
+    auto const input_logged_on_query = mir::raii::paired_calls(
+        [event, this]
+        {
+            if (log_messages)
+                log_input_on_query([event] { mir::log_info("handle_touch_event event=%s", dump_of(event).c_str()); });
+        },
+        [this] { log_input_on_query({}); });
+
+    if (records)
+    {
+        auto const count = mir_touch_event_point_count(event);
+        std::map<std::string, std::string> fields{
+            {"time", std::to_string(mir_input_event_get_event_time(mir_touch_event_input_event(event)))},
+            {"modifiers", std::to_string(mir_touch_event_modifiers(event))},
+            {"touches", std::to_string(count)}};
+
+        for (unsigned int index = 0; index != count; ++index)
         {
-            mir::log_info("handle_touch_event event=%s", dump_of(event).c_str());
-            log_input = []{};
-        };
+            auto const suffix = "." + std::to_string(index);
+            fields["id" + suffix] = std::to_string(mir_touch_event_id(event, index));
+            fields["action" + suffix] = std::to_string(mir_touch_event_action(event, index));
+            fields["tool" + suffix] = std::to_string(mir_touch_event_tooltype(event, index));
+            fields["x" + suffix] = number(mir_touch_event_axis_value(event, index, mir_touch_axis_x));
+            fields["y" + suffix] = number(mir_touch_event_axis_value(event, index, mir_touch_axis_y));
+        }
+
+        record(__func__, std::move(fields));
+    }
 
     return policy->handle_touch_event(event);
 }
@@ -728,11 +916,35 @@ MIRAL_TRACE_EXCEPTION
 
 bool miral::WindowManagementTrace::handle_pointer_event(MirPointerEvent const* event)
 try {
-    log_input = [event, this]
+    // The event is only valid during this call, so mustn't be logged after it
+    auto const input_logged_on_query = mir::raii::paired_calls(
+        [event, this]
         {
-            mir::log_info("handle_pointer_event event=%s", dump_of(event).c_str());
-            log_input = []{};
-        };
+            if (log_messages)
+                log_input_on_query([event] { mir::log_info("handle_pointer_event event=%s", dump_of(event).c_str()); });
+        },
+        [this] { log_input_on_query({}); });
+
+    if (records)
+    {
+        unsigned int button_state = 0;
+
+        for (auto const a : {mir_pointer_button_primary, mir_pointer_button_secondary, mir_pointer_button_tertiary,
+                             mir_pointer_button_back, mir_pointer_button_forward})
+            button_state |= mir_pointer_event_button_state(event, a) ? a : 0;
+
+        record(__func__, {
+            {"time", std::to_string(mir_input_event_get_event_time(mir_pointer_event_input_event(event)))},
+            {"action", std::to_string(mir_pointer_event_action(event))},
+            {"buttons", std::to_string(button_state)},
+            {"x", number(mir_pointer_event_axis_value(event, mir_pointer_axis_x))},
+            {"y", number(mir_pointer_event_axis_value(event, mir_pointer_axis_y))},
+            {"dx", number(mir_pointer_event_axis_value(event, mir_pointer_axis_relative_x))},
+            {"dy", number(mir_pointer_event_axis_value(event, mir_pointer_axis_relative_y))},
+            {"vscroll", number(mir_pointer_event_axis_value(event, mir_pointer_axis_vscroll))},
+            {"hscroll", number(mir_pointer_event_axis_value(event, mir_pointer_axis_hscroll))},
+            {"modifiers", std::to_string(mir_pointer_event_modifiers(event))}});
+    }
 
     return policy->handle_pointer_event(event);
 }
@@ -743,7 +955,7 @@ auto miral::WindowManagementTrace::confirm_inherited_move(WindowInfo const& wind
 try {
     std::stringstream out;
     out << movement;
-    mir::log_info("%s window_info=%s, movement=%s", __func__, dump_of(window_info).c_str(), out.str().c_str());
+    if (log_messages) mir::log_info("%s window_info=%s, movement=%s", __func__, dump_of(window_info).c_str(), out.str().c_str());
 
     return policy->confirm_inherited_move(window_info, movement);
 }
@@ -751,7 +963,6 @@ MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_begin()
 try {
-    log_input = []{};
     trace_count.store(0);
     policy->advise_begin();
 }
@@ -759,92 +970,123 @@ MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_end()
 try {
-    if (trace_count.load() > 0)
+    if (log_messages && trace_count.load() > 0)
         mir::log_info("====");
     policy->advise_end();
+
+    // Every change to the window manager ends here, so a trace is complete up to the latest change
+    if (records) records->flush();
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_new_app(miral::ApplicationInfo& application)
 try {
-    mir::log_info("%s application=%s", __func__, dump_of(application).c_str());
+    if (log_messages) mir::log_info("%s application=%s", __func__, dump_of(application).c_str());
+    if (records) record(__func__, {{"app", id_of(application.application())}, {"name", application.name()}});
     policy->advise_new_app(application);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_delete_app(miral::ApplicationInfo const& application)
 try {
-    mir::log_info("%s application=%s", __func__, dump_of(application).c_str());
+    if (log_messages) mir::log_info("%s application=%s", __func__, dump_of(application).c_str());
+    if (records) record(__func__, {{"app", id_of(application.application())}});
     policy->advise_delete_app(application);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_new_window(miral::WindowInfo const& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+
+    if (records)
+    {
+        auto const& window = window_info.window();
+        auto fields = rectangle_fields({window.top_left(), window.size()});
+        fields["window"] = id_of(window);
+        fields["app"] = id_of(window.application());
+        fields["name"] = window_info.name();
+        fields["type"] = std::to_string(window_info.type());
+        fields["state"] = std::to_string(window_info.state());
+        if (window_info.parent())
+            fields["parent"] = id_of(window_info.parent());
+
+        record(__func__, std::move(fields));
+    }
+
     policy->advise_new_window(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_focus_lost(miral::WindowInfo const& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
     policy->advise_focus_lost(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_focus_gained(miral::WindowInfo const& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
     policy->advise_focus_gained(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_state_change(miral::WindowInfo const& window_info, MirWindowState state)
 try {
-    mir::log_info("%s window_info=%s, state=%s", __func__, dump_of(window_info).c_str(), dump_of(state).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s, state=%s", __func__, dump_of(window_info).c_str(), dump_of(state).c_str());
     policy->advise_state_change(window_info, state);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_move_to(miral::WindowInfo const& window_info, mir::geometry::Point top_left)
 try {
-    mir::log_info("%s window_info=%s, top_left=%s", __func__, dump_of(window_info).c_str(), dump_of(top_left).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s, top_left=%s", __func__, dump_of(window_info).c_str(), dump_of(top_left).c_str());
     policy->advise_move_to(window_info, top_left);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_resize(miral::WindowInfo const& window_info, mir::geometry::Size const& new_size)
 try {
-    mir::log_info("%s window_info=%s, new_size=%s", __func__, dump_of(window_info).c_str(), dump_of(new_size).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s, new_size=%s", __func__, dump_of(window_info).c_str(), dump_of(new_size).c_str());
     policy->advise_resize(window_info, new_size);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_delete_window(miral::WindowInfo const& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (records) record(__func__, {{"window", id_of(window_info.window())}});
     policy->advise_delete_window(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_raise(std::vector<miral::Window> const& windows)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(windows).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(windows).c_str());
     policy->advise_raise(windows);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::handle_request_drag_and_drop(miral::WindowInfo& window_info)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (records) record(__func__, {{"window", id_of(window_info.window())}});
     policy->handle_request_drag_and_drop(window_info);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::handle_request_move(miral::WindowInfo& window_info, MirInputEvent const* input_event)
 try {
-    mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+    if (log_messages) mir::log_info("%s window_info=%s", __func__, dump_of(window_info).c_str());
+
+    if (records)
+    {
+        record(__func__, {
+            {"window", id_of(window_info.window())},
+            {"time", std::to_string(mir_input_event_get_event_time(input_event))}});
+    }
+
     policy->handle_request_move(window_info, input_event);
 }
 MIRAL_TRACE_EXCEPTION
@@ -852,7 +1094,16 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::handle_request_resize(
     miral::WindowInfo& window_info, MirInputEvent const* input_event, MirResizeEdge edge)
 try {
-    mir::log_info("%s window_info=%s, edge=0x%1x", __func__, dump_of(window_info).c_str(), edge);
+    if (log_messages) mir::log_info("%s window_info=%s, edge=0x%1x", __func__, dump_of(window_info).c_str(), edge);
+
+    if (records)
+    {
+        record(__func__, {
+            {"window", id_of(window_info.window())},
+            {"time", std::to_string(mir_input_event_get_event_time(input_event))},
+            {"edge", std::to_string(edge)}});
+    }
+
     policy->handle_request_resize(window_info, input_event, edge);
 }
 MIRAL_TRACE_EXCEPTION
@@ -860,7 +1111,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::advise_adding_to_workspace(
     std::shared_ptr<miral::Workspace> const& workspace, std::vector<miral::Window> const& windows)
 try {
-    mir::log_info("%s workspace=%p, windows=%s", __func__, workspace.get(), dump_of(windows).c_str());
+    if (log_messages) mir::log_info("%s workspace=%p, windows=%s", __func__, workspace.get(), dump_of(windows).c_str());
     policy->advise_adding_to_workspace(workspace, windows);
 }
 MIRAL_TRACE_EXCEPTION
@@ -868,7 +1119,7 @@ MIRAL_TRACE_EXCEPTION
 void miral::WindowManagementTrace::advise_removing_from_workspace(
     std::shared_ptr<miral::Workspace> const& workspace, std::vector<miral::Window> const& windows)
 try {
-    mir::log_info("%s workspace=%p, windows=%s", __func__, workspace.get(), dump_of(windows).c_str());
+    if (log_messages) mir::log_info("%s workspace=%p, windows=%s", __func__, workspace.get(), dump_of(windows).c_str());
     policy->advise_removing_from_workspace(workspace, windows);
 }
 MIRAL_TRACE_EXCEPTION
@@ -880,7 +1131,7 @@ auto miral::WindowManagementTrace::confirm_placement_on_display(
     Rectangle const& new_placement) -> Rectangle
 try {
     auto const& result = policy->confirm_placement_on_display(window_info, new_state, new_placement);
-    mir::log_info("%s window_info=%s, new_state= %s, new_placement= %s -> %s", __func__,
+    if (log_messages) mir::log_info("%s window_info=%s, new_state= %s, new_placement= %s -> %s", __func__,
         dump_of(window_info).c_str(), dump_of(new_state).c_str(), dump_of(new_placement).c_str(), dump_of(result).c_str());
     return result;
 }
@@ -888,42 +1139,59 @@ MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_output_create(Output const& output)
 try {
-    mir::log_info("%s output=%s", __func__, dump_of(output).c_str());
+    if (log_messages) mir::log_info("%s output=%s", __func__, dump_of(output).c_str());
+
+    if (records)
+    {
+        auto fields = rectangle_fields(output.extents());
+        fields["output"] = std::to_string(output.id());
+        record(__func__, std::move(fields));
+    }
+
     return policy->advise_output_create(output);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_output_update(Output const& updated, Output const& original)
 try {
-    mir::log_info("%s updated=%s, original=%s", __func__, dump_of(updated).c_str(), dump_of(original).c_str());
+    if (log_messages) mir::log_info("%s updated=%s, original=%s", __func__, dump_of(updated).c_str(), dump_of(original).c_str());
+
+    if (records)
+    {
+        auto fields = rectangle_fields(updated.extents());
+        fields["output"] = std::to_string(updated.id());
+        record(__func__, std::move(fields));
+    }
+
     return policy->advise_output_update(updated, original);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_output_delete(Output const& output)
 try {
-    mir::log_info("%s output=%s", __func__, dump_of(output).c_str());
+    if (log_messages) mir::log_info("%s output=%s", __func__, dump_of(output).c_str());
+    if (records) record(__func__, {{"output", std::to_string(output.id())}});
     return policy->advise_output_delete(output);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_application_zone_create(Zone const& application_zone)
 try {
-    mir::log_info("%s application_zone=%s", __func__, dump_of(application_zone).c_str());
+    if (log_messages) mir::log_info("%s application_zone=%s", __func__, dump_of(application_zone).c_str());
     return policy_application_zone_addendum->advise_application_zone_create(application_zone);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_application_zone_update(Zone const& updated, Zone const& original)
 try {
-    mir::log_info("%s updated=%s, original=%s", __func__, dump_of(updated).c_str(), dump_of(original).c_str());
+    if (log_messages) mir::log_info("%s updated=%s, original=%s", __func__, dump_of(updated).c_str(), dump_of(original).c_str());
     return policy_application_zone_addendum->advise_application_zone_update(updated, original);
 }
 MIRAL_TRACE_EXCEPTION
 
 void miral::WindowManagementTrace::advise_application_zone_delete(Zone const& application_zone)
 try {
-    mir::log_info("%s application_zone=%s", __func__, dump_of(application_zone).c_str());
+    if (log_messages) mir::log_info("%s application_zone=%s", __func__, dump_of(application_zone).c_str());
     return policy_application_zone_addendum->advise_application_zone_delete(application_zone);
 }
 MIRAL_TRACE_EXCEPTION
@@ -26,6 +26,11 @@
 #include "miral/window_management_policy.h"
 
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
 
 namespace miral
 {
@@ -37,6 +42,22 @@ class WindowManagementTrace
 public:
     WindowManagementTrace(WindowManagerTools const& wrapped, WindowManagementPolicyBuilder const& builder);
 
+    /**
+     * @param log_messages  whether to log every call as text
+     * @param records       if set, receives a WindowManagementTraceRecord line for each call that
+     *                      drives the window manager (applications, windows, client requests, input
+     *                      and outputs): enough to replay the session headlessly
+     */
+    WindowManagementTrace(
+        WindowManagerTools const& wrapped,
+        WindowManagementPolicyBuilder const& builder,
+        bool log_messages,
+        std::unique_ptr<std::ostream> records);
+
+    /// Opens path to receive records, or returns null if path is empty
+    /// \throws mir::AbnormalExit if path can't be written
+    static auto open_trace_records(std::string const& path) -> std::unique_ptr<std::ostream>;
+
 private:
     virtual auto count_applications() const -> unsigned int override;
 
@@ -77,9 +98,12 @@ private:
     virtual void end_drag_and_drop() override;
 
     virtual void modify_window(WindowInfo& window_info, WindowSpecification const& modifications) override;
+    virtual void modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications) override;
 
     virtual void invoke_under_lock(std::function<void()> const& callback) override;
 
+    virtual void invoke_under_shared_lock(std::function<void()> const& callback) override;
+
     virtual auto place_new_window(
         ApplicationInfo const& app_info,
         WindowSpecification const& requested_specification) -> WindowSpecification override;
@@ -173,7 +197,19 @@ private:
     std::unique_ptr<miral::WindowManagementPolicy> const policy;
     miral::WindowManagementPolicy::ApplicationZoneAddendum* const policy_application_zone_addendum;
     std::atomic<unsigned> mutable trace_count;
-    std::function<void()> log_input;
+    /// Logs the input event being handled, the first time the policy uses the tools while handling it.
+    /// Queries made under invoke_under_shared_lock() run concurrently, so this is guarded by input_log_mutex.
+    std::mutex mutable input_log_mutex;
+    std::function<void()> mutable input_log;
+    bool const log_messages;
+    std::unique_ptr<std::ostream> const records;
+    std::chrono::steady_clock::time_point const trace_start;
+
+    void log_input_on_query(std::function<void()> log);
+    void log_input() const;
+
+    /// Policy calls are serialized by the window manager, so records need no further locking
+    void record(char const* operation, std::map<std::string, std::string> fields);
 };
 }
 
@@ -0,0 +1,138 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_management_trace_record.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+bool needs_escape(char c)
+{
+    return c == '%' || c == '=' || static_cast<unsigned char>(c) <= ' ' || c == '\x7f';
+}
+
+auto escaped(std::string const& value) -> std::string
+{
+    std::string result;
+    result.reserve(value.size());
+
+    for (auto const c : value)
+    {
+        if (needs_escape(c))
+        {
+            char hex[4];
+            snprintf(hex, sizeof hex, "%%%02X", static_cast<unsigned char>(c));
+            result += hex;
+        }
+        else
+        {
+            result += c;
+        }
+    }
+
+    return result;
+}
+
+auto unescaped(std::string const& value) -> std::string
+{
+    std::string result;
+    result.reserve(value.size());
+
+    for (auto i = 0u; i < value.size(); ++i)
+    {
+        if (value[i] == '%')
+        {
+            if (i + 2 >= value.size())
+                BOOST_THROW_EXCEPTION(std::runtime_error("Truncated escape in trace value: " + value));
+
+            result += static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else
+        {
+            result += value[i];
+        }
+    }
+
+    return result;
+}
+}
+
+auto miral::WindowManagementTraceRecord::has_field(std::string const& key) const -> bool
+{
+    return fields.find(key) != fields.end();
+}
+
+auto miral::WindowManagementTraceRecord::field(std::string const& key) const -> std::string const&
+{
+    auto const i = fields.find(key);
+
+    if (i == fields.end())
+        BOOST_THROW_EXCEPTION(std::runtime_error(operation + " record has no " + key));
+
+    return i->second;
+}
+
+auto miral::WindowManagementTraceRecord::integer_field(std::string const& key) const -> long long
+{
+    return std::stoll(field(key));
+}
+
+auto miral::WindowManagementTraceRecord::number_field(std::string const& key) const -> double
+{
+    return std::stod(field(key));
+}
+
+auto miral::WindowManagementTraceRecord::to_line() const -> std::string
+{
+    std::ostringstream out;
+    out << timestamp.count() << ' ' << operation;
+
+    for (auto const& field : fields)
+        out << ' ' << field.first << '=' << escaped(field.second);
+
+    return out.str();
+}
+
+auto miral::WindowManagementTraceRecord::from_line(std::string const& line) -> WindowManagementTraceRecord
+{
+    std::istringstream in{line};
+    WindowManagementTraceRecord record;
+
+    long long timestamp;
+    if (!(in >> timestamp >> record.operation))
+        BOOST_THROW_EXCEPTION(std::runtime_error("Not a trace record: " + line));
+
+    record.timestamp = std::chrono::nanoseconds{timestamp};
+
+    std::string field;
+    while (in >> field)
+    {
+        auto const equals = field.find('=');
+
+        if (equals == std::string::npos)
+            BOOST_THROW_EXCEPTION(std::runtime_error("Trace field without a value: " + field));
+
+        record.fields[field.substr(0, equals)] = unescaped(field.substr(equals + 1));
+    }
+
+    return record;
+}
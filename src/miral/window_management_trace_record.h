@@ -0,0 +1,55 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRAL_WINDOW_MANAGEMENT_TRACE_RECORD_H
+#define MIRAL_WINDOW_MANAGEMENT_TRACE_RECORD_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace miral
+{
+/**
+ * One entry of a replayable window management trace.
+ *
+ * A record is a line of text: the nanoseconds since tracing started, the name
+ * of the traced call and then space separated "key=value" fields. Values escape
+ * '%', '=', spaces and control characters as "%XX", so names survive the trip.
+ *
+ *     1042117 advise_new_window app=1f0a0c0 window=1f1b2d0 name=Terminal type=0 ...
+ */
+struct WindowManagementTraceRecord
+{
+    std::chrono::nanoseconds timestamp{0};
+    std::string operation;
+    std::map<std::string, std::string> fields;
+
+    auto has_field(std::string const& key) const -> bool;
+
+    /// \throws std::runtime_error if there is no such field
+    auto field(std::string const& key) const -> std::string const&;
+    auto integer_field(std::string const& key) const -> long long;
+    auto number_field(std::string const& key) const -> double;
+
+    auto to_line() const -> std::string;
+
+    /// \throws std::runtime_error if line is not a record
+    static auto from_line(std::string const& line) -> WindowManagementTraceRecord;
+};
+}
+
+#endif //MIRAL_WINDOW_MANAGEMENT_TRACE_RECORD_H
@@ -98,6 +98,9 @@ void miral::WindowManagerTools::modify_window(WindowInfo& window_info, WindowSpe
 void miral::WindowManagerTools::modify_window(Window const& window, WindowSpecification const& modifications)
 { tools->modify_window(tools->info_for(window), modifications); }
 
+void miral::WindowManagerTools::modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications)
+{ tools->modify_windows(modifications); }
+
 auto miral::WindowManagerTools::info_for_window_id(std::string const& id) const -> WindowInfo&
 { return tools->info_for_window_id(id); }
 
@@ -107,6 +110,9 @@ auto miral::WindowManagerTools::id_for_window(Window const& window) const -> std
 void miral::WindowManagerTools::invoke_under_lock(std::function<void()> const& callback)
 { tools->invoke_under_lock(callback); }
 
+void miral::WindowManagerTools::invoke_under_shared_lock(std::function<void()> const& callback)
+{ tools->invoke_under_shared_lock(callback); }
+
 void miral::WindowManagerTools::place_and_size_for_state(
     WindowSpecification& modifications, WindowInfo const& window_info) const
 { tools->place_and_size_for_state(modifications, window_info); }
@@ -26,6 +26,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace mir { namespace scene { class Surface; } }
@@ -71,6 +72,7 @@ public:
     virtual void start_drag_and_drop(WindowInfo& window_info, std::vector<uint8_t> const& handle) = 0;
     virtual void end_drag_and_drop() = 0;
     virtual void modify_window(WindowInfo& window_info, WindowSpecification const& modifications) = 0;
+    virtual void modify_windows(std::vector<std::pair<Window, WindowSpecification>> const& modifications) = 0;
     virtual auto info_for_window_id(std::string const& id) const -> WindowInfo& = 0;
     virtual auto id_for_window(Window const& window) const -> std::string = 0;
     virtual void place_and_size_for_state(WindowSpecification& modifications, WindowInfo const& window_info) const= 0;
@@ -97,6 +99,8 @@ public:
  *  already holds the lock).
  *  @{ */
     virtual void invoke_under_lock(std::function<void()> const& callback) = 0;
+    /// As invoke_under_lock(), for callbacks that do not update the model (and may run concurrently)
+    virtual void invoke_under_shared_lock(std::function<void()> const& callback) = 0;
 /** @} */
 
     virtual ~WindowManagerToolsImplementation() = default;
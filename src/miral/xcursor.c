@@ -897,3 +897,81 @@ xcursor_load_theme(const char *theme, int size,
 	if (inherits)
 		free(inherits);
 }
+
+#define XCURSOR_MAX_INHERITS_DEPTH 32
+
+static XcursorImages *
+load_cursor_from_theme(const char *theme, const char *name, int size, int depth)
+{
+	char *full, *dir;
+	char *inherits = NULL;
+	const char *path, *i;
+	XcursorImages *images = NULL;
+	FILE *f;
+
+	if (depth > XCURSOR_MAX_INHERITS_DEPTH)
+		return NULL;
+
+	for (path = XcursorLibraryPath();
+	     path && !images;
+	     path = _XcursorNextPath(path)) {
+		dir = _XcursorBuildThemeDir(path, theme);
+		if (!dir)
+			continue;
+
+		full = _XcursorBuildFullname(dir, "cursors", name);
+		if (full) {
+			f = fopen(full, "r");
+			if (f) {
+				images = XcursorFileLoadImages(f, size);
+				if (images)
+					XcursorImagesSetName(images, name);
+				fclose(f);
+			}
+			free(full);
+		}
+
+		if (!images && !inherits) {
+			full = _XcursorBuildFullname(dir, "", "index.theme");
+			if (full) {
+				inherits = _XcursorThemeInherits(full);
+				free(full);
+			}
+		}
+
+		free(dir);
+	}
+
+	for (i = inherits; i && !images; i = _XcursorNextPath(i))
+		images = load_cursor_from_theme(i, name, size, depth + 1);
+
+	if (inherits)
+		free(inherits);
+
+	return images;
+}
+
+/** Load a single cursor from a theme
+ *
+ * This function searches the given theme, and then its inherited themes,
+ * for the named cursor and loads only the images closest to the
+ * requested size. Unlike xcursor_load_theme() only the one cursor file
+ * is read. The caller is expected to destroy the returned XcursorImages
+ * object with XcursorImagesDestroy().
+ *
+ * \param theme The name of the theme to search
+ * \param name The name of the cursor (e.g. "left_ptr")
+ * \param size The desired size of the cursor images
+ * \return The images for the cursor, or NULL if it was not found
+ */
+XcursorImages *
+xcursor_load_cursor(const char *theme, const char *name, int size)
+{
+	if (!theme)
+		theme = "default";
+
+	if (!name || strchr(name, '/'))
+		return NULL;
+
+	return load_cursor_from_theme(theme, name, size, 0);
+}
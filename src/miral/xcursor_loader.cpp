@@ -21,6 +21,7 @@
 #include <mir/graphics/cursor_image.h>
 
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <stdexcept>
 
 #include <string.h>
@@ -140,76 +141,95 @@ xcursor_name_for_mir_cursor(std::string const& mir_cursor_name)
         return mir_cursor_name;
     }
 }
-}
 
-miral::XCursorLoader::XCursorLoader()
-{
-    load_cursor_theme("default");
-}
+// Enough for the cursors in use at any one time, at a couple of scales
+std::size_t const max_loaded_images = 32;
 
-miral::XCursorLoader::XCursorLoader(std::string const& theme)
+auto load_image(std::string const& theme, std::string const& xcursor_name, int nominal_size)
+-> std::shared_ptr<mg::CursorImage>
 {
-    load_cursor_theme(theme);
-}
+    auto const images = xcursor_load_cursor(theme.c_str(), xcursor_name.c_str(), nominal_size);
 
-// Each XcursorImages represents images for the different sizes of a given symbolic cursor.
-void miral::XCursorLoader::load_appropriately_sized_image(_XcursorImages *images)
-{
-    // We would rather take this lock in load_cursor_theme but the Xcursor lib style
-    // makes it difficult to use our standard 'pass the lg around to _locked members' pattern
-    std::lock_guard<std::mutex> lg(guard);
+    if (!images)
+        return nullptr;
 
-    // We have to save all the images as XCursor expects us to free them.
-    // This contains the actual image data though, so we need to ensure they stay alive
-    // with the lifetime of the mg::CursorImage instance which refers to them.
-    auto saved_xcursor_library_resource = std::shared_ptr<_XcursorImages>(images, [](_XcursorImages *images)
+    // XCursor expects us to free all the images together. This contains the actual image
+    // data though, so we need to ensure they stay alive with the lifetime of the
+    // mg::CursorImage instance which refers to them.
+    auto const saved_xcursor_library_resource = std::shared_ptr<_XcursorImages>(images, [](_XcursorImages *images)
         {
             XcursorImagesDestroy(images);
         });
 
+    if (images->nimage < 1)
+        return nullptr;
+
+    // Only the images closest to the nominal size were loaded; prefer an exact match.
     for (int i = 0; i < images->nimage; i++)
     {
         _XcursorImage *candidate = images->images[i];
-        if (candidate->width == mi::default_cursor_size.width.as_uint32_t() &&
-            candidate->height == mi::default_cursor_size.height.as_uint32_t())
+        if (candidate->width == static_cast<uint32_t>(nominal_size) &&
+            candidate->height == static_cast<uint32_t>(nominal_size))
         {
-            loaded_images[std::string(images->name)] = std::make_shared<XCursorImage>(candidate, saved_xcursor_library_resource);
-            return;
+            return std::make_shared<XCursorImage>(candidate, saved_xcursor_library_resource);
         }
     }
 
-    loaded_images[std::string(images->name)] = std::make_shared<XCursorImage>(images->images[0], saved_xcursor_library_resource);
+    return std::make_shared<XCursorImage>(images->images[0], saved_xcursor_library_resource);
+}
 }
 
-void miral::XCursorLoader::load_cursor_theme(std::string const& theme_name)
+miral::XCursorLoader::XCursorLoader() :
+    XCursorLoader{"default"}
+{
+}
+
+miral::XCursorLoader::XCursorLoader(std::string const& theme) :
+    theme{theme}
 {
-    // Cursors are named by their square dimension...called the nominal size in XCursor terminology, so we just look up by width.
-    // Later we verify the actual size.
-    xcursor_load_theme(theme_name.c_str(), mi::default_cursor_size.width.as_uint32_t(),
-        [](XcursorImages* images, void *this_ptr)  -> void
-        {
-            // Can't use lambda capture as this lambda is thunked to a C function ptr
-            auto p = static_cast<miral::XCursorLoader*>(this_ptr);
-            p->load_appropriately_sized_image(images);
-        }, this);
 }
 
 std::shared_ptr<mg::CursorImage> miral::XCursorLoader::image(
     std::string const& cursor_name,
-    geom::Size const& /*size*/)
+    geom::Size const& size)
 {
-    auto xcursor_name = xcursor_name_for_mir_cursor(cursor_name);
+    auto const xcursor_name = xcursor_name_for_mir_cursor(cursor_name);
+
+    // Cursors are named by their square dimension...called the nominal size in XCursor terminology,
+    // so we just look up by width. Later we verify the actual size.
+    auto const nominal_size = size.width.as_int() > 0 ? size.width.as_int() : mi::default_cursor_size.width.as_int();
 
     std::lock_guard<std::mutex> lg(guard);
+    return image_locked(lg, xcursor_name, nominal_size);
+}
 
-    auto it = loaded_images.find(xcursor_name);
-    if (it != loaded_images.end())
-        return it->second;
+auto miral::XCursorLoader::image_locked(
+    std::lock_guard<std::mutex> const& lock,
+    std::string const& xcursor_name,
+    int nominal_size) -> std::shared_ptr<mg::CursorImage>
+{
+    Key const key{xcursor_name, nominal_size};
+
+    auto const loaded = std::find_if(begin(loaded_images), end(loaded_images),
+        [&key](auto const& entry) { return entry.first == key; });
+
+    if (loaded != end(loaded_images))
+    {
+        loaded_images.splice(begin(loaded_images), loaded_images, loaded);
+        return loaded->second;
+    }
+
+    auto image = load_image(theme, xcursor_name, nominal_size);
 
     // Fall back
-    it = loaded_images.find("arrow");
-    if (it != loaded_images.end())
-        return it->second;
+    if (!image && xcursor_name != "arrow")
+        image = image_locked(lock, "arrow", nominal_size);
+
+    // Remember missing cursors too, so we don't search the theme for them again
+    loaded_images.emplace_front(key, image);
+
+    if (loaded_images.size() > max_loaded_images)
+        loaded_images.pop_back();
 
-    return nullptr;
+    return image;
 }
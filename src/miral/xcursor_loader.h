@@ -24,19 +24,15 @@
 
 #include <memory>
 #include <string>
-#include <map>
+#include <list>
 #include <mutex>
-
-// Unfortunately this library does not compile as C++ so we can not namespace it.
-extern "C"
-{
-struct _XcursorImages;
-}
+#include <utility>
 
 namespace mir { namespace graphics { class CursorImage; } }
 
 namespace miral
 {
+/// Loads cursor images from an XCursor theme on demand, keeping the most recently used resident
 class XCursorLoader : public mir::input::CursorImages
 {
 public:
@@ -53,12 +49,20 @@ protected:
     XCursorLoader& operator=(XCursorLoader const&) = delete;
 
 private:
+    // XCursor name and nominal size
+    using Key = std::pair<std::string, int>;
+
+    std::string const theme;
+
     std::mutex guard;
 
-    std::map<std::string, std::shared_ptr<mir::graphics::CursorImage>> loaded_images;
+    // Most recently used first
+    std::list<std::pair<Key, std::shared_ptr<mir::graphics::CursorImage>>> loaded_images;
 
-    void load_cursor_theme(std::string const& theme_name);
-    void load_appropriately_sized_image(_XcursorImages *images);
+    auto image_locked(
+        std::lock_guard<std::mutex> const& lock,
+        std::string const& xcursor_name,
+        int nominal_size) -> std::shared_ptr<mir::graphics::CursorImage>;
 };
 }
 
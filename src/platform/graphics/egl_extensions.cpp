@@ -125,3 +125,21 @@ mg::EGLExtensions::PlatformBaseEXT::PlatformBaseEXT()
         BOOST_THROW_EXCEPTION((std::runtime_error{"EGL implementation doesn't support EGL_EXT_platform_base"}));
     }
 }
+
+mg::EGLExtensions::EXTImageDmaBufImportModifiers::EXTImageDmaBufImportModifiers(EGLDisplay dpy)
+    : eglQueryDmaBufFormatsExt{
+        reinterpret_cast<PFNEGLQUERYDMABUFFORMATSEXTPROC>(eglGetProcAddress("eglQueryDmaBufFormatsEXT"))
+    },
+    eglQueryDmaBufModifiersExt{
+        reinterpret_cast<PFNEGLQUERYDMABUFMODIFIERSEXTPROC>(eglGetProcAddress("eglQueryDmaBufModifiersEXT"))
+    }
+{
+    auto const* extensions = eglQueryString(dpy, EGL_EXTENSIONS);
+    if (!extensions ||
+        !strstr(extensions, "EGL_EXT_image_dma_buf_import_modifiers") ||
+        !eglQueryDmaBufFormatsExt ||
+        !eglQueryDmaBufModifiersExt)
+    {
+        BOOST_THROW_EXCEPTION((std::runtime_error{"EGL implementation doesn't support EGL_EXT_image_dma_buf_import_modifiers"}));
+    }
+}
@@ -31,6 +31,13 @@
 #include "mir/executor.h"
 #include "mir/graphics/program_factory.h"
 #include "mir/graphics/program.h"
+#include "mir/graphics/yuv_shader.h"
+#include "mir/raii.h"
+
+#include <wayland-server-core.h>
+
+#include <experimental/optional>
+#include <vector>
 
 #include MIR_SERVER_GL_H
 
@@ -100,39 +107,101 @@ EGLint get_wl_egl_format(wl_resource* resource, mg::EGLExtensions::WaylandExtens
     return format;
 }
 
-class WaylandTexBuffer :
-    public mg::BufferBasic,
-    public mg::NativeBufferBase,
-    public mg::gl::Texture
+/// The YUV planes of a buffer in egl_format, or nothing if it's an RGB format
+auto yuv_planes_for(EGLint egl_format) -> std::experimental::optional<mg::gl::YuvPlanes>
+{
+    switch (egl_format)
+    {
+    case EGL_TEXTURE_Y_U_V_WL:
+        return mg::gl::YuvPlanes::y_u_v;
+    case EGL_TEXTURE_Y_UV_WL:
+        return mg::gl::YuvPlanes::y_uv;
+    case EGL_TEXTURE_Y_XUXV_WL:
+        return mg::gl::YuvPlanes::y_xuxv;
+    default:
+        return {};
+    }
+}
+
+/**
+ * The texture imported from a hardware wl_buffer.
+ *
+ * The texture is an EGLImage sibling of the client's buffer, so it sees whatever the client
+ * renders into it next; it is imported once and reused by every commit of the wl_buffer.
+ *
+ * YUV buffers are imported a plane at a time, one texture each, for a YUV shader to combine.
+ */
+class ImportedTexture
 {
 public:
     // Note: Must be called with a current EGL context
-    WaylandTexBuffer(
+    ImportedTexture(
         wl_resource* buffer,
         std::shared_ptr<mir::renderer::gl::Context> ctx,
         mg::EGLExtensions const& extensions,
-        std::function<void()>&& on_consumed,
-        std::function<void()>&& on_release,
         std::shared_ptr<mir::Executor> wayland_executor)
         : ctx{std::move(ctx)},
-          tex{get_tex_id()},
-          on_consumed{std::move(on_consumed)},
-          on_release{std::move(on_release)},
-          size_{get_wl_buffer_size(buffer, *extensions.wayland)},
-          layout_{get_texture_layout(buffer, *extensions.wayland)},
+          size{get_wl_buffer_size(buffer, *extensions.wayland)},
+          layout{get_texture_layout(buffer, *extensions.wayland)},
           egl_format{get_wl_egl_format(buffer, *extensions.wayland)},
+          yuv_planes{yuv_planes_for(egl_format)},
+          yuv_encoding{mg::gl::default_yuv_encoding(size)},
           wayland_executor{std::move(wayland_executor)}
     {
-        if (egl_format != EGL_TEXTURE_RGB && egl_format != EGL_TEXTURE_RGBA)
+        if (egl_format == EGL_TEXTURE_EXTERNAL_WL)
         {
-            BOOST_THROW_EXCEPTION((std::runtime_error{"YUV textures unimplemented"}));
+            BOOST_THROW_EXCEPTION((std::runtime_error{"External textures unimplemented"}));
         }
         eglBindAPI(MIR_SERVER_EGL_OPENGL_API);
 
+        auto const plane_count = yuv_planes ? mg::gl::texture_count(*yuv_planes) : 1;
+        for (auto plane = 0u; plane != plane_count; ++plane)
+        {
+            try
+            {
+                tex.push_back(import_plane(buffer, plane, extensions));
+            }
+            catch (...)
+            {
+                glDeleteTextures(tex.size(), tex.data());
+                throw;
+            }
+        }
+    }
+
+    ~ImportedTexture()
+    {
+        wayland_executor->spawn(
+            [context = ctx, tex = tex]()
+            {
+              context->make_current();
+
+              glDeleteTextures(tex.size(), tex.data());
+
+              context->release_current();
+            });
+    }
+
+    ImportedTexture(ImportedTexture const&) = delete;
+    ImportedTexture& operator=(ImportedTexture const&) = delete;
+
+    std::shared_ptr<mir::renderer::gl::Context> const ctx;
+    std::vector<GLuint> tex;
+    geom::Size const size;
+    mg::gl::Texture::Layout const layout;
+    EGLint const egl_format;
+    std::experimental::optional<mg::gl::YuvPlanes> const yuv_planes;
+    mg::gl::YuvEncoding const yuv_encoding;
+
+    std::shared_ptr<mir::Executor> const wayland_executor;
+
+private:
+    static auto import_plane(wl_resource* buffer, EGLint plane, mg::EGLExtensions const& extensions) -> GLuint
+    {
         const EGLint image_attrs[] =
             {
                 EGL_IMAGE_PRESERVED_KHR, EGL_TRUE,
-                EGL_WAYLAND_PLANE_WL, 0,
+                EGL_WAYLAND_PLANE_WL, plane,
                 EGL_NONE
             };
 
@@ -144,8 +213,11 @@ public:
             image_attrs);
 
         if (egl_image == EGL_NO_IMAGE_KHR)
+        {
             BOOST_THROW_EXCEPTION(mg::egl_error("Failed to create EGLImage"));
+        }
 
+        auto const tex = get_tex_id();
         glBindTexture(GL_TEXTURE_2D, tex);
         extensions.glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, egl_image);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -156,20 +228,71 @@ public:
         // tex is now an EGLImage sibling, so we can free the EGLImage without
         // freeing the backing data.
         extensions.eglDestroyImageKHR(eglGetCurrentDisplay(), egl_image);
+
+        return tex;
     }
+};
 
-    ~WaylandTexBuffer()
+/**
+ * Keeps the ImportedTexture of a wl_buffer for as long as the wl_buffer exists, so that
+ * committing it again needs neither a current context nor any EGL or GL object creation.
+ */
+struct ImportedBuffer
+{
+    static auto texture_for(wl_resource* buffer) -> std::shared_ptr<ImportedTexture const>
     {
-        wayland_executor->spawn(
-            [context = ctx, tex = tex]()
-            {
-              context->make_current();
+        if (auto notifier = wl_resource_get_destroy_listener(buffer, &on_buffer_destroyed))
+        {
+            ImportedBuffer* me;
+            me = wl_container_of(notifier, me, destruction_listener);
+            return me->texture;
+        }
+        return nullptr;
+    }
 
-              glDeleteTextures(1, &tex);
+    static void associate(wl_resource* buffer, std::shared_ptr<ImportedTexture const> texture)
+    {
+        auto const me = new ImportedBuffer;
+        me->texture = std::move(texture);
+        me->destruction_listener.notify = &on_buffer_destroyed;
+        wl_resource_add_destroy_listener(buffer, &me->destruction_listener);
+    }
 
-              context->release_current();
-            });
+private:
+    static void on_buffer_destroyed(wl_listener* listener, void*)
+    {
+        static_assert(
+            std::is_standard_layout<ImportedBuffer>::value,
+            "ImportedBuffer must be Standard Layout for wl_container_of to be defined behaviour");
+
+        ImportedBuffer* me;
+        me = wl_container_of(listener, me, destruction_listener);
+        delete me;
+    }
+
+    std::shared_ptr<ImportedTexture const> texture;
+    wl_listener destruction_listener;
+};
 
+/// One commit of a wl_buffer, drawn with the wl_buffer's ImportedTexture
+class WaylandTexBuffer :
+    public mg::BufferBasic,
+    public mg::NativeBufferBase,
+    public mg::gl::Texture
+{
+public:
+    WaylandTexBuffer(
+        std::shared_ptr<ImportedTexture const> texture,
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release)
+        : texture{std::move(texture)},
+          on_consumed{std::move(on_consumed)},
+          on_release{std::move(on_release)}
+    {
+    }
+
+    ~WaylandTexBuffer()
+    {
         on_release();
     }
 
@@ -180,7 +303,7 @@ public:
 
     mir::geometry::Size size() const override
     {
-        return size_;
+        return texture->size;
     }
 
     MirPixelFormat pixel_format() const override
@@ -188,7 +311,7 @@ public:
         /* TODO: These are lies, but the only piece of information external code uses
          * out of the MirPixelFormat is whether or not the buffer has an alpha channel.
          */
-        switch(egl_format)
+        switch(texture->egl_format)
         {
         case EGL_TEXTURE_RGB:
             return mir_pixel_format_xrgb_8888;
@@ -218,6 +341,11 @@ public:
 
     mir::graphics::gl::Program const& shader(mir::graphics::gl::ProgramFactory& cache) const override
     {
+        if (texture->yuv_planes)
+        {
+            return mg::gl::yuv_program(cache, *texture->yuv_planes, texture->yuv_encoding);
+        }
+
         static std::unique_ptr<mg::gl::Program> shader;
         if (!shader)
         {
@@ -234,12 +362,17 @@ public:
 
     Layout layout() const override
     {
-        return layout_;
+        return texture->layout;
     }
 
     void bind() override
     {
-        glBindTexture(GL_TEXTURE_2D, tex);
+        // Plane i goes to texture unit i; going backwards leaves GL_TEXTURE0 active, as the renderer expects
+        for (auto i = texture->tex.size(); i-- != 0;)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, texture->tex[i]);
+        }
         on_consumed();
         on_consumed = [](){};
     }
@@ -248,17 +381,10 @@ public:
     {
     }
 private:
-    std::shared_ptr<mir::renderer::gl::Context> const ctx;
-    GLuint const tex;
+    std::shared_ptr<ImportedTexture const> const texture;
 
     std::function<void()> on_consumed;
     std::function<void()> const on_release;
-
-    geom::Size const size_;
-    Layout const layout_;
-    EGLint const egl_format;
-
-    std::shared_ptr<mir::Executor> const wayland_executor;
 };
 }
 
@@ -285,11 +411,19 @@ auto mg::wayland::buffer_from_resource(
     mg::EGLExtensions const& extensions,
     std::shared_ptr<mir::Executor> wayland_executor) -> std::unique_ptr<mg::Buffer>
 {
+    auto texture = ImportedBuffer::texture_for(buffer);
+    if (!texture)
+    {
+        auto context_guard = mir::raii::paired_calls(
+            [&ctx]() { ctx->make_current(); },
+            [&ctx]() { ctx->release_current(); });
+
+        texture = std::make_shared<ImportedTexture>(buffer, ctx, extensions, std::move(wayland_executor));
+        ImportedBuffer::associate(buffer, texture);
+    }
+
     return std::make_unique<WaylandTexBuffer>(
-        buffer,
-        ctx,
-        extensions,
+        std::move(texture),
         std::move(on_consumed),
-        std::move(on_release),
-        wayland_executor);
+        std::move(on_release));
 }
@@ -0,0 +1,896 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "linux-dmabuf"
+
+#include "mir/graphics/linux_dmabuf.h"
+
+#include "mir/graphics/egl_extensions.h"
+#include "mir/graphics/egl_error.h"
+#include "mir/graphics/buffer_basic.h"
+#include "mir/graphics/texture.h"
+#include "mir/graphics/program_factory.h"
+#include "mir/graphics/program.h"
+#include "mir/renderer/gl/context.h"
+#include "mir/geometry/size.h"
+#include "mir/executor.h"
+#include "mir/raii.h"
+#include "mir/log.h"
+
+#include "linux-dmabuf-unstable-v1_wrapper.h"
+#include "wayland_wrapper.h"
+
+#include <boost/throw_exception.hpp>
+
+#include MIR_SERVER_GL_H
+#include MIR_SERVER_GLEXT_H
+
+#include <wayland-server-core.h>
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <system_error>
+
+namespace mg = mir::graphics;
+namespace mw = mir::wayland;
+namespace geom = mir::geometry;
+
+namespace mir
+{
+namespace wayland
+{
+extern struct wl_interface const wl_buffer_interface_data;
+}
+}
+
+namespace
+{
+using Error = mw::LinuxBufferParamsV1::Error;
+
+constexpr auto fourcc(char a, char b, char c, char d) -> uint32_t
+{
+    return uint32_t(a) | (uint32_t(b) << 8) | (uint32_t(c) << 16) | (uint32_t(d) << 24);
+}
+
+uint32_t const argb8888 = fourcc('A', 'R', '2', '4');
+uint32_t const xrgb8888 = fourcc('X', 'R', '2', '4');
+uint32_t const abgr8888 = fourcc('A', 'B', '2', '4');
+uint32_t const xbgr8888 = fourcc('X', 'B', '2', '4');
+
+auto has_alpha(uint32_t format) -> bool
+{
+    switch (format)
+    {
+    case fourcc('A', 'R', '2', '4'):
+    case fourcc('A', 'B', '2', '4'):
+    case fourcc('R', 'A', '2', '4'):
+    case fourcc('B', 'A', '2', '4'):
+    case fourcc('A', 'R', '3', '0'):
+    case fourcc('A', 'B', '3', '0'):
+    case fourcc('R', 'A', '3', '0'):
+    case fourcc('B', 'A', '3', '0'):
+    case fourcc('A', 'R', '1', '2'):
+    case fourcc('A', 'B', '1', '2'):
+    case fourcc('A', 'R', '1', '5'):
+    case fourcc('A', 'B', '1', '5'):
+    case fourcc('A', 'B', '4', 'H'):
+        return true;
+    default:
+        return false;
+    }
+}
+
+auto supported_formats(EGLDisplay dpy) -> mg::DmaBufFormats
+{
+    auto const* extensions = eglQueryString(dpy, EGL_EXTENSIONS);
+    if (!extensions || !strstr(extensions, "EGL_EXT_image_dma_buf_import"))
+    {
+        BOOST_THROW_EXCEPTION((std::runtime_error{"EGL implementation doesn't support EGL_EXT_image_dma_buf_import"}));
+    }
+
+    mg::DmaBufFormats formats;
+
+    std::experimental::optional<mg::EGLExtensions::EXTImageDmaBufImportModifiers> modifier_ext;
+    try
+    {
+        modifier_ext.emplace(dpy);
+    }
+    catch (std::runtime_error const&)
+    {
+        // Without the modifiers extension only the formats every driver can import are safe to offer
+        for (auto const format : {argb8888, xrgb8888, abgr8888, xbgr8888})
+        {
+            formats.add(format, mg::DmaBufFormats::implicit_modifier, false);
+        }
+        return formats;
+    }
+
+    EGLint format_count{0};
+    if (modifier_ext->eglQueryDmaBufFormatsExt(dpy, 0, nullptr, &format_count) != EGL_TRUE)
+    {
+        BOOST_THROW_EXCEPTION(mg::egl_error("Failed to query the number of dmabuf formats"));
+    }
+    std::vector<EGLint> codes(format_count);
+    if (modifier_ext->eglQueryDmaBufFormatsExt(dpy, format_count, codes.data(), &format_count) != EGL_TRUE)
+    {
+        BOOST_THROW_EXCEPTION(mg::egl_error("Failed to query dmabuf formats"));
+    }
+    codes.resize(format_count);
+
+    for (auto const code : codes)
+    {
+        auto const format = static_cast<uint32_t>(code);
+
+        // Any format the driver can import can be imported with the modifier implied by the dmabuf
+        formats.add(format, mg::DmaBufFormats::implicit_modifier, false);
+
+        EGLint modifier_count{0};
+        if (modifier_ext->eglQueryDmaBufModifiersExt(dpy, code, 0, nullptr, nullptr, &modifier_count) != EGL_TRUE)
+        {
+            continue;
+        }
+        std::vector<EGLuint64KHR> modifiers(modifier_count);
+        std::vector<EGLBoolean> external_only(modifier_count);
+        if (modifier_ext->eglQueryDmaBufModifiersExt(
+                dpy, code, modifier_count, modifiers.data(), external_only.data(), &modifier_count) != EGL_TRUE)
+        {
+            continue;
+        }
+
+        for (EGLint i = 0; i != modifier_count; ++i)
+        {
+            if (modifiers[i] != mg::DmaBufFormats::implicit_modifier)
+            {
+                formats.add(format, modifiers[i], external_only[i] == EGL_TRUE);
+            }
+        }
+    }
+
+    return formats;
+}
+
+/// A sealed memfd holding the format table of zwp_linux_dmabuf_feedback_v1
+auto format_table_for(mg::DmaBufFormats const& formats) -> mir::Fd
+{
+    struct TableEntry
+    {
+        uint32_t format;
+        uint32_t padding;
+        uint64_t modifier;
+    };
+    static_assert(sizeof(TableEntry) == 16, "The protocol fixes the size of a format table entry");
+
+    std::vector<TableEntry> table;
+    for (auto const& entry : formats.entries())
+    {
+        table.push_back({entry.format, 0, entry.modifier});
+    }
+
+    mir::Fd fd{static_cast<int>(syscall(SYS_memfd_create, "mir-dmabuf-formats", MFD_CLOEXEC | MFD_ALLOW_SEALING))};
+    if (fd < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to create dmabuf format table"}));
+    }
+
+    auto const size = table.size() * sizeof(TableEntry);
+    if (write(fd, table.data(), size) != static_cast<ssize_t>(size))
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to write dmabuf format table"}));
+    }
+
+    // Every client maps this same file, so none of them may change it
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to seal dmabuf format table"}));
+    }
+
+    return fd;
+}
+
+/**
+ * The texture imported from a client's dmabufs.
+ *
+ * The texture is an EGLImage sibling of the dmabufs, so it shows whatever the client last
+ * rendered into them; it lives as long as the wl_buffer or any commit still using it.
+ */
+class DmaBufTexture
+{
+public:
+    // Note: Must be called with a current EGL context
+    DmaBufTexture(
+        EGLDisplay dpy,
+        mg::EGLExtensions const& extensions,
+        mg::DmaBufParams const& params,
+        int32_t width,
+        int32_t height,
+        mg::DmaBufFormats::Entry const& format,
+        uint32_t flags,
+        std::shared_ptr<mir::renderer::gl::Context> ctx,
+        std::shared_ptr<mir::Executor> wayland_executor)
+        : ctx{std::move(ctx)},
+          target{format.external_only ? GLenum{GL_TEXTURE_EXTERNAL_OES} : GLenum{GL_TEXTURE_2D}},
+          tex{create_texture(dpy, extensions, params, width, height, format, target)},
+          size{width, height},
+          layout{flags & mw::LinuxBufferParamsV1::Flags::y_invert ? Layout::GL : Layout::TopRowFirst},
+          alpha{has_alpha(format.format)},
+          wayland_executor{std::move(wayland_executor)}
+    {
+    }
+
+    ~DmaBufTexture()
+    {
+        wayland_executor->spawn(
+            [context = ctx, tex = tex]()
+            {
+                context->make_current();
+
+                glDeleteTextures(1, &tex);
+
+                context->release_current();
+            });
+    }
+
+    DmaBufTexture(DmaBufTexture const&) = delete;
+    DmaBufTexture& operator=(DmaBufTexture const&) = delete;
+
+    using Layout = mg::gl::Texture::Layout;
+
+    std::shared_ptr<mir::renderer::gl::Context> const ctx;
+    GLenum const target;
+    GLuint const tex;
+    geom::Size const size;
+    Layout const layout;
+    bool const alpha;
+
+    std::shared_ptr<mir::Executor> const wayland_executor;
+
+private:
+    static auto create_texture(
+        EGLDisplay dpy,
+        mg::EGLExtensions const& extensions,
+        mg::DmaBufParams const& params,
+        int32_t width,
+        int32_t height,
+        mg::DmaBufFormats::Entry const& format,
+        GLenum target) -> GLuint
+    {
+        static EGLint const plane_attribs[mg::DmaBufParams::max_planes][5] = {
+            {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE0_OFFSET_EXT, EGL_DMA_BUF_PLANE0_PITCH_EXT,
+             EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT},
+            {EGL_DMA_BUF_PLANE1_FD_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT, EGL_DMA_BUF_PLANE1_PITCH_EXT,
+             EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT},
+            {EGL_DMA_BUF_PLANE2_FD_EXT, EGL_DMA_BUF_PLANE2_OFFSET_EXT, EGL_DMA_BUF_PLANE2_PITCH_EXT,
+             EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT},
+            {EGL_DMA_BUF_PLANE3_FD_EXT, EGL_DMA_BUF_PLANE3_OFFSET_EXT, EGL_DMA_BUF_PLANE3_PITCH_EXT,
+             EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT, EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT}};
+
+        std::vector<EGLint> attribs{
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_LINUX_DRM_FOURCC_EXT, static_cast<EGLint>(format.format)};
+
+        auto const planes = params.planes();
+        for (size_t i = 0; i != planes.size(); ++i)
+        {
+            attribs.insert(attribs.end(), {
+                plane_attribs[i][0], planes[i].fd,
+                plane_attribs[i][1], static_cast<EGLint>(planes[i].offset),
+                plane_attribs[i][2], static_cast<EGLint>(planes[i].stride)});
+
+            if (format.modifier != mg::DmaBufFormats::implicit_modifier)
+            {
+                attribs.insert(attribs.end(), {
+                    plane_attribs[i][3], static_cast<EGLint>(format.modifier & 0xffffffff),
+                    plane_attribs[i][4], static_cast<EGLint>(format.modifier >> 32)});
+            }
+        }
+        attribs.insert(attribs.end(), {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE});
+
+        auto egl_image = extensions.eglCreateImageKHR(
+            dpy,
+            EGL_NO_CONTEXT,
+            EGL_LINUX_DMA_BUF_EXT,
+            nullptr,
+            attribs.data());
+
+        if (egl_image == EGL_NO_IMAGE_KHR)
+            BOOST_THROW_EXCEPTION(mg::egl_error("Failed to create EGLImage from dmabuf"));
+
+        GLuint tex;
+        glGenTextures(1, &tex);
+        glBindTexture(target, tex);
+        extensions.glEGLImageTargetTexture2DOES(target, egl_image);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // tex is now an EGLImage sibling, so we can free the EGLImage without
+        // freeing the backing data.
+        extensions.eglDestroyImageKHR(dpy, egl_image);
+
+        if (glGetError() != GL_NO_ERROR)
+        {
+            glDeleteTextures(1, &tex);
+            BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to bind dmabuf EGLImage to a texture"}));
+        }
+
+        return tex;
+    }
+};
+
+/// One commit of a dmabuf-backed wl_buffer
+class DmaBufCommit :
+    public mg::BufferBasic,
+    public mg::NativeBufferBase,
+    public mg::gl::Texture
+{
+public:
+    DmaBufCommit(
+        std::shared_ptr<DmaBufTexture const> texture,
+        std::function<void()>&& on_consumed,
+        std::function<void()>&& on_release)
+        : texture{std::move(texture)},
+          on_consumed{std::move(on_consumed)},
+          on_release{std::move(on_release)}
+    {
+    }
+
+    ~DmaBufCommit()
+    {
+        on_release();
+    }
+
+    std::shared_ptr<mir::graphics::NativeBuffer> native_buffer_handle() const override
+    {
+        return {nullptr};
+    }
+
+    mir::geometry::Size size() const override
+    {
+        return texture->size;
+    }
+
+    MirPixelFormat pixel_format() const override
+    {
+        // As for wl_drm buffers, only whether there is an alpha channel matters to callers
+        return texture->alpha ? mir_pixel_format_argb_8888 : mir_pixel_format_xrgb_8888;
+    }
+
+    NativeBufferBase* native_buffer_base() override
+    {
+        return this;
+    }
+
+    mir::graphics::gl::Program const& shader(mir::graphics::gl::ProgramFactory& cache) const override
+    {
+        if (texture->target == GL_TEXTURE_EXTERNAL_OES)
+        {
+            static std::unique_ptr<mg::gl::Program> external_shader;
+            if (!external_shader)
+            {
+                external_shader = cache.compile_fragment_shader(
+                    "#ifdef GL_ES\n"
+                    "#extension GL_OES_EGL_image_external : require\n"
+                    "#endif\n",
+                    "uniform samplerExternalOES tex;\n"
+                    "vec4 sample_to_rgba(in vec2 texcoord)\n"
+                    "{\n"
+                    "    return texture2D(tex, texcoord);\n"
+                    "}\n");
+            }
+            return *external_shader;
+        }
+
+        static std::unique_ptr<mg::gl::Program> shader;
+        if (!shader)
+        {
+            shader = cache.compile_fragment_shader(
+                "",
+                "uniform sampler2D tex;\n"
+                "vec4 sample_to_rgba(in vec2 texcoord)\n"
+                "{\n"
+                "    return texture2D(tex, texcoord);\n"
+                "}\n");
+        }
+        return *shader;
+    }
+
+    Layout layout() const override
+    {
+        return texture->layout;
+    }
+
+    void bind() override
+    {
+        glBindTexture(texture->target, texture->tex);
+        on_consumed();
+        on_consumed = [](){};
+    }
+
+    void add_syncpoint() override
+    {
+    }
+
+private:
+    std::shared_ptr<DmaBufTexture const> const texture;
+
+    std::function<void()> on_consumed;
+    std::function<void()> const on_release;
+};
+
+/// A wl_buffer created through zwp_linux_buffer_params_v1
+class DmaBufBuffer : public mw::Buffer
+{
+public:
+    DmaBufBuffer(wl_resource* resource, std::shared_ptr<DmaBufTexture const> texture)
+        : Buffer{resource, Version<1>{}},
+          texture{std::move(texture)}
+    {
+    }
+
+    std::shared_ptr<DmaBufTexture const> const texture;
+
+private:
+    void destroy() override
+    {
+        destroy_wayland_object();
+    }
+};
+
+/// What every object of the protocol needs to know
+struct Importer
+{
+    Importer(
+        EGLDisplay dpy,
+        std::shared_ptr<mg::EGLExtensions> egl_extensions,
+        std::shared_ptr<mir::renderer::gl::Context> ctx,
+        std::shared_ptr<mir::Executor> wayland_executor,
+        dev_t main_device)
+        : dpy{dpy},
+          egl_extensions{std::move(egl_extensions)},
+          ctx{std::move(ctx)},
+          wayland_executor{std::move(wayland_executor)},
+          formats{supported_formats(dpy)},
+          format_table{format_table_for(formats)},
+          main_device{main_device}
+    {
+    }
+
+    /// \returns    nullptr if the GPU can't import the buffer
+    /// \throws     DmaBufParams::ProtocolError if the client has broken the protocol
+    auto import(
+        mg::DmaBufParams const& params,
+        int32_t width,
+        int32_t height,
+        uint32_t format,
+        uint32_t flags) const -> std::shared_ptr<DmaBufTexture const>
+    {
+        params.check(width, height, format, formats);
+
+        using Flags = mw::LinuxBufferParamsV1::Flags;
+        if (flags & (Flags::interlaced | Flags::bottom_first))
+        {
+            mir::log_debug("Rejecting interlaced dmabuf buffer");
+            return nullptr;
+        }
+
+        auto const context_guard = mir::raii::paired_calls(
+            [this]() { ctx->make_current(); },
+            [this]() { ctx->release_current(); });
+
+        try
+        {
+            return std::make_shared<DmaBufTexture>(
+                dpy,
+                *egl_extensions,
+                params,
+                width,
+                height,
+                *formats.find(format, params.modifier()),
+                flags,
+                ctx,
+                wayland_executor);
+        }
+        catch (std::exception const& error)
+        {
+            mir::log_debug("Failed to import dmabuf buffer: %s", error.what());
+            return nullptr;
+        }
+    }
+
+    EGLDisplay const dpy;
+    std::shared_ptr<mg::EGLExtensions> const egl_extensions;
+    std::shared_ptr<mir::renderer::gl::Context> const ctx;
+    std::shared_ptr<mir::Executor> const wayland_executor;
+    mg::DmaBufFormats const formats;
+    mir::Fd const format_table;
+    dev_t const main_device;
+};
+
+class LinuxBufferParams : public mw::LinuxBufferParamsV1
+{
+public:
+    LinuxBufferParams(wl_resource* new_resource, std::shared_ptr<Importer const> importer)
+        : LinuxBufferParamsV1{new_resource, Version<4>{}},
+          importer{std::move(importer)}
+    {
+    }
+
+private:
+    void destroy() override
+    {
+        destroy_wayland_object();
+    }
+
+    void add(
+        mir::Fd fd,
+        uint32_t plane_idx,
+        uint32_t offset,
+        uint32_t stride,
+        uint32_t modifier_hi,
+        uint32_t modifier_lo) override
+    {
+        try
+        {
+            check_unused();
+            params.add(std::move(fd), plane_idx, offset, stride, (uint64_t{modifier_hi} << 32) | modifier_lo);
+        }
+        catch (mg::DmaBufParams::ProtocolError const& error)
+        {
+            wl_resource_post_error(resource, error.code, "%s", error.what());
+        }
+    }
+
+    void create(int32_t width, int32_t height, uint32_t format, uint32_t flags) override
+    {
+        try
+        {
+            check_unused();
+            used = true;
+
+            auto texture = importer->import(params, width, height, format, flags);
+            if (!texture)
+            {
+                send_failed_event();
+                return;
+            }
+
+            auto const buffer = wl_resource_create(client, &mw::wl_buffer_interface_data, 1, 0);
+            if (!buffer)
+            {
+                wl_client_post_no_memory(client);
+                return;
+            }
+            new DmaBufBuffer{buffer, std::move(texture)};
+            send_created_event(buffer);
+        }
+        catch (mg::DmaBufParams::ProtocolError const& error)
+        {
+            wl_resource_post_error(resource, error.code, "%s", error.what());
+        }
+    }
+
+    void create_immed(
+        wl_resource* buffer_id,
+        int32_t width,
+        int32_t height,
+        uint32_t format,
+        uint32_t flags) override
+    {
+        try
+        {
+            check_unused();
+            used = true;
+
+            auto texture = importer->import(params, width, height, format, flags);
+            if (!texture)
+            {
+                wl_resource_post_error(resource, Error::invalid_wl_buffer, "Failed to import dmabuf buffer");
+                return;
+            }
+
+            new DmaBufBuffer{buffer_id, std::move(texture)};
+        }
+        catch (mg::DmaBufParams::ProtocolError const& error)
+        {
+            wl_resource_post_error(resource, error.code, "%s", error.what());
+        }
+    }
+
+    void check_unused() const
+    {
+        if (used)
+        {
+            BOOST_THROW_EXCEPTION((mg::DmaBufParams::ProtocolError{
+                Error::already_used, "Params have already been used to create a buffer"}));
+        }
+    }
+
+    std::shared_ptr<Importer const> const importer;
+    mg::DmaBufParams params;
+    bool used{false};
+};
+
+class LinuxDmabufFeedback : public mw::LinuxDmabufFeedbackV1
+{
+public:
+    LinuxDmabufFeedback(wl_resource* new_resource, Importer const& importer)
+        : LinuxDmabufFeedbackV1{new_resource, Version<4>{}}
+    {
+        auto const entries = importer.formats.entries().size();
+        send_format_table_event(importer.format_table, entries * 16);
+
+        wl_array device;
+        wl_array_init(&device);
+        memcpy(wl_array_add(&device, sizeof(dev_t)), &importer.main_device, sizeof(dev_t));
+        send_main_device_event(&device);
+
+        // A single tranche: we have yet to learn which buffers can be scanned out
+        wl_array indices;
+        wl_array_init(&indices);
+        for (size_t i = 0; i != entries && i <= UINT16_MAX; ++i)
+        {
+            auto const index = static_cast<uint16_t>(i);
+            memcpy(wl_array_add(&indices, sizeof index), &index, sizeof index);
+        }
+        send_tranche_target_device_event(&device);
+        send_tranche_flags_event(0);
+        send_tranche_formats_event(&indices);
+        send_tranche_done_event();
+        send_done_event();
+
+        wl_array_release(&indices);
+        wl_array_release(&device);
+    }
+
+private:
+    void destroy() override
+    {
+        destroy_wayland_object();
+    }
+};
+
+class LinuxDmabufInstance : public mw::LinuxDmabufV1
+{
+public:
+    LinuxDmabufInstance(wl_resource* new_resource, std::shared_ptr<Importer const> importer)
+        : LinuxDmabufV1{new_resource, Version<4>{}},
+          importer{std::move(importer)}
+    {
+        // From version 4 clients learn the formats from feedback objects instead
+        if (wl_resource_get_version(resource) >= 4)
+            return;
+
+        for (auto const& entry : this->importer->formats.entries())
+        {
+            if (version_supports_modifier())
+            {
+                send_modifier_event(
+                    entry.format,
+                    static_cast<uint32_t>(entry.modifier >> 32),
+                    static_cast<uint32_t>(entry.modifier & 0xffffffff));
+            }
+            else if (entry.modifier == mg::DmaBufFormats::implicit_modifier)
+            {
+                send_format_event(entry.format);
+            }
+        }
+    }
+
+private:
+    void destroy() override
+    {
+        destroy_wayland_object();
+    }
+
+    void create_params(wl_resource* params_id) override
+    {
+        new LinuxBufferParams{params_id, importer};
+    }
+
+    void get_default_feedback(wl_resource* id) override
+    {
+        new LinuxDmabufFeedback{id, *importer};
+    }
+
+    void get_surface_feedback(wl_resource* id, wl_resource* /*surface*/) override
+    {
+        new LinuxDmabufFeedback{id, *importer};
+    }
+
+    std::shared_ptr<Importer const> const importer;
+};
+}
+
+class mg::LinuxDmaBufUnstable::Global : public mw::LinuxDmabufV1::Global
+{
+public:
+    Global(wl_display* display, std::shared_ptr<Importer const> importer)
+        : mw::LinuxDmabufV1::Global{display, Version<4>{}},
+          importer{std::move(importer)}
+    {
+    }
+
+private:
+    void bind(wl_resource* new_resource) override
+    {
+        new LinuxDmabufInstance{new_resource, importer};
+    }
+
+    std::shared_ptr<Importer const> const importer;
+};
+
+uint64_t const mg::DmaBufFormats::implicit_modifier;
+size_t const mg::DmaBufParams::max_planes;
+
+void mg::DmaBufFormats::add(uint32_t format, uint64_t modifier, bool external_only)
+{
+    if (!find(format, modifier))
+    {
+        entries_.push_back({format, modifier, external_only});
+    }
+}
+
+auto mg::DmaBufFormats::find(uint32_t format, uint64_t modifier) const -> Entry const*
+{
+    for (auto const& entry : entries_)
+    {
+        if (entry.format == format && entry.modifier == modifier)
+            return &entry;
+    }
+    return nullptr;
+}
+
+auto mg::DmaBufFormats::entries() const -> std::vector<Entry> const&
+{
+    return entries_;
+}
+
+mg::DmaBufParams::ProtocolError::ProtocolError(uint32_t code, std::string const& message)
+    : std::runtime_error{message},
+      code{code}
+{
+}
+
+void mg::DmaBufParams::add(Fd fd, uint32_t plane_idx, uint32_t offset, uint32_t stride, uint64_t modifier)
+{
+    if (plane_idx >= max_planes)
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{
+            Error::plane_idx, "Plane index " + std::to_string(plane_idx) + " is out of range"}));
+    }
+    if (planes_[plane_idx])
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{
+            Error::plane_set, "Plane " + std::to_string(plane_idx) + " has already been set"}));
+    }
+    if (modifier_ && modifier_.value() != modifier)
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{
+            Error::invalid_format, "Every plane of a buffer must have the same modifier"}));
+    }
+
+    planes_[plane_idx] = Plane{std::move(fd), offset, stride};
+    modifier_ = modifier;
+}
+
+void mg::DmaBufParams::check(int32_t width, int32_t height, uint32_t format, DmaBufFormats const& formats) const
+{
+    size_t plane_count = 0;
+    while (plane_count != max_planes && planes_[plane_count])
+    {
+        ++plane_count;
+    }
+    if (plane_count == 0)
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{Error::incomplete, "No planes have been added"}));
+    }
+    for (auto i = plane_count; i != max_planes; ++i)
+    {
+        if (planes_[i])
+        {
+            BOOST_THROW_EXCEPTION((ProtocolError{
+                Error::incomplete, "Plane " + std::to_string(plane_count) + " is missing"}));
+        }
+    }
+
+    if (width <= 0 || height <= 0)
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{
+            Error::invalid_dimensions,
+            "Invalid buffer size " + std::to_string(width) + "x" + std::to_string(height)}));
+    }
+
+    if (!formats.find(format, modifier_.value()))
+    {
+        BOOST_THROW_EXCEPTION((ProtocolError{Error::invalid_format, "Unsupported format and modifier"}));
+    }
+
+    for (size_t i = 0; i != plane_count; ++i)
+    {
+        auto const& plane = planes_[i].value();
+
+        // Files that can't tell us their size get the benefit of the doubt
+        auto const size = lseek(plane.fd, 0, SEEK_END);
+        if (size < 0)
+            continue;
+
+        // Only the first plane is known to have as many rows as the buffer
+        uint64_t const rows = i == 0 ? height : 1;
+        if (uint64_t{plane.offset} + uint64_t{plane.stride} * rows > static_cast<uint64_t>(size))
+        {
+            BOOST_THROW_EXCEPTION((ProtocolError{
+                Error::out_of_bounds, "Plane " + std::to_string(i) + " extends beyond its dmabuf"}));
+        }
+    }
+}
+
+auto mg::DmaBufParams::planes() const -> std::vector<Plane>
+{
+    std::vector<Plane> result;
+    for (auto const& plane : planes_)
+    {
+        if (!plane)
+            break;
+        result.push_back(plane.value());
+    }
+    return result;
+}
+
+auto mg::DmaBufParams::modifier() const -> uint64_t
+{
+    return modifier_.value_or(DmaBufFormats::implicit_modifier);
+}
+
+mg::LinuxDmaBufUnstable::LinuxDmaBufUnstable(
+    wl_display* display,
+    EGLDisplay dpy,
+    std::shared_ptr<EGLExtensions> egl_extensions,
+    std::shared_ptr<renderer::gl::Context> ctx,
+    std::shared_ptr<Executor> wayland_executor,
+    dev_t main_device)
+    : global{std::make_unique<Global>(
+          display,
+          std::make_shared<Importer>(
+              dpy,
+              std::move(egl_extensions),
+              std::move(ctx),
+              std::move(wayland_executor),
+              main_device))}
+{
+}
+
+mg::LinuxDmaBufUnstable::~LinuxDmaBufUnstable() = default;
+
+auto mg::LinuxDmaBufUnstable::buffer_from_resource(
+    wl_resource* buffer,
+    std::function<void()>&& on_consumed,
+    std::function<void()>&& on_release) -> std::shared_ptr<Buffer>
+{
+    if (!mw::Buffer::is_instance(buffer))
+        return nullptr;
+
+    auto const dmabuf = dynamic_cast<DmaBufBuffer*>(mw::Buffer::from(buffer));
+    if (!dmabuf)
+        return nullptr;
+
+    return std::make_shared<DmaBufCommit>(dmabuf->texture, std::move(on_consumed), std::move(on_release));
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/solid_color_buffer.h"
+#include "mir/graphics/program_factory.h"
+#include "mir/graphics/program.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <iomanip>
+#include <locale>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+namespace
+{
+auto channel(uint32_t argb, int shift) -> uint32_t
+{
+    return (argb >> shift) & 0xFF;
+}
+
+auto premultiply(uint32_t argb) -> uint32_t
+{
+    auto const alpha = channel(argb, 24);
+    auto const scaled = [alpha](uint32_t value) { return (value * alpha + 127) / 255; };
+
+    return (alpha << 24) |
+           (scaled(channel(argb, 16)) << 16) |
+           (scaled(channel(argb, 8)) << 8) |
+           scaled(channel(argb, 0));
+}
+}
+
+mg::SolidColorBuffer::SolidColorBuffer(uint32_t argb)
+    : argb_{argb},
+      premultiplied{premultiply(argb)}
+{
+}
+
+std::shared_ptr<mg::NativeBuffer> mg::SolidColorBuffer::native_buffer_handle() const
+{
+    return {nullptr};
+}
+
+geom::Size mg::SolidColorBuffer::size() const
+{
+    return {1, 1};
+}
+
+MirPixelFormat mg::SolidColorBuffer::pixel_format() const
+{
+    // Opaque colors needn't be blended
+    return channel(argb_, 24) == 0xFF ? mir_pixel_format_xrgb_8888 : mir_pixel_format_argb_8888;
+}
+
+mg::NativeBufferBase* mg::SolidColorBuffer::native_buffer_base()
+{
+    return this;
+}
+
+mg::gl::Program const& mg::SolidColorBuffer::shader(gl::ProgramFactory& factory) const
+{
+    // There's one program per distinct color, and we expect only a handful of colors
+    static std::mutex mutex;
+    static std::map<uint32_t, std::unique_ptr<gl::Program>> programs;
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& program = programs[argb_];
+    if (!program)
+    {
+        program = factory.compile_fragment_shader("", solid_color_fragment_shader(argb_).c_str());
+    }
+    return *program;
+}
+
+auto mg::SolidColorBuffer::layout() const -> Layout
+{
+    return Layout::TopRowFirst;
+}
+
+void mg::SolidColorBuffer::bind()
+{
+    // There's no texture; the color is in the shader
+}
+
+void mg::SolidColorBuffer::add_syncpoint()
+{
+}
+
+void mg::SolidColorBuffer::write(unsigned char const*, size_t)
+{
+    BOOST_THROW_EXCEPTION(std::logic_error("SolidColorBuffer cannot be written to"));
+}
+
+void mg::SolidColorBuffer::read(std::function<void(unsigned char const*)> const& do_with_pixels)
+{
+    do_with_pixels(reinterpret_cast<unsigned char const*>(&premultiplied));
+}
+
+geom::Stride mg::SolidColorBuffer::stride() const
+{
+    return geom::Stride{sizeof premultiplied};
+}
+
+auto mg::solid_color_fragment_shader(uint32_t argb) -> std::string
+{
+    auto const premultiplied = premultiply(argb);
+
+    std::ostringstream shader;
+    // GLSL wants a '.' whatever the locale says
+    shader.imbue(std::locale::classic());
+    shader << std::fixed << std::setprecision(8);
+
+    shader <<
+        "vec4 sample_to_rgba(in vec2 texcoord)\n"
+        "{\n"
+        "    return vec4(" <<
+        channel(premultiplied, 16) / 255.0f << ", " <<
+        channel(premultiplied, 8) / 255.0f << ", " <<
+        channel(premultiplied, 0) / 255.0f << ", " <<
+        channel(premultiplied, 24) / 255.0f << ");\n"
+        "}\n";
+
+    return shader.str();
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/yuv_shader.h"
+#include "mir/graphics/program_factory.h"
+#include "mir/graphics/program.h"
+
+#include <iomanip>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace mg = mir::graphics;
+namespace mgl = mir::graphics::gl;
+namespace geom = mir::geometry;
+
+namespace
+{
+auto components_for(mgl::YuvPlanes planes) -> char const*
+{
+    switch (planes)
+    {
+    case mgl::YuvPlanes::y_u_v:
+        return
+            "    vec3 yuv = vec3(\n"
+            "        texture2D(tex[0], texcoord).r,\n"
+            "        texture2D(tex[1], texcoord).r,\n"
+            "        texture2D(tex[2], texcoord).r);\n";
+    case mgl::YuvPlanes::y_uv:
+        return
+            "    vec3 yuv = vec3(texture2D(tex[0], texcoord).r, texture2D(tex[1], texcoord).rg);\n";
+    case mgl::YuvPlanes::y_uv_la:
+        return
+            "    vec3 yuv = vec3(texture2D(tex[0], texcoord).r, texture2D(tex[1], texcoord).ra);\n";
+    case mgl::YuvPlanes::y_xuxv:
+        return
+            "    vec3 yuv = vec3(texture2D(tex[0], texcoord).r, texture2D(tex[1], texcoord).ga);\n";
+    }
+    return nullptr;
+}
+
+auto index_of(mgl::YuvPlanes planes, mgl::YuvEncoding encoding) -> size_t
+{
+    return static_cast<size_t>(planes) * 4 +
+        static_cast<size_t>(encoding.matrix) * 2 +
+        static_cast<size_t>(encoding.range);
+}
+}
+
+auto mgl::texture_count(YuvPlanes planes) -> unsigned
+{
+    return planes == YuvPlanes::y_u_v ? 3 : 2;
+}
+
+auto mgl::default_yuv_encoding(geom::Size const& size) -> YuvEncoding
+{
+    auto const is_hd = size.width.as_int() >= 1280 || size.height.as_int() >= 720;
+    return {is_hd ? YuvEncoding::Matrix::bt709 : YuvEncoding::Matrix::bt601, YuvEncoding::Range::limited};
+}
+
+auto mgl::yuv_to_rgb(YuvEncoding encoding) -> YuvToRgb
+{
+    // The luma weights of red and blue; green's is whatever is left
+    float const kr = encoding.matrix == YuvEncoding::Matrix::bt709 ? 0.2126f : 0.299f;
+    float const kb = encoding.matrix == YuvEncoding::Matrix::bt709 ? 0.0722f : 0.114f;
+    float const kg = 1.0f - kr - kb;
+
+    bool const limited = encoding.range == YuvEncoding::Range::limited;
+    float const y_scale = limited ? 255.0f / 219.0f : 1.0f;
+    float const c_scale = limited ? 255.0f / 224.0f : 1.0f;
+
+    return {
+        {
+            y_scale, y_scale, y_scale,
+            0.0f, -c_scale * 2 * kb * (1 - kb) / kg, c_scale * 2 * (1 - kb),
+            c_scale * 2 * (1 - kr), -c_scale * 2 * kr * (1 - kr) / kg, 0.0f
+        },
+        {limited ? 16.0f / 255.0f : 0.0f, 128.0f / 255.0f, 128.0f / 255.0f}
+    };
+}
+
+auto mgl::yuv_fragment_shader(YuvPlanes planes, YuvEncoding encoding) -> std::string
+{
+    auto const conversion = yuv_to_rgb(encoding);
+
+    std::ostringstream shader;
+    // GLSL wants a '.' whatever the locale says
+    shader.imbue(std::locale::classic());
+    shader << std::fixed << std::setprecision(8);
+
+    shader <<
+        "uniform sampler2D tex[" << texture_count(planes) << "];\n"
+        "vec4 sample_to_rgba(in vec2 texcoord)\n"
+        "{\n" <<
+        components_for(planes) <<
+        "    mat3 to_rgb = mat3(";
+    for (auto i = 0u; i != conversion.matrix.size(); ++i)
+    {
+        shader << (i ? ", " : "") << conversion.matrix[i];
+    }
+    shader <<
+        ");\n"
+        "    vec3 offset = vec3(" <<
+        conversion.offset[0] << ", " << conversion.offset[1] << ", " << conversion.offset[2] << ");\n"
+        "    return vec4(clamp(to_rgb * (yuv - offset), 0.0, 1.0), 1.0);\n"
+        "}\n";
+
+    return shader.str();
+}
+
+auto mgl::yuv_program(ProgramFactory& factory, YuvPlanes planes, YuvEncoding encoding) -> Program const&
+{
+    static std::mutex mutex;
+    static std::unique_ptr<Program> programs[4 * 2 * 2];
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& program = programs[index_of(planes, encoding)];
+    if (!program)
+    {
+        program = factory.compile_fragment_shader("", yuv_fragment_shader(planes, encoding).c_str());
+    }
+    return *program;
+}
@@ -53,6 +53,11 @@ char const* const mo::enable_key_repeat_opt       = "enable-key-repeat";
 char const* const mo::x11_display_opt             = "enable-x11";
 char const* const mo::wayland_extensions_opt      = "wayland-extensions";
 char const* const mo::enable_mirclient_opt        = "enable-mirclient";
+char const* const mo::wayland_request_profile_opt = "wayland-request-profile";
+char const* const mo::async_logging_opt           = "async-logging";
+char const* const mo::flight_recorder_opt         = "flight-recorder";
+char const* const mo::flight_recorder_file_opt    = "flight-recorder-file";
+char const* const mo::gl_program_cache_opt        = "gl-program-cache";
 
 char const* const mo::off_opt_value = "off";
 char const* const mo::log_opt_value = "log";
@@ -61,6 +66,7 @@ char const* const mo::lttng_opt_value = "lttng";
 char const* const mo::platform_graphics_lib = "platform-graphics-lib";
 char const* const mo::platform_input_lib = "platform-input-lib";
 char const* const mo::platform_path = "platform-path";
+char const* const mo::platform_probe_cache = "platform-probe-cache";
 
 char const* const mo::console_provider = "console-provider";
 char const* const mo::logind_console = "logind";
@@ -158,6 +164,9 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Library to use for platform input support (default: input-stub.so)")
         (platform_path, po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
             "Directory to look for platform libraries (default: " MIR_SERVER_PLATFORM_PATH ")")
+        (platform_probe_cache, po::value<std::string>(),
+            "File in which to remember platform libraries that failed to probe, so that "
+            "later starts on the same devices skip them (default: probe every library)")
         (enable_input_opt, po::value<bool>()->default_value(enable_input_default),
             "Enable input.")
         (compositor_report_opt, po::value<std::string>()->default_value(off_opt_value),
@@ -203,6 +212,19 @@ mo::DefaultConfiguration::DefaultConfiguration(
         (debug_opt, "Enable extra development debugging. "
             "This is only interesting for people doing Mir server or client development.")
         (enable_mirclient_opt, "Enable deprecated mirclient socket (for running old clients)")
+        (wayland_request_profile_opt, "Profile the time spent handling Wayland requests, by client "
+            "and request. The profile is logged on SIGUSR2.")
+        (async_logging_opt, "Write log messages on a background thread, so that logging doesn't "
+            "block the threads doing it. Messages may be dropped when logging faster than they can be written.")
+        (flight_recorder_opt, po::value<bool>()->default_value(true),
+            "Keep the last few seconds of frame and input timing in memory. They are written, "
+            "in the Trace Event Format, on SIGUSR2.")
+        (flight_recorder_file_opt, po::value<std::string>(),
+            "Where to write the flight recorder's trace [default: $XDG_RUNTIME_DIR/mir-flight-recorder-<pid>.json, "
+            "or no trace if XDG_RUNTIME_DIR is not set]")
+        (gl_program_cache_opt, po::value<std::string>(),
+            "Directory in which to keep linked GL shader programs, so that later starts "
+            "with the same driver needn't compile them (default: compile every start)")
         (console_provider,
             po::value<std::string>()->default_value("auto"),
             "Console device handling\n"
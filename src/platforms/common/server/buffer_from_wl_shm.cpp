@@ -19,10 +19,12 @@
 
 #include "buffer_from_wl_shm.h"
 #include "shm_buffer.h"
+#include "egl_context_executor.h"
 
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/executor.h"
 #include "mir/renderer/gl/context.h"
+#include "mir/graphics/yuv_shader.h"
 
 #define MIR_LOG_COMPONENT "wayland-gfx-helpers"
 #include "mir/log.h"
@@ -37,6 +39,7 @@
 #include <wayland-server-core.h>
 #include <wayland-server-protocol.h>
 #include <cassert>
+#include <vector>
 
 namespace mg = mir::graphics;
 namespace mgc = mir::graphics::common;
@@ -387,6 +390,222 @@ private:
     mir::geometry::Stride const stride_;
 };
 
+/**
+ * A wl_shm buffer in a YUV format, uploaded a plane at a time for a YUV shader to
+ * convert to RGB as it is drawn.
+ *
+ * Only packed formats are supported: libwayland checks that the stride × height bytes
+ * of the buffer lie within the pool, but the chroma planes of planar formats (NV12,
+ * YUV420) would follow them, unchecked. Clients can use linux-dmabuf for those.
+ */
+class WlShmYuvBuffer :
+    public mg::BufferBasic,
+    public mg::NativeBufferBase,
+    public mg::gl::Texture
+{
+public:
+    WlShmYuvBuffer(
+        SharedWlBuffer buffer,
+        std::shared_ptr<mgc::EGLContextExecutor> egl_delegate,
+        mir::geometry::Size const& size,
+        mir::geometry::Stride stride,
+        uint32_t format,
+        std::function<void()>&& on_consumed)
+        : on_consumed{std::move(on_consumed)},
+          buffer{std::move(buffer)},
+          egl_delegate{std::move(egl_delegate)},
+          size_{size},
+          yuv_planes{yuv_planes_for(format)},
+          planes{planes_for(format, size, stride.as_int())}
+    {
+        // libwayland only checks that the stride is at least the width, in bytes; each
+        // pair of YUYV pixels (rounded up) needs four
+        if (stride.as_int() < 4 * ((size.width.as_int() + 1) / 2))
+        {
+            BOOST_THROW_EXCEPTION((std::runtime_error{"Stride of YUYV wl_shm buffer is too small for its width"}));
+        }
+    }
+
+    ~WlShmYuvBuffer()
+    {
+        if (!tex.empty())
+        {
+            egl_delegate->spawn(
+                [tex = tex]()
+                {
+                    glDeleteTextures(tex.size(), tex.data());
+                });
+        }
+    }
+
+    /// Whether buffer_from_wl_shm() can import buffers of this wl_shm format as WlShmYuvBuffers
+    static auto supports(uint32_t format) -> bool
+    {
+        switch (format)
+        {
+        case WL_SHM_FORMAT_YUYV:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    std::shared_ptr<mg::NativeBuffer> native_buffer_handle() const override
+    {
+        BOOST_THROW_EXCEPTION((std::logic_error{"Attempt to get mirclient handle for Wayland Shm buffer"}));
+    }
+
+    mir::geometry::Size size() const override
+    {
+        return size_;
+    }
+
+    MirPixelFormat pixel_format() const override
+    {
+        // Not RGB at all, but the only thing callers learn from this is that there's no alpha channel
+        return mir_pixel_format_xrgb_8888;
+    }
+
+    NativeBufferBase* native_buffer_base() override
+    {
+        return this;
+    }
+
+    mg::gl::Program const& shader(mg::gl::ProgramFactory& cache) const override
+    {
+        return mg::gl::yuv_program(cache, yuv_planes, mg::gl::default_yuv_encoding(size_));
+    }
+
+    Layout layout() const override
+    {
+        return Layout::GL;
+    }
+
+    void bind() override
+    {
+        std::lock_guard<std::mutex> lock{consumption_mutex};
+        if (tex.empty())
+        {
+            upload();
+            on_consumed();
+            on_consumed = [](){};
+        }
+
+        // Plane i goes to texture unit i; going backwards leaves GL_TEXTURE0 active, as the renderer expects
+        for (auto i = tex.size(); i-- != 0;)
+        {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_2D, tex[i]);
+        }
+    }
+
+    void add_syncpoint() override
+    {
+    }
+
+private:
+    /// Where a plane is in the wl_shm buffer, and how it is uploaded
+    struct Plane
+    {
+        GLenum format;
+        int width;
+        int height;
+        size_t offset;
+        int row_length;     ///< In texels of format
+    };
+
+    static auto yuv_planes_for(uint32_t format) -> mg::gl::YuvPlanes
+    {
+        switch (format)
+        {
+        case WL_SHM_FORMAT_YUYV:
+            return mg::gl::YuvPlanes::y_xuxv;
+        default:
+            BOOST_THROW_EXCEPTION((std::logic_error{"Not a YUV wl_shm format"}));
+        }
+    }
+
+    static auto planes_for(uint32_t format, mir::geometry::Size const& size, int stride) -> std::vector<Plane>
+    {
+        auto const width = size.width.as_int();
+        auto const height = size.height.as_int();
+        auto const chroma_width = (width + 1) / 2;
+
+        switch (format)
+        {
+        case WL_SHM_FORMAT_YUYV:
+            // One plane of Y0 U Y1 V; Y is the luminance of a two-channel texel, U and V are
+            // the green and alpha of a four-channel texel spanning two pixels
+            return {
+                {GL_LUMINANCE_ALPHA, width, height, 0, stride / 2},
+                {GL_RGBA, chroma_width, height, 0, stride / 4}};
+        default:
+            BOOST_THROW_EXCEPTION((std::logic_error{"Not a YUV wl_shm format"}));
+        }
+    }
+
+    /// \note This must be called with a current GL context
+    void upload()
+    {
+        tex.resize(planes.size());
+        glGenTextures(tex.size(), tex.data());
+
+        auto const locked_buffer = buffer.lock();
+        if (!locked_buffer)
+        {
+            mir::log_debug("Wayland buffer destroyed before use; rendering will be incomplete");
+        }
+
+        auto const shm_buffer = locked_buffer ? wl_shm_buffer_get(locked_buffer) : nullptr;
+        if (shm_buffer)
+        {
+            wl_shm_buffer_begin_access(shm_buffer);
+        }
+        auto const pixels = shm_buffer ? static_cast<unsigned char const*>(wl_shm_buffer_get_data(shm_buffer)) : nullptr;
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (auto i = 0u; i != planes.size(); ++i)
+        {
+            auto const& plane = planes[i];
+
+            glBindTexture(GL_TEXTURE_2D, tex[i]);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+            glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, plane.row_length);
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                plane.format,
+                plane.width, plane.height,
+                0,
+                plane.format,
+                GL_UNSIGNED_BYTE,
+                pixels ? pixels + plane.offset : nullptr);
+        }
+
+        // Be nice to other users of the GL context by reverting our changes to shared state
+        glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0);     // 0 is default, meaning “use width”
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);          // 4 is default; word alignment.
+
+        if (shm_buffer)
+        {
+            wl_shm_buffer_end_access(shm_buffer);
+        }
+    }
+
+    std::mutex consumption_mutex;
+    std::function<void()> on_consumed;
+    SharedWlBuffer const buffer;
+    std::shared_ptr<mgc::EGLContextExecutor> const egl_delegate;
+    mir::geometry::Size const size_;
+    mg::gl::YuvPlanes const yuv_planes;
+    std::vector<Plane> const planes;
+    std::vector<GLuint> tex;
+};
+
 auto mg::wayland::buffer_from_wl_shm(
     wl_resource* buffer,
     std::shared_ptr<Executor> executor,
@@ -398,6 +617,22 @@ auto mg::wayland::buffer_from_wl_shm(
     {
         BOOST_THROW_EXCEPTION((std::logic_error{"Attempt to import a non-SHM buffer as a SHM buffer"}));
     }
+
+    auto const format = wl_shm_buffer_get_format(shm_buffer);
+    if (WlShmYuvBuffer::supports(format))
+    {
+        return std::make_shared<WlShmYuvBuffer>(
+            SharedWlBuffer{buffer, std::move(executor)},
+            std::move(egl_delegate),
+            mir::geometry::Size{
+                wl_shm_buffer_get_width(shm_buffer),
+                wl_shm_buffer_get_height(shm_buffer)
+            },
+            mir::geometry::Stride{wl_shm_buffer_get_stride(shm_buffer)},
+            format,
+            std::move(on_consumed));
+    }
+
     return std::make_shared<WlShmBuffer>(
         SharedWlBuffer{buffer, std::move(executor)},
         std::move(egl_delegate),
@@ -406,6 +641,11 @@ auto mg::wayland::buffer_from_wl_shm(
             wl_shm_buffer_get_height(shm_buffer)
         },
         mir::geometry::Stride{wl_shm_buffer_get_stride(shm_buffer)},
-        wl_format_to_mir_format(wl_shm_buffer_get_format(shm_buffer)),
+        wl_format_to_mir_format(format),
         std::move(on_consumed));
 }
+
+void mg::wayland::add_shm_formats(wl_display* display)
+{
+    wl_display_add_shm_format(display, WL_SHM_FORMAT_YUYV);
+}
@@ -23,6 +23,7 @@
 #include <memory>
 #include <functional>
 
+struct wl_display;
 struct wl_resource;
 
 namespace mir
@@ -43,8 +44,8 @@ namespace wayland
 /**
  * Get a mir::graphics::Buffer with the content of the shm buffer.
  *
- * The returned buffer will support the mg::gl::Texture and
- * mir::renderer::sw::PixelSource interfaces.
+ * The returned buffer will support the mg::gl::Texture interface and, unless it is in
+ * the YUV format added by add_shm_formats(), mir::renderer::sw::PixelSource.
  *
  * \note This must be called on the Wayland thread, with a current GL context
  *
@@ -59,6 +60,15 @@ auto buffer_from_wl_shm(
     std::shared_ptr<Executor> executor,
     std::shared_ptr<common::EGLContextExecutor> egl_delegate,
     std::function<void()>&& on_consumed) -> std::shared_ptr<Buffer>;
+
+/**
+ * Advertise the wl_shm formats buffer_from_wl_shm() supports beyond the ARGB8888 and
+ * XRGB8888 every wl_shm has: YUYV, converted to RGB on the GPU.
+ *
+ * Planar YUV formats are not offered through wl_shm, as their chroma planes lie outside
+ * the bounds libwayland checks against the pool; they can be imported through linux-dmabuf.
+ */
+void add_shm_formats(wl_display* display);
 }
 }
 }
@@ -403,6 +403,7 @@ void mir::graphics::eglstream::BufferAllocator::bind_display(
     {
         BOOST_THROW_EXCEPTION((mg::egl_error("Failed to bind Wayland EGL display")));
     }
+    mg::wayland::add_shm_formats(display);
 
     std::vector<char const*> missing_extensions;
     for (char const* extension : {
@@ -531,6 +531,13 @@ bool mge::Display::apply_if_configuration_preserves_display_buffers(
     return false;
 }
 
+bool mge::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    mg::DisplayConfiguration const& /*conf*/,
+    std::function<void(mg::DisplaySyncGroup&)> const& /*remove_sync_group*/)
+{
+    return false;
+}
+
 mg::Frame mge::Display::last_frame_on(unsigned) const
 {
     /*
@@ -34,6 +34,7 @@
 #include "mir/renderer/gl/context.h"
 #include "mir/renderer/gl/context_source.h"
 #include "mir/graphics/egl_wayland_allocator.h"
+#include "mir/graphics/linux_dmabuf.h"
 #include "buffer_from_wl_shm.h"
 #include "mir/executor.h"
 
@@ -51,6 +52,7 @@
 #include <gbm.h>
 #include <cassert>
 #include <fcntl.h>
+#include <sys/stat.h>
 
 #include <wayland-server.h>
 
@@ -260,6 +262,8 @@ mgm::BufferAllocator::BufferAllocator(
 {
 }
 
+mgm::BufferAllocator::~BufferAllocator() = default;
+
 std::shared_ptr<mg::Buffer> mgm::BufferAllocator::alloc_buffer(
     BufferProperties const& buffer_properties)
 {
@@ -369,8 +373,28 @@ void mgm::BufferAllocator::bind_display(wl_display* display, std::shared_ptr<Exe
     auto dpy = eglGetCurrentDisplay();
 
     mg::wayland::bind_display(dpy, display, *egl_extensions);
+    mg::wayland::add_shm_formats(display);
 
     this->wayland_executor = std::move(wayland_executor);
+
+    struct stat device_stat;
+    if (fstat(gbm_device_get_fd(device), &device_stat) == 0)
+    {
+        try
+        {
+            dmabuf_extension = std::make_unique<mg::LinuxDmaBufUnstable>(
+                display,
+                dpy,
+                egl_extensions,
+                ctx,
+                this->wayland_executor,
+                device_stat.st_rdev);
+        }
+        catch (std::runtime_error const& error)
+        {
+            mir::log_info("Not enabling linux-dmabuf: %s", error.what());
+        }
+    }
 }
 
 std::shared_ptr<mg::Buffer> mgm::BufferAllocator::buffer_from_resource(
@@ -378,9 +402,14 @@ std::shared_ptr<mg::Buffer> mgm::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release)
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
+    if (dmabuf_extension)
+    {
+        // Takes on_consumed and on_release only if buffer is one of its own
+        if (auto dmabuf = dmabuf_extension->buffer_from_resource(buffer, std::move(on_consumed), std::move(on_release)))
+        {
+            return dmabuf;
+        }
+    }
 
     return mg::wayland::buffer_from_resource(
         buffer,
@@ -48,6 +48,7 @@ namespace graphics
 {
 class Display;
 struct EGLExtensions;
+class LinuxDmaBufUnstable;
 
 namespace common
 {
@@ -73,6 +74,7 @@ public:
         gbm_device* device,
         BypassOption bypass_option,
         BufferImportMethod const buffer_import_method);
+    ~BufferAllocator();
 
     std::shared_ptr<Buffer> alloc_buffer(
         geometry::Size size, uint32_t native_format, uint32_t native_flags) override;
@@ -98,6 +100,7 @@ private:
     std::shared_ptr<Executor> wayland_executor;
     gbm_device* const device;
     std::shared_ptr<EGLExtensions> const egl_extensions;
+    std::unique_ptr<LinuxDmaBufUnstable> dmabuf_extension;
 
     BypassOption const bypass_option;
     BufferImportMethod const buffer_import_method;
@@ -28,6 +28,7 @@
 
 #include <boost/exception/errinfo_errno.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -40,6 +41,11 @@ namespace
 const uint64_t fallback_cursor_size = 64;
 char const* const mir_drm_cursor_64x64 = "MIR_DRM_CURSOR_64x64";
 
+// Enough for the cursors a pointer typically hovers between (arrow, text, link, resize...)
+size_t const max_prepared_buffers = 4;
+uint64_t const no_image_id = 0;
+uint64_t const blank_image_id = 1;
+
 // Transforms a relative position within the display bounds described by \a rect which is rotated with \a orientation
 geom::Displacement transform(geom::Rectangle const& rect, geom::Displacement const& vector, MirOrientation orientation)
 {
@@ -99,16 +105,15 @@ gbm_device* gbm_create_device_checked(int fd)
 }
 }
 
-mgm::Cursor::GBMBOWrapper::GBMBOWrapper(int fd, MirOrientation orientation) :
-    device{gbm_create_device_checked(fd)},
+mgm::Cursor::GBMBOWrapper::GBMBOWrapper(std::shared_ptr<gbm_device> const& device, int fd) :
+    device{device},
     buffer{
         gbm_bo_create(
-            device,
+            device.get(),
             get_drm_cursor_width(fd),
             get_drm_cursor_height(fd),
             GBM_FORMAT_ARGB8888,
-            GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE)},
-    current_orientation{orientation}
+            GBM_BO_USE_CURSOR | GBM_BO_USE_WRITE)}
 {
     if (!buffer) BOOST_THROW_EXCEPTION(std::runtime_error("failed to create gbm buffer"));
 }
@@ -120,28 +125,15 @@ inline mgm::Cursor::GBMBOWrapper::operator gbm_bo*()
 
 inline mgm::Cursor::GBMBOWrapper::~GBMBOWrapper()
 {
-    if (device)
-        gbm_device_destroy(device);
     if (buffer)
         gbm_bo_destroy(buffer);
 }
 
 mgm::Cursor::GBMBOWrapper::GBMBOWrapper(GBMBOWrapper&& from)
-    : device{from.device},
-      buffer{from.buffer},
-      current_orientation{from.current_orientation}
+    : device{std::move(from.device)},
+      buffer{from.buffer}
 {
     from.buffer = nullptr;
-    from.device = nullptr;
-}
-
-auto mir::graphics::mesa::Cursor::GBMBOWrapper::change_orientation(MirOrientation new_orientation) -> bool
-{
-    if (current_orientation == new_orientation)
-        return false;
-
-    current_orientation = new_orientation;
-    return true;
 }
 
 mgm::Cursor::Cursor(
@@ -150,6 +142,9 @@ mgm::Cursor::Cursor(
         output_container(output_container),
         current_position(),
         last_set_failed(false),
+        current_image_id{blank_image_id},
+        next_image_id{blank_image_id + 1},
+        buffer_use_count{0},
         min_buffer_width{std::numeric_limits<uint32_t>::max()},
         min_buffer_height{std::numeric_limits<uint32_t>::max()},
         current_configuration(current_configuration)
@@ -162,7 +157,7 @@ mgm::Cursor::Cursor(
                 [this, &kms_conf](auto const& output)
                 {
                     // I'm not sure why g++ needs the explicit "this->" but it does - alan_g
-                    this->buffer_for_output(*kms_conf.get_output_for(output.id));
+                    this->buffers_for_output(*kms_conf.get_output_for(output.id));
                 });
         });
 
@@ -192,9 +187,9 @@ void mgm::Cursor::write_buffer_data_locked(
 
 void mgm::Cursor::pad_and_write_image_data_locked(
     std::lock_guard<std::mutex> const& lg,
-    GBMBOWrapper& buffer)
+    gbm_bo* buffer,
+    MirOrientation orientation)
 {
-    auto const orientation = buffer.orientation();
     bool const sideways = orientation == mir_orientation_left || orientation == mir_orientation_right;
 
     auto const min_width  = sideways ? min_buffer_width : min_buffer_height;
@@ -202,77 +197,102 @@ void mgm::Cursor::pad_and_write_image_data_locked(
 
     auto const image_width = std::min(min_width, size.width.as_uint32_t());
     auto const image_height = std::min(min_height, size.height.as_uint32_t());
-    auto const image_stride = size.width.as_uint32_t() * 4;
+    auto const image_stride = size.width.as_uint32_t();                     // in pixels
 
     auto const buffer_stride = std::max(min_width*4, gbm_bo_get_stride(buffer));  // in bytes
     auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
     size_t const padded_size = buffer_stride * buffer_height;
+    auto const dest_stride = buffer_stride / 4;                             // in pixels
 
-    auto padded = std::unique_ptr<uint8_t[]>(new uint8_t[padded_size]);
-    size_t rhs_padding = buffer_stride - 4*image_width;
+    // Zero initialised, so everything we don't copy the image into is transparent padding.
+    // Working a pixel (rather than a byte) at a time lets the compiler vectorize the copies.
+    std::vector<uint32_t> padded((padded_size + 3) / 4);
 
-    auto const filler = 0; // 0x3f; is useful to make buffer visible for debugging
-    uint8_t const* src = argb8888.data();
-    uint8_t* dest = &padded[0];
+    auto const src = reinterpret_cast<uint32_t const*>(argb8888.data());
+    auto const dest = padded.data();
 
     switch (orientation)
     {
     case mir_orientation_normal:
-        for (unsigned int y = 0; y < image_height; y++)
+        for (unsigned int row = 0; row != image_height; ++row)
         {
-            memcpy(dest, src, 4*image_width);
-            memset(dest + 4*image_width, filler, rhs_padding);
-            dest += buffer_stride;
-            src += image_stride;
+            std::copy_n(src + row*image_stride, image_width, dest + row*dest_stride);
         }
-
-        memset(dest, 0, buffer_stride * (buffer_height - image_height));
         break;
 
     case mir_orientation_inverted:
         for (unsigned int row = 0; row != image_height; ++row)
         {
-            memset(dest+row*buffer_stride+4*image_width, filler, rhs_padding);
-
-            for (unsigned int col = 0; col != image_width; ++col)
-            {
-                memcpy(dest+row*buffer_stride+4*col, src + ((image_height-1)-row)*image_stride + 4*((image_width-1)-col), 4);
-            }
+            auto const src_row = src + ((image_height-1)-row)*image_stride;
+            std::reverse_copy(src_row, src_row + image_width, dest + row*dest_stride);
         }
-
-        memset(dest+image_height*buffer_stride, filler, buffer_stride * (buffer_height - image_height));
         break;
 
     case mir_orientation_left:
-        for (unsigned int row = 0; row != image_width; ++row)
+        // Walk the source a row at a time so that reads are sequential
+        for (unsigned int y = 0; y != image_height; ++y)
         {
-            memset(dest+row*buffer_stride+4*image_height, filler, rhs_padding);
-
-            for (unsigned int col = 0; col != image_height; ++col)
+            auto const src_row = src + y*image_stride;
+            for (unsigned int x = 0; x != image_width; ++x)
             {
-                memcpy(dest+row*buffer_stride+4*col, src + ((image_width-1)-row)*4 + image_stride*col, 4);
+                dest[((image_width-1)-x)*dest_stride + y] = src_row[x];
             }
         }
-
-        memset(dest+image_width*buffer_stride, filler, buffer_stride * (buffer_height - image_width));
         break;
 
     case mir_orientation_right:
-        for (unsigned int row = 0; row != image_width; ++row)
+        for (unsigned int y = 0; y != image_height; ++y)
         {
-            memset(dest+row*buffer_stride+4*image_height, filler, rhs_padding);
-
-            for (unsigned int col = 0; col != image_height; ++col)
+            auto const src_row = src + y*image_stride;
+            auto const dest_col = dest + ((image_height-1)-y);
+            for (unsigned int x = 0; x != image_width; ++x)
             {
-                memcpy(dest+row*buffer_stride+4*col, src + row*4 + image_stride*((image_height-1)-col), 4);
+                dest_col[x*dest_stride] = src_row[x];
             }
         }
-
-        memset(dest+image_width*buffer_stride, filler, buffer_stride * (buffer_height - image_width));
         break;
     }
 
-    write_buffer_data_locked(lg, buffer, &padded[0], padded_size);
+    write_buffer_data_locked(lg, buffer, padded.data(), padded_size);
+}
+
+auto mgm::Cursor::prepared_buffer_for_locked(
+    std::lock_guard<std::mutex> const& lg,
+    OutputBuffers& output_buffers,
+    MirOrientation orientation) -> gbm_bo*
+{
+    auto& prepared = output_buffers.prepared;
+
+    auto buffer = std::find_if(begin(prepared), end(prepared),
+        [this, orientation](PreparedBuffer const& candidate)
+        {
+            return candidate.image_id == current_image_id && candidate.orientation == orientation;
+        });
+
+    if (buffer == end(prepared))
+    {
+        if (prepared.size() < max_prepared_buffers)
+        {
+            prepared.push_back(PreparedBuffer{
+                GBMBOWrapper{output_buffers.device, output_buffers.drm_fd}, no_image_id, orientation, 0});
+            track_buffer_size(prepared.back().buffer);
+            buffer = end(prepared) - 1;
+        }
+        else
+        {
+            buffer = std::min_element(begin(prepared), end(prepared),
+                [](PreparedBuffer const& lhs, PreparedBuffer const& rhs) { return lhs.last_used < rhs.last_used; });
+        }
+
+        // Don't leave the old image recorded against the buffer if writing throws
+        buffer->image_id = no_image_id;
+        pad_and_write_image_data_locked(lg, buffer->buffer, orientation);
+        buffer->image_id = current_image_id;
+        buffer->orientation = orientation;
+    }
+
+    buffer->last_used = ++buffer_use_count;
+    return buffer->buffer;
 }
 
 void mgm::Cursor::show()
@@ -291,21 +311,40 @@ void mgm::Cursor::show(CursorImage const& cursor_image)
     std::lock_guard<std::mutex> lg(guard);
 
     size = cursor_image.size();
+    hotspot = cursor_image.hotspot();
 
-    argb8888.resize(size.width.as_uint32_t() * size.height.as_uint32_t() * 4);
-    memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+    auto const pixels = static_cast<uint8_t const*>(cursor_image.as_argb_8888());
+    size_t const image_bytes = size.width.as_uint32_t() * size.height.as_uint32_t() * 4;
 
-    hotspot = cursor_image.hotspot();
-    {
-        auto locked_buffers = buffers.lock();
-        for (auto& tuple : *locked_buffers)
+    auto const recent = std::find_if(begin(recent_images), end(recent_images),
+        [&](CachedImage const& image)
         {
-            pad_and_write_image_data_locked(lg, std::get<2>(tuple));
-        }
+            return image.size == size && memcmp(image.argb8888.data(), pixels, image_bytes) == 0;
+        });
+
+    if (recent != end(recent_images))
+    {
+        std::rotate(begin(recent_images), recent, recent + 1);
     }
+    else
+    {
+        recent_images.insert(begin(recent_images), CachedImage{next_image_id++, size, {pixels, pixels + image_bytes}});
+
+        if (recent_images.size() > max_prepared_buffers)
+            recent_images.pop_back();
+    }
+
+    current_image_id = recent_images.front().id;
+    argb8888 = recent_images.front().argb8888;
+
+    // Writing the data could throw an exception so lets prepare the
+    // buffers we are about to show before setting visible.
+    for_each_used_output([&](KMSOutput& output, geom::Rectangle const& output_rect, MirOrientation orientation)
+    {
+        if (output_rect.contains(current_position))
+            prepared_buffer_for_locked(lg, buffers_for_output(output), orientation);
+    });
 
-    // Writing the data could throw an exception so lets
-    // hold off on setting visible until after we have succeeded.
     visible = true;
     place_cursor_at_locked(lg, current_position, ForceState);
 }
@@ -394,15 +433,14 @@ void mgm::Cursor::place_cursor_at_locked(
             // work on radeon and intel. There also seems to be precedent in weston for
             // implementing hotspot in this fashion.
             output.move_cursor(geom::Point{} + dp - hs);
-            auto& buffer = buffer_for_output(output);
-
-            auto const changed_orientation = buffer.change_orientation(orientation);
+            auto& output_buffers = buffers_for_output(output);
+            auto const buffer = prepared_buffer_for_locked(lg, output_buffers, orientation);
 
-            if (changed_orientation)
-                pad_and_write_image_data_locked(lg, buffer);
+            auto const changed_buffer = buffer != output_buffers.on_output;
 
-            if (force_state || !output.has_cursor() || changed_orientation)
+            if (force_state || !output.has_cursor() || changed_buffer)
             {
+                output_buffers.on_output = buffer;
                 if (!output.set_cursor(buffer) || !output.has_cursor())
                     set_on_all_outputs = false;
             }
@@ -419,30 +457,38 @@ void mgm::Cursor::place_cursor_at_locked(
     last_set_failed = !set_on_all_outputs;
 }
 
-mgm::Cursor::GBMBOWrapper& mgm::Cursor::buffer_for_output(KMSOutput const& output)
+mgm::Cursor::OutputBuffers& mgm::Cursor::buffers_for_output(KMSOutput const& output)
 {
     auto const drm_fd = output.drm_fd();
     auto const id = output.id();
     auto locked_buffers = buffers.lock();
 
-    for (auto& bo : *locked_buffers)
+    for (auto& output_buffers : *locked_buffers)
     {
         // We use both id and drm_fd as identifier as we're not sure of the uniqueness of either
-        if (std::get<0>(bo) == id && std::get<1>(bo) == drm_fd)
-            return std::get<2>(bo);
+        if (output_buffers.output_id == id && output_buffers.drm_fd == drm_fd)
+            return output_buffers;
     }
 
-    locked_buffers->push_back(image_buffer{id, drm_fd, GBMBOWrapper{drm_fd, mir_orientation_normal}});
+    std::shared_ptr<gbm_device> const device{gbm_create_device_checked(drm_fd), &gbm_device_destroy};
 
-    GBMBOWrapper& bo = std::get<2>(locked_buffers->back());
-    if (gbm_bo_get_width(bo) < min_buffer_width)
+    std::vector<PreparedBuffer> prepared;
+    prepared.push_back(PreparedBuffer{GBMBOWrapper{device, drm_fd}, no_image_id, mir_orientation_normal, 0});
+    track_buffer_size(prepared.back().buffer);
+
+    locked_buffers->push_back(OutputBuffers{id, drm_fd, device, std::move(prepared), nullptr});
+
+    return locked_buffers->back();
+}
+
+void mgm::Cursor::track_buffer_size(gbm_bo* buffer)
+{
+    if (gbm_bo_get_width(buffer) < min_buffer_width)
     {
-        min_buffer_width = gbm_bo_get_width(bo);
+        min_buffer_width = gbm_bo_get_width(buffer);
     }
-    if (gbm_bo_get_height(bo) < min_buffer_height)
+    if (gbm_bo_get_height(buffer) < min_buffer_height)
     {
-        min_buffer_height = gbm_bo_get_height(bo);
+        min_buffer_height = gbm_bo_get_height(buffer);
     }
-
-    return bo;
 }
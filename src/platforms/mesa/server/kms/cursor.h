@@ -86,6 +86,7 @@ public:
 private:
     enum ForceCursorState { UpdateState, ForceState };
     struct GBMBOWrapper;
+    struct OutputBuffers;
     void for_each_used_output(std::function<void(KMSOutput&, geometry::Rectangle const&, MirOrientation orientation)> const& f);
     void place_cursor_at(geometry::Point position, ForceCursorState force_state);
     void place_cursor_at_locked(std::lock_guard<std::mutex> const&, geometry::Point position, ForceCursorState force_state);
@@ -96,10 +97,16 @@ private:
         size_t count);
     void pad_and_write_image_data_locked(
         std::lock_guard<std::mutex> const&,
-        GBMBOWrapper& buffer);
+        gbm_bo* buffer,
+        MirOrientation orientation);
+    auto prepared_buffer_for_locked(
+        std::lock_guard<std::mutex> const&,
+        OutputBuffers& output_buffers,
+        MirOrientation orientation) -> gbm_bo*;
     void clear(std::lock_guard<std::mutex> const&);
 
-    GBMBOWrapper& buffer_for_output(KMSOutput const& output);
+    OutputBuffers& buffers_for_output(KMSOutput const& output);
+    void track_buffer_size(gbm_bo* buffer);
     
     std::mutex guard;
 
@@ -112,27 +119,52 @@ private:
     bool visible;
     bool last_set_failed;
 
+    // Recently shown images, most recent first, so reshowing one can reuse its prepared buffers
+    struct CachedImage
+    {
+        uint64_t id;
+        geometry::Size size;
+        std::vector<uint8_t> argb8888;
+    };
+    std::vector<CachedImage> recent_images;
+    uint64_t current_image_id;
+    uint64_t next_image_id;
+    uint64_t buffer_use_count;
+
     struct GBMBOWrapper
     {
-        GBMBOWrapper(int fd, MirOrientation orientation);
+        GBMBOWrapper(std::shared_ptr<gbm_device> const& device, int fd);
         operator gbm_bo*();
 
-        auto orientation() const -> MirOrientation { return current_orientation; }
-        auto change_orientation(MirOrientation new_orientation) -> bool;
-
         ~GBMBOWrapper();
 
         GBMBOWrapper(GBMBOWrapper&& from);
     private:
-        gbm_device* device;
+        std::shared_ptr<gbm_device> device;
         gbm_bo* buffer;
-        MirOrientation current_orientation;
         GBMBOWrapper(GBMBOWrapper const&) = delete;
         GBMBOWrapper& operator=(GBMBOWrapper const&) = delete;
     };
 
-    using image_buffer = std::tuple<uint32_t, int, GBMBOWrapper>;
-    Mutex<std::vector<image_buffer>> buffers;
+    // A buffer holding a cursor image padded and rotated for an output
+    struct PreparedBuffer
+    {
+        GBMBOWrapper buffer;
+        uint64_t image_id;
+        MirOrientation orientation;
+        uint64_t last_used;
+    };
+
+    struct OutputBuffers
+    {
+        uint32_t output_id;
+        int drm_fd;
+        std::shared_ptr<gbm_device> device;
+        std::vector<PreparedBuffer> prepared;
+        gbm_bo* on_output;
+    };
+
+    Mutex<std::vector<OutputBuffers>> buffers;
 
     uint32_t min_buffer_width;
     uint32_t min_buffer_height;
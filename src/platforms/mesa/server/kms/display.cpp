@@ -407,6 +407,28 @@ bool mgm::Display::apply_if_configuration_preserves_display_buffers(
     return result;
 }
 
+bool mgm::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    mg::DisplayConfiguration const& conf,
+    std::function<void(mg::DisplaySyncGroup&)> const& remove_sync_group)
+{
+    if (!conf.valid())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Invalid or inconsistent display configuration"));
+    }
+
+    {
+        std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
+        configure_changed_sync_groups_locked(
+            dynamic_cast<RealKMSDisplayConfiguration const&>(conf),
+            remove_sync_group,
+            lock);
+    }
+
+    if (auto c = cursor.lock()) c->resume();
+    return true;
+}
+
 mg::Frame mgm::Display::last_frame_on(unsigned output_id) const
 {
     auto output = current_display_configuration.get_output_for(
@@ -443,6 +465,221 @@ void add_to_drm_device_group(
 }
 }
 
+auto mgm::Display::create_display_buffer(
+    std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+    geom::Rectangle const& bounding_rect,
+    glm::mat2 const& transformation) -> std::unique_ptr<DisplayBuffer>
+{
+    glm::vec2 const logical_size{
+        bounding_rect.size.width.as_uint32_t(),
+        bounding_rect.size.height.as_uint32_t()};
+
+    auto const physical_size = transformation * logical_size;
+    uint32_t width = abs(int(physical_size.x));
+    uint32_t height = abs(int(physical_size.y));
+
+    /*
+     * In a hybrid setup a scanout surface needs to be allocated differently if it
+     * needs to be able to be shared across GPUs. This likely reduces performance.
+     *
+     * As a first cut, assume every scanout buffer in a hybrid setup might need
+     * to be shared.
+     */
+    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
+    auto const raw_surface = surface.get();
+
+    return std::make_unique<DisplayBuffer>(
+        bypass_option,
+        listener,
+        outputs,
+        GBMOutputSurface{
+            outputs.front()->drm_fd(),
+            std::move(surface),
+            width, height,
+            helpers::EGLHelper{
+                *gl_config,
+                *gbm,
+                raw_surface,
+                shared_egl.context()
+            }
+        },
+        bounding_rect,
+        transformation);
+}
+
+namespace
+{
+/*
+ * Whether an output is scanned out identically in both configurations. Changes
+ * that only concern clients (scale, form factor, subpixel arrangement) don't matter.
+ */
+bool same_scanout(mg::DisplayConfigurationOutput const& current, mg::DisplayConfigurationOutput const& updated)
+{
+    auto clone = updated;
+    clone.subpixel_arrangement = current.subpixel_arrangement;
+    clone.scale = current.scale;
+    clone.form_factor = current.form_factor;
+    return current == clone && current.power_mode == updated.power_mode;
+}
+}
+
+void mgm::Display::configure_changed_sync_groups_locked(
+    mgm::RealKMSDisplayConfiguration const& kms_conf,
+    std::function<void(mg::DisplaySyncGroup&)> const& remove_sync_group,
+    std::lock_guard<std::mutex> const&)
+{
+    struct PlannedDisplayBuffer
+    {
+        std::vector<std::shared_ptr<KMSOutput>> outputs;
+        std::vector<DisplayConfigurationOutput> conf_outputs;
+        geom::Rectangle bounding_rect;
+        glm::mat2 transformation;
+        DisplayBuffer* retained;
+        std::unique_ptr<DisplayBuffer> created;
+    };
+
+    auto const unchanged = [this](DisplayConfigurationOutput const& updated)
+        {
+            bool result = false;
+            current_display_configuration.for_each_output(
+                [&](DisplayConfigurationOutput const& current)
+                {
+                    if (current.id == updated.id)
+                        result = current.used && same_scanout(current, updated);
+                });
+            return result;
+        };
+
+    /* Work out the DisplayBuffers needed: one per GPU memory domain of each group */
+    std::vector<PlannedDisplayBuffer> planned;
+    OverlappingOutputGrouping grouping{kms_conf};
+
+    grouping.for_each_group(
+        [&](OverlappingOutputGroup const& group)
+        {
+            auto const bounding_rect = group.bounding_rectangle();
+            auto const first_in_group = planned.size();
+
+            group.for_each_output(
+                [&](DisplayConfigurationOutput const& conf_output)
+                {
+                    auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+
+                    auto domain = std::find_if(
+                        planned.begin() + first_in_group, planned.end(),
+                        [&](PlannedDisplayBuffer const& db)
+                        {
+                            return db.outputs.front()->drm_fd() == kms_output->drm_fd();
+                        });
+
+                    if (domain == planned.end())
+                    {
+                        planned.push_back({{}, {}, bounding_rect, conf_output.transformation(), nullptr, nullptr});
+                        domain = planned.end() - 1;
+                    }
+
+                    domain->outputs.push_back(std::move(kms_output));
+                    domain->conf_outputs.push_back(conf_output);
+                });
+        });
+
+    /* Keep the DisplayBuffers that would be recreated exactly as they are */
+    std::vector<KMSOutput*> retained_outputs;
+    for (auto& db : planned)
+    {
+        if (!std::all_of(db.conf_outputs.begin(), db.conf_outputs.end(), unchanged))
+            continue;
+
+        for (auto const& existing : display_buffers)
+        {
+            if (existing->view_area() == db.bounding_rect &&
+                existing->transformation() == db.transformation &&
+                existing->uses_outputs(db.outputs))
+            {
+                db.retained = existing.get();
+                for (auto const& output : db.outputs)
+                    retained_outputs.push_back(output.get());
+                break;
+            }
+        }
+    }
+
+    auto const is_retained = [&](std::unique_ptr<DisplayBuffer> const& existing)
+        {
+            return std::any_of(planned.begin(), planned.end(),
+                [&](PlannedDisplayBuffer const& db) { return db.retained == existing.get(); });
+        };
+
+    /* Stop using the DisplayBuffers that are going away (see configure_locked()) */
+    for (auto& existing : display_buffers)
+    {
+        if (!is_retained(existing))
+        {
+            remove_sync_group(*existing);
+            existing->wait_for_page_flip();
+        }
+    }
+
+    /* Reset the state of all outputs not driven by a retained DisplayBuffer */
+    kms_conf.for_each_output(
+        [&](DisplayConfigurationOutput const& conf_output)
+        {
+            auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+
+            if (std::find(retained_outputs.begin(), retained_outputs.end(), kms_output.get()) ==
+                retained_outputs.end())
+            {
+                kms_output->clear_cursor();
+                kms_output->reset();
+            }
+        });
+
+    /* Set up outputs for new DisplayBuffers */
+    for (auto& db : planned)
+    {
+        for (auto i = 0u; i != db.outputs.size(); ++i)
+        {
+            auto const& conf_output = db.conf_outputs[i];
+
+            if (!db.retained)
+            {
+                auto const mode_index = kms_conf.get_kms_mode_index(conf_output.id,
+                                                                    conf_output.current_mode_index);
+                db.outputs[i]->configure(conf_output.top_left - db.bounding_rect.top_left, mode_index);
+                db.outputs[i]->set_power_mode(conf_output.power_mode);
+            }
+            db.outputs[i]->set_gamma(conf_output.gamma);
+        }
+
+        if (!db.retained)
+            db.created = create_display_buffer(db.outputs, db.bounding_rect, db.transformation);
+    }
+
+    std::vector<std::unique_ptr<DisplayBuffer>> display_buffers_new;
+    for (auto& db : planned)
+    {
+        if (db.retained)
+        {
+            auto const existing = std::find_if(display_buffers.begin(), display_buffers.end(),
+                [&](std::unique_ptr<DisplayBuffer> const& existing) { return existing.get() == db.retained; });
+
+            display_buffers_new.push_back(std::move(*existing));
+        }
+        else
+        {
+            display_buffers_new.push_back(std::move(db.created));
+        }
+    }
+
+    display_buffers = std::move(display_buffers_new);
+
+    /* Store applied configuration */
+    current_display_configuration = kms_conf;
+
+    /* Clear connected but unused outputs */
+    clear_connected_unused_outputs();
+}
+
 void mgm::Display::configure_locked(
     mgm::RealKMSDisplayConfiguration const& kms_conf,
     std::lock_guard<std::mutex> const&)
@@ -518,45 +755,10 @@ void mgm::Display::configure_locked(
             }
             else
             {
-                glm::vec2 const logical_size{
-                    bounding_rect.size.width.as_uint32_t(),
-                    bounding_rect.size.height.as_uint32_t()};
-
-                auto const physical_size = transformation * logical_size;
-                uint32_t width = abs(int(physical_size.x));
-                uint32_t height = abs(int(physical_size.y));
-
                 for (auto const& group : kms_output_groups)
                 {
-                    /*
-                     * In a hybrid setup a scanout surface needs to be allocated differently if it
-                     * needs to be able to be shared across GPUs. This likely reduces performance.
-                     *
-                     * As a first cut, assume every scanout buffer in a hybrid setup might need
-                     * to be shared.
-                     */
-                    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
-                    auto const raw_surface = surface.get();
-
-                    auto db = std::make_unique<DisplayBuffer>(
-                        bypass_option,
-                        listener,
-                        group,
-                        GBMOutputSurface{
-                            group.front()->drm_fd(),
-                            std::move(surface),
-                            width, height,
-                            helpers::EGLHelper{
-                                *gl_config,
-                                *gbm,
-                                raw_surface,
-                                shared_egl.context()
-                            }
-                        },
-                        bounding_rect,
-                        transformation);
-
-                    display_buffers_new.push_back(std::move(db));
+                    display_buffers_new.push_back(
+                        create_display_buffer(group, bounding_rect, transformation));
                 }
             }
         });
@@ -80,6 +80,9 @@ public:
 
     std::unique_ptr<DisplayConfiguration> configuration() const override;
     bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) override;
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& remove_sync_group) override;
     void configure(DisplayConfiguration const& conf) override;
 
     void register_configuration_change_handler(
@@ -121,6 +124,16 @@ private:
         RealKMSDisplayConfiguration const& conf,
         std::lock_guard<decltype(configuration_mutex)> const&);
 
+    void configure_changed_sync_groups_locked(
+        RealKMSDisplayConfiguration const& conf,
+        std::function<void(graphics::DisplaySyncGroup&)> const& remove_sync_group,
+        std::lock_guard<decltype(configuration_mutex)> const&);
+
+    auto create_display_buffer(
+        std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+        geometry::Rectangle const& bounding_rect,
+        glm::mat2 const& transformation) -> std::unique_ptr<DisplayBuffer>;
+
     BypassOption bypass_option;
     std::weak_ptr<Cursor> cursor;
     std::shared_ptr<GLConfig> const gl_config;
@@ -575,6 +575,12 @@ glm::mat2 mgm::DisplayBuffer::transformation() const
     return transform;
 }
 
+bool mgm::DisplayBuffer::uses_outputs(std::vector<std::shared_ptr<KMSOutput>> const& candidates) const
+{
+    return candidates.size() == outputs.size() &&
+           std::is_permutation(outputs.begin(), outputs.end(), candidates.begin());
+}
+
 void mgm::DisplayBuffer::set_transformation(glm::mat2 const& t, geometry::Rectangle const& a)
 {
     transform = t;
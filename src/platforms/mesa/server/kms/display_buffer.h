@@ -123,6 +123,7 @@ public:
     NativeDisplayBuffer* native_display_buffer() override;
 
     void set_transformation(glm::mat2 const& t, geometry::Rectangle const& a);
+    bool uses_outputs(std::vector<std::shared_ptr<KMSOutput>> const& candidates) const;
     void schedule_set_crtc();
     void wait_for_page_flip();
 
@@ -383,6 +383,13 @@ bool mgx::Display::apply_if_configuration_preserves_display_buffers(
     return false;
 }
 
+bool mgx::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    mg::DisplayConfiguration const& /*conf*/,
+    std::function<void(mg::DisplaySyncGroup&)> const& /*remove_sync_group*/)
+{
+    return false;
+}
+
 mg::Frame mgx::Display::last_frame_on(unsigned) const
 {
     return last_frame->load();
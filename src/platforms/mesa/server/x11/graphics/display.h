@@ -81,6 +81,10 @@ public:
 
     bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const& conf) override;
 
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        graphics::DisplayConfiguration const& conf,
+        std::function<void(graphics::DisplaySyncGroup&)> const& remove_sync_group) override;
+
     void configure(graphics::DisplayConfiguration const&) override;
 
     void register_configuration_change_handler(
@@ -315,6 +315,7 @@ void mg::rpi::BufferAllocator::bind_display(wl_display* display, std::shared_ptr
     {
         mir::log_info("Bound WaylandAllocator display");
     }
+    mg::wayland::add_shm_formats(display);
     this->wayland_executor = std::move(wayland_executor);
 }
 
@@ -234,6 +234,14 @@ auto mg::rpi::Display::apply_if_configuration_preserves_display_buffers(
     return true;
 }
 
+auto mg::rpi::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    mg::DisplayConfiguration const& /*conf*/,
+    std::function<void(DisplaySyncGroup&)> const& /*remove_sync_group*/)
+    -> bool
+{
+    return false;
+}
+
 void mg::rpi::Display::configure(mg::DisplayConfiguration const& conf)
 {
     conf.for_each_output(
@@ -48,6 +48,9 @@ public:
     void for_each_display_sync_group(std::function<void(DisplaySyncGroup&)> const& f) override;
     std::unique_ptr<graphics::DisplayConfiguration> configuration() const override;
     bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const& conf) override;
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        graphics::DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& remove_sync_group) override;
     void configure(graphics::DisplayConfiguration const& conf) override;
     void register_configuration_change_handler(
         EventHandlerRegister& handlers, DisplayConfigurationChangeHandler const& conf_change_handler) override;
@@ -114,6 +114,7 @@ void mgw::BufferAllocator::bind_display(wl_display* display, std::shared_ptr<Exe
     auto dpy = eglGetCurrentDisplay();
 
     mg::wayland::bind_display(dpy, display, *egl_extensions);
+    mg::wayland::add_shm_formats(display);
 
     this->wayland_executor = std::move(wayland_executor);
 }
@@ -123,10 +124,6 @@ auto mgw::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release) -> std::shared_ptr<Buffer>
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
-
     return mg::wayland::buffer_from_resource(
         buffer,
         std::move(on_consumed),
@@ -151,6 +151,13 @@ bool mgw::Display::apply_if_configuration_preserves_display_buffers(DisplayConfi
     return false;
 }
 
+bool mgw::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    DisplayConfiguration const& /*conf*/,
+    std::function<void(DisplaySyncGroup&)> const& /*remove_sync_group*/)
+{
+    return false;
+}
+
 auto mgw::Display::last_frame_on(unsigned) const -> Frame
 {
     fatal_error(__PRETTY_FUNCTION__);
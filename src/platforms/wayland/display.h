@@ -74,6 +74,9 @@ public:
     auto configuration() const -> std::unique_ptr<DisplayConfiguration> override;
 
     bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) override;
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        DisplayConfiguration const& conf,
+        std::function<void(DisplaySyncGroup&)> const& remove_sync_group) override;
 
     void configure(DisplayConfiguration const& conf) override;
 
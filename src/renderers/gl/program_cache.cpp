@@ -0,0 +1,299 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "GLProgramCache"
+
+#include "program_cache.h"
+#include "mir/log.h"
+
+#include MIR_SERVER_GL_H
+#include MIR_SERVER_GLEXT_H
+#include <EGL/egl.h>
+
+#include <experimental/optional>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mrg = mir::renderer::gl;
+
+namespace
+{
+// Shared by GL_OES_get_program_binary and GL_ARB_get_program_binary
+GLenum const program_binary_length = 0x8741;
+GLenum const num_program_binary_formats = 0x87FE;
+// Only in GL_ARB_get_program_binary and GLES 3; GL_OES_get_program_binary has no hint
+GLenum const program_binary_retrievable_hint = 0x8257;
+
+char const file_magic[8] = {'M', 'I', 'R', 'P', 'R', 'O', 'G', '1'};
+
+struct ProgramBinaryFunctions
+{
+    void (*get_program_binary)(GLuint program, GLsizei size, GLsizei* length, GLenum* format, void* binary);
+    void (*program_binary)(GLuint program, GLenum format, void const* binary, GLint length);
+    void (*program_parameteri)(GLuint program, GLenum pname, GLint value);  // May be null
+};
+
+// Needs a current context: support depends on the driver behind it
+auto program_binary_functions() -> std::experimental::optional<ProgramBinaryFunctions>
+{
+    auto const extensions = reinterpret_cast<char const*>(glGetString(GL_EXTENSIONS));
+    if (!extensions)
+        return {};
+
+    char const* get_name;
+    char const* load_name;
+    bool has_retrievable_hint;
+    if (strstr(extensions, "GL_OES_get_program_binary"))
+    {
+        get_name = "glGetProgramBinaryOES";
+        load_name = "glProgramBinaryOES";
+
+        auto const version = reinterpret_cast<char const*>(glGetString(GL_VERSION));
+        int major = 0;
+        has_retrievable_hint = version && sscanf(version, "OpenGL ES %d", &major) == 1 && major >= 3;
+    }
+    else if (strstr(extensions, "GL_ARB_get_program_binary"))
+    {
+        get_name = "glGetProgramBinary";
+        load_name = "glProgramBinary";
+        has_retrievable_hint = true;
+    }
+    else
+    {
+        return {};
+    }
+
+    // Drivers may advertise the extension without supporting any binary format
+    GLint formats = 0;
+    glGetIntegerv(num_program_binary_formats, &formats);
+    if (formats <= 0)
+        return {};
+
+    ProgramBinaryFunctions const functions{
+        reinterpret_cast<decltype(ProgramBinaryFunctions::get_program_binary)>(eglGetProcAddress(get_name)),
+        reinterpret_cast<decltype(ProgramBinaryFunctions::program_binary)>(eglGetProcAddress(load_name)),
+        has_retrievable_hint ?
+            reinterpret_cast<decltype(ProgramBinaryFunctions::program_parameteri)>(
+                eglGetProcAddress("glProgramParameteri")) :
+            nullptr};
+
+    if (!functions.get_program_binary || !functions.program_binary)
+        return {};
+
+    return functions;
+}
+
+auto driver_description() -> std::string
+{
+    std::string result;
+    for (auto const name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+    {
+        if (auto const value = reinterpret_cast<char const*>(glGetString(name)))
+            result += value;
+        result += '\n';
+    }
+    return result;
+}
+
+void make_directories(std::string const& path)
+{
+    for (auto slash = path.find('/', 1); ; slash = path.find('/', slash + 1))
+    {
+        auto const parent = path.substr(0, slash);
+        if (mkdir(parent.c_str(), 0700) != 0 && errno != EEXIST)
+            return;
+        if (slash == std::string::npos)
+            return;
+    }
+}
+}
+
+mrg::ProgramCache::ProgramCache(std::string const& directory)
+    : directory{directory}
+{
+}
+
+auto mrg::ProgramCache::key_for(
+    std::string const& driver,
+    GLchar const* vertex_src,
+    GLchar const* fragment_src) -> std::string
+{
+    // 64 bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325;
+    auto const add = [&hash](char const* begin, char const* end)
+        {
+            for (auto p = begin; p != end; ++p)
+            {
+                hash ^= static_cast<unsigned char>(*p);
+                hash *= 0x100000001b3;
+            }
+        };
+
+    // Include the terminators, so that text can't move between the parts unnoticed
+    add(driver.c_str(), driver.c_str() + driver.size() + 1);
+    add(vertex_src, vertex_src + strlen(vertex_src) + 1);
+    add(fragment_src, fragment_src + strlen(fragment_src) + 1);
+
+    char key[17];
+    snprintf(key, sizeof key, "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+auto mrg::ProgramCache::path_for(std::string const& key) const -> std::string
+{
+    return directory + "/" + key + ".bin";
+}
+
+auto mrg::ProgramCache::find(std::string const& key) -> std::shared_ptr<Binary const>
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    auto const cached = binaries.find(key);
+    if (cached != binaries.end())
+        return cached->second;
+
+    if (directory.empty())
+        return {};
+
+    std::ifstream file{path_for(key), std::ios::binary};
+    if (!file)
+        return {};
+
+    char magic[sizeof file_magic];
+    uint32_t format;
+    if (!file.read(magic, sizeof magic) ||
+        memcmp(magic, file_magic, sizeof magic) != 0 ||
+        !file.read(reinterpret_cast<char*>(&format), sizeof format))
+    {
+        return {};
+    }
+
+    auto const binary = std::make_shared<Binary const>(Binary{
+        format,
+        std::vector<char>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}});
+
+    if (binary->data.empty())
+        return {};
+
+    binaries[key] = binary;
+    return binary;
+}
+
+void mrg::ProgramCache::insert(std::string const& key, Binary binary)
+{
+    auto const shared = std::make_shared<Binary const>(std::move(binary));
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    binaries[key] = shared;
+
+    if (directory.empty())
+        return;
+
+    make_directories(directory);
+
+    // Write to a temporary and rename, so a concurrent server never reads a partial file
+    auto const path = path_for(key);
+    auto const temporary = path + "." + std::to_string(getpid());
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        uint32_t const format = shared->format;
+        file.write(file_magic, sizeof file_magic);
+        file.write(reinterpret_cast<char const*>(&format), sizeof format);
+        file.write(shared->data.data(), shared->data.size());
+
+        if (!file.flush())
+        {
+            mir::log_debug("Failed to write GL program cache file %s", temporary.c_str());
+            file.close();
+            unlink(temporary.c_str());
+            return;
+        }
+    }
+
+    if (rename(temporary.c_str(), path.c_str()) != 0)
+        unlink(temporary.c_str());
+}
+
+void mrg::ProgramCache::erase(std::string const& key)
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    binaries.erase(key);
+
+    if (!directory.empty())
+        unlink(path_for(key).c_str());
+}
+
+auto mrg::ProgramCache::load(GLchar const* vertex_src, GLchar const* fragment_src) -> GLuint
+{
+    auto const functions = program_binary_functions();
+    if (!functions)
+        return 0;
+
+    auto const key = key_for(driver_description(), vertex_src, fragment_src);
+    auto const binary = find(key);
+    if (!binary)
+        return 0;
+
+    auto const program = glCreateProgram();
+    functions->program_binary(program, binary->format, binary->data.data(), binary->data.size());
+
+    // Drivers may reject binaries from other builds even if they report the same version
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        glDeleteProgram(program);
+        erase(key);
+        return 0;
+    }
+
+    return program;
+}
+
+void mrg::ProgramCache::prepare_to_link(GLuint program)
+{
+    auto const functions = program_binary_functions();
+    if (functions && functions->program_parameteri)
+        functions->program_parameteri(program, program_binary_retrievable_hint, GL_TRUE);
+}
+
+void mrg::ProgramCache::store(GLuint program, GLchar const* vertex_src, GLchar const* fragment_src)
+{
+    auto const functions = program_binary_functions();
+    if (!functions)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, program_binary_length, &length);
+    if (length <= 0)
+        return;
+
+    Binary binary{0, std::vector<char>(length)};
+    GLsizei written = 0;
+    functions->get_program_binary(program, length, &written, &binary.format, binary.data.data());
+    if (written <= 0)
+        return;
+
+    binary.data.resize(written);
+    insert(key_for(driver_description(), vertex_src, fragment_src), std::move(binary));
+}
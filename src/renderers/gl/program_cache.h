@@ -0,0 +1,95 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_PROGRAM_CACHE_H_
+#define MIR_RENDERER_GL_PROGRAM_CACHE_H_
+
+#include MIR_SERVER_GL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+
+/**
+ * Linked GL programs, kept as driver-specific binaries (GL_OES_get_program_binary
+ * or GL_ARB_get_program_binary) so that later renderers, and later runs of the
+ * server, can skip compiling and linking shaders.
+ *
+ * Binaries are keyed by a hash of the GL vendor, renderer and version strings and
+ * the shader sources, so a driver update or shader change simply misses the cache.
+ * They are shared in memory between the renderers given the same cache and, unless
+ * disabled, persisted as one file per program in a cache directory.
+ */
+class ProgramCache
+{
+public:
+    struct Binary
+    {
+        GLenum format;
+        std::vector<char> data;
+    };
+
+    /**
+     * \param [in] directory    Where binaries are persisted. Empty to keep them in memory only.
+     */
+    explicit ProgramCache(std::string const& directory);
+
+    /**
+     * Creates a linked program from a cached binary, if there is one that the current
+     * context accepts. Needs a current GL context.
+     *
+     * \return The program, or 0 if it needs to be built from source
+     */
+    auto load(GLchar const* vertex_src, GLchar const* fragment_src) -> GLuint;
+
+    /**
+     * Asks the driver to keep the program retrievable as a binary, on drivers that need
+     * asking. Needs a current GL context, and must be called before the program is linked.
+     */
+    void prepare_to_link(GLuint program);
+
+    /// Saves a successfully linked program. Needs a current GL context.
+    void store(GLuint program, GLchar const* vertex_src, GLchar const* fragment_src);
+
+    // The GL independent part: binaries by key
+    static auto key_for(std::string const& driver, GLchar const* vertex_src, GLchar const* fragment_src) -> std::string;
+    auto find(std::string const& key) -> std::shared_ptr<Binary const>;
+    void insert(std::string const& key, Binary binary);
+    void erase(std::string const& key);
+
+private:
+    auto path_for(std::string const& key) const -> std::string;
+
+    std::string const directory;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Binary const>> binaries;
+};
+
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_PROGRAM_CACHE_H_
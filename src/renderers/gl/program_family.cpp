@@ -17,6 +17,7 @@
  */
 
 #include "program_family.h"
+#include "program_cache.h"
 #include MIR_SERVER_GL_H
 #include MIR_SERVER_GLEXT_H
 #include <mutex>
@@ -53,6 +54,11 @@ void ProgramFamily::Shader::init(GLenum type, const GLchar* src)
     }
 }
 
+ProgramFamily::ProgramFamily(std::shared_ptr<ProgramCache> const& cache)
+    : cache{cache}
+{
+}
+
 ProgramFamily::~ProgramFamily() noexcept
 {
     // shader and program lifetimes are managed manually, so that we don't
@@ -89,18 +95,22 @@ GLuint ProgramFamily::add_program(const GLchar* const vshader_src,
     static std::mutex lp1416482_mutex;
     std::lock_guard<decltype(lp1416482_mutex)> lock{lp1416482_mutex};
 
-    auto& v = vshader[vshader_src];
-    if (!v.id) v.init(GL_VERTEX_SHADER, vshader_src);
-
-    auto& f = fshader[fshader_src];
-    if (!f.id) f.init(GL_FRAGMENT_SHADER, fshader_src);
+    auto& p = program[{vshader_src, fshader_src}];
+    if (!p.id && cache)
+        p.id = cache->load(vshader_src, fshader_src);
 
-    auto& p = program[{v.id, f.id}];
     if (!p.id)
     {
+        auto& v = vshader[vshader_src];
+        if (!v.id) v.init(GL_VERTEX_SHADER, vshader_src);
+
+        auto& f = fshader[fshader_src];
+        if (!f.id) f.init(GL_FRAGMENT_SHADER, fshader_src);
+
         p.id = glCreateProgram();
         glAttachShader(p.id, v.id);
         glAttachShader(p.id, f.id);
+        if (cache) cache->prepare_to_link(p.id);
         glLinkProgram(p.id);
         GLint ok;
         glGetProgramiv(p.id, GL_LINK_STATUS, &ok);
@@ -113,6 +123,8 @@ GLuint ProgramFamily::add_program(const GLchar* const vshader_src,
             p.id = 0;
             throw std::runtime_error(std::string("Link failed: ")+log);
         }
+
+        if (cache) cache->store(p.id, vshader_src, fshader_src);
     }
 
     return p.id;
@@ -22,6 +22,7 @@
 #include MIR_SERVER_GL_H
 #include <utility>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 namespace mir
@@ -30,6 +31,7 @@ namespace renderer
 {
 namespace gl
 {
+class ProgramCache;
 
 /**
  * ProgramFamily represents a set of GLSL programs that are closely
@@ -43,6 +45,8 @@ class ProgramFamily
 {
 public:
     ProgramFamily() = default;
+    /// \param [in] cache  Where linked programs are looked up and saved. May be null.
+    explicit ProgramFamily(std::shared_ptr<ProgramCache> const& cache);
     ProgramFamily(ProgramFamily const&) = delete;
     ProgramFamily& operator=(ProgramFamily const&) = delete;
     ~ProgramFamily() noexcept;
@@ -51,6 +55,8 @@ public:
                        const GLchar* const static_fshader_src);
 
 private:
+    std::shared_ptr<ProgramCache> const cache;
+
     struct Shader
     {
         GLuint id = 0;
@@ -59,12 +65,13 @@ private:
     typedef std::unordered_map<const GLchar*, Shader> ShaderMap;
     ShaderMap vshader, fshader;
 
-    typedef std::pair<GLuint, GLuint> ShaderPair;
+    // Programs may come from the ProgramCache, without compiling any shaders
+    typedef std::pair<const GLchar*, const GLchar*> SourcePair;
     struct Program
     {
         GLuint id = 0;
     };
-    std::map<ShaderPair, Program> program;
+    std::map<SourcePair, Program> program;
 };
 
 }
@@ -19,6 +19,7 @@
 #define MIR_LOG_COMPONENT "GLRenderer"
 
 #include "renderer.h"
+#include "program_cache.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/gl/default_program_factory.h"
 #include "mir/graphics/renderable.h"
@@ -150,6 +151,16 @@ public:
         from.id = 0;
     }
 
+    GLHandle& operator=(GLHandle&& from)
+    {
+        if (id)
+            (*deleter)(id);
+
+        id = from.id;
+        from.id = 0;
+        return *this;
+    }
+
     operator GLuint() const
     {
         return id;
@@ -198,9 +209,8 @@ const GLchar* const vertex_shader_src =
 class mrg::Renderer::ProgramFactory : public mir::graphics::gl::ProgramFactory
 {
 public:
-    // NOTE: This must be called with a current GL context
-    ProgramFactory()
-        : vertex_shader{compile_shader(GL_VERTEX_SHADER, vertex_shader_src)}
+    explicit ProgramFactory(std::shared_ptr<ProgramCache> const& cache)
+        : cache{cache}
     {
     }
 
@@ -247,20 +257,33 @@ public:
         // GL shader compilation is *not* threadsafe, and requires external synchronisation
         std::lock_guard<std::mutex> lock{compilation_mutex};
 
-        ShaderHandle const opaque_shader{
-            compile_shader(GL_FRAGMENT_SHADER, opaque_fragment.str().c_str())};
-        ShaderHandle const alpha_shader{
-            compile_shader(GL_FRAGMENT_SHADER, alpha_fragment.str().c_str())};
-
         return std::make_unique<::Program>(
-            link_shader(vertex_shader, opaque_shader),
-            link_shader(vertex_shader, alpha_shader));
-
-        // We delete opaque_shader and alpha_shader here. This is fine; it only marks them
-        // for deletion. GL will only delete them once the GL Program they're linked in is destroyed.
+            build_program(opaque_fragment.str().c_str()),
+            build_program(alpha_fragment.str().c_str()));
     }
 
 private:
+    // NOTE: This must be called with a current GL context and compilation_mutex held
+    ProgramHandle build_program(GLchar const* fragment_src)
+    {
+        if (cache)
+        {
+            if (auto const cached = cache->load(vertex_shader_src, fragment_src))
+                return ProgramHandle{cached};
+        }
+
+        if (!vertex_shader)
+            vertex_shader = ShaderHandle{compile_shader(GL_VERTEX_SHADER, vertex_shader_src)};
+
+        ShaderHandle const fragment_shader{compile_shader(GL_FRAGMENT_SHADER, fragment_src)};
+        auto program = link_shader(vertex_shader, fragment_shader, cache.get());
+        if (cache) cache->store(program, vertex_shader_src, fragment_src);
+        return program;
+
+        // We delete fragment_shader here. This is fine; it only marks it for deletion.
+        // GL will only delete it once the GL Program it's linked in is destroyed.
+    }
+
     static GLuint compile_shader(GLenum type, GLchar const* src)
     {
         GLuint id = glCreateShader(type);
@@ -288,11 +311,13 @@ private:
 
     static ProgramHandle link_shader(
         ShaderHandle const& vertex_shader,
-        ShaderHandle const& fragment_shader)
+        ShaderHandle const& fragment_shader,
+        ProgramCache* cache)
     {
         ProgramHandle program{glCreateProgram()};
         glAttachShader(program, fragment_shader);
         glAttachShader(program, vertex_shader);
+        if (cache) cache->prepare_to_link(program);
         glLinkProgram(program);
         GLint ok;
         glGetProgramiv(program, GL_LINK_STATUS, &ok);
@@ -309,7 +334,9 @@ private:
         return program;
     }
 
-    ShaderHandle const vertex_shader;
+    std::shared_ptr<ProgramCache> const cache;
+    // Only compiled if a program isn't in the cache
+    ShaderHandle vertex_shader{0};
     // GL requires us to synchronise multi-threaded access to the shader APIs.
     std::mutex compilation_mutex;
 };
@@ -335,11 +362,19 @@ mrg::Renderer::Program::Program(GLuint program_id)
 }
 
 mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
+    : Renderer(display_buffer, nullptr)
+{
+}
+
+mrg::Renderer::Renderer(
+    graphics::DisplayBuffer& display_buffer,
+    std::shared_ptr<ProgramCache> const& program_cache)
     : render_target(&display_buffer),
       clear_color{0.0f, 0.0f, 0.0f, 0.0f},
+      family{program_cache},
       default_program(family.add_program(vshader, default_fshader)),
       alpha_program(family.add_program(vshader, alpha_fshader)),
-      program_factory{std::make_unique<ProgramFactory>()},
+      program_factory{std::make_unique<ProgramFactory>(program_cache)},
       texture_cache(mgl::DefaultProgramFactory().create_texture_cache()),
       display_transform(1)
 {
@@ -60,6 +60,8 @@ class Renderer : public renderer::Renderer
 {
 public:
     Renderer(graphics::DisplayBuffer& display_buffer);
+    /// \param [in] program_cache  Where linked shader programs are looked up and saved. May be null.
+    Renderer(graphics::DisplayBuffer& display_buffer, std::shared_ptr<ProgramCache> const& program_cache);
     virtual ~Renderer();
 
     // These are called with a valid GL context:
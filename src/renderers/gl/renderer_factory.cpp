@@ -18,13 +18,23 @@
 
 #include "renderer_factory.h"
 #include "renderer.h"
+#include "program_cache.h"
 #include "mir/graphics/display_buffer.h"
 
 namespace mrg = mir::renderer::gl;
 
+mrg::RendererFactory::RendererFactory() = default;
+
+mrg::RendererFactory::RendererFactory(std::string const& program_cache_directory)
+    : program_cache{std::make_shared<ProgramCache>(program_cache_directory)}
+{
+}
+
+mrg::RendererFactory::~RendererFactory() = default;
+
 std::unique_ptr<mir::renderer::Renderer>
 mrg::RendererFactory::create_renderer_for(
     graphics::DisplayBuffer& display_buffer)
 {
-    return std::make_unique<Renderer>(display_buffer);
+    return std::make_unique<Renderer>(display_buffer, program_cache);
 }
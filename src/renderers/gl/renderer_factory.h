@@ -21,18 +21,32 @@
 
 #include "mir/renderer/renderer_factory.h"
 
+#include <memory>
+#include <string>
+
 namespace mir
 {
 namespace renderer
 {
 namespace gl
 {
+class ProgramCache;
 
 class RendererFactory : public renderer::RendererFactory
 {
 public:
+    RendererFactory();
+
+    /// Renderers share linked shader programs, which are kept in \a program_cache_directory
+    explicit RendererFactory(std::string const& program_cache_directory);
+
+    ~RendererFactory();
+
     std::unique_ptr<renderer::Renderer> create_renderer_for(
         graphics::DisplayBuffer& display_buffer) override;
+
+private:
+    std::shared_ptr<ProgramCache> const program_cache;
 };
 
 }
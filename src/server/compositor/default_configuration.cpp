@@ -86,8 +86,14 @@ mir::DefaultServerConfiguration::the_compositor()
 std::shared_ptr<mir::renderer::RendererFactory> mir::DefaultServerConfiguration::the_renderer_factory()
 {
     return renderer_factory(
-        []()
+        [this]()
         {
+            if (the_options()->is_set(options::gl_program_cache_opt))
+            {
+                return std::make_shared<mir::renderer::gl::RendererFactory>(
+                    the_options()->get<std::string>(options::gl_program_cache_opt));
+            }
+
             return std::make_shared<mir::renderer::gl::RendererFactory>();
         });
 }
@@ -29,8 +29,10 @@ namespace mc = mir::compositor;
 namespace mf = mir::frontend;
 
 mc::MultiMonitorArbiter::MultiMonitorArbiter(
-    std::shared_ptr<Schedule> const& schedule) :
-    schedule(schedule)
+    std::shared_ptr<Schedule> const& schedule,
+    Delivery delivery) :
+    schedule(schedule),
+    delivery(delivery)
 {
     // We're highly unlikely to have more than 6 outputs
     current_buffer_users.reserve(6);
@@ -44,13 +46,14 @@ std::shared_ptr<mg::Buffer> mc::MultiMonitorArbiter::compositor_acquire(composit
 {
     std::lock_guard<decltype(mutex)> lk(mutex);
 
-    // If there is no current buffer or there is, but this compositor is already using it...
-    if (!current_buffer || is_user_of_current_buffer(id))
+    // If there is no current buffer, or there is but this compositor is already using it,
+    // or every compositor is to get the newest buffer...
+    if (!current_buffer || is_user_of_current_buffer(id) || delivery == Delivery::mailbox)
     {
         // And if there is a scheduled buffer
         if (schedule->num_scheduled() > 0)
         {
-            // Advance the current buffer
+            // Advance the current buffer, releasing the old one once no compositor is showing it
             current_buffer = schedule->next_buffer();
             clear_current_users();
         }
@@ -93,6 +96,12 @@ void mc::MultiMonitorArbiter::set_schedule(std::shared_ptr<Schedule> const& new_
     schedule = new_schedule;
 }
 
+void mc::MultiMonitorArbiter::set_delivery(Delivery new_delivery)
+{
+    std::lock_guard<decltype(mutex)> lk(mutex);
+    delivery = new_delivery;
+}
+
 bool mc::MultiMonitorArbiter::buffer_ready_for(mc::CompositorID id)
 {
     std::lock_guard<decltype(mutex)> lk(mutex);
@@ -37,13 +37,29 @@ class Schedule;
 class MultiMonitorArbiter : public BufferAcquisition 
 {
 public:
+    /// How the buffers of the schedule are shared between compositors
+    enum class Delivery
+    {
+        /// A new buffer is taken from the schedule only once the compositor asking has
+        /// used the current one, so the fastest compositor paces the schedule and the
+        /// others see whatever it last took.
+        lockstep,
+        /// Each compositor is given the newest buffer scheduled when it asks, so every
+        /// output shows the latest frame at its own rate. Only sensible with a schedule
+        /// that drops frames, as one that queues them would have the fastest compositor
+        /// consume the queue.
+        mailbox
+    };
+
     MultiMonitorArbiter(
-        std::shared_ptr<Schedule> const& schedule);
+        std::shared_ptr<Schedule> const& schedule,
+        Delivery delivery = Delivery::lockstep);
     ~MultiMonitorArbiter();
 
     std::shared_ptr<graphics::Buffer> compositor_acquire(compositor::CompositorID id) override;
     std::shared_ptr<graphics::Buffer> snapshot_acquire() override;
     void set_schedule(std::shared_ptr<Schedule> const& schedule);
+    void set_delivery(Delivery delivery);
     bool buffer_ready_for(compositor::CompositorID id);
     void advance_schedule();
 
@@ -56,6 +72,7 @@ private:
     std::shared_ptr<graphics::Buffer> current_buffer;
     std::vector<std::experimental::optional<compositor::CompositorID>> current_buffer_users;
     std::shared_ptr<Schedule> schedule;
+    Delivery delivery;
 };
 
 }
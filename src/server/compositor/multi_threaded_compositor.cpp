@@ -29,9 +29,11 @@
 #include "mir/scene/surface.h"
 #include "mir/terminate_with_current_exception.h"
 #include "mir/raii.h"
+#include "mir/startup_timeline.h"
 #include "mir/unwind_helpers.h"
 #include "mir/thread_name.h"
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <condition_variable>
@@ -141,6 +143,7 @@ public:
                         compositor->composite(scene->scene_elements_for(compositor.get()));
                     }
                     group.post();
+                    startup_timeline::first_frame_posted();
 
                     /*
                      * "Predictive bypass" optimization: If the last frame was
@@ -222,6 +225,11 @@ public:
         run_cv.notify_one();
     }
 
+    bool composites(mg::DisplaySyncGroup const& candidate) const
+    {
+        return &group == &candidate;
+    }
+
     void wait_until_started()
     {
         if (started_future.wait_for(10s) != std::future_status::ready)
@@ -286,6 +294,7 @@ mc::MultiThreadedCompositor::~MultiThreadedCompositor()
 void mc::MultiThreadedCompositor::schedule_compositing(int num)
 {
     report->scheduled();
+    std::lock_guard<std::mutex> lock{thread_functors_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing(num);
 }
@@ -293,6 +302,7 @@ void mc::MultiThreadedCompositor::schedule_compositing(int num)
 void mc::MultiThreadedCompositor::schedule_compositing(int num, geometry::Rectangle const& damage) const
 {
     report->scheduled();
+    std::lock_guard<std::mutex> lock{thread_functors_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing(num, damage);
 }
@@ -361,17 +371,72 @@ void mc::MultiThreadedCompositor::stop()
     state = CompositorState::stopped;
 }
 
+void mc::MultiThreadedCompositor::remove_display_sync_group(mg::DisplaySyncGroup& group)
+{
+    if (state != CompositorState::started)
+        return;
+
+    std::unique_ptr<CompositingFunctor> thread_functor;
+    std::future<void> future;
+    {
+        std::lock_guard<std::mutex> lock{thread_functors_mutex};
+        for (auto i = 0u; i != thread_functors.size(); ++i)
+        {
+            if (thread_functors[i]->composites(group))
+            {
+                thread_functor = std::move(thread_functors[i]);
+                future = std::move(futures[i]);
+
+                thread_functors.erase(thread_functors.begin() + i);
+                futures.erase(futures.begin() + i);
+                break;
+            }
+        }
+    }
+
+    if (thread_functor)
+    {
+        thread_functor->stop();
+        future.wait();
+    }
+}
+
+void mc::MultiThreadedCompositor::add_new_display_sync_groups()
+{
+    if (state != CompositorState::started)
+        return;
+
+    std::vector<CompositingFunctor*> new_thread_functors;
+
+    display->for_each_display_sync_group([this, &new_thread_functors](mg::DisplaySyncGroup& group)
+    {
+        {
+            std::lock_guard<std::mutex> lock{thread_functors_mutex};
+            if (std::any_of(thread_functors.begin(), thread_functors.end(),
+                            [&](auto const& functor) { return functor->composites(group); }))
+                return;
+        }
+
+        new_thread_functors.push_back(create_compositing_thread_for(group));
+    });
+
+    thread_pool.shrink();
+
+    for (auto const functor : new_thread_functors)
+    {
+        functor->wait_until_started();
+
+        // Nothing has been drawn on the new outputs yet
+        functor->schedule_compositing(1);
+    }
+}
+
 void mc::MultiThreadedCompositor::create_compositing_threads()
 {
     /* Start the display buffer compositing threads */
     display->for_each_display_sync_group([this](mg::DisplaySyncGroup& group)
     {
-        auto thread_functor = std::make_unique<mc::CompositingFunctor>(
-            display_buffer_compositor_factory, group, scene, display_listener,
-            fixed_composite_delay, report);
-
-        futures.push_back(thread_pool.run(std::ref(*thread_functor), &group));
-        thread_functors.push_back(std::move(thread_functor));
+        create_compositing_thread_for(group);
     });
 
     thread_pool.shrink();
@@ -380,6 +445,20 @@ void mc::MultiThreadedCompositor::create_compositing_threads()
         functor->wait_until_started();
 }
 
+auto mc::MultiThreadedCompositor::create_compositing_thread_for(
+    mg::DisplaySyncGroup& group) -> CompositingFunctor*
+{
+    auto thread_functor = std::make_unique<mc::CompositingFunctor>(
+        display_buffer_compositor_factory, group, scene, display_listener,
+        fixed_composite_delay, report);
+    auto const result = thread_functor.get();
+
+    std::lock_guard<std::mutex> lock{thread_functors_mutex};
+    futures.push_back(thread_pool.run(std::ref(*thread_functor), &group));
+    thread_functors.push_back(std::move(thread_functor));
+    return result;
+}
+
 void mc::MultiThreadedCompositor::destroy_compositing_threads()
 {
     for (auto& f : thread_functors)
@@ -388,6 +467,7 @@ void mc::MultiThreadedCompositor::destroy_compositing_threads()
     for (auto& f : futures)
         f.wait();
 
+    std::lock_guard<std::mutex> lock{thread_functors_mutex};
     thread_functors.clear();
     futures.clear();
 }
@@ -35,6 +35,7 @@ namespace geometry { struct Rectangle; }
 namespace graphics
 {
 class Display;
+class DisplaySyncGroup;
 }
 namespace scene
 {
@@ -74,9 +75,13 @@ public:
     void start();
     void stop();
 
+    void remove_display_sync_group(graphics::DisplaySyncGroup& group) override;
+    void add_new_display_sync_groups() override;
+
 private:
     void create_compositing_threads();
     void destroy_compositing_threads();
+    auto create_compositing_thread_for(graphics::DisplaySyncGroup& group) -> CompositingFunctor*;
 
     std::shared_ptr<graphics::Display> const display;
     std::shared_ptr<Scene> const scene;
@@ -84,6 +89,7 @@ private:
     std::shared_ptr<DisplayListener> const display_listener;
     std::shared_ptr<CompositorReport> const report;
 
+    std::mutex mutable thread_functors_mutex;
     std::vector<std::unique_ptr<CompositingFunctor>> thread_functors;
     std::vector<std::future<void>> futures;
 
@@ -102,10 +102,12 @@ void mc::Stream::allow_framedropping(bool dropping)
     if (dropping && schedule_mode == ScheduleMode::Queueing)
     {
         transition_schedule(std::make_shared<mc::DroppingSchedule>(), lk);
+        arbiter->set_delivery(MultiMonitorArbiter::Delivery::mailbox);
         schedule_mode = ScheduleMode::Dropping;
     }
     else if (!dropping && schedule_mode == ScheduleMode::Dropping)
     {
+        arbiter->set_delivery(MultiMonitorArbiter::Delivery::lockstep);
         transition_schedule(std::make_shared<mc::QueueingSchedule>(), lk);
         schedule_mode = ScheduleMode::Queueing;
     }
@@ -23,6 +23,7 @@
 #include "mir/main_loop.h"
 #include "mir/server_status_listener.h"
 #include "mir/display_changer.h"
+#include "mir/startup_timeline.h"
 
 #include "mir/compositor/compositor.h"
 #include "mir/frontend/connector.h"
@@ -225,12 +226,14 @@ void mir::DisplayServer::run()
     auto const& server = *p.load();
 
     server.compositor->start();
+    startup_timeline::phase_completed("Compositor started");
     server.input_manager->start();
     server.input_dispatcher->start();
     server.prompt_connector->start();
     server.connector->start();
     server.wayland_connector->start();
     server.xwayland_connector->start();
+    startup_timeline::phase_completed("Input and connectors started");
 
     server.server_status_listener->started();
 
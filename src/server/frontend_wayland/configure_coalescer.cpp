@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "configure_coalescer.h"
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+
+mf::ConfigureCoalescer::ConfigureCoalescer(
+    Schedule const& schedule,
+    StateChanged const& state_changed,
+    Resized const& resized)
+    : schedule{schedule},
+      state_changed{state_changed},
+      resized{resized},
+      window_size{0, 0}
+{
+}
+
+void mf::ConfigureCoalescer::state_changed_to(MirWindowState state)
+{
+    update_pending([state](Pending& pending)
+        {
+            pending.state = state;
+        });
+}
+
+void mf::ConfigureCoalescer::resized_to(geom::Size const& size)
+{
+    update_pending([size](Pending& pending)
+        {
+            pending.size = size;
+        });
+}
+
+void mf::ConfigureCoalescer::placed_at(geom::Rectangle const& placement)
+{
+    update_pending([placement](Pending& pending)
+        {
+            pending.top_left = placement.top_left;
+            pending.size = placement.size;
+        });
+}
+
+void mf::ConfigureCoalescer::latest_client_size(geom::Size window_size)
+{
+    this->window_size = window_size;
+}
+
+auto mf::ConfigureCoalescer::requested_window_size() const -> std::experimental::optional<geom::Size>
+{
+    return requested_size;
+}
+
+auto mf::ConfigureCoalescer::state() const -> MirWindowState
+{
+    return current_state;
+}
+
+void mf::ConfigureCoalescer::update_pending(std::function<void(Pending&)> const& update)
+{
+    std::lock_guard<std::mutex> lock{pending_mutex};
+    update(pending);
+
+    if (!send_scheduled)
+    {
+        send_scheduled = true;
+        schedule([this]() { send_pending(); });
+    }
+}
+
+void mf::ConfigureCoalescer::send_pending()
+{
+    Pending configure;
+    {
+        std::lock_guard<std::mutex> lock{pending_mutex};
+        std::swap(configure, pending);
+        send_scheduled = false;
+    }
+
+    if (configure.state)
+        current_state = configure.state.value();
+
+    // A resize configure carries the latest state too, so at most one configure is sent
+    if (configure.size && (configure.top_left || configure.size.value() != window_size))
+    {
+        requested_size = configure.size;
+        resized(configure.top_left, configure.size.value());
+    }
+    else if (configure.state)
+    {
+        state_changed(current_state);
+    }
+}
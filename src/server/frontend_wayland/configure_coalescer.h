@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_CONFIGURE_COALESCER_H_
+#define MIR_FRONTEND_CONFIGURE_COALESCER_H_
+
+#include "mir/geometry/rectangle.h"
+#include "mir_toolkit/common.h"
+
+#include <experimental/optional>
+#include <functional>
+#include <mutex>
+
+namespace mir
+{
+namespace frontend
+{
+/**
+ * Collects the state and size changes Mir makes to a window, so that those made before the Wayland thread
+ * catches up are sent to the client as a single configure.
+ *
+ * Changes may be made on any thread. The configure is sent by work given to schedule, which must run on the
+ * Wayland thread (as must latest_client_size(), requested_window_size() and state()).
+ */
+class ConfigureCoalescer
+{
+public:
+    using Schedule = std::function<void(std::function<void()>&& work)>;
+    using StateChanged = std::function<void(MirWindowState new_state)>;
+    using Resized = std::function<void(
+        std::experimental::optional<geometry::Point> const& new_top_left,
+        geometry::Size const& new_size)>;
+
+    ConfigureCoalescer(Schedule const& schedule, StateChanged const& state_changed, Resized const& resized);
+
+    void state_changed_to(MirWindowState state);
+    void resized_to(geometry::Size const& size);
+    void placed_at(geometry::Rectangle const& placement);
+
+    void latest_client_size(geometry::Size window_size);
+    auto requested_window_size() const -> std::experimental::optional<geometry::Size>;
+    auto state() const -> MirWindowState;
+
+private:
+    struct Pending
+    {
+        std::experimental::optional<MirWindowState> state;
+        std::experimental::optional<geometry::Point> top_left;
+        std::experimental::optional<geometry::Size> size;
+    };
+
+    Schedule const schedule;
+    StateChanged const state_changed;
+    Resized const resized;
+
+    geometry::Size window_size;
+    std::experimental::optional<geometry::Size> requested_size;
+    MirWindowState current_state{mir_window_state_unknown};
+
+    std::mutex pending_mutex;
+    Pending pending;
+    bool send_scheduled{false};
+
+    void update_pending(std::function<void(Pending&)> const& update);
+    void send_pending();
+};
+}
+}
+
+#endif // MIR_FRONTEND_CONFIGURE_COALESCER_H_
@@ -27,12 +27,16 @@
 #include "xwayland_wm_shell.h"
 #include "mir_display.h"
 #include "wl_seat.h"
+#include "wayland_request_profile.h"
 #include "xdg-output-unstable-v1_wrapper.h"
 
 #include "mir/graphics/platform.h"
+#include "mir/main_loop.h"
 #include "mir/options/default_configuration.h"
 #include "mir/scene/session.h"
 
+#include <csignal>
+
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
 namespace msh = mir::shell;
@@ -151,6 +155,13 @@ std::shared_ptr<mf::Connector>
                 the_frontend_display_changer(),
                 the_display_configuration_observer_registrar());
 
+            if (options->is_set(mo::wayland_request_profile_opt))
+            {
+                auto const profile = std::make_shared<mf::WaylandRequestProfile>();
+                mw::set_request_report(profile);
+                the_main_loop()->register_signal_handler({SIGUSR2}, [profile](int) { profile->dump(); });
+            }
+
             return std::make_shared<mf::WaylandConnector>(
                 the_shell(),
                 display_config,
@@ -0,0 +1,160 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "frontend:Wayland"
+
+#include "wayland_request_profile.h"
+#include "mir/log.h"
+
+#include <wayland-server-core.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace mf = mir::frontend;
+
+namespace
+{
+auto process_name_of(pid_t pid) -> std::string
+{
+    std::string name;
+    std::ifstream comm{"/proc/" + std::to_string(pid) + "/comm"};
+    std::getline(comm, name);
+    return name.empty() ? "unknown" : name;
+}
+
+auto microseconds(mf::WaylandRequestProfile::Duration duration) -> double
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+auto by_total_time = [](auto const& a, auto const& b) { return a.handling.total > b.handling.total; };
+}
+
+void mf::WaylandRequestProfile::Histogram::add(Duration handling_time)
+{
+    ++count;
+    total += handling_time;
+    max = std::max(max, handling_time);
+
+    size_t bucket = 0;
+    while (bucket + 1 < bucket_count && handling_time >= bucket_limit(bucket))
+        ++bucket;
+    ++buckets[bucket];
+}
+
+auto mf::WaylandRequestProfile::Histogram::bucket_limit(size_t bucket) -> Duration
+{
+    return std::chrono::microseconds{1ll << bucket};
+}
+
+auto mf::WaylandRequestProfile::Histogram::percentile(double fraction) const -> Duration
+{
+    auto const wanted = static_cast<uint64_t>(fraction * count + 0.5);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket + 1 < bucket_count; ++bucket)
+    {
+        seen += buckets[bucket];
+        if (seen >= wanted)
+            return std::min(bucket_limit(bucket), max);
+    }
+    return max;
+}
+
+void mf::WaylandRequestProfile::request_handled(
+    wl_client* client,
+    char const* interface_name,
+    uint32_t opcode,
+    char const* request_name,
+    Duration handling_time)
+{
+    pid_t pid = 0;
+    wl_client_get_credentials(client, &pid, nullptr, nullptr);
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+
+    auto entry = entries.find(pid);
+    if (entry == entries.end())
+        entry = entries.emplace(pid, ClientEntry{process_name_of(pid), {}, {}}).first;
+
+    entry->second.handling.add(handling_time);
+
+    auto& request = entry->second.requests[RequestKey{interface_name, opcode}];
+    request.first = request_name;
+    request.second.add(handling_time);
+}
+
+auto mf::WaylandRequestProfile::clients() const -> std::vector<ClientProfile>
+{
+    std::vector<ClientProfile> result;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        for (auto const& entry : entries)
+        {
+            ClientProfile client{entry.first, entry.second.process_name, entry.second.handling, {}};
+            for (auto const& request : entry.second.requests)
+            {
+                client.requests.push_back(
+                    {request.first.first, request.first.second, request.second.first, request.second.second});
+            }
+            std::sort(client.requests.begin(), client.requests.end(), by_total_time);
+            result.push_back(std::move(client));
+        }
+    }
+
+    std::sort(result.begin(), result.end(), by_total_time);
+    return result;
+}
+
+void mf::WaylandRequestProfile::dump() const
+{
+    auto const profile = clients();
+
+    Duration total{0};
+    for (auto const& client : profile)
+        total += client.handling.total;
+
+    mir::log_info("Wayland request profile: %zu clients, %.3fms handling requests",
+                  profile.size(), microseconds(total) / 1000);
+
+    for (auto const& client : profile)
+    {
+        mir::log_info(
+            "  %s (pid %d): %llu requests, %.3fms (%.1f%%), max %.1fµs",
+            client.process_name.c_str(),
+            client.pid,
+            static_cast<unsigned long long>(client.handling.count),
+            microseconds(client.handling.total) / 1000,
+            total.count() ? 100.0 * client.handling.total.count() / total.count() : 0.0,
+            microseconds(client.handling.max));
+
+        for (auto const& request : client.requests)
+        {
+            mir::log_info(
+                "    %s.%s (opcode %u): %llu requests, %.3fms, "
+                "mean %.1fµs, p50 %.0fµs, p99 %.0fµs, max %.1fµs",
+                request.interface_name.c_str(),
+                request.request_name.c_str(),
+                request.opcode,
+                static_cast<unsigned long long>(request.handling.count),
+                microseconds(request.handling.total) / 1000,
+                microseconds(request.handling.total) / request.handling.count,
+                microseconds(request.handling.percentile(0.5)),
+                microseconds(request.handling.percentile(0.99)),
+                microseconds(request.handling.max));
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_WAYLAND_REQUEST_PROFILE_H_
+#define MIR_FRONTEND_WAYLAND_REQUEST_PROFILE_H_
+
+#include "mir/wayland/wayland_base.h"
+
+#include <sys/types.h>
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace frontend
+{
+/**
+ * Accumulates how much of the Wayland thread's time each client's requests take,
+ * by interface and request, so that clients monopolising the frontend can be found.
+ *
+ * Clients are identified by process, so all connections of a process are combined.
+ */
+class WaylandRequestProfile : public wayland::RequestReport
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    /// Handling times, in buckets of doubling width: [0, 1µs), [1µs, 2µs), [2µs, 4µs)...
+    struct Histogram
+    {
+        static size_t const bucket_count = 20;
+
+        uint64_t count{0};
+        Duration total{0};
+        Duration max{0};
+        std::array<uint64_t, bucket_count> buckets{};
+
+        void add(Duration handling_time);
+
+        /// Upper bound of the bucket containing the given fraction of requests
+        auto percentile(double fraction) const -> Duration;
+        static auto bucket_limit(size_t bucket) -> Duration;
+    };
+
+    struct RequestProfile
+    {
+        std::string interface_name;
+        uint32_t opcode;
+        std::string request_name;
+        Histogram handling;
+    };
+
+    struct ClientProfile
+    {
+        pid_t pid;
+        std::string process_name;
+        Histogram handling;
+        std::vector<RequestProfile> requests;   ///< Most time consuming first
+    };
+
+    void request_handled(
+        wl_client* client,
+        char const* interface_name,
+        uint32_t opcode,
+        char const* request_name,
+        Duration handling_time) override;
+
+    /// The profile so far, most time consuming clients first
+    auto clients() const -> std::vector<ClientProfile>;
+
+    /// Logs the profile so far
+    void dump() const;
+
+private:
+    // The names are the generated wrappers' string literals, so can be compared by address
+    using RequestKey = std::pair<char const*, uint32_t>;
+
+    struct ClientEntry
+    {
+        std::string process_name;
+        Histogram handling;
+        std::map<RequestKey, std::pair<char const*, Histogram>> requests;
+    };
+
+    std::mutex mutable mutex;
+    std::unordered_map<pid_t, ClientEntry> entries;
+};
+}
+}
+
+#endif // MIR_FRONTEND_WAYLAND_REQUEST_PROFILE_H_
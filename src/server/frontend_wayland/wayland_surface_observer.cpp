@@ -41,8 +41,14 @@ mf::WaylandSurfaceObserver::WaylandSurfaceObserver(
     : seat{seat},
       window{window},
       input_dispatcher{std::make_unique<WaylandInputDispatcher>(seat, surface)},
-      window_size{geometry::Size{0,0}},
-      destroyed{std::make_shared<bool>(false)}
+      destroyed{std::make_shared<bool>(false)},
+      configure{
+          [this](std::function<void()>&& work) { run_on_wayland_thread_unless_destroyed(std::move(work)); },
+          [this](MirWindowState new_state) { this->window->handle_state_change(new_state); },
+          [this](std::experimental::optional<geometry::Point> const& new_top_left, geometry::Size const& new_size)
+          {
+              this->window->handle_resize(new_top_left, new_size);
+          }}
 {
 }
 
@@ -65,11 +71,7 @@ void mf::WaylandSurfaceObserver::attrib_changed(ms::Surface const*, MirWindowAtt
         break;
 
     case mir_window_attrib_state:
-        run_on_wayland_thread_unless_destroyed([this, value]()
-            {
-                current_state = static_cast<MirWindowState>(value);
-                window->handle_state_change(current_state);
-            });
+        configure.state_changed_to(static_cast<MirWindowState>(value));
         break;
 
     default:;
@@ -78,15 +80,7 @@ void mf::WaylandSurfaceObserver::attrib_changed(ms::Surface const*, MirWindowAtt
 
 void mf::WaylandSurfaceObserver::content_resized_to(ms::Surface const*, geom::Size const& content_size)
 {
-    run_on_wayland_thread_unless_destroyed(
-        [this, content_size]()
-        {
-            if (content_size != window_size)
-            {
-                requested_size = content_size;
-                window->handle_resize(std::experimental::nullopt, content_size);
-            }
-        });
+    configure.resized_to(content_size);
 }
 
 void mf::WaylandSurfaceObserver::client_surface_close_requested(ms::Surface const*)
@@ -118,12 +112,7 @@ void mf::WaylandSurfaceObserver::keymap_changed(
 
 void mf::WaylandSurfaceObserver::placed_relative(ms::Surface const*, geometry::Rectangle const& placement)
 {
-    run_on_wayland_thread_unless_destroyed(
-        [this, placement = placement]()
-        {
-            requested_size = placement.size;
-            window->handle_resize(placement.top_left, placement.size);
-        });
+    configure.placed_at(placement);
 }
 
 void mf::WaylandSurfaceObserver::input_consumed(ms::Surface const*, MirEvent const* event)
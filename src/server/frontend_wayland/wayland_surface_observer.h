@@ -21,6 +21,7 @@
 #define MIR_FRONTEND_WAYLAND_SURFACE_OBSERVER_H_
 
 #include "mir/scene/null_surface_observer.h"
+#include "configure_coalescer.h"
 
 #include <memory>
 #include <experimental/optional>
@@ -63,19 +64,19 @@ public:
 
     void latest_client_size(geometry::Size window_size)
     {
-        this->window_size = window_size;
+        configure.latest_client_size(window_size);
     }
 
     std::experimental::optional<geometry::Size> requested_window_size()
     {
-        return requested_size;
+        return configure.requested_window_size();
     }
 
     auto latest_timestamp() const -> std::chrono::nanoseconds;
 
     auto state() const -> MirWindowState
     {
-        return current_state;
+        return configure.state();
     }
 
     void disconnect() { *destroyed = true; }
@@ -85,10 +86,8 @@ private:
     WindowWlSurfaceRole* const window;
     std::unique_ptr<WaylandInputDispatcher> const input_dispatcher;
 
-    geometry::Size window_size;
-    std::experimental::optional<geometry::Size> requested_size;
-    MirWindowState current_state{mir_window_state_unknown};
     std::shared_ptr<bool> const destroyed;
+    ConfigureCoalescer configure;
 
     void run_on_wayland_thread_unless_destroyed(std::function<void()>&& work);
 };
@@ -31,6 +31,7 @@
 #include "null_event_sink.h"
 
 #include "mir/log.h"
+#include "mir/scene/session.h"
 #include "mir/scene/surface.h"
 #include "mir/scene/surface_creation_parameters.h"
 
@@ -121,6 +122,21 @@ void mf::WindowWlSurfaceRole::refresh_surface_data_now()
     }
 }
 
+void mf::WindowWlSurfaceRole::refresh_subsurface_data_now()
+{
+    // Subsurfaces only change the streams and input shape of the window, which the window manager passes straight
+    // to the scene surface. Skipping the window manager (and its lock) keeps clients that move subsurfaces every
+    // frame cheap.
+    if (auto const scene_surface = weak_scene_surface.lock())
+    {
+        std::vector<shell::StreamSpecification> streams;
+        std::vector<geom::Rectangle> input_shape;
+        surface->populate_surface_data(streams, input_shape, {});
+        session->configure_streams(*scene_surface, streams);
+        scene_surface->set_input_region(input_shape);
+    }
+}
+
 void mf::WindowWlSurfaceRole::apply_spec(mir::shell::SurfaceSpecification const& new_spec)
 {
     if (new_spec.width.is_set())
@@ -370,6 +386,10 @@ void mf::WindowWlSurfaceRole::commit(WlSurfaceState const& state)
         {
             populate_spec_with_surface_data(spec());
         }
+        else if (state.subsurface_data_needs_refresh())
+        {
+            refresh_subsurface_data_now();
+        }
 
         if (pending_changes)
         {
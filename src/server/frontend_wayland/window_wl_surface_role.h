@@ -72,6 +72,7 @@ public:
 
     void populate_spec_with_surface_data(shell::SurfaceSpecification& spec);
     void refresh_surface_data_now() override;
+    void refresh_subsurface_data_now() override;
 
     void apply_spec(shell::SurfaceSpecification const& new_spec);
     void set_pending_offset(std::experimental::optional<geometry::Displacement> const& offset);
@@ -19,8 +19,6 @@
 
 #include "wl_region.h"
 
-#include <mir/log.h>
-
 namespace mf = mir::frontend;
 namespace geom = mir::geometry;
 namespace mw = mir::wayland;
@@ -32,11 +30,6 @@ mf::WlRegion::WlRegion(wl_resource* new_resource)
 mf::WlRegion::~WlRegion()
 {}
 
-std::vector<geom::Rectangle> mf::WlRegion::rectangle_vector()
-{
-    return rects;
-}
-
 mf::WlRegion* mf::WlRegion::from(wl_resource* resource)
 {
     void* raw = wl_resource_get_user_data(resource);
@@ -50,14 +43,10 @@ void mf::WlRegion::destroy()
 
 void mf::WlRegion::add(int32_t x, int32_t y, int32_t width, int32_t height)
 {
-    rects.push_back(geom::Rectangle{{x, y}, {width, height}});
+    region_.add(geom::Rectangle{{x, y}, {width, height}});
 }
 
 void mf::WlRegion::subtract(int32_t x, int32_t y, int32_t width, int32_t height)
 {
-    (void)x;
-    (void)y;
-    (void)width;
-    (void)height;
-    log_warning("WlRegion::subtract not implemented. ignoring.");
+    region_.subtract(geom::Rectangle{{x, y}, {width, height}});
 }
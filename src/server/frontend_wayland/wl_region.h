@@ -22,9 +22,7 @@
 
 #include "wayland_wrapper.h"
 
-#include "mir/geometry/rectangle.h"
-
-#include <vector>
+#include "mir/geometry/region.h"
 
 namespace mir
 {
@@ -37,7 +35,7 @@ public:
     WlRegion(wl_resource* new_resource);
     ~WlRegion();
 
-    std::vector<geometry::Rectangle> rectangle_vector();
+    auto region() const -> geometry::Region const& { return region_; }
 
     static WlRegion* from(wl_resource* resource);
 
@@ -46,7 +44,7 @@ private:
     void add(int32_t x, int32_t y, int32_t width, int32_t height) override;
     void subtract(int32_t x, int32_t y, int32_t width, int32_t height) override;
 
-    std::vector<geometry::Rectangle> rects;
+    geometry::Region region_;
 };
 
 }
@@ -27,6 +27,14 @@ namespace mf = mir::frontend;
 namespace geom = mir::geometry;
 namespace mw = mir::wayland;
 
+namespace
+{
+auto needs_surface_data_refresh(mf::WlSurfaceState const& state) -> bool
+{
+    return state.surface_data_needs_refresh() || state.subsurface_data_needs_refresh();
+}
+}
+
 namespace mir
 {
 namespace frontend
@@ -107,13 +115,17 @@ auto mf::WlSubsurface::scene_surface() const -> std::experimental::optional<std:
     return parent->scene_surface();
 }
 
-void mf::WlSubsurface::parent_has_committed()
+bool mf::WlSubsurface::parent_has_committed()
 {
     if (cached_state && synchronized())
     {
         surface->commit(cached_state.value());
+        auto const needs_refresh = needs_surface_data_refresh(cached_state.value());
         cached_state = std::experimental::nullopt;
+        return needs_refresh;
     }
+
+    return false;
 }
 
 mf::WlSurface::Position mf::WlSubsurface::transform_point(geom::Point point)
@@ -128,14 +140,26 @@ void mf::WlSubsurface::set_position(int32_t x, int32_t y)
 
 void mf::WlSubsurface::place_above(struct wl_resource* sibling)
 {
-    (void)sibling;
-    log_warning("TODO: wl_subsurface.place_above not implemented");
+    if (!*parent_destroyed && !parent->pending_place(this, WlSurface::from(sibling), true))
+    {
+        wl_resource_post_error(
+            resource,
+            Error::bad_surface,
+            "wl_subsurface.place_above: wl_surface@%d is not the parent or a sibling",
+            wl_resource_get_id(sibling));
+    }
 }
 
 void mf::WlSubsurface::place_below(struct wl_resource* sibling)
 {
-    (void)sibling;
-    log_warning("TODO: wl_subsurface.place_below not implemented");
+    if (!*parent_destroyed && !parent->pending_place(this, WlSurface::from(sibling), false))
+    {
+        wl_resource_post_error(
+            resource,
+            Error::bad_surface,
+            "wl_subsurface.place_below: wl_surface@%d is not the parent or a sibling",
+            wl_resource_get_id(sibling));
+    }
 }
 
 void mf::WlSubsurface::set_sync()
@@ -154,9 +178,15 @@ void mf::WlSubsurface::destroy()
 }
 
 void mf::WlSubsurface::refresh_surface_data_now()
+{
+    // Nothing about a subsurface concerns the window manager
+    refresh_subsurface_data_now();
+}
+
+void mf::WlSubsurface::refresh_subsurface_data_now()
 {
     if (!*parent_destroyed)
-        parent->refresh_surface_data_now();
+        parent->refresh_subsurface_data_now();
 }
 
 void mf::WlSubsurface::commit(WlSurfaceState const& state)
@@ -168,14 +198,14 @@ void mf::WlSubsurface::commit(WlSurfaceState const& state)
 
     if (synchronized())
     {
-        if (cached_state.value().surface_data_needs_refresh() && !*parent_destroyed)
-            parent->pending_invalidate_surface_data();
+        if (needs_surface_data_refresh(cached_state.value()) && !*parent_destroyed)
+            parent->pending_invalidate_subsurface_data();
     }
     else
     {
         surface->commit(cached_state.value());
-        if (cached_state.value().surface_data_needs_refresh())
-            refresh_surface_data_now();
+        if (needs_surface_data_refresh(cached_state.value()))
+            refresh_subsurface_data_now();
         cached_state = std::experimental::nullopt;
     }
 }
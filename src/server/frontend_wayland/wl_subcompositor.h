@@ -62,7 +62,10 @@ public:
     bool synchronized() const override;
     auto scene_surface() const -> std::experimental::optional<std::shared_ptr<scene::Surface>> override;
 
-    void parent_has_committed();
+    /// \return if the surface data of the parent needs refreshing
+    bool parent_has_committed();
+
+    auto wl_surface() const -> WlSurface* { return surface; }
 
     WlSurface::Position transform_point(geometry::Point point);
 
@@ -76,6 +79,7 @@ private:
     void destroy() override; // overrides function in both WlSurfaceRole and wayland::Subsurface
 
     void refresh_surface_data_now() override;
+    void refresh_subsurface_data_now() override;
     virtual void commit(WlSurfaceState const& state) override;
     virtual void visiblity(bool visible) override;
 
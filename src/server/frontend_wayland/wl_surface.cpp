@@ -69,6 +69,9 @@ void mf::WlSurfaceState::update_from(WlSurfaceState const& source)
 
     if (source.surface_data_invalidated)
         surface_data_invalidated = true;
+
+    if (source.subsurface_data_invalidated)
+        subsurface_data_invalidated = true;
 }
 
 bool mf::WlSurfaceState::surface_data_needs_refresh() const
@@ -89,6 +92,7 @@ mf::WlSurface::WlSurface(
         executor{executor},
         null_role{this},
         role{&null_role},
+        children{nullptr},
         destroyed{std::make_shared<bool>(false)}
 {
     // wl_surface is specified to act in mailbox mode
@@ -119,18 +123,21 @@ bool mf::WlSurface::synchronized() const
 mf::WlSurface::Position mf::WlSurface::transform_point(geom::Point point)
 {
     point = point - offset_;
-    // loop backwards so the first subsurface we find that accepts the input is the topmost one
+    // loop backwards so the first surface we find that accepts the input is the topmost one
     for (auto child_it = children.rbegin(); child_it != children.rend(); ++child_it)
     {
-        auto result = (*child_it)->transform_point(point);
-        if (result.is_in_input_region)
-            return result;
-    }
-    geom::Rectangle surface_rect = {geom::Point{}, buffer_size_.value_or(geom::Size{})};
-    for (auto& rect : input_shape.value_or(std::vector<geom::Rectangle>{{{}, buffer_size_.value_or(geom::Size{})}}))
-    {
-        if (rect.intersection_with(surface_rect).contains(point))
-            return {point, this, true};
+        if (*child_it)
+        {
+            auto result = (*child_it)->transform_point(point);
+            if (result.is_in_input_region)
+                return result;
+        }
+        else
+        {
+            geom::Rectangle surface_rect = {geom::Point{}, buffer_size_.value_or(geom::Size{})};
+            if (surface_rect.contains(point) && (!input_shape || input_shape.value().contains(point)))
+                return {point, this, true};
+        }
     }
     return {point, this, false};
 }
@@ -160,6 +167,8 @@ void mf::WlSurface::set_pending_offset(std::experimental::optional<geom::Displac
 std::unique_ptr<mf::WlSurface, std::function<void(mf::WlSurface*)>> mf::WlSurface::add_child(WlSubsurface* child)
 {
     children.push_back(child);
+    if (pending_children)
+        pending_children.value().push_back(child);
 
     return std::unique_ptr<WlSurface, std::function<void(WlSurface*)>>(
         this,
@@ -167,44 +176,82 @@ std::unique_ptr<mf::WlSurface, std::function<void(mf::WlSurface*)>> mf::WlSurfac
         {
             if (*destroyed)
                 return;
-            // remove the child from the vector
+            // remove the child from the vectors
             self->children.erase(std::remove(self->children.begin(),
                                              self->children.end(),
                                              child),
                                  self->children.end());
+            if (self->pending_children)
+            {
+                auto& pending = self->pending_children.value();
+                pending.erase(std::remove(pending.begin(), pending.end(), child), pending.end());
+            }
         });
 }
 
+bool mf::WlSurface::pending_place(WlSubsurface* child, WlSurface* sibling, bool above)
+{
+    if (!pending_children)
+        pending_children = children;
+
+    auto& order = pending_children.value();
+
+    auto const sibling_it = std::find_if(order.begin(), order.end(), [&](WlSubsurface* entry)
+        {
+            return entry ? entry->wl_surface() == sibling : sibling == this;
+        });
+
+    if (sibling_it == order.end() || *sibling_it == child)
+        return false;
+
+    auto const sibling_entry = *sibling_it;
+    order.erase(std::remove(order.begin(), order.end(), child), order.end());
+    auto const position = std::find(order.begin(), order.end(), sibling_entry);
+    order.insert(above ? position + 1 : position, child);
+
+    pending.invalidate_subsurface_data();
+    return true;
+}
+
 void mf::WlSurface::refresh_surface_data_now()
 {
     role->refresh_surface_data_now();
 }
 
+void mf::WlSurface::refresh_subsurface_data_now()
+{
+    role->refresh_subsurface_data_now();
+}
+
 void mf::WlSurface::populate_surface_data(std::vector<shell::StreamSpecification>& buffer_streams,
                                           std::vector<geom::Rectangle>& input_shape_accumulator,
                                           geometry::Displacement const& parent_offset) const
 {
     geometry::Displacement offset = parent_offset + offset_;
 
-    buffer_streams.push_back(msh::StreamSpecification{stream, offset, {}});
-    geom::Rectangle surface_rect = {geom::Point{} + offset, buffer_size_.value_or(geom::Size{})};
-    if (input_shape)
+    for (WlSubsurface* subsurface : children)
     {
-        for (auto rect : input_shape.value())
+        if (subsurface)
         {
-            rect.top_left = rect.top_left + offset;
-            rect = rect.intersection_with(surface_rect); // clip to surface
-            input_shape_accumulator.push_back(rect);
+            subsurface->populate_surface_data(buffer_streams, input_shape_accumulator, offset);
+            continue;
         }
-    }
-    else
-    {
-        input_shape_accumulator.push_back(surface_rect);
-    }
 
-    for (WlSubsurface* subsurface : children)
-    {
-        subsurface->populate_surface_data(buffer_streams, input_shape_accumulator, offset);
+        buffer_streams.push_back(msh::StreamSpecification{stream, offset, {}});
+        geom::Rectangle surface_rect = {geom::Point{} + offset, buffer_size_.value_or(geom::Size{})};
+        if (input_shape)
+        {
+            for (auto rect : input_shape.value())
+            {
+                rect.top_left = rect.top_left + offset;
+                rect = rect.intersection_with(surface_rect); // clip to surface
+                input_shape_accumulator.push_back(rect);
+            }
+        }
+        else
+        {
+            input_shape_accumulator.push_back(surface_rect);
+        }
     }
 }
 
@@ -290,8 +337,7 @@ void mf::WlSurface::set_input_region(std::experimental::optional<wl_resource*> c
     if (region)
     {
         // since pending.input_shape is an optional optional, this is needed
-        auto shape = WlRegion::from(region.value())->rectangle_vector();
-        pending.input_shape = decltype(pending.input_shape)::value_type{move(shape)};
+        pending.input_shape = decltype(pending.input_shape)::value_type{WlRegion::from(region.value())->region()};
     }
     else
     {
@@ -313,6 +359,13 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
     if (state.input_shape)
         input_shape = state.input_shape.value();
 
+    if (pending_children)
+    {
+        children = std::move(pending_children.value());
+        pending_children = std::experimental::nullopt;
+        state.invalidate_subsurface_data();
+    }
+
     if (state.buffer)
     {
         wl_resource * buffer = *state.buffer;
@@ -386,7 +439,8 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
 
     for (WlSubsurface* child: children)
     {
-        child->parent_has_committed();
+        if (child && child->parent_has_committed())
+            state.invalidate_subsurface_data();
     }
 }
 
@@ -395,9 +449,7 @@ void mf::WlSurface::commit()
     if (pending.offset && *pending.offset == offset_)
         pending.offset = std::experimental::nullopt;
 
-    // The same input shape could be represented by the same rectangles in a different order, or even
-    // different rectangles. We don't check for that, however, because it would only cause an unnecessary
-    // update and not do any real harm. Checking for identical vectors should cover most cases.
+    // Regions are kept in a canonical form, so the same shape always compares equal
     if (pending.input_shape && *pending.input_shape == input_shape)
         pending.input_shape = std::experimental::nullopt;
 
@@ -26,6 +26,7 @@
 #include "mir/geometry/displacement.h"
 #include "mir/geometry/size.h"
 #include "mir/geometry/point.h"
+#include "mir/geometry/region.h"
 
 #include <vector>
 #include <map>
@@ -73,7 +74,12 @@ struct WlSurfaceState
 
     void invalidate_surface_data() const { surface_data_invalidated = true; }
 
+    /// Marks a change to only the subsurfaces' offsets, stacking, sizes or input shapes, which can be applied directly
+    /// to the scene surface rather than through the window manager
+    void invalidate_subsurface_data() const { subsurface_data_invalidated = true; }
+
     bool surface_data_needs_refresh() const;
+    bool subsurface_data_needs_refresh() const { return subsurface_data_invalidated; }
 
     // NOTE: buffer can be both nullopt and nullptr (I know, sounds dumb, but bare with me)
     // if it's nullopt, there is not a new buffer and no value should be copied to current state
@@ -81,7 +87,7 @@ struct WlSurfaceState
     std::experimental::optional<wl_resource*> buffer;
 
     std::experimental::optional<geometry::Displacement> offset;
-    std::experimental::optional<std::experimental::optional<std::vector<geometry::Rectangle>>> input_shape;
+    std::experimental::optional<std::experimental::optional<geometry::Region>> input_shape;
     std::vector<std::shared_ptr<Callback>> frame_callbacks;
 
 private:
@@ -90,6 +96,7 @@ private:
     // is marked mutable so invalidate_surface_data() can be const and be called from a const reference
     // (this is the only thing we need to modify from the const reference)
     bool mutable surface_data_invalidated{false};
+    bool mutable subsurface_data_invalidated{false};
 };
 
 class NullWlSurfaceRole : public WlSurfaceRole
@@ -136,7 +143,12 @@ public:
     void set_pending_offset(std::experimental::optional<geometry::Displacement> const& offset);
     std::unique_ptr<WlSurface, std::function<void(WlSurface*)>> add_child(WlSubsurface* child);
     void refresh_surface_data_now();
+    void refresh_subsurface_data_now();
     void pending_invalidate_surface_data() { pending.invalidate_surface_data(); }
+    void pending_invalidate_subsurface_data() { pending.invalidate_subsurface_data(); }
+    /// Stacks child directly above or below sibling (this surface or another child) when this surface next commits
+    /// \return false if sibling is neither this surface nor one of its children
+    bool pending_place(WlSubsurface* child, WlSurface* sibling, bool above);
     void populate_surface_data(std::vector<shell::StreamSpecification>& buffer_streams,
                                std::vector<mir::geometry::Rectangle>& input_shape_accumulator,
                                geometry::Displacement const& parent_offset) const;
@@ -155,13 +167,14 @@ private:
 
     NullWlSurfaceRole null_role;
     WlSurfaceRole* role;
-    std::vector<WlSubsurface*> children; // ordering is from bottom to top
+    std::vector<WlSubsurface*> children; // ordering is from bottom to top, nullptr is this surface
+    std::experimental::optional<std::vector<WlSubsurface*>> pending_children;
 
     WlSurfaceState pending;
     geometry::Displacement offset_;
     std::experimental::optional<geometry::Size> buffer_size_;
     std::vector<std::shared_ptr<WlSurfaceState::Callback>> frame_callbacks;
-    std::experimental::optional<std::vector<mir::geometry::Rectangle>> input_shape;
+    std::experimental::optional<geometry::Region> input_shape;
     std::map<void const*, std::function<void()>> destroy_listeners;
     std::shared_ptr<bool> const destroyed;
 
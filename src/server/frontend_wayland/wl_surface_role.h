@@ -44,6 +44,8 @@ public:
     virtual auto total_offset() const -> geometry::Displacement { return {}; }
     virtual auto scene_surface() const -> std::experimental::optional<std::shared_ptr<scene::Surface>> = 0;
     virtual void refresh_surface_data_now() = 0;
+    /// Only subsurface offsets, stacking, sizes or input shapes have changed
+    virtual void refresh_subsurface_data_now() { refresh_surface_data_now(); }
     virtual void commit(WlSurfaceState const& state) = 0;
     virtual void visiblity(bool visible) = 0;
     virtual void destroy() = 0;
@@ -91,7 +91,7 @@ void mf::XWaylandSurfaceRole::commit(WlSurfaceState const& state)
 
     wl_surface->commit(state);
 
-    if (state.surface_data_needs_refresh())
+    if (state.surface_data_needs_refresh() || state.subsurface_data_needs_refresh())
     {
         refresh_surface_data_now();
     }
@@ -20,6 +20,7 @@
 #include "mir/glib_main_loop_sources.h"
 #include "mir/lockable_callback.h"
 #include "mir/raii.h"
+#include "mir/time/timer_wheel.h"
 
 #include <algorithm>
 #include <atomic>
@@ -29,6 +30,7 @@
 #include <csignal>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/timerfd.h>
 
 #include <boost/throw_exception.hpp>
 #include <glib-unix.h>
@@ -253,97 +255,225 @@ void md::add_server_action_gsource(
     g_source_attach(gsource, main_context);
 }
 
-md::GSourceHandle md::add_timer_gsource(
-    GMainContext* main_context,
-    std::shared_ptr<time::Clock> const& clock,
-    std::shared_ptr<LockableCallback> const& handler,
-    std::function<void()> const& exception_handler,
-    time::Timestamp target_time)
+/***************
+ * TimerSource *
+ ***************/
+
+struct md::TimerSource::TimerQueue
 {
-    struct TimerContext
-    {
-        TimerContext(std::shared_ptr<time::Clock> const& clock,
-                     std::shared_ptr<LockableCallback> const& handler,
-                     std::function<void()> const& exception_handler,
-                     time::Timestamp target_time)
-            : clock{clock}, handler{handler}, exception_handler{exception_handler},
-              target_time{target_time}, enabled{true}
+    struct Entry : time::TimerWheel::Timer, std::enable_shared_from_this<Entry>
+    {
+        Entry(std::shared_ptr<LockableCallback> const& handler,
+              std::function<void()> const& exception_handler)
+            : handler{handler}, exception_handler{exception_handler}
         {
         }
-        std::shared_ptr<time::Clock> clock;
-        std::shared_ptr<LockableCallback> handler;
-        std::function<void()> exception_handler;
-        time::Timestamp target_time;
-        std::recursive_mutex mutex;
-        bool enabled;
+
+        std::shared_ptr<LockableCallback> const handler;
+        std::function<void()> const exception_handler;
+        // Held while dispatching, so that cancelling can wait for it
+        std::recursive_mutex dispatch_mutex;
+        // Bumped whenever the entry is (re)scheduled or cancelled; guarded by TimerQueue::mutex
+        uint64_t generation{0};
     };
 
-    struct TimerGSource
-    {
-        GSource gsource;
-        TimerContext ctx;
-        bool ctx_constructed;
+    using Due = std::vector<std::pair<std::shared_ptr<Entry>, uint64_t>>;
 
-        static gboolean prepare(GSource* source, gint *timeout)
+    TimerQueue(std::shared_ptr<time::Clock> const& clock, time::Duration resolution)
+        : clock{clock},
+          timer_fd{timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)},
+          wheel{clock->now(), resolution}
+    {
+        if (timer_fd < 0)
         {
-            auto const& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+            BOOST_THROW_EXCEPTION(
+                std::system_error(errno, std::system_category(), "Failed to create timerfd"));
+        }
+    }
 
-            auto const now = ctx.clock->now();
-            bool const ready = (now >= ctx.target_time);
-            if (ready)
-                *timeout = -1;
-            else
-                *timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    ctx.clock->min_wait_until(ctx.target_time)).count();
+    void schedule(Entry& entry, time::Timestamp target_time)
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        ++entry.generation;
+
+        auto const previous_event = wheel.next_event();
+        wheel.schedule(entry, target_time);
+        if (wheel.next_event() != previous_event)
+            arm_timer_fd(lock);
+    }
 
-            return ready;
+    void cancel(Entry& entry)
+    {
+        // The timer_fd may now fire for nothing, which is cheaper than rearming it
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        ++entry.generation;
+        wheel.cancel(entry);
+    }
+
+    bool is_current(Entry const& entry, uint64_t generation)
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        return entry.generation == generation;
+    }
+
+    bool has_work()
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        return clock->now() >= wheel.next_event();
+    }
+
+    bool has_work_after_wakeup()
+    {
+        uint64_t expirations;
+        bool const woken = read(timer_fd, &expirations, sizeof expirations) == sizeof expirations;
+
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        auto const work = clock->now() >= wheel.next_event();
+        // The timer_fd is one-shot, so if it fired early (or for a cancelled timer) it needs rearming
+        if (woken && !work)
+            arm_timer_fd(lock);
+        return work;
+    }
+
+    auto take_due() -> Due
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+
+        Due due;
+        for (auto const timer : wheel.advance_to(clock->now()))
+        {
+            auto const entry = static_cast<Entry*>(timer);
+            due.emplace_back(entry->shared_from_this(), entry->generation);
         }
 
-        static gboolean check(GSource* source)
+        arm_timer_fd(lock);
+        return due;
+    }
+
+    std::shared_ptr<time::Clock> const clock;
+    mir::Fd const timer_fd;
+
+private:
+    void arm_timer_fd(std::lock_guard<std::mutex> const&)
+    {
+        itimerspec spec{};
+
+        auto const next_event = wheel.next_event();
+        if (next_event != time::Timestamp::max())
         {
-            auto const& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+            auto const wait = clock->min_wait_until(next_event);
 
-            auto const now = ctx.clock->now();
-            bool const ready = (now >= ctx.target_time);
-            return ready;
+            // A fake clock may say there's no wait without having reached next_event.
+            // That won't change in real time, so leave it to prepare() once the clock
+            // has been moved on.
+            if (wait > time::Duration::zero() || clock->now() >= next_event)
+            {
+                // A zero it_value disarms the timer_fd, so wait at least 1ns
+                auto const ns = std::max(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count(),
+                    std::chrono::nanoseconds::rep{1});
+                spec.it_value.tv_sec = ns / 1000000000;
+                spec.it_value.tv_nsec = ns % 1000000000;
+            }
         }
 
-        static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+        timerfd_settime(timer_fd, 0, &spec, nullptr);
+    }
+
+    std::mutex mutex;
+    time::TimerWheel wheel;
+};
+
+struct md::TimerSource::TimerImpl : TimerSource::Timer
+{
+    TimerImpl(std::shared_ptr<TimerQueue> const& queue,
+              std::shared_ptr<TimerQueue::Entry> const& entry)
+        : queue{queue}, entry{entry}
+    {
+    }
+
+    ~TimerImpl() override
+    {
+        ensure_no_further_dispatch();
+    }
+
+    void schedule(time::Timestamp target_time) override
+    {
+        queue->schedule(*entry, target_time);
+    }
+
+    void ensure_no_further_dispatch() override
+    {
+        queue->cancel(*entry);
+
+        // Wait for a dispatch under way on another thread; on this thread the mutex is recursive
+        std::lock_guard<decltype(entry->dispatch_mutex)> wait{entry->dispatch_mutex};
+    }
+
+    std::shared_ptr<TimerQueue> const queue;
+    std::shared_ptr<TimerQueue::Entry> const entry;
+};
+
+struct md::TimerSource::TimerGSource
+{
+    GSource gsource;
+    std::shared_ptr<TimerQueue> queue;
+    bool queue_constructed;
+
+    static gboolean prepare(GSource* source, gint *timeout)
+    {
+        // The timer_fd wakes us when there is work, so poll() needn't time out
+        *timeout = -1;
+        return reinterpret_cast<TimerGSource*>(source)->queue->has_work();
+    }
+
+    static gboolean check(GSource* source)
+    {
+        return reinterpret_cast<TimerGSource*>(source)->queue->has_work_after_wakeup();
+    }
+
+    static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+    {
+        auto& queue = *reinterpret_cast<TimerGSource*>(source)->queue;
+
+        for (auto const& due : queue.take_due())
         {
-            auto& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
+            auto& entry = *due.first;
             try
             {
                 // Attempt to preserve locking order during callback dispatching
                 // so we acquire the caller's lock before our own.
-                auto& handler = *ctx.handler;
+                auto& handler = *entry.handler;
                 std::lock_guard<LockableCallback> handler_lock{handler};
-                std::lock_guard<decltype(ctx.mutex)> lock{ctx.mutex};
-                if (ctx.enabled)
+                std::lock_guard<decltype(entry.dispatch_mutex)> lock{entry.dispatch_mutex};
+
+                // Skip entries rescheduled or cancelled since they came due
+                if (queue.is_current(entry, due.second))
                     handler();
             }
             catch(...)
             {
-                ctx.exception_handler();
+                entry.exception_handler();
             }
-
-            return FALSE;
         }
 
-        static void finalize(GSource* source)
-        {
-            auto const timer_gsource = reinterpret_cast<TimerGSource*>(source);
-            if (timer_gsource->ctx_constructed)
-                timer_gsource->ctx.~TimerContext();
-        }
+        return G_SOURCE_CONTINUE;
+    }
 
-        static void disable(GSource* source)
-        {
-            auto& ctx = reinterpret_cast<TimerGSource*>(source)->ctx;
-            std::lock_guard<decltype(ctx.mutex)> lock{ctx.mutex};
-            ctx.enabled = false;
-        }
-    };
+    static void finalize(GSource* source)
+    {
+        auto const timer_gsource = reinterpret_cast<TimerGSource*>(source);
+        if (timer_gsource->queue_constructed)
+            timer_gsource->queue.~shared_ptr();
+    }
+};
 
+md::TimerSource::TimerSource(
+    GMainContext* main_context,
+    std::shared_ptr<time::Clock> const& clock,
+    time::Duration resolution)
+    : queue{std::make_shared<TimerQueue>(clock, resolution)}
+{
     static GSourceFuncs gsource_funcs{
         TimerGSource::prepare,
         TimerGSource::check,
@@ -353,18 +483,28 @@ md::GSourceHandle md::add_timer_gsource(
         nullptr
     };
 
-    GSourceHandle gsource{
+    gsource = GSourceHandle{
         g_source_new(&gsource_funcs, sizeof(TimerGSource)),
-        [](GSource* gsource) { TimerGSource::disable(gsource); }};
+        [](GSource*) {}};
     auto const timer_gsource = reinterpret_cast<TimerGSource*>(static_cast<GSource*>(gsource));
 
-    timer_gsource->ctx_constructed = false;
-    new (&timer_gsource->ctx) TimerContext{clock, handler, exception_handler, target_time};
-    timer_gsource->ctx_constructed = true;
+    timer_gsource->queue_constructed = false;
+    new (&timer_gsource->queue) std::shared_ptr<TimerQueue>{queue};
+    timer_gsource->queue_constructed = true;
 
+    g_source_add_unix_fd(gsource, queue->timer_fd, G_IO_IN);
     g_source_attach(gsource, main_context);
+}
 
-    return gsource;
+md::TimerSource::~TimerSource() = default;
+
+auto md::TimerSource::create_timer(
+    std::shared_ptr<LockableCallback> const& handler,
+    std::function<void()> const& exception_handler) -> std::unique_ptr<Timer>
+{
+    return std::make_unique<TimerImpl>(
+        queue,
+        std::make_shared<TimerQueue::Entry>(handler, exception_handler));
 }
 
 /*************
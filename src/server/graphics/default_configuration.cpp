@@ -40,6 +40,7 @@
 #include "mir/log.h"
 #include "mir/main_loop.h"
 #include "mir/report_exception.h"
+#include "mir/startup_timeline.h"
 
 #include "mir_toolkit/common.h"
 
@@ -103,8 +104,21 @@ std::shared_ptr<mg::Platform> mir::DefaultServerConfiguration::the_graphics_plat
                         auto msg = "Failed to find any platform plugins in: " + path;
                         throw std::runtime_error(msg.c_str());
                     }
-                    platform_library = mir::graphics::module_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()), the_console_services());
+                    auto const& program_options = dynamic_cast<mir::options::ProgramOption&>(*the_options());
+                    if (the_options()->is_set(options::platform_probe_cache))
+                    {
+                        mg::ProbeResultCache cache{
+                            the_options()->get<std::string>(options::platform_probe_cache),
+                            mg::current_device_set()};
+                        platform_library = mg::module_for_device(platforms, program_options, the_console_services(), cache);
+                    }
+                    else
+                    {
+                        platform_library = mg::module_for_device(platforms, program_options, the_console_services());
+                    }
                 }
+                startup_timeline::phase_completed("Graphics platform probed");
+
                 auto create_host_platform =
                     [platform_library]() -> std::function<std::remove_pointer<mg::CreateHostPlatform>::type>
                     {
@@ -149,12 +163,14 @@ std::shared_ptr<mg::Platform> mir::DefaultServerConfiguration::the_graphics_plat
                               description->minor_version,
                               description->micro_version);
 
-                return create_host_platform(
+                auto const platform = create_host_platform(
                     the_options(),
                     the_emergency_cleanup(),
                     the_console_services(),
                     the_display_report(),
                     the_logger());
+                startup_timeline::phase_completed("Graphics platform created");
+                return platform;
             }
             catch(...)
             {
@@ -200,9 +216,11 @@ mir::DefaultServerConfiguration::the_display()
                 }
             }
 
-            return the_graphics_platform()->create_display(
+            auto const display = the_graphics_platform()->create_display(
                 the_display_configuration_policy(),
                 the_gl_config());
+            startup_timeline::phase_completed("Display created");
+            return display;
         });
 }
 
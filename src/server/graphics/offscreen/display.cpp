@@ -212,3 +212,10 @@ bool mgo::Display::apply_if_configuration_preserves_display_buffers(mg::DisplayC
 {
     return false;
 }
+
+bool mgo::Display::apply_if_configuration_preserves_unchanged_sync_groups(
+    mg::DisplayConfiguration const&,
+    std::function<void(mg::DisplaySyncGroup&)> const&)
+{
+    return false;
+}
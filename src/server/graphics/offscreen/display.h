@@ -107,6 +107,9 @@ public:
 
     std::unique_ptr<renderer::gl::Context> create_gl_context() const override;
     bool apply_if_configuration_preserves_display_buffers(graphics::DisplayConfiguration const& conf) override;
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        graphics::DisplayConfiguration const& conf,
+        std::function<void(graphics::DisplaySyncGroup&)> const& remove_sync_group) override;
 private:
     detail::EGLDisplayHandle const egl_display;
     SurfacelessEGLContext const egl_context_shared;
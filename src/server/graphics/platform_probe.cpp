@@ -21,6 +21,87 @@
 #include "platform_probe.h"
 
 #include <boost/throw_exception.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+namespace mg = mir::graphics;
+
+namespace
+{
+struct BuildIdSearch
+{
+    char const* const filename;
+    std::string build_id;
+};
+
+int find_build_id(dl_phdr_info* info, size_t, void* context)
+{
+    auto& search = *static_cast<BuildIdSearch*>(context);
+
+    if (!info->dlpi_name || strcmp(info->dlpi_name, search.filename) != 0)
+        return 0;
+
+    for (auto i = 0; i != info->dlpi_phnum; ++i)
+    {
+        auto const& segment = info->dlpi_phdr[i];
+        if (segment.p_type != PT_NOTE)
+            continue;
+
+        auto note = reinterpret_cast<char const*>(info->dlpi_addr + segment.p_vaddr);
+        auto const end = note + segment.p_memsz;
+
+        while (note + sizeof(ElfW(Nhdr)) <= end)
+        {
+            auto const header = reinterpret_cast<ElfW(Nhdr) const*>(note);
+            auto const name = note + sizeof(ElfW(Nhdr));
+            auto const desc = name + ((header->n_namesz + 3) & ~3u);
+
+            if (header->n_type == NT_GNU_BUILD_ID &&
+                header->n_namesz == sizeof("GNU") &&
+                memcmp(name, "GNU", sizeof("GNU")) == 0)
+            {
+                std::ostringstream hex;
+                hex << std::hex << std::setfill('0');
+                for (auto byte = desc; byte != desc + header->n_descsz; ++byte)
+                    hex << std::setw(2) << static_cast<unsigned>(static_cast<unsigned char>(*byte));
+
+                search.build_id = hex.str();
+                return 1;
+            }
+
+            note = desc + ((header->n_descsz + 3) & ~3u);
+        }
+    }
+
+    return 1;
+}
+
+auto first_line_of(std::string const& filename) -> std::string
+{
+    std::ifstream file{filename};
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+char const* const device_set_tag = "device-set ";
+}
 
 auto mir::graphics::probe_module(
     mir::SharedLibrary& module,
@@ -89,19 +170,175 @@ auto mir::graphics::probe_module(
 }
 
 
-std::shared_ptr<mir::SharedLibrary>
-mir::graphics::module_for_device(
-    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+auto mir::graphics::module_identity(SharedLibrary const& module, char const* describe_symbol) -> std::string
+{
+    Dl_info info;
+    auto const symbol = module.load_function<void*>(describe_symbol);
+
+    if (!dladdr(symbol, &info) || !info.dli_fname)
+        BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to locate platform module file"}));
+
+    std::string const filename{info.dli_fname};
+
+    BuildIdSearch search{info.dli_fname, {}};
+    dl_iterate_phdr(&find_build_id, &search);
+
+    if (!search.build_id.empty())
+        return filename + " build-id:" + search.build_id;
+
+    struct stat file_info;
+    if (stat(info.dli_fname, &file_info) != 0)
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to stat " + filename}));
+
+    return filename +
+        " size:" + std::to_string(file_info.st_size) +
+        " mtime:" + std::to_string(file_info.st_mtime);
+}
+
+auto mir::graphics::current_device_set() -> std::string
+{
+    std::vector<std::string> devices;
+
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator i{"/dev/dri", ec}, end; !ec && i != end; i.increment(ec))
+    {
+        struct stat device_info;
+        if (stat(i->path().c_str(), &device_info) != 0 || !S_ISCHR(device_info.st_mode))
+            continue;
+
+        auto const sys_device =
+            "/sys/dev/char/" +
+            std::to_string(major(device_info.st_rdev)) + ":" +
+            std::to_string(minor(device_info.st_rdev)) + "/device/modalias";
+
+        devices.push_back(i->path().filename().string() + "=" + first_line_of(sys_device));
+    }
+
+    std::sort(devices.begin(), devices.end());
+
+    // Hosted platforms probe for a host display server rather than devices
+    for (auto const variable : {"DISPLAY", "WAYLAND_DISPLAY"})
+    {
+        if (auto const value = getenv(variable))
+            devices.push_back(std::string{variable} + "=" + value);
+    }
+
+    std::string result;
+    for (auto const& device : devices)
+        result += device + ";";
+
+    return result;
+}
+
+std::chrono::seconds const mg::ProbeResultCache::default_failure_lifetime{std::chrono::hours{1}};
+
+mg::ProbeResultCache::ProbeResultCache(
+    std::string const& filename,
+    std::string const& device_set,
+    std::chrono::seconds failure_lifetime) :
+    filename{filename},
+    device_set{device_set},
+    failure_lifetime{failure_lifetime}
+{
+    std::ifstream file{filename};
+    std::string line;
+
+    if (!std::getline(file, line) || line != device_set_tag + device_set)
+        return;
+
+    while (std::getline(file, line))
+    {
+        std::istringstream entry{line};
+        int priority;
+        std::time_t probed;
+        std::string module_id;
+
+        if (entry >> priority >> probed && entry.get() == ' ' && std::getline(entry, module_id))
+        {
+            results[module_id] = {
+                static_cast<PlatformPriority>(priority),
+                std::chrono::system_clock::from_time_t(probed)};
+        }
+    }
+}
+
+bool mg::ProbeResultCache::known_unsupported(std::string const& module_id) const
+{
+    auto const result = results.find(module_id);
+    return result != results.end() &&
+        result->second.priority <= PlatformPriority::unsupported &&
+        std::chrono::system_clock::now() - result->second.probed < failure_lifetime;
+}
+
+void mg::ProbeResultCache::record(std::string const& module_id, PlatformPriority priority)
+{
+    results[module_id] = {priority, std::chrono::system_clock::now()};
+}
+
+void mg::ProbeResultCache::save() const
+{
+    auto const temporary = filename + ".new";
+
+    {
+        std::ofstream file{temporary, std::ios::trunc};
+
+        file << device_set_tag << device_set << '\n';
+        for (auto const& result : results)
+        {
+            file << static_cast<int>(result.second.priority) << ' '
+                 << std::chrono::system_clock::to_time_t(result.second.probed) << ' '
+                 << result.first << '\n';
+        }
+
+        if (!file.flush())
+        {
+            mir::log_warning("Failed to write platform probe cache: %s", temporary.c_str());
+            return;
+        }
+    }
+
+    if (rename(temporary.c_str(), filename.c_str()) != 0)
+    {
+        mir::log_warning("Failed to update platform probe cache %s: %s", filename.c_str(), strerror(errno));
+        std::remove(temporary.c_str());
+    }
+}
+
+namespace
+{
+/*
+ * Modules are deliberately probed one after another: probes take the same
+ * devices through ConsoleServices::acquire_device(), which is exclusive (logind
+ * TakeDevice), so concurrent probes would fail spuriously rather than run faster.
+ */
+auto probe_for_best_module(
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
     mir::options::ProgramOption const& options,
-    std::shared_ptr<ConsoleServices> const& console)
+    std::shared_ptr<mir::ConsoleServices> const& console,
+    mg::ProbeResultCache* cache,
+    bool skip_known_unsupported) -> std::shared_ptr<mir::SharedLibrary>
 {
-    mir::graphics::PlatformPriority best_priority_so_far = mir::graphics::unsupported;
+    mg::PlatformPriority best_priority_so_far = mg::unsupported;
     std::shared_ptr<mir::SharedLibrary> best_module_so_far;
     for (auto& module : modules)
     {
+        std::string module_id;
         try
         {
-            auto module_priority = probe_module(*module, options, console);
+            if (cache)
+            {
+                module_id = mg::module_identity(*module);
+
+                if (skip_known_unsupported && cache->known_unsupported(module_id))
+                {
+                    mir::log_debug("Skipping graphics module known not to support this system: %s", module_id.c_str());
+                    continue;
+                }
+            }
+
+            auto module_priority = mg::probe_module(*module, options, console);
+            if (cache) cache->record(module_id, module_priority);
+
             if (module_priority > best_priority_so_far)
             {
                 best_priority_so_far = module_priority;
@@ -110,11 +347,43 @@ mir::graphics::module_for_device(
         }
         catch (std::runtime_error const&)
         {
+            if (cache && !module_id.empty()) cache->record(module_id, mg::unsupported);
         }
     }
-    if (best_priority_so_far > mir::graphics::unsupported)
+    return best_priority_so_far > mg::unsupported ? best_module_so_far : nullptr;
+}
+}
+
+std::shared_ptr<mir::SharedLibrary>
+mir::graphics::module_for_device(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    std::shared_ptr<ConsoleServices> const& console)
+{
+    if (auto const module = probe_for_best_module(modules, options, console, nullptr, false))
+    {
+        return module;
+    }
+    BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to find platform for current system"}));
+}
+
+std::shared_ptr<mir::SharedLibrary>
+mir::graphics::module_for_device(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    std::shared_ptr<ConsoleServices> const& console,
+    ProbeResultCache& cache)
+{
+    auto module = probe_for_best_module(modules, options, console, &cache, true);
+
+    // Something outside the cache key may have changed: don't trust stale failures
+    if (!module)
+        module = probe_for_best_module(modules, options, console, &cache, false);
+
+    if (module)
     {
-        return best_module_so_far;
+        cache.save();
+        return module;
     }
     BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to find platform for current system"}));
 }
@@ -19,8 +19,11 @@
 #ifndef MIR_GRAPHICS_PLATFORM_PROBE_H_
 #define MIR_GRAPHICS_PLATFORM_PROBE_H_
 
+#include <chrono>
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include "mir/shared_library.h"
 #include "mir/options/program_option.h"
 #include "mir/graphics/platform.h"
@@ -38,11 +41,66 @@ auto probe_module(
     options::ProgramOption const& options,
     std::shared_ptr<ConsoleServices> const& console) -> PlatformPriority;
 
+/**
+ * Probe results persisted between server runs.
+ *
+ * Probing a platform module can be expensive (opening devices, initialising EGL),
+ * so modules that failed to probe on the current set of devices are remembered
+ * and skipped on subsequent starts. Results are discarded if the device set changes.
+ *
+ * A failure may be transient (a device not yet ready, or busy), so it is only
+ * trusted for \a failure_lifetime after it was last probed; after that the module
+ * is probed again even if a lower priority module would succeed.
+ */
+class ProbeResultCache
+{
+public:
+    static std::chrono::seconds const default_failure_lifetime;
+
+    ProbeResultCache(
+        std::string const& filename,
+        std::string const& device_set,
+        std::chrono::seconds failure_lifetime = default_failure_lifetime);
+
+    bool known_unsupported(std::string const& module_id) const;
+    void record(std::string const& module_id, PlatformPriority priority);
+
+    /// Writes the results back to the cache file. Failures are logged, not thrown.
+    void save() const;
+
+private:
+    std::string const filename;
+    std::string const device_set;
+    std::chrono::seconds const failure_lifetime;
+
+    struct Result
+    {
+        PlatformPriority priority;
+        std::chrono::system_clock::time_point probed;
+    };
+    std::unordered_map<std::string, Result> results;
+};
+
+/// Identifies a module by filename and GNU build-id (or size and mtime if it has none).
+/// The file is located through \a describe_symbol, which the module must export.
+auto module_identity(
+    SharedLibrary const& module,
+    char const* describe_symbol = "describe_graphics_module") -> std::string;
+
+/// Describes the devices and host display environment that probing depends upon.
+auto current_device_set() -> std::string;
+
 std::shared_ptr<SharedLibrary> module_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     options::ProgramOption const& options,
     std::shared_ptr<ConsoleServices> const& console);
 
+std::shared_ptr<SharedLibrary> module_for_device(
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules,
+    options::ProgramOption const& options,
+    std::shared_ptr<ConsoleServices> const& console,
+    ProbeResultCache& cache);
+
 }
 }
 
@@ -222,14 +222,23 @@ void mg::SoftwareCursor::hide()
 
 void mg::SoftwareCursor::move_to(geometry::Point position)
 {
+    geom::Rectangle old_area;
+    geom::Rectangle new_area;
     {
         std::lock_guard<std::mutex> lg{guard};
 
         if (!renderable)
             return;
 
+        old_area = renderable->screen_position();
         renderable->move_to(position - hotspot);
+        new_area = renderable->screen_position();
     }
 
-    scene->emit_scene_changed();
+    if (old_area == new_area)
+        return;
+
+    // Only the outputs the cursor is leaving and entering need recompositing
+    scene->emit_scene_damaged(old_area);
+    scene->emit_scene_damaged(new_area);
 }
@@ -27,8 +27,12 @@
 #include "mir/log.h"
 #include "mir/libname.h"
 
+#include "../graphics/platform_probe.h"
+
+#include <memory>
 #include <stdexcept>
 
+namespace mg = mir::graphics;
 namespace mi = mir::input;
 namespace mo = mir::options;
 
@@ -52,6 +56,12 @@ mir::UniqueModulePtr<mi::Platform> create_input_platform(
 
     return result;
 }
+
+// Input results share the graphics probe cache; mesa-x11 is both kinds of module, so keep the keys apart
+auto input_module_identity(mir::SharedLibrary const& module) -> std::string
+{
+    return "input " + mg::module_identity(module, "describe_input_module");
+}
 }
 
 mir::UniqueModulePtr<mi::Platform> mi::probe_input_platforms(
@@ -67,14 +77,31 @@ mir::UniqueModulePtr<mi::Platform> mi::probe_input_platforms(
     std::shared_ptr<mir::SharedLibrary> platform_module;
     std::vector<std::string> module_names;
 
+    std::unique_ptr<mg::ProbeResultCache> cache;
+    bool skip_known_unsupported = false;
+
     auto const module_selector = [&](std::shared_ptr<mir::SharedLibrary> const& module)
         {
+            std::string module_id;
             try
             {
                 auto const probe = module->load_function<mi::ProbePlatform>(
                     "probe_input_platform", MIR_SERVER_INPUT_PLATFORM_VERSION);
 
+                if (cache)
+                {
+                    module_id = input_module_identity(*module);
+
+                    if (skip_known_unsupported && cache->known_unsupported(module_id))
+                    {
+                        mir::log_debug("Skipping input module known not to support this system: %s", module_id.c_str());
+                        return Selection::persist;
+                    }
+                }
+
                 auto const priority = probe(options, *console);
+                if (cache) cache->record(module_id, static_cast<mg::PlatformPriority>(priority));
+
                 if (priority > reject_platform_priority)
                 {
                     platform_module = module;
@@ -85,6 +112,7 @@ mir::UniqueModulePtr<mi::Platform> mi::probe_input_platforms(
             catch (std::runtime_error const&)
             {
                 // Assume we were handed a SharedLibrary that's not an input module of the correct vintage.
+                if (cache && !module_id.empty()) cache->record(module_id, mg::unsupported);
             }
 
             return Selection::persist;
@@ -97,7 +125,30 @@ mir::UniqueModulePtr<mi::Platform> mi::probe_input_platforms(
     }
     else
     {
-        select_libraries_for_path(options.get<std::string>(mo::platform_path), module_selector, prober_report);
+        auto const& path = options.get<std::string>(mo::platform_path);
+
+        if (options.is_set(mo::platform_probe_cache))
+        {
+            cache = std::make_unique<mg::ProbeResultCache>(
+                options.get<std::string>(mo::platform_probe_cache),
+                mg::current_device_set());
+            skip_known_unsupported = true;
+        }
+
+        select_libraries_for_path(path, module_selector, prober_report);
+
+        if (cache)
+        {
+            // A cached failure may be stale (e.g. the device was busy); probe everything before giving up
+            if (!platform_module)
+            {
+                skip_known_unsupported = false;
+                select_libraries_for_path(path, module_selector, prober_report);
+            }
+
+            if (platform_module)
+                cache->save();
+        }
     }
 
     if (!platform_module)
@@ -16,6 +16,8 @@
  * Authored by: Andreas Pokorny <andreas.pokorny@canonical.com>
  */
 
+#define MIR_LOG_COMPONENT "flight-recorder"
+
 #include "mir/default_server_configuration.h"
 #include "mir/options/configuration.h"
 
@@ -23,8 +25,25 @@
 #include "lttng_report_factory.h"
 #include "logging_report_factory.h"
 #include "null_report_factory.h"
+#include "flight_recorder/compositor_report.h"
+#include "flight_recorder/display_report.h"
+#include "flight_recorder/input_report.h"
+#include "flight_recorder/recorder.h"
 
 #include "mir/abnormal_exit.h"
+#include "mir/fd.h"
+#include "mir/log.h"
+#include "mir/main_loop.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace mg = mir::graphics;
 namespace mf = mir::frontend;
@@ -32,6 +51,51 @@ namespace mc = mir::compositor;
 namespace mi = mir::input;
 namespace ms = mir::scene;
 
+namespace
+{
+// The trace is written to a new file that only we can read, which then replaces the destination. As that file
+// is created with O_EXCL and O_NOFOLLOW, anything planted at its path makes the dump fail rather than redirecting it.
+void write_trace_file(mir::report::flight_recorder::Recorder const& recorder, std::string const& path)
+{
+    std::ostringstream trace;
+    recorder.write_trace(trace);
+    auto const contents = trace.str();
+
+    auto const temporary = path + ".new";
+    mir::Fd const fd{open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600)};
+    if (fd < 0)
+    {
+        mir::log_warning("Failed to create flight recorder trace %s: %s", temporary.c_str(), strerror(errno));
+        return;
+    }
+
+    for (size_t written = 0; written != contents.size();)
+    {
+        auto const result = write(fd, contents.data() + written, contents.size() - written);
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result < 0)
+        {
+            mir::log_warning("Failed to write flight recorder trace %s: %s", temporary.c_str(), strerror(errno));
+            unlink(temporary.c_str());
+            return;
+        }
+
+        written += result;
+    }
+
+    if (rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        mir::log_warning("Failed to write flight recorder trace to %s: %s", path.c_str(), strerror(errno));
+        unlink(temporary.c_str());
+        return;
+    }
+
+    mir::log_info("Flight recorder trace written to %s", path.c_str());
+}
+}
+
 std::unique_ptr<mir::report::ReportFactory> mir::DefaultServerConfiguration::report_factory(char const* report_opt)
 {
     auto opt = the_options()->get<std::string>(report_opt);
@@ -61,12 +125,56 @@ std::shared_ptr<void> mir::DefaultServerConfiguration::default_reports()
     return std::make_unique<report::Reports>(*this, *the_options());
 }
 
+auto mir::DefaultServerConfiguration::the_flight_recorder() -> std::shared_ptr<report::flight_recorder::Recorder>
+{
+    return flight_recorder(
+        [this]() -> std::shared_ptr<report::flight_recorder::Recorder>
+        {
+            auto const options = the_options();
+            if (!options->get<bool>(options::flight_recorder_opt))
+                return nullptr;
+
+            std::string path;
+            if (options->is_set(options::flight_recorder_file_opt))
+            {
+                path = options->get<std::string>(options::flight_recorder_file_opt);
+            }
+            else if (auto const runtime_dir = getenv("XDG_RUNTIME_DIR"))
+            {
+                path = std::string{runtime_dir} + "/mir-flight-recorder-" + std::to_string(getpid()) + ".json";
+            }
+            else
+            {
+                // Anywhere else (such as /tmp) may be shared with other users
+                log_info("Flight recorder disabled: XDG_RUNTIME_DIR is not set and no --%s was given",
+                         options::flight_recorder_file_opt);
+                return nullptr;
+            }
+
+            auto const recorder = std::make_shared<report::flight_recorder::Recorder>();
+
+            the_main_loop()->register_signal_handler(
+                {SIGUSR2},
+                [recorder, path](int)
+                {
+                    write_trace_file(*recorder, path);
+                });
+
+            return recorder;
+        });
+}
+
 auto mir::DefaultServerConfiguration::the_compositor_report() -> std::shared_ptr<mc::CompositorReport>
 {
     return compositor_report(
         [this]()->std::shared_ptr<mc::CompositorReport>
         {
-            return report_factory(options::compositor_report_opt)->create_compositor_report();
+            auto const report = report_factory(options::compositor_report_opt)->create_compositor_report();
+
+            if (auto const recorder = the_flight_recorder())
+                return std::make_shared<report::flight_recorder::CompositorReport>(recorder, report);
+
+            return report;
         });
 }
 
@@ -93,7 +201,12 @@ auto mir::DefaultServerConfiguration::the_display_report() -> std::shared_ptr<mg
     return display_report(
         [this]()->std::shared_ptr<mg::DisplayReport>
         {
-            return report_factory(options::display_report_opt)->create_display_report();
+            auto const report = report_factory(options::display_report_opt)->create_display_report();
+
+            if (auto const recorder = the_flight_recorder())
+                return std::make_shared<report::flight_recorder::DisplayReport>(recorder, report);
+
+            return report;
         });
 }
 
@@ -102,7 +215,12 @@ auto mir::DefaultServerConfiguration::the_input_report() -> std::shared_ptr<mi::
     return input_report(
         [this]()->std::shared_ptr<mi::InputReport>
         {
-            return report_factory(options::input_report_opt)->create_input_report();
+            auto const report = report_factory(options::input_report_opt)->create_input_report();
+
+            if (auto const recorder = the_flight_recorder())
+                return std::make_shared<report::flight_recorder::InputReport>(recorder, report);
+
+            return report;
         });
 }
 
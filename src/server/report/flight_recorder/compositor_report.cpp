@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "compositor_report.h"
+#include "recorder.h"
+
+#include "mir/graphics/buffer.h"
+
+namespace mrf = mir::report::flight_recorder;
+
+namespace
+{
+auto as_id(mrf::CompositorReport::SubCompositorId id) -> uint64_t
+{
+    return reinterpret_cast<uintptr_t>(id);
+}
+}
+
+mrf::CompositorReport::CompositorReport(
+    std::shared_ptr<Recorder> const& recorder,
+    std::shared_ptr<compositor::CompositorReport> const& next) :
+    recorder{recorder},
+    next{next}
+{
+}
+
+void mrf::CompositorReport::added_display(int width, int height, int x, int y, SubCompositorId id)
+{
+    next->added_display(width, height, x, y, id);
+}
+
+void mrf::CompositorReport::began_frame(SubCompositorId id)
+{
+    recorder->record(Recorder::Event::frame_began, as_id(id));
+    next->began_frame(id);
+}
+
+void mrf::CompositorReport::renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables)
+{
+    for (auto const& renderable : renderables)
+        recorder->record(Recorder::Event::buffer_consumed, as_id(id), renderable->buffer()->id().as_value());
+    next->renderables_in_frame(id, renderables);
+}
+
+void mrf::CompositorReport::rendered_frame(SubCompositorId id)
+{
+    recorder->record(Recorder::Event::frame_rendered, as_id(id));
+    next->rendered_frame(id);
+}
+
+void mrf::CompositorReport::finished_frame(SubCompositorId id)
+{
+    recorder->record(Recorder::Event::frame_finished, as_id(id));
+    next->finished_frame(id);
+}
+
+void mrf::CompositorReport::started()
+{
+    next->started();
+}
+
+void mrf::CompositorReport::stopped()
+{
+    next->stopped();
+}
+
+void mrf::CompositorReport::scheduled()
+{
+    next->scheduled();
+}
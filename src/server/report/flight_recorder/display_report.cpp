@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "display_report.h"
+#include "recorder.h"
+
+#include "mir/graphics/frame.h"
+
+namespace mrf = mir::report::flight_recorder;
+
+mrf::DisplayReport::DisplayReport(
+    std::shared_ptr<Recorder> const& recorder,
+    std::shared_ptr<graphics::DisplayReport> const& next) :
+    recorder{recorder},
+    next{next}
+{
+}
+
+void mrf::DisplayReport::report_successful_setup_of_native_resources()
+{
+    next->report_successful_setup_of_native_resources();
+}
+
+void mrf::DisplayReport::report_successful_egl_make_current_on_construction()
+{
+    next->report_successful_egl_make_current_on_construction();
+}
+
+void mrf::DisplayReport::report_successful_egl_buffer_swap_on_construction()
+{
+    next->report_successful_egl_buffer_swap_on_construction();
+}
+
+void mrf::DisplayReport::report_successful_display_construction()
+{
+    next->report_successful_display_construction();
+}
+
+void mrf::DisplayReport::report_egl_configuration(EGLDisplay disp, EGLConfig cfg)
+{
+    next->report_egl_configuration(disp, cfg);
+}
+
+void mrf::DisplayReport::report_vsync(unsigned int output_id, graphics::Frame const& frame)
+{
+    // Flip times on other clocks can't be placed on the recorder's timeline
+    auto const flip_time = frame.ust.clock_id == CLOCK_MONOTONIC ? frame.ust.nanoseconds.count() : 0;
+
+    recorder->record(Recorder::Event::page_flip, output_id, frame.msc, flip_time);
+    next->report_vsync(output_id, frame);
+}
+
+void mrf::DisplayReport::report_successful_drm_mode_set_crtc_on_construction()
+{
+    next->report_successful_drm_mode_set_crtc_on_construction();
+}
+
+void mrf::DisplayReport::report_drm_master_failure(int error)
+{
+    next->report_drm_master_failure(error);
+}
+
+void mrf::DisplayReport::report_vt_switch_away_failure()
+{
+    next->report_vt_switch_away_failure();
+}
+
+void mrf::DisplayReport::report_vt_switch_back_failure()
+{
+    next->report_vt_switch_back_failure();
+}
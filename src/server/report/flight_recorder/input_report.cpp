@@ -0,0 +1,60 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_report.h"
+#include "recorder.h"
+
+namespace mrf = mir::report::flight_recorder;
+
+mrf::InputReport::InputReport(
+    std::shared_ptr<Recorder> const& recorder,
+    std::shared_ptr<input::InputReport> const& next) :
+    recorder{recorder},
+    next{next}
+{
+}
+
+void mrf::InputReport::received_event_from_kernel(int64_t when, int type, int code, int value)
+{
+    recorder->record(
+        Recorder::Event::input_received,
+        (static_cast<uint64_t>(type & 0xffff) << 16) | static_cast<uint64_t>(code & 0xffff),
+        value,
+        when);
+    next->received_event_from_kernel(when, type, code, value);
+}
+
+void mrf::InputReport::published_key_event(int dest_fd, uint32_t seq_id, int64_t event_time)
+{
+    recorder->record(Recorder::Event::input_published, dest_fd, seq_id, event_time);
+    next->published_key_event(dest_fd, seq_id, event_time);
+}
+
+void mrf::InputReport::published_motion_event(int dest_fd, uint32_t seq_id, int64_t event_time)
+{
+    recorder->record(Recorder::Event::input_published, dest_fd, seq_id, event_time);
+    next->published_motion_event(dest_fd, seq_id, event_time);
+}
+
+void mrf::InputReport::opened_input_device(char const* device_name, char const* input_platform)
+{
+    next->opened_input_device(device_name, input_platform);
+}
+
+void mrf::InputReport::failed_to_open_input_device(char const* device_name, char const* input_platform)
+{
+    next->failed_to_open_input_device(device_name, input_platform);
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recorder.h"
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <ostream>
+
+namespace mrf = mir::report::flight_recorder;
+
+namespace
+{
+// The history of threads that have exited is kept, but not without limit
+size_t const max_exited_rings = 8;
+
+auto now() -> int64_t
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+auto name_of_this_thread() -> std::string
+{
+    char name[16] = "";
+    pthread_getname_np(pthread_self(), name, sizeof name);
+    return name;
+}
+}
+
+/**
+ * One thread's records. The thread is the only writer; readers copy records without
+ * stopping it and discard any that may have been overwritten while they were copied.
+ */
+struct mrf::Recorder::Ring : PerThreadRing
+{
+    // Relaxed atomics compile to plain loads and stores, but make concurrent reads well defined
+    struct Slot
+    {
+        std::atomic<int64_t> time;
+        std::atomic<uint32_t> event;
+        std::atomic<uint64_t> id;
+        std::atomic<int64_t> value;
+        std::atomic<int64_t> extra;
+    };
+
+    explicit Ring(size_t size) :
+        size{size},
+        slots{new Slot[size]()},
+        thread{static_cast<pid_t>(syscall(SYS_gettid))},
+        thread_name{name_of_this_thread()}
+    {
+    }
+
+    void record(Event event, uint64_t id, int64_t value, int64_t extra)
+    {
+        auto const n = started.load(std::memory_order_relaxed);
+        auto& slot = slots[n % size];
+
+        // A reader seeing any of the new values below also sees that the old record is gone
+        started.store(n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.time.store(now(), std::memory_order_relaxed);
+        slot.event.store(static_cast<uint32_t>(event), std::memory_order_relaxed);
+        slot.id.store(id, std::memory_order_relaxed);
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.extra.store(extra, std::memory_order_relaxed);
+
+        finished.store(n + 1, std::memory_order_release);
+    }
+
+    void copy_to(std::vector<Record>& records) const
+    {
+        auto const end = finished.load(std::memory_order_acquire);
+        auto const begin = end > size ? end - size : 0;
+
+        std::vector<Record> copied;
+        copied.reserve(end - begin);
+        for (auto n = begin; n != end; ++n)
+        {
+            auto const& slot = slots[n % size];
+            copied.push_back({
+                slot.time.load(std::memory_order_relaxed),
+                thread,
+                static_cast<Event>(slot.event.load(std::memory_order_relaxed)),
+                slot.id.load(std::memory_order_relaxed),
+                slot.value.load(std::memory_order_relaxed),
+                slot.extra.load(std::memory_order_relaxed)});
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto const overwritten = started.load(std::memory_order_relaxed);
+        auto const first_intact = overwritten > size ? overwritten - size : 0;
+
+        auto const skip = std::min<uint64_t>(first_intact > begin ? first_intact - begin : 0, copied.size());
+        records.insert(records.end(), copied.begin() + skip, copied.end());
+    }
+
+    size_t const size;
+    std::unique_ptr<Slot[]> const slots;
+    std::atomic<uint64_t> started{0};
+    std::atomic<uint64_t> finished{0};
+    pid_t const thread;
+    std::string const thread_name;
+};
+
+namespace
+{
+auto event_name(mrf::Recorder::Event event) -> char const*
+{
+    switch (event)
+    {
+    case mrf::Recorder::Event::frame_began:
+    case mrf::Recorder::Event::frame_finished:
+        return "composite";
+    case mrf::Recorder::Event::frame_rendered:
+        return "rendered";
+    case mrf::Recorder::Event::buffer_consumed:
+        return "buffer consumed";
+    case mrf::Recorder::Event::page_flip:
+        return "page flip";
+    case mrf::Recorder::Event::buffer_submitted:
+        return "buffer submitted";
+    case mrf::Recorder::Event::input_received:
+        return "input received";
+    case mrf::Recorder::Event::input_published:
+        return "input published";
+    }
+    return "unknown";
+}
+
+auto category(mrf::Recorder::Event event) -> char const*
+{
+    switch (event)
+    {
+    case mrf::Recorder::Event::input_received:
+    case mrf::Recorder::Event::input_published:
+        return "input";
+    case mrf::Recorder::Event::buffer_submitted:
+        return "client";
+    default:
+        return "compositor";
+    }
+}
+
+auto phase(mrf::Recorder::Event event) -> char
+{
+    switch (event)
+    {
+    case mrf::Recorder::Event::frame_began:
+        return 'B';
+    case mrf::Recorder::Event::frame_finished:
+        return 'E';
+    default:
+        return 'i';
+    }
+}
+
+void write_string(std::ostream& out, std::string const& text)
+{
+    out << '"';
+    for (auto const c : text)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) >= ' ')
+            out << c;
+    }
+    out << '"';
+}
+
+void write_timestamp(std::ostream& out, int64_t nanoseconds)
+{
+    // The format's timestamps are in microseconds
+    out << nanoseconds / 1000 << '.';
+    auto const fraction = nanoseconds % 1000;
+    out << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "") << fraction;
+}
+
+void write_args(std::ostream& out, mrf::Recorder::Record const& record)
+{
+    using Event = mrf::Recorder::Event;
+
+    switch (record.event)
+    {
+    case Event::frame_began:
+    case Event::frame_rendered:
+    case Event::frame_finished:
+        out << "{\"display_buffer\":" << record.id << '}';
+        break;
+    case Event::buffer_consumed:
+        out << "{\"display_buffer\":" << record.id << ",\"buffer\":" << record.value << '}';
+        break;
+    case Event::page_flip:
+        out << "{\"output\":" << record.id << ",\"msc\":" << record.value << ",\"flip_time\":";
+        write_timestamp(out, record.extra);
+        out << '}';
+        break;
+    case Event::buffer_submitted:
+        out << "{\"surface\":" << record.id << ",\"frames_available\":" << record.value << '}';
+        break;
+    case Event::input_received:
+        out << "{\"type\":" << (record.id >> 16) << ",\"code\":" << (record.id & 0xffff)
+            << ",\"value\":" << record.value << ",\"kernel_time\":";
+        write_timestamp(out, record.extra);
+        out << '}';
+        break;
+    case Event::input_published:
+        out << "{\"fd\":" << record.id << ",\"sequence\":" << record.value << ",\"event_time\":";
+        write_timestamp(out, record.extra);
+        out << '}';
+        break;
+    }
+}
+}
+
+mrf::Recorder::Recorder(size_t records_per_thread) :
+    records_per_thread{std::max<size_t>(records_per_thread, 1)}
+{
+}
+
+mrf::Recorder::~Recorder()
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    for (auto const& ring : rings)
+        ring->owner_destroyed = true;
+}
+
+void mrf::Recorder::record(Event event, uint64_t id, int64_t value, int64_t extra)
+{
+    ring_for_this_thread().record(event, id, value, extra);
+}
+
+auto mrf::Recorder::records() const -> std::vector<Record>
+{
+    std::vector<std::shared_ptr<Ring>> current;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        current = rings;
+    }
+
+    std::vector<Record> result;
+    for (auto const& ring : current)
+        ring->copy_to(result);
+
+    std::stable_sort(result.begin(), result.end(),
+        [](Record const& lhs, Record const& rhs) { return lhs.time < rhs.time; });
+
+    return result;
+}
+
+void mrf::Recorder::write_trace(std::ostream& out) const
+{
+    auto const pid = getpid();
+    auto const all = records();
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        for (auto const& ring : rings)
+        {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << ring->thread
+                << ",\"args\":{\"name\":";
+            write_string(out, ring->thread_name);
+            out << "}}";
+        }
+    }
+
+    for (auto const& record : all)
+    {
+        out << (first ? "\n" : ",\n");
+        first = false;
+
+        auto const ph = phase(record.event);
+        out << "{\"name\":\"" << event_name(record.event) << "\",\"cat\":\"" << category(record.event)
+            << "\",\"ph\":\"" << ph << "\",\"ts\":";
+        write_timestamp(out, record.time);
+        out << ",\"pid\":" << pid << ",\"tid\":" << record.thread;
+        if (ph == 'i')
+            out << ",\"s\":\"t\"";
+        out << ",\"args\":";
+        write_args(out, record);
+        out << '}';
+    }
+
+    out << "\n]}\n";
+}
+
+auto mrf::Recorder::ring_for_this_thread() -> Ring&
+{
+    return thread_rings.for_this_thread([this]
+        {
+            auto const ring = std::make_shared<Ring>(records_per_thread);
+            std::lock_guard<decltype(mutex)> lock{mutex};
+
+            auto exited = std::count_if(rings.begin(), rings.end(),
+                [](auto const& ring) { return ring->thread_exited.load(); });
+            for (auto i = rings.begin(); exited > static_cast<long>(max_exited_rings) && i != rings.end();)
+            {
+                if ((*i)->thread_exited)
+                {
+                    i = rings.erase(i);
+                    --exited;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            rings.push_back(ring);
+            return ring;
+        });
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_FLIGHT_RECORDER_RECORDER_H_
+#define MIR_REPORT_FLIGHT_RECORDER_RECORDER_H_
+
+#include "mir/per_thread_rings.h"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mir
+{
+namespace report
+{
+namespace flight_recorder
+{
+/**
+ * Keeps the most recent frame and input timing events of each thread, so that the last
+ * few seconds before a stutter can be dumped without having reproduced it under a tracer.
+ *
+ * Recording reads the monotonic clock and stores into a fixed-size ring owned by the
+ * calling thread: it takes no locks, and the oldest records are overwritten.
+ */
+class Recorder
+{
+public:
+    enum class Event : uint32_t
+    {
+        frame_began,        ///< id: display buffer compositor
+        frame_rendered,     ///< id: display buffer compositor
+        frame_finished,     ///< id: display buffer compositor
+        buffer_consumed,    ///< id: display buffer compositor, value: buffer id
+        page_flip,          ///< id: output, value: media stream counter, extra: flip time (CLOCK_MONOTONIC ns)
+        buffer_submitted,   ///< id: surface, value: frames available
+        input_received,     ///< id: (type << 16) | code, value: value, extra: kernel time (ns)
+        input_published,    ///< id: client fd, value: sequence id, extra: event time (ns)
+    };
+
+    struct Record
+    {
+        int64_t time;       ///< CLOCK_MONOTONIC ns
+        pid_t thread;
+        Event event;
+        uint64_t id;
+        int64_t value;
+        int64_t extra;
+    };
+
+    static size_t const default_records_per_thread = 16384;
+
+    explicit Recorder(size_t records_per_thread = default_records_per_thread);
+    ~Recorder();
+
+    void record(Event event, uint64_t id, int64_t value = 0, int64_t extra = 0);
+
+    /// The records still held, oldest first
+    auto records() const -> std::vector<Record>;
+
+    /// Writes the records in the JSON Trace Event Format read by chrome://tracing and Perfetto
+    void write_trace(std::ostream& out) const;
+
+    struct Ring;
+
+private:
+    auto ring_for_this_thread() -> Ring&;
+
+    size_t const records_per_thread;
+    PerThreadRings<Ring> thread_rings;
+
+    std::mutex mutable mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+};
+}
+}
+}
+
+#endif // MIR_REPORT_FLIGHT_RECORDER_RECORDER_H_
@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "scene_observer.h"
+#include "recorder.h"
+
+#include "mir/scene/null_surface_observer.h"
+#include "mir/scene/surface.h"
+
+namespace mrf = mir::report::flight_recorder;
+namespace ms = mir::scene;
+
+namespace
+{
+class SubmissionRecorder : public ms::NullSurfaceObserver
+{
+public:
+    explicit SubmissionRecorder(std::shared_ptr<mrf::Recorder> const& recorder) :
+        recorder{recorder}
+    {
+    }
+
+    void frame_posted(ms::Surface const* surface, int frames_available, mir::geometry::Size const&) override
+    {
+        recorder->record(
+            mrf::Recorder::Event::buffer_submitted,
+            reinterpret_cast<uintptr_t>(surface),
+            frames_available);
+    }
+
+private:
+    std::shared_ptr<mrf::Recorder> const recorder;
+};
+}
+
+mrf::SceneObserver::SceneObserver(std::shared_ptr<Recorder> const& recorder) :
+    surface_observer{std::make_shared<SubmissionRecorder>(recorder)}
+{
+}
+
+mrf::SceneObserver::~SceneObserver()
+{
+    end_observation();
+}
+
+void mrf::SceneObserver::surface_added(std::shared_ptr<ms::Surface> const& surface)
+{
+    surface->add_observer(surface_observer);
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    surfaces[surface.get()] = surface;
+}
+
+void mrf::SceneObserver::surface_exists(std::shared_ptr<ms::Surface> const& surface)
+{
+    surface_added(surface);
+}
+
+void mrf::SceneObserver::surface_removed(std::shared_ptr<ms::Surface> const& surface)
+{
+    surface->remove_observer(surface_observer);
+
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    surfaces.erase(surface.get());
+}
+
+void mrf::SceneObserver::end_observation()
+{
+    std::lock_guard<decltype(mutex)> lock{mutex};
+    for (auto const& entry : surfaces)
+    {
+        if (auto const surface = entry.second.lock())
+            surface->remove_observer(surface_observer);
+    }
+    surfaces.clear();
+}
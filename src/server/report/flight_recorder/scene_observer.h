@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_FLIGHT_RECORDER_SCENE_OBSERVER_H_
+#define MIR_REPORT_FLIGHT_RECORDER_SCENE_OBSERVER_H_
+
+#include "mir/scene/null_observer.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+namespace scene
+{
+class Surface;
+class SurfaceObserver;
+}
+namespace report
+{
+namespace flight_recorder
+{
+class Recorder;
+
+/// Records each buffer a client submits to a surface in the scene
+class SceneObserver : public scene::NullObserver
+{
+public:
+    explicit SceneObserver(std::shared_ptr<Recorder> const& recorder);
+    ~SceneObserver();
+
+    void surface_added(std::shared_ptr<scene::Surface> const& surface) override;
+    void surface_removed(std::shared_ptr<scene::Surface> const& surface) override;
+    void surface_exists(std::shared_ptr<scene::Surface> const& surface) override;
+    void end_observation() override;
+
+private:
+    std::shared_ptr<scene::SurfaceObserver> const surface_observer;
+
+    std::mutex mutex;
+    std::map<scene::Surface*, std::weak_ptr<scene::Surface>> surfaces;
+};
+}
+}
+}
+
+#endif // MIR_REPORT_FLIGHT_RECORDER_SCENE_OBSERVER_H_
@@ -153,3 +153,15 @@ void mrl::ShellReport::surfaces_raised(shell::SurfaceSet const& surfaces)
 {
     log->log(Severity::informational, "Raising " + boost::lexical_cast<std::string>(surfaces.size()) + " surfaces", component);
 }
+
+void mrl::ShellReport::window_management_lock_contention(shell::LockContention const& contention)
+{
+    std::ostringstream out;
+
+    out << "Window management lock: " << contention.exclusive_contended << " of "
+        << contention.exclusive_acquisitions << " exclusive and " << contention.shared_contended << " of "
+        << contention.shared_acquisitions << " shared acquisitions waited, for "
+        << std::chrono::duration_cast<std::chrono::microseconds>(contention.time_waiting).count() << "us in total";
+
+    log->log(Severity::informational, out.str(), component);
+}
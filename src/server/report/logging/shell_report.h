@@ -75,6 +75,8 @@ public:
 
     void surfaces_raised(shell::SurfaceSet const& surfaces) override;
 
+    void window_management_lock_contention(shell::LockContention const& contention) override;
+
 private:
     std::shared_ptr<mir::logging::Logger> const log;
 };
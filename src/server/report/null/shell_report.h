@@ -71,6 +71,8 @@ class ShellReport : public shell::ShellReport
         scene::Surface const* /*focus_surface*/) override;
 
     void surfaces_raised(shell::SurfaceSet const& /*surfaces*/) override;
+
+    void window_management_lock_contention(shell::LockContention const& /*contention*/) override;
 };
 }
 }
@@ -21,6 +21,8 @@
 #include "mir/default_server_configuration.h"
 #include "mir/options/option.h"
 #include "logging/display_configuration_report.h"
+#include "flight_recorder/scene_observer.h"
+#include "mir/compositor/scene.h"
 #include "mir/observer_multiplexer.h"
 #include "mir/options/configuration.h"
 #include "mir/abnormal_exit.h"
@@ -122,6 +124,14 @@ std::shared_ptr<mir::frontend::SessionMediatorObserver> create_session_mediator_
         std::throw_with_nested(mir::AbnormalExit("Failed to create report for "s + mo::session_mediator_report_opt));
     }
 }
+
+auto create_flight_recorder_observer(mir::DefaultServerConfiguration& config) -> std::shared_ptr<mir::scene::Observer>
+{
+    if (auto const recorder = config.the_flight_recorder())
+        return std::make_shared<mr::flight_recorder::SceneObserver>(recorder);
+
+    return nullptr;
+}
 }
 
 mir::report::Reports::Reports(
@@ -135,9 +145,20 @@ mir::report::Reports::Reports(
           create_session_mediator_reports(
               server,
               options.get<std::string>(mo::session_mediator_report_opt))},
-      session_mediator_observer_multiplexer{server.the_session_mediator_observer_registrar()}
+      session_mediator_observer_multiplexer{server.the_session_mediator_observer_registrar()},
+      scene{server.the_scene()},
+      flight_recorder_observer{create_flight_recorder_observer(server)}
 {
     display_configuration_multiplexer->register_interest(display_configuration_report);
     seat_observer_multiplexer->register_interest(seat_report);
     session_mediator_observer_multiplexer->register_interest(session_mediator_report);
+
+    if (flight_recorder_observer)
+        scene->add_observer(flight_recorder_observer);
+}
+
+mir::report::Reports::~Reports()
+{
+    if (flight_recorder_observer)
+        scene->remove_observer(flight_recorder_observer);
 }
@@ -45,6 +45,14 @@ namespace frontend
 {
 class SessionMediatorObserver;
 }
+namespace compositor
+{
+class Scene;
+}
+namespace scene
+{
+class Observer;
+}
 
 namespace report
 {
@@ -59,6 +67,7 @@ class Reports
 {
 public:
     Reports(DefaultServerConfiguration& server, options::Option const& options);
+    ~Reports();
 
 private:
     std::shared_ptr<logging::DisplayConfigurationReport> const display_configuration_report;
@@ -68,6 +77,8 @@ private:
     std::shared_ptr<frontend::SessionMediatorObserver> const session_mediator_report;
     std::shared_ptr<ObserverRegistrar<frontend::SessionMediatorObserver>> const
         session_mediator_observer_multiplexer;
+    std::shared_ptr<compositor::Scene> const scene;
+    std::shared_ptr<scene::Observer> const flight_recorder_observer;
 };
 }
 }
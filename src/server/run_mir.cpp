@@ -25,6 +25,7 @@
 #include "mir/frontend/connector.h"
 #include "mir/raii.h"
 #include "mir/emergency_cleanup.h"
+#include "mir/startup_timeline.h"
 
 #include <atomic>
 #include <exception>
@@ -75,6 +76,7 @@ void mir::run_mir(
 {
     DisplayServer* server_ptr{nullptr};
     clear_termination_exception();
+    startup_timeline::started();
 
     auto const main_loop = config.the_main_loop();
 
@@ -97,6 +99,7 @@ void mir::run_mir(
 
     DisplayServer server(config);
     server_ptr = &server;
+    startup_timeline::phase_completed("Server constructed");
 
     weak_emergency_cleanup = config.the_emergency_cleanup();
 
@@ -273,7 +273,7 @@ ms::BasicSurface::BasicSurface(
     surface_alpha(1.0f),
     hidden(false),
     input_mode(mi::InputReceptionMode::normal),
-    custom_input_rectangles(),
+    custom_input_region(),
     surface_buffer_stream(default_stream(layers)),
     cursor_image_(cursor_image),
     report(report),
@@ -366,8 +366,13 @@ std::shared_ptr<mf::BufferStream> ms::BasicSurface::primary_buffer_stream() cons
 
 void ms::BasicSurface::set_input_region(std::vector<geom::Rectangle> const& input_rectangles)
 {
+    // Build the region before taking the lock: input_area_contains() is called for every input event
+    std::experimental::optional<geom::Region> region;
+    if (!input_rectangles.empty())
+        region = geom::Region{input_rectangles};
+
     std::lock_guard<std::mutex> lock(guard);
-    custom_input_rectangles = input_rectangles;
+    custom_input_region = std::move(region);
 }
 
 void ms::BasicSurface::resize(geom::Size const& desired_size)
@@ -414,22 +419,14 @@ bool ms::BasicSurface::input_area_contains(geom::Point const& point) const
             return false;
     }
 
-    if (custom_input_rectangles.empty())
+    if (!custom_input_region)
     {
         // no custom input, restrict to bounding rectangle
         auto const input_rect = geom::Rectangle{content_top_left(lock), content_size(lock)};
         return input_rect.contains(point);
     }
-    else
-    {
-        auto local_point = as_point(point - content_top_left(lock));
-        for (auto const& rectangle : custom_input_rectangles)
-        {
-            if (rectangle.contains(local_point))
-                return true;
-        }
-    }
-    return false;
+
+    return custom_input_region.value().contains(as_point(point - content_top_left(lock)));
 }
 
 void ms::BasicSurface::set_alpha(float alpha)
@@ -24,6 +24,7 @@
 #include "mir/scene/surface_observers.h"
 
 #include "mir/geometry/rectangle.h"
+#include "mir/geometry/region.h"
 
 #include "mir_toolkit/common.h"
 
@@ -194,7 +195,8 @@ private:
     float surface_alpha;
     bool hidden;
     input::InputReceptionMode input_mode;
-    std::vector<geometry::Rectangle> custom_input_rectangles;
+    /// In content coordinates. If unset, input is accepted anywhere on the content
+    std::experimental::optional<geometry::Region> custom_input_region;
     std::shared_ptr<compositor::BufferStream> const surface_buffer_stream;
     std::shared_ptr<graphics::CursorImage> cursor_image_;
     std::shared_ptr<SceneReport> const report;
@@ -474,10 +474,23 @@ void ms::MediatingDisplayChanger::apply_config(
         if (configuration_has_new_outputs_enabled(*display->configuration(), *conf) ||
             !display->apply_if_configuration_preserves_display_buffers(*conf))
         {
-            ApplyNowAndRevertOnScopeExit comp{
-                [this] { compositor->stop(); },
-                [this] { compositor->start(); }};
-            display->configure(*conf);
+            /*
+             * Where the platform supports it only the outputs that change stop
+             * compositing. Otherwise everything stops while the display is configured.
+             */
+            if (display->apply_if_configuration_preserves_unchanged_sync_groups(
+                    *conf,
+                    [this](mg::DisplaySyncGroup& group) { compositor->remove_display_sync_group(group); }))
+            {
+                compositor->add_new_display_sync_groups();
+            }
+            else
+            {
+                ApplyNowAndRevertOnScopeExit comp{
+                    [this] { compositor->stop(); },
+                    [this] { compositor->start(); }};
+                display->configure(*conf);
+            }
         }
 
         observer->configuration_applied(conf);
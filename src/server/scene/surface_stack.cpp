@@ -152,6 +152,7 @@ ms::SurfaceStack::~SurfaceStack() noexcept(true)
 
 mc::SceneElementSequence ms::SurfaceStack::scene_elements_for(mc::CompositorID id)
 {
+    RecursiveReadLock atomic_update_lock(atomic_update_guard);
     RecursiveReadLock lg(guard);
 
     scene_changed = false;
@@ -253,13 +254,45 @@ void ms::SurfaceStack::remove_input_visualization(
     emit_scene_changed();
 }
 
+void ms::SurfaceStack::apply_atomically(std::function<void()> const& changes)
+{
+    {
+        RecursiveWriteLock lg(atomic_update_guard);
+        ++atomic_update_depth;
+        try
+        {
+            changes();
+        }
+        catch (...)
+        {
+            --atomic_update_depth;
+            throw;
+        }
+
+        if (--atomic_update_depth)
+            return;
+    }
+
+    // Any compositor woken by the changes has waited for all of them, so one notification suffices
+    emit_scene_changed();
+}
+
 void ms::SurfaceStack::emit_scene_changed()
 {
     {
         RecursiveWriteLock lg(guard);
         scene_changed = true;
     }
-    observers.scene_changed();
+
+    if (!atomic_update_depth)
+        observers.scene_changed();
+}
+
+void ms::SurfaceStack::emit_scene_damaged(geometry::Rectangle const& damage)
+{
+    // Unlike emit_scene_changed() we don't flag a change for every compositor:
+    // only those whose outputs overlap the damage need to recomposite.
+    observers.scene_damaged(damage);
 }
 
 void ms::SurfaceStack::add_surface(
@@ -502,6 +535,12 @@ void ms::Observers::scene_changed()
         { observer->scene_changed(); });
 }
 
+void ms::Observers::scene_damaged(geometry::Rectangle const& damage)
+{
+   for_each([&](std::shared_ptr<Observer> const& observer)
+        { observer->scene_damaged(damage); });
+}
+
 void ms::Observers::surface_exists(std::shared_ptr<Surface> const& surface)
 {
     for_each([&](std::shared_ptr<Observer> const& observer)
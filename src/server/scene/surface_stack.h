@@ -59,6 +59,7 @@ public:
    void surface_removed(std::shared_ptr<Surface> const& surface) override;
    void surfaces_reordered() override;
    void scene_changed() override;
+   void scene_damaged(geometry::Rectangle const& damage) override;
    void surface_exists(std::shared_ptr<Surface> const& surface) override;
    void end_observation() override;
 
@@ -98,6 +99,8 @@ public:
 
     auto surface_at(geometry::Point) const -> std::shared_ptr<Surface> override;
 
+    void apply_atomically(std::function<void()> const& changes) override;
+
     void add_observer(std::shared_ptr<Observer> const& observer) override;
     void remove_observer(std::weak_ptr<Observer> const& observer) override;
 
@@ -106,6 +109,7 @@ public:
     void remove_input_visualization(std::weak_ptr<graphics::Renderable> const& overlay) override;
 
     void emit_scene_changed() override;
+    void emit_scene_damaged(geometry::Rectangle const& damage) override;
 
 private:
     SurfaceStack(const SurfaceStack&) = delete;
@@ -116,6 +120,12 @@ private:
 
     RecursiveReadWriteMutex mutable guard;
 
+    /// Held for writing by apply_atomically() and for reading while compositors snapshot the scene.
+    /// Unlike guard it is held while observers are notified, so it must only be taken before guard.
+    RecursiveReadWriteMutex atomic_update_guard;
+    /// While non-zero scene changes are flagged, but observers are only notified once they are all applied
+    std::atomic<int> atomic_update_depth{0};
+
     std::shared_ptr<SceneReport> const report;
 
     /**
@@ -533,6 +533,11 @@ void msh::AbstractShell::raise(SurfaceSet const& surfaces)
     report->surfaces_raised(surfaces);
 }
 
+void msh::AbstractShell::apply_atomically(std::function<void()> const& changes)
+{
+    surface_stack->apply_atomically(changes);
+}
+
 void msh::AbstractShell::set_drag_and_drop_handle(std::vector<uint8_t> const& handle)
 {
     input_targeter->set_drag_and_drop_handle(handle);
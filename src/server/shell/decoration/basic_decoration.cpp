@@ -44,6 +44,7 @@ namespace ms = mir::scene;
 namespace mg = mir::graphics;
 namespace mc = mir::compositor;
 namespace geom = mir::geometry;
+namespace mi = mir::input;
 namespace msh = mir::shell;
 namespace msd = mir::shell::decoration;
 
@@ -118,7 +119,17 @@ public:
 
     auto create_buffer_stream() -> std::shared_ptr<mc::BufferStream>;
 
+    struct Button
+    {
+        std::shared_ptr<mc::BufferStream> const background;
+        std::shared_ptr<mc::BufferStream> const icon;
+    };
+
+    /// The streams for the nth button, created the first time they're needed
+    auto button(unsigned n) -> Button const&;
+
     std::shared_ptr<mc::BufferStream> const titlebar;
+    std::shared_ptr<mc::BufferStream> const title;
     std::shared_ptr<mc::BufferStream> const left_border;
     std::shared_ptr<mc::BufferStream> const right_border;
     std::shared_ptr<mc::BufferStream> const bottom_border;
@@ -127,11 +138,13 @@ private:
     BufferStreams(BufferStreams const&) = delete;
     BufferStreams& operator=(BufferStreams const&) = delete;
 
+    std::vector<Button> buttons;
 };
 
 msd::BasicDecoration::BufferStreams::BufferStreams(std::shared_ptr<scene::Session> const& session)
     : session{session},
       titlebar{create_buffer_stream()},
+      title{create_buffer_stream()},
       left_border{create_buffer_stream()},
       right_border{create_buffer_stream()},
       bottom_border{create_buffer_stream()}
@@ -141,9 +154,15 @@ msd::BasicDecoration::BufferStreams::BufferStreams(std::shared_ptr<scene::Sessio
 msd::BasicDecoration::BufferStreams::~BufferStreams()
 {
     session->destroy_buffer_stream(titlebar);
+    session->destroy_buffer_stream(title);
     session->destroy_buffer_stream(left_border);
     session->destroy_buffer_stream(right_border);
     session->destroy_buffer_stream(bottom_border);
+    for (auto const& button : buttons)
+    {
+        session->destroy_buffer_stream(button.background);
+        session->destroy_buffer_stream(button.icon);
+    }
 }
 
 auto msd::BasicDecoration::BufferStreams::create_buffer_stream() -> std::shared_ptr<mc::BufferStream>
@@ -156,6 +175,16 @@ auto msd::BasicDecoration::BufferStreams::create_buffer_stream() -> std::shared_
     return stream;
 }
 
+auto msd::BasicDecoration::BufferStreams::button(unsigned n) -> Button const&
+{
+    while (buttons.size() <= n)
+    {
+        auto const background = create_buffer_stream();
+        buttons.push_back(Button{background, create_buffer_stream()});
+    }
+    return buttons[n];
+}
+
 msd::BasicDecoration::BasicDecoration(
     std::shared_ptr<msh::Shell> const& shell,
     std::shared_ptr<mg::GraphicBufferAllocator> const& buffer_allocator,
@@ -275,8 +304,7 @@ void msd::BasicDecoration::request_close()
 void msd::BasicDecoration::set_cursor(std::string const& cursor_image_name)
 {
     msh::SurfaceSpecification spec;
-    // size is hard-coded because current implementation ignores it
-    spec.cursor_image = cursor_images->image(cursor_image_name, {16, 16});
+    spec.cursor_image = cursor_images->image(cursor_image_name, mi::default_cursor_size);
     shell->modify_surface(session, decoration_surface, spec);
 }
 
@@ -322,6 +350,20 @@ void msd::BasicDecoration::update(
             as_delta(window_state->side_border_width()));
     }
 
+    if (window_updated({
+            &WindowState::focused_state,
+            &WindowState::window_name,
+            &WindowState::titlebar_rect,
+            &WindowState::left_border_rect,
+            &WindowState::right_border_rect,
+            &WindowState::bottom_border_rect}) ||
+        input_updated({
+            &InputState::buttons}))
+    {
+        // Before the streams are specified, as they depend on the size of the title
+        renderer->update_state(*window_state, *input_state);
+    }
+
     msh::SurfaceSpecification spec;
 
     if (window_updated({
@@ -339,6 +381,7 @@ void msd::BasicDecoration::update(
 
     if (window_updated({
             &WindowState::border_type,
+            &WindowState::window_name,
             &WindowState::titlebar_rect,
             &WindowState::left_border_rect,
             &WindowState::right_border_rect,
@@ -347,20 +390,34 @@ void msd::BasicDecoration::update(
         spec.streams = std::vector<StreamSpecification>{};
         auto const emplace = [&](std::shared_ptr<mc::BufferStream> stream, geom::Rectangle rect)
             {
+                // Each stream's buffer is stretched to rect, so solid colors need only one pixel
                 if (rect.size.width > geom::Width{} && rect.size.height > geom::Height{})
                     spec.streams.value().emplace_back(StreamSpecification{stream, as_displacement(rect.top_left), rect.size});
             };
+        auto const emplace_titlebar = [&]()
+            {
+                // Streams are drawn in order, so later ones go on top
+                emplace(buffer_streams->titlebar, window_state->titlebar_rect());
+                emplace(buffer_streams->title, renderer->title_rect());
+                auto const& buttons = input_state->buttons();
+                for (unsigned i = 0; i < buttons.size(); i++)
+                {
+                    auto const& streams = buffer_streams->button(i);
+                    emplace(streams.background, buttons[i].rect);
+                    emplace(streams.icon, renderer->icon_rect(buttons[i].rect));
+                }
+            };
 
         switch (window_state->border_type())
         {
         case BorderType::Full:
-            emplace(buffer_streams->titlebar, window_state->titlebar_rect());
+            emplace_titlebar();
             emplace(buffer_streams->left_border, window_state->left_border_rect());
             emplace(buffer_streams->right_border, window_state->right_border_rect());
             emplace(buffer_streams->bottom_border, window_state->bottom_border_rect());
             break;
         case BorderType::Titlebar:
-            emplace(buffer_streams->titlebar, window_state->titlebar_rect());
+            emplace_titlebar();
             break;
         case BorderType::None:
             break;
@@ -372,41 +429,24 @@ void msd::BasicDecoration::update(
         shell->modify_surface(session, decoration_surface, spec);
     }
 
-    if (window_updated({
-            &WindowState::focused_state,
-            &WindowState::window_name,
-            &WindowState::titlebar_rect,
-            &WindowState::left_border_rect,
-            &WindowState::right_border_rect,
-            &WindowState::bottom_border_rect}) ||
-        input_updated({
-            &InputState::buttons}))
-    {
-        renderer->update_state(*window_state, *input_state);
-    }
-
     std::vector<std::pair<
         std::shared_ptr<mc::BufferStream>,
         std::experimental::optional<std::shared_ptr<mg::Buffer>>>> new_buffers;
 
+    // The frame is solid colors stretched to fit, so only needs new buffers when the colors change. They are
+    // rendered even for borders that are currently empty, as those streams aren't resubmitted when they grow.
     if (window_updated({
-            &WindowState::focused_state,
-            &WindowState::side_border_width,
-            &WindowState::side_border_height}))
+            &WindowState::focused_state}))
     {
+        new_buffers.emplace_back(
+            buffer_streams->titlebar,
+            renderer->render_titlebar());
         new_buffers.emplace_back(
             buffer_streams->left_border,
             renderer->render_left_border());
         new_buffers.emplace_back(
             buffer_streams->right_border,
             renderer->render_right_border());
-    }
-
-    if (window_updated({
-            &WindowState::focused_state,
-            &WindowState::bottom_border_width,
-            &WindowState::bottom_border_height}))
-    {
         new_buffers.emplace_back(
             buffer_streams->bottom_border,
             renderer->render_bottom_border());
@@ -419,9 +459,38 @@ void msd::BasicDecoration::update(
         input_updated({
             &InputState::buttons}))
     {
+        // nullopt (so nothing is submitted) unless the title's text, color or size changed
         new_buffers.emplace_back(
-            buffer_streams->titlebar,
-            renderer->render_titlebar());
+            buffer_streams->title,
+            renderer->render_title());
+    }
+
+    if (input_updated({
+            &InputState::buttons}))
+    {
+        auto const& buttons = input_state->buttons();
+        for (unsigned i = 0; i < buttons.size(); i++)
+        {
+            auto const& streams = buffer_streams->button(i);
+            auto const previous = previous_input_state.value_or(nullptr);
+            bool const existed = previous && i < previous->buttons().size();
+
+            if (!existed || previous->buttons()[i].state != buttons[i].state)
+            {
+                new_buffers.emplace_back(
+                    streams.background,
+                    renderer->render_button_background(buttons[i]));
+            }
+
+            if (!existed ||
+                previous->buttons()[i].function != buttons[i].function ||
+                previous->buttons()[i].rect.size != buttons[i].rect.size)
+            {
+                new_buffers.emplace_back(
+                    streams.icon,
+                    renderer->render_button_icon(buttons[i]));
+            }
+        }
     }
 
     for (auto const& pair : new_buffers)
@@ -22,6 +22,7 @@
 #include "input.h"
 
 #include "mir/graphics/graphic_buffer_allocator.h"
+#include "mir/graphics/solid_color_buffer.h"
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/geometry/displacement.h"
 #include "mir/log.h"
@@ -184,6 +185,8 @@ public:
         geom::Height height_pixels,
         Pixel color) override;
 
+    auto rendered_width(std::string const& text, geom::Height height_pixels) -> geom::Width override;
+
 private:
     std::mutex mutex;
     FT_Library library;
@@ -216,6 +219,11 @@ public:
     {
     }
 
+    auto rendered_width(std::string const&, geom::Height) -> geom::Width override
+    {
+        return {};
+    }
+
 private:
 };
 
@@ -242,6 +250,33 @@ auto msd::Renderer::Text::instance() -> std::shared_ptr<Text>
     return shared;
 }
 
+std::mutex msd::Renderer::IconAtlas::static_mutex;
+std::weak_ptr<msd::Renderer::IconAtlas> msd::Renderer::IconAtlas::singleton;
+
+auto msd::Renderer::IconAtlas::instance() -> std::shared_ptr<IconAtlas>
+{
+    std::lock_guard<std::mutex> lock{static_mutex};
+    auto shared = singleton.lock();
+    if (!shared)
+    {
+        shared = std::make_shared<IconAtlas>();
+        singleton = shared;
+    }
+    return shared;
+}
+
+auto msd::Renderer::IconAtlas::icon(
+    ButtonFunction function,
+    geom::Size size,
+    std::function<std::shared_ptr<mg::Buffer>()> const& draw) -> std::shared_ptr<mg::Buffer>
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    auto& icon = icons[std::make_tuple(function, size.width.as_int(), size.height.as_int())];
+    if (!icon)
+        icon = draw();
+    return icon;
+}
+
 msd::Renderer::Text::Impl::Impl()
 {
     if (auto const error = FT_Init_FreeType(&library))
@@ -326,6 +361,36 @@ void msd::Renderer::Text::Impl::render(
     }
 }
 
+auto msd::Renderer::Text::Impl::rendered_width(std::string const& text, geom::Height height_pixels) -> geom::Width
+{
+    if (height_pixels <= geom::Height{})
+        return {};
+
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (!library || !face)
+        return {};
+
+    try
+    {
+        set_char_size(height_pixels);
+    }
+    catch (std::runtime_error const& error)
+    {
+        log_warning(error.what());
+        return {};
+    }
+
+    int width{0};
+    for (char32_t const glyph : utf8_to_utf32(text))
+    {
+        // Loading (without rendering) is enough to get the advance
+        if (!FT_Load_Glyph(face, FT_Get_Char_Index(face, glyph), 0))
+            width += face->glyph->advance.x / 64;
+    }
+    return geom::Width{width};
+}
+
 void msd::Renderer::Text::Impl::set_char_size(geom::Height height)
 {
     if (auto const error = FT_Set_Pixel_Sizes(face, 0, height.as_int()))
@@ -375,12 +440,14 @@ void msd::Renderer::Text::Impl::render_glyph(
             geom::X const glyph_x = buffer_x - glyph_offset.dx;
             unsigned char const glyph_alpha = ((int)glyph_row[glyph_x.as_int()] * color_alpha) / 255;
             unsigned char* const buffer_pixels = (unsigned char *)(buffer_row + buffer_x.as_int());
-            for (int i = 0; i < 3; i++)
+            for (int i = 0; i < 4; i++)
             {
-                // Blend color with the previous buffer color based on the glyph's alpha
+                // Blend color over the previous (premultiplied) buffer color based on the glyph's alpha
+                // The color's own alpha is already in glyph_alpha, so it contributes a fully opaque alpha
+                unsigned char const color_channel = (i == 3) ? 0xFF : color_pixels[i];
                 buffer_pixels[i] =
                     ((int)buffer_pixels[i] * (255 - glyph_alpha)) / 255 +
-                    ((int)color_pixels[i] * glyph_alpha) / 255;
+                    ((int)color_channel * glyph_alpha) / 255;
             }
         }
     }
@@ -462,33 +529,13 @@ msd::Renderer::Renderer(
               render_minimize_icon}},
       },
       static_geometry{static_geometry},
-      text{Text::instance()}
+      text{Text::instance()},
+      icon_atlas{IconAtlas::instance()}
 {
 }
 
 void msd::Renderer::update_state(WindowState const& window_state, InputState const& input_state)
 {
-    left_border_size = window_state.left_border_rect().size;
-    right_border_size = window_state.right_border_rect().size;
-    bottom_border_size = window_state.bottom_border_rect().size;
-
-    size_t length{0};
-    length = std::max(length, area(left_border_size));
-    length = std::max(length, area(right_border_size));
-    length = std::max(length, area(bottom_border_size));
-
-    if (length != solid_color_pixels_length)
-    {
-        solid_color_pixels_length = length;
-        solid_color_pixels.reset(); // force a reallocation next time it's needed
-    }
-
-    if (window_state.titlebar_rect().size != titlebar_size)
-    {
-        titlebar_size = window_state.titlebar_rect().size;
-        titlebar_pixels.reset(); // force a reallocation next time it's needed
-    }
-
     Theme const* const new_theme = (window_state.focused_state() == mir_window_focus_state_focused) ?
         &focused_theme :
         &unfocused_theme;
@@ -496,151 +543,142 @@ void msd::Renderer::update_state(WindowState const& window_state, InputState con
     if (new_theme != current_theme)
     {
         current_theme = new_theme;
-        needs_titlebar_redraw = true;
-        needs_solid_color_redraw = true;
+        needs_title_redraw = true;
     }
 
     if (window_state.window_name() != name)
     {
         name = window_state.window_name();
-        needs_titlebar_redraw = true;
+        needs_title_redraw = true;
     }
 
-    if (input_state.buttons() != buttons)
-    {
-        // If the number of buttons or their location changed, redraw the whole titlebar
-        // Otherwise if the buttons are in the same place, just redraw them
-        if (input_state.buttons().size() != buttons.size())
-        {
-            needs_titlebar_redraw = true;
-        }
-        else
-        {
-            for (unsigned i = 0; i < buttons.size(); i++)
-            {
-                if (input_state.buttons()[i].rect != buttons[i].rect)
-                    needs_titlebar_redraw = true;
-            }
-        }
-        buttons = input_state.buttons();
-        needs_titlebar_buttons_redraw = true;
-    }
-}
+    buttons = input_state.buttons();
 
-auto msd::Renderer::render_titlebar() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
-{
-    if (!area(titlebar_size))
-        return std::experimental::nullopt;
+    // The title is only as wide as its text, and stops short of the buttons
+    auto const titlebar = window_state.titlebar_rect();
+    geom::Point const top_left = titlebar.top_left + as_displacement(static_geometry->title_font_top_left);
+    geom::X right = titlebar.right();
+    for (auto const& button : buttons)
+        right = std::min(right, button.rect.left());
 
-    if (!titlebar_pixels)
+    geom::Rectangle new_title_rect{top_left, {}};
+    if (!name.empty() && right > top_left.x && titlebar.bottom() > top_left.y)
     {
-        titlebar_pixels = alloc_pixels(titlebar_size);
-        needs_titlebar_redraw = true;
+        auto const available = as_width(right - top_left.x);
+        auto const width = std::min(
+            std::max(text->rendered_width(name, static_geometry->title_font_height), geom::Width{1}),
+            available);
+        new_title_rect.size = {width, as_height(titlebar.bottom() - top_left.y)};
     }
 
-    if (needs_titlebar_redraw)
-    {
-        for (geom::Y y{0}; y < as_y(titlebar_size.height); y += geom::DeltaY{1})
-        {
-            render_row(
-                titlebar_pixels.get(), titlebar_size,
-                {0, y}, titlebar_size.width,
-                current_theme->background_color);
-        }
-
-        text->render(
-            titlebar_pixels.get(),
-            titlebar_size,
-            name,
-            static_geometry->title_font_top_left,
-            static_geometry->title_font_height,
-            current_theme->text_color);
-    }
+    if (new_title_rect.size != title_rect_.size)
+        needs_title_redraw = true;
+    title_rect_ = new_title_rect;
+}
 
-    if (needs_titlebar_redraw || needs_titlebar_buttons_redraw)
-    {
-        for (auto const& button : buttons)
-        {
-            auto const icon = button_icons.find(button.function);
-            if (icon != button_icons.end())
-            {
-                Pixel button_color = icon->second.normal_color;
-                if (button.state == ButtonState::Hovered)
-                    button_color = icon->second.active_color;
-                for (geom::Y y{button.rect.top()}; y < button.rect.bottom(); y += geom::DeltaY{1})
-                {
-                    render_row(
-                        titlebar_pixels.get(),
-                        titlebar_size,
-                        {button.rect.left(), y},
-                        button.rect.size.width,
-                        button_color);
-                }
-                geom::Rectangle const icon_rect = {
-                button.rect.top_left + static_geometry->icon_padding, {
-                    button.rect.size.width - static_geometry->icon_padding.dx * 2,
-                    button.rect.size.height - static_geometry->icon_padding.dy * 2}};
-                icon->second.render_icon(
-                    titlebar_pixels.get(),
-                    titlebar_size,
-                    icon_rect,
-                    static_geometry->icon_line_width,
-                    icon->second.icon_color);
-            }
-            else
-            {
-                log_warning("Could not render decoration button with unknown function %d\n", button.function);
-            }
-        }
-    }
+auto msd::Renderer::title_rect() const -> geom::Rectangle
+{
+    return title_rect_;
+}
 
-    needs_titlebar_redraw = false;
-    needs_titlebar_buttons_redraw = false;
+auto msd::Renderer::icon_rect(geom::Rectangle const& button_rect) const -> geom::Rectangle
+{
+    return {
+        button_rect.top_left + static_geometry->icon_padding, {
+            button_rect.size.width - static_geometry->icon_padding.dx * 2,
+            button_rect.size.height - static_geometry->icon_padding.dy * 2}};
+}
 
-    return make_buffer(titlebar_pixels.get(), titlebar_size);
+auto msd::Renderer::render_titlebar() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
+{
+    return solid_color_buffer(current_theme->background_color);
 }
 
 auto msd::Renderer::render_left_border() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
 {
-    if (!area(left_border_size))
-        return std::experimental::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), left_border_size);
+    return solid_color_buffer(current_theme->background_color);
 }
 
 auto msd::Renderer::render_right_border() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
 {
-    if (!area(right_border_size))
-        return std::experimental::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), right_border_size);
+    return solid_color_buffer(current_theme->background_color);
 }
 
 auto msd::Renderer::render_bottom_border() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
 {
-    if (!area(bottom_border_size))
-        return std::experimental::nullopt;
-    update_solid_color_pixels();
-    return make_buffer(solid_color_pixels.get(), bottom_border_size);
+    return solid_color_buffer(current_theme->background_color);
 }
 
-void msd::Renderer::update_solid_color_pixels()
+auto msd::Renderer::render_button_background(
+    ButtonInfo const& button) -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
 {
-    if (!solid_color_pixels)
+    auto const icon = button_icons.find(button.function);
+    if (icon == button_icons.end())
     {
-        solid_color_pixels = alloc_pixels(geom::Size{solid_color_pixels_length, 1});
-        needs_solid_color_redraw = true;
+        log_warning("Could not render decoration button with unknown function %d\n", button.function);
+        return std::experimental::nullopt;
     }
 
-    if (needs_solid_color_redraw)
+    if (button.state == ButtonState::Hovered)
+        return solid_color_buffer(icon->second.active_color);
+    else
+        return solid_color_buffer(icon->second.normal_color);
+}
+
+auto msd::Renderer::render_button_icon(
+    ButtonInfo const& button) -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
+{
+    auto const icon = button_icons.find(button.function);
+    if (icon == button_icons.end())
     {
-        render_row(
-            solid_color_pixels.get(), geom::Size{solid_color_pixels_length, 1},
-            geom::Point{}, geom::Width{solid_color_pixels_length},
-            current_theme->background_color);
+        log_warning("Could not render decoration button with unknown function %d\n", button.function);
+        return std::experimental::nullopt;
     }
 
-    needs_solid_color_redraw = false;
+    auto const size = icon_rect(button.rect).size;
+    if (!area(size))
+        return std::experimental::nullopt;
+
+    auto const buffer = icon_atlas->icon(button.function, size, [&]() -> std::shared_ptr<mg::Buffer>
+        {
+            // Drawn over a transparent background, so it can go over either button color
+            auto const pixels = alloc_pixels(size);
+            icon->second.render_icon(
+                pixels.get(),
+                size,
+                {{}, size},
+                static_geometry->icon_line_width,
+                icon->second.icon_color);
+            return make_buffer(pixels.get(), size).value_or(nullptr);
+        });
+
+    if (!buffer)
+        return std::experimental::nullopt;
+    return buffer;
+}
+
+auto msd::Renderer::render_title() -> std::experimental::optional<std::shared_ptr<mg::Buffer>>
+{
+    if (!needs_title_redraw || !area(title_rect_.size))
+        return std::experimental::nullopt;
+
+    auto const pixels = alloc_pixels(title_rect_.size);
+    text->render(
+        pixels.get(),
+        title_rect_.size,
+        name,
+        geom::Point{},
+        static_geometry->title_font_height,
+        current_theme->text_color);
+
+    needs_title_redraw = false;
+
+    return make_buffer(pixels.get(), title_rect_.size);
+}
+
+auto msd::Renderer::solid_color_buffer(Pixel color) -> std::shared_ptr<mg::Buffer>
+{
+    return std::make_shared<mg::SolidColorBuffer>(color);
 }
 
 auto msd::Renderer::make_buffer(
@@ -666,9 +704,9 @@ auto msd::Renderer::make_buffer(
 
 auto msd::Renderer::alloc_pixels(geometry::Size size) -> std::unique_ptr<uint32_t[]>
 {
-    size_t const buf_size = area(size) * bytes_per_pixel;
-    if (buf_size)
-        return std::unique_ptr<uint32_t[]>{new uint32_t[buf_size]};
+    // Value-initialized, so fully transparent
+    if (auto const pixels = area(size))
+        return std::unique_ptr<uint32_t[]>{new uint32_t[pixels]()};
     else
         return nullptr;
 }
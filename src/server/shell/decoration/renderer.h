@@ -23,8 +23,11 @@
 
 #include "input.h"
 
+#include <functional>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <tuple>
 
 namespace mir
 {
@@ -52,10 +55,26 @@ public:
         std::shared_ptr<StaticGeometry const> const& static_geometry);
 
     void update_state(WindowState const& window_state, InputState const& input_state);
+
+    /// Where the title goes within the decoration surface; empty if there is no title to draw
+    auto title_rect() const -> geometry::Rectangle;
+    /// Where the icon of the button occupying button_rect goes
+    auto icon_rect(geometry::Rectangle const& button_rect) const -> geometry::Rectangle;
+
+    /// The solid color buffers are a single pixel, to be stretched to the size of their area
+    /// They don't depend on that size, so are always rendered (even for an area that is currently empty)
     auto render_titlebar() -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
     auto render_left_border() -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
     auto render_right_border() -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
     auto render_bottom_border() -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
+    auto render_button_background(ButtonInfo const& button) -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
+
+    /// Shared by every decoration with the same button, so not per-window
+    auto render_button_icon(ButtonInfo const& button) -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
+
+    /// The only per-window pixels: the title text over a transparent background
+    /// Returns nullopt if the title hasn't changed since it was last rendered
+    auto render_title() -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
 
 private:
     using Pixel = uint32_t;
@@ -75,6 +94,9 @@ private:
             geometry::Height height_pixels,
             Pixel color) = 0;
 
+        /// How far render() would advance drawing text
+        virtual auto rendered_width(std::string const& text, geometry::Height height_pixels) -> geometry::Width = 0;
+
     private:
         class Impl;
         class Null;
@@ -83,6 +105,26 @@ private:
         static std::weak_ptr<Text> singleton;
     };
 
+    /// Button icons, drawn once and shared between all decorations
+    class IconAtlas
+    {
+    public:
+        static auto instance() -> std::shared_ptr<IconAtlas>;
+
+        /// Returns the icon for function at size, calling draw to create it if there isn't one yet
+        auto icon(
+            ButtonFunction function,
+            geometry::Size size,
+            std::function<std::shared_ptr<graphics::Buffer>()> const& draw) -> std::shared_ptr<graphics::Buffer>;
+
+    private:
+        std::mutex mutex;
+        std::map<std::tuple<ButtonFunction, int, int>, std::shared_ptr<graphics::Buffer>> icons;
+
+        static std::mutex static_mutex;
+        static std::weak_ptr<IconAtlas> singleton;
+    };
+
     /// A visual theme for a decoration
     /// Focused and unfocused windows use a different theme
     struct Theme
@@ -112,24 +154,15 @@ private:
     std::map<ButtonFunction, Icon const> button_icons;
     std::shared_ptr<StaticGeometry const> const static_geometry;
 
-    bool needs_solid_color_redraw{true};
-    geometry::Size left_border_size;
-    geometry::Size right_border_size;
-    geometry::Size bottom_border_size;
-    size_t solid_color_pixels_length{0};
-    std::unique_ptr<Pixel[]> solid_color_pixels; // can be nullptr
-
-    geometry::Size titlebar_size{};
-    std::unique_ptr<Pixel[]> titlebar_pixels; // can be nullptr
-
-    bool needs_titlebar_redraw{true};
-    bool needs_titlebar_buttons_redraw{true};
+    bool needs_title_redraw{true};
+    geometry::Rectangle title_rect_;
     std::string name;
     std::vector<ButtonInfo> buttons;
 
     std::shared_ptr<Text> const text;
+    std::shared_ptr<IconAtlas> const icon_atlas;
 
-    void update_solid_color_pixels();
+    auto solid_color_buffer(Pixel color) -> std::shared_ptr<graphics::Buffer>;
     auto make_buffer(
         Pixel const* pixels,
         geometry::Size size) -> std::experimental::optional<std::shared_ptr<graphics::Buffer>>;
@@ -185,6 +185,11 @@ void msh::ShellWrapper::raise(SurfaceSet const& surfaces)
     return wrapped->raise(surfaces);
 }
 
+void msh::ShellWrapper::apply_atomically(std::function<void()> const& changes)
+{
+    wrapped->apply_atomically(changes);
+}
+
 void msh::ShellWrapper::set_drag_and_drop_handle(std::vector<uint8_t> const& handle)
 {
     wrapped->set_drag_and_drop_handle(handle);
@@ -55,3 +55,8 @@ auto msh::SurfaceStackWrapper::surface_at(geometry::Point point) const -> std::s
 {
     return wrapped->surface_at(point);
 }
+
+void msh::SurfaceStackWrapper::apply_atomically(std::function<void()> const& changes)
+{
+    wrapped->apply_atomically(changes);
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define MIR_LOG_COMPONENT "startup"
+
+#include "mir/startup_timeline.h"
+#include "mir/log.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> timeline_active{false};
+std::mutex timeline_mutex;
+Clock::time_point start_time;
+Clock::time_point last_phase_time;
+
+auto milliseconds_between(Clock::time_point from, Clock::time_point to) -> double
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+void log_phase(std::lock_guard<std::mutex> const&, char const* phase)
+{
+    auto const now = Clock::now();
+
+    mir::log_info(
+        "%s: %.1fms (%.1fms since start)",
+        phase,
+        milliseconds_between(last_phase_time, now),
+        milliseconds_between(start_time, now));
+
+    last_phase_time = now;
+}
+}
+
+void mir::startup_timeline::started()
+{
+    std::lock_guard<std::mutex> lock{timeline_mutex};
+    start_time = last_phase_time = Clock::now();
+    timeline_active = true;
+}
+
+void mir::startup_timeline::phase_completed(char const* phase)
+{
+    if (!timeline_active)
+        return;
+
+    std::lock_guard<std::mutex> lock{timeline_mutex};
+    if (timeline_active)
+        log_phase(lock, phase);
+}
+
+void mir::startup_timeline::first_frame_posted()
+{
+    if (!timeline_active)
+        return;
+
+    std::lock_guard<std::mutex> lock{timeline_mutex};
+    if (timeline_active.exchange(false))
+        log_phase(lock, "First frame posted");
+}
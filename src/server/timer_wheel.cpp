@@ -0,0 +1,202 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/time/timer_wheel.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+
+namespace mt = mir::time;
+
+namespace
+{
+/// The ticks that share their slot at level with tick (and everything below it)
+auto rotation_of(uint64_t tick, int level, int bits_per_level) -> uint64_t
+{
+    auto const shift = (level + 1) * bits_per_level;
+    return shift < 64 ? (tick >> shift) << shift : 0;
+}
+}
+
+mt::TimerWheel::TimerWheel(Timestamp origin, Duration resolution)
+    : origin{origin},
+      resolution{resolution}
+{
+    if (resolution <= Duration::zero())
+        BOOST_THROW_EXCEPTION(std::invalid_argument("TimerWheel resolution must be positive"));
+}
+
+void mt::TimerWheel::schedule(Timer& timer, Timestamp expiry)
+{
+    if (timer.is_scheduled())
+        unlink(timer);
+
+    timer.expiry = tick_of(expiry, true);
+    insert(timer);
+}
+
+void mt::TimerWheel::cancel(Timer& timer)
+{
+    if (timer.is_scheduled())
+        unlink(timer);
+}
+
+auto mt::TimerWheel::next_event() const -> Timestamp
+{
+    auto const tick = next_tick();
+    return tick == UINT64_MAX ? Timestamp::max() : time_of(tick);
+}
+
+auto mt::TimerWheel::advance_to(Timestamp now) -> std::vector<Timer*>
+{
+    std::vector<Timer*> due;
+
+    auto const collect = [&due, this](int bucket)
+        {
+            while (auto const timer = buckets[bucket])
+            {
+                unlink(*timer);
+                if (timer->expiry <= current)
+                    due.push_back(timer);
+                else
+                    insert(*timer);     // Into a lower level, nearer to its expiry
+            }
+        };
+
+    collect(due_bucket);
+
+    auto const target = tick_of(now, false);
+    while (current < target)
+    {
+        auto const next = next_tick();
+        if (next > target)
+        {
+            current = target;
+            break;
+        }
+
+        current = next;
+
+        // Only the lowest occupied level can hold the slot starting at next
+        for (auto level = 0; level != levels; ++level)
+        {
+            if (occupied[level])
+            {
+                collect(level * slots_per_level + __builtin_ctzll(occupied[level]));
+                break;
+            }
+        }
+    }
+
+    return due;
+}
+
+auto mt::TimerWheel::tick_of(Timestamp time, bool round_up) const -> uint64_t
+{
+    if (time <= origin)
+        return 0;
+
+    auto const elapsed = time - origin;
+    uint64_t const ticks = elapsed / resolution;
+    return round_up && elapsed % resolution != Duration::zero() ? ticks + 1 : ticks;
+}
+
+auto mt::TimerWheel::time_of(uint64_t tick) const -> Timestamp
+{
+    if (tick > static_cast<uint64_t>((Timestamp::max() - origin) / resolution))
+        return Timestamp::max();
+
+    return origin + static_cast<Duration::rep>(tick) * resolution;
+}
+
+auto mt::TimerWheel::next_tick() const -> uint64_t
+{
+    if (buckets[due_bucket])
+        return current;
+
+    // Every timer in a level is in a slot after current's, so the lowest
+    // occupied level's first occupied slot is the next to be processed
+    for (auto level = 0; level != levels; ++level)
+    {
+        if (occupied[level])
+        {
+            uint64_t const slot = __builtin_ctzll(occupied[level]);
+            return rotation_of(current, level, bits_per_level) | (slot << (level * bits_per_level));
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+void mt::TimerWheel::insert(Timer& timer)
+{
+    if (timer.expiry <= current)
+    {
+        link(timer, due_bucket);
+        return;
+    }
+
+    // The level of the most significant digit in which expiry differs from
+    // current: the timer waits there until current reaches that digit
+    auto const level = (63 - __builtin_clzll(timer.expiry ^ current)) / bits_per_level;
+    auto const slot = (timer.expiry >> (level * bits_per_level)) & (slots_per_level - 1);
+
+    link(timer, level * slots_per_level + static_cast<int>(slot));
+}
+
+void mt::TimerWheel::link(Timer& timer, int bucket)
+{
+    // Each bucket is a circular list, so appending is O(1) and keeps insertion order
+    auto& head = buckets[bucket];
+    if (head)
+    {
+        timer.next = head;
+        timer.prev = head->prev;
+        head->prev->next = &timer;
+        head->prev = &timer;
+    }
+    else
+    {
+        head = &timer;
+        timer.next = timer.prev = &timer;
+    }
+
+    timer.bucket = bucket;
+    if (bucket != due_bucket)
+        occupied[bucket / slots_per_level] |= uint64_t{1} << (bucket % slots_per_level);
+}
+
+void mt::TimerWheel::unlink(Timer& timer)
+{
+    auto& head = buckets[timer.bucket];
+    if (timer.next == &timer)
+    {
+        head = nullptr;
+        if (timer.bucket != due_bucket)
+            occupied[timer.bucket / slots_per_level] &= ~(uint64_t{1} << (timer.bucket % slots_per_level));
+    }
+    else
+    {
+        timer.prev->next = timer.next;
+        timer.next->prev = timer.prev;
+        if (head == &timer)
+            head = timer.next;
+    }
+
+    timer.prev = timer.next = nullptr;
+    timer.bucket = Timer::unscheduled;
+}
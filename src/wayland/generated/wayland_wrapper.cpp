@@ -106,6 +106,7 @@ struct mw::Compositor::Thunks
 
     static void create_surface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "create_surface"};
         auto me = static_cast<Compositor*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_surface_interface_data, wl_resource_get_version(resource), id)};
@@ -126,6 +127,7 @@ struct mw::Compositor::Thunks
 
     static void create_region_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "create_region"};
         auto me = static_cast<Compositor*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_region_interface_data, wl_resource_get_version(resource), id)};
@@ -243,6 +245,7 @@ struct mw::ShmPool::Thunks
 
     static void create_buffer_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, int32_t offset, int32_t width, int32_t height, int32_t stride, uint32_t format)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "create_buffer"};
         auto me = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_buffer_interface_data, wl_resource_get_version(resource), id)};
@@ -263,6 +266,7 @@ struct mw::ShmPool::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "destroy"};
         auto me = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
         try
         {
@@ -276,6 +280,7 @@ struct mw::ShmPool::Thunks
 
     static void resize_thunk(struct wl_client* client, struct wl_resource* resource, int32_t size)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "resize"};
         auto me = static_cast<ShmPool*>(wl_resource_get_user_data(resource));
         try
         {
@@ -351,6 +356,7 @@ struct mw::Shm::Thunks
 
     static void create_pool_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, int32_t fd, int32_t size)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "create_pool"};
         auto me = static_cast<Shm*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_shm_pool_interface_data, wl_resource_get_version(resource), id)};
@@ -474,6 +480,7 @@ struct mw::Buffer::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<Buffer*>(wl_resource_get_user_data(resource));
         try
         {
@@ -545,6 +552,7 @@ struct mw::DataOffer::Thunks
 
     static void accept_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial, char const* mime_type)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "accept"};
         auto me = static_cast<DataOffer*>(wl_resource_get_user_data(resource));
         std::experimental::optional<std::string> mime_type_resolved;
         if (mime_type != nullptr)
@@ -563,6 +571,7 @@ struct mw::DataOffer::Thunks
 
     static void receive_thunk(struct wl_client* client, struct wl_resource* resource, char const* mime_type, int32_t fd)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "receive"};
         auto me = static_cast<DataOffer*>(wl_resource_get_user_data(resource));
         mir::Fd fd_resolved{fd};
         try
@@ -577,6 +586,7 @@ struct mw::DataOffer::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "destroy"};
         auto me = static_cast<DataOffer*>(wl_resource_get_user_data(resource));
         try
         {
@@ -590,6 +600,7 @@ struct mw::DataOffer::Thunks
 
     static void finish_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "finish"};
         auto me = static_cast<DataOffer*>(wl_resource_get_user_data(resource));
         try
         {
@@ -603,6 +614,7 @@ struct mw::DataOffer::Thunks
 
     static void set_actions_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t dnd_actions, uint32_t preferred_action)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_actions"};
         auto me = static_cast<DataOffer*>(wl_resource_get_user_data(resource));
         try
         {
@@ -705,6 +717,7 @@ struct mw::DataSource::Thunks
 
     static void offer_thunk(struct wl_client* client, struct wl_resource* resource, char const* mime_type)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "offer"};
         auto me = static_cast<DataSource*>(wl_resource_get_user_data(resource));
         try
         {
@@ -718,6 +731,7 @@ struct mw::DataSource::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "destroy"};
         auto me = static_cast<DataSource*>(wl_resource_get_user_data(resource));
         try
         {
@@ -731,6 +745,7 @@ struct mw::DataSource::Thunks
 
     static void set_actions_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t dnd_actions)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_actions"};
         auto me = static_cast<DataSource*>(wl_resource_get_user_data(resource));
         try
         {
@@ -858,6 +873,7 @@ struct mw::DataDevice::Thunks
 
     static void start_drag_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* source, struct wl_resource* origin, struct wl_resource* icon, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "start_drag"};
         auto me = static_cast<DataDevice*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> source_resolved;
         if (source != nullptr)
@@ -881,6 +897,7 @@ struct mw::DataDevice::Thunks
 
     static void set_selection_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* source, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_selection"};
         auto me = static_cast<DataDevice*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> source_resolved;
         if (source != nullptr)
@@ -899,6 +916,7 @@ struct mw::DataDevice::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "release"};
         auto me = static_cast<DataDevice*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1046,6 +1064,7 @@ struct mw::DataDeviceManager::Thunks
 
     static void create_data_source_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "create_data_source"};
         auto me = static_cast<DataDeviceManager*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_data_source_interface_data, wl_resource_get_version(resource), id)};
@@ -1066,6 +1085,7 @@ struct mw::DataDeviceManager::Thunks
 
     static void get_data_device_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* seat)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_data_device"};
         auto me = static_cast<DataDeviceManager*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_data_device_interface_data, wl_resource_get_version(resource), id)};
@@ -1184,6 +1204,7 @@ struct mw::Shell::Thunks
 
     static void get_shell_surface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* surface)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "get_shell_surface"};
         auto me = static_cast<Shell*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_shell_surface_interface_data, wl_resource_get_version(resource), id)};
@@ -1296,6 +1317,7 @@ struct mw::ShellSurface::Thunks
 
     static void pong_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "pong"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1309,6 +1331,7 @@ struct mw::ShellSurface::Thunks
 
     static void move_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "move"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1322,6 +1345,7 @@ struct mw::ShellSurface::Thunks
 
     static void resize_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, uint32_t edges)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "resize"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1335,6 +1359,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_toplevel_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_toplevel"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1348,6 +1373,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_transient_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* parent, int32_t x, int32_t y, uint32_t flags)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_transient"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1361,6 +1387,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_fullscreen_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t method, uint32_t framerate, struct wl_resource* output)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "set_fullscreen"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> output_resolved;
         if (output != nullptr)
@@ -1379,6 +1406,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_popup_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, struct wl_resource* parent, int32_t x, int32_t y, uint32_t flags)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "set_popup"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1392,6 +1420,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_maximized_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* output)
     {
+        RequestTimer const request_timer{client, interface_name, 7, "set_maximized"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> output_resolved;
         if (output != nullptr)
@@ -1410,6 +1439,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_title_thunk(struct wl_client* client, struct wl_resource* resource, char const* title)
     {
+        RequestTimer const request_timer{client, interface_name, 8, "set_title"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1423,6 +1453,7 @@ struct mw::ShellSurface::Thunks
 
     static void set_class_thunk(struct wl_client* client, struct wl_resource* resource, char const* class_)
     {
+        RequestTimer const request_timer{client, interface_name, 9, "set_class"};
         auto me = static_cast<ShellSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1561,6 +1592,7 @@ struct mw::Surface::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1574,6 +1606,7 @@ struct mw::Surface::Thunks
 
     static void attach_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* buffer, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "attach"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> buffer_resolved;
         if (buffer != nullptr)
@@ -1592,6 +1625,7 @@ struct mw::Surface::Thunks
 
     static void damage_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "damage"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1605,6 +1639,7 @@ struct mw::Surface::Thunks
 
     static void frame_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t callback)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "frame"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         wl_resource* callback_resolved{
             wl_resource_create(client, &wl_callback_interface_data, wl_resource_get_version(resource), callback)};
@@ -1625,6 +1660,7 @@ struct mw::Surface::Thunks
 
     static void set_opaque_region_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* region)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_opaque_region"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> region_resolved;
         if (region != nullptr)
@@ -1643,6 +1679,7 @@ struct mw::Surface::Thunks
 
     static void set_input_region_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* region)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "set_input_region"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> region_resolved;
         if (region != nullptr)
@@ -1661,6 +1698,7 @@ struct mw::Surface::Thunks
 
     static void commit_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "commit"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1674,6 +1712,7 @@ struct mw::Surface::Thunks
 
     static void set_buffer_transform_thunk(struct wl_client* client, struct wl_resource* resource, int32_t transform)
     {
+        RequestTimer const request_timer{client, interface_name, 7, "set_buffer_transform"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1687,6 +1726,7 @@ struct mw::Surface::Thunks
 
     static void set_buffer_scale_thunk(struct wl_client* client, struct wl_resource* resource, int32_t scale)
     {
+        RequestTimer const request_timer{client, interface_name, 8, "set_buffer_scale"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1700,6 +1740,7 @@ struct mw::Surface::Thunks
 
     static void damage_buffer_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 9, "damage_buffer"};
         auto me = static_cast<Surface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -1821,6 +1862,7 @@ struct mw::Seat::Thunks
 
     static void get_pointer_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "get_pointer"};
         auto me = static_cast<Seat*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_pointer_interface_data, wl_resource_get_version(resource), id)};
@@ -1841,6 +1883,7 @@ struct mw::Seat::Thunks
 
     static void get_keyboard_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_keyboard"};
         auto me = static_cast<Seat*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_keyboard_interface_data, wl_resource_get_version(resource), id)};
@@ -1861,6 +1904,7 @@ struct mw::Seat::Thunks
 
     static void get_touch_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "get_touch"};
         auto me = static_cast<Seat*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_touch_interface_data, wl_resource_get_version(resource), id)};
@@ -1881,6 +1925,7 @@ struct mw::Seat::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "release"};
         auto me = static_cast<Seat*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2020,6 +2065,7 @@ struct mw::Pointer::Thunks
 
     static void set_cursor_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial, struct wl_resource* surface, int32_t hotspot_x, int32_t hotspot_y)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "set_cursor"};
         auto me = static_cast<Pointer*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> surface_resolved;
         if (surface != nullptr)
@@ -2038,6 +2084,7 @@ struct mw::Pointer::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "release"};
         auto me = static_cast<Pointer*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2203,6 +2250,7 @@ struct mw::Keyboard::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "release"};
         auto me = static_cast<Keyboard*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2321,6 +2369,7 @@ struct mw::Touch::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "release"};
         auto me = static_cast<Touch*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2454,6 +2503,7 @@ struct mw::Output::Thunks
 
     static void release_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "release"};
         auto me = static_cast<Output*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2604,6 +2654,7 @@ struct mw::Region::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<Region*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2617,6 +2668,7 @@ struct mw::Region::Thunks
 
     static void add_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "add"};
         auto me = static_cast<Region*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2630,6 +2682,7 @@ struct mw::Region::Thunks
 
     static void subtract_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "subtract"};
         auto me = static_cast<Region*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2696,6 +2749,7 @@ struct mw::Subcompositor::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<Subcompositor*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2709,6 +2763,7 @@ struct mw::Subcompositor::Thunks
 
     static void get_subsurface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* surface, struct wl_resource* parent)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_subsurface"};
         auto me = static_cast<Subcompositor*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &wl_subsurface_interface_data, wl_resource_get_version(resource), id)};
@@ -2824,6 +2879,7 @@ struct mw::Subsurface::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2837,6 +2893,7 @@ struct mw::Subsurface::Thunks
 
     static void set_position_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_position"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2850,6 +2907,7 @@ struct mw::Subsurface::Thunks
 
     static void place_above_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* sibling)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "place_above"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2863,6 +2921,7 @@ struct mw::Subsurface::Thunks
 
     static void place_below_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* sibling)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "place_below"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2876,6 +2935,7 @@ struct mw::Subsurface::Thunks
 
     static void set_sync_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_sync"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -2889,6 +2949,7 @@ struct mw::Subsurface::Thunks
 
     static void set_desync_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "set_desync"};
         auto me = static_cast<Subsurface*>(wl_resource_get_user_data(resource));
         try
         {
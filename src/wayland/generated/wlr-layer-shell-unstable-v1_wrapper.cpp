@@ -52,6 +52,7 @@ struct mw::LayerShellV1::Thunks
 
     static void get_layer_surface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* surface, struct wl_resource* output, uint32_t layer, char const* namespace_)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "get_layer_surface"};
         auto me = static_cast<LayerShellV1*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zwlr_layer_surface_v1_interface_data, wl_resource_get_version(resource), id)};
@@ -172,6 +173,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void set_size_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t width, uint32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "set_size"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -185,6 +187,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void set_anchor_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t anchor)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_anchor"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -198,6 +201,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void set_exclusive_zone_thunk(struct wl_client* client, struct wl_resource* resource, int32_t zone)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_exclusive_zone"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -211,6 +215,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void set_margin_thunk(struct wl_client* client, struct wl_resource* resource, int32_t top, int32_t right, int32_t bottom, int32_t left)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_margin"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -224,6 +229,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void set_keyboard_interactivity_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t keyboard_interactivity)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_keyboard_interactivity"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -237,6 +243,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void get_popup_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* popup)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "get_popup"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -250,6 +257,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void ack_configure_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "ack_configure"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -263,6 +271,7 @@ struct mw::LayerSurfaceV1::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 7, "destroy"};
         auto me = static_cast<LayerSurfaceV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -50,6 +50,7 @@ struct mw::XdgOutputManagerV1::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgOutputManagerV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -63,6 +64,7 @@ struct mw::XdgOutputManagerV1::Thunks
 
     static void get_xdg_output_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* output)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_xdg_output"};
         auto me = static_cast<XdgOutputManagerV1*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zxdg_output_v1_interface_data, wl_resource_get_version(resource), id)};
@@ -177,6 +179,7 @@ struct mw::XdgOutputV1::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgOutputV1*>(wl_resource_get_user_data(resource));
         try
         {
@@ -55,6 +55,7 @@ struct mw::XdgShellV6::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgShellV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -68,6 +69,7 @@ struct mw::XdgShellV6::Thunks
 
     static void create_positioner_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "create_positioner"};
         auto me = static_cast<XdgShellV6*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zxdg_positioner_v6_interface_data, wl_resource_get_version(resource), id)};
@@ -88,6 +90,7 @@ struct mw::XdgShellV6::Thunks
 
     static void get_xdg_surface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* surface)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "get_xdg_surface"};
         auto me = static_cast<XdgShellV6*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zxdg_surface_v6_interface_data, wl_resource_get_version(resource), id)};
@@ -108,6 +111,7 @@ struct mw::XdgShellV6::Thunks
 
     static void pong_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "pong"};
         auto me = static_cast<XdgShellV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -232,6 +236,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -245,6 +250,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_size"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -258,6 +264,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_anchor_rect_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_anchor_rect"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -271,6 +278,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_anchor_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t anchor)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_anchor"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -284,6 +292,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_gravity_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t gravity)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_gravity"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -297,6 +306,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_constraint_adjustment_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t constraint_adjustment)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "set_constraint_adjustment"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -310,6 +320,7 @@ struct mw::XdgPositionerV6::Thunks
 
     static void set_offset_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "set_offset"};
         auto me = static_cast<XdgPositionerV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -384,6 +395,7 @@ struct mw::XdgSurfaceV6::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgSurfaceV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -397,6 +409,7 @@ struct mw::XdgSurfaceV6::Thunks
 
     static void get_toplevel_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_toplevel"};
         auto me = static_cast<XdgSurfaceV6*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zxdg_toplevel_v6_interface_data, wl_resource_get_version(resource), id)};
@@ -417,6 +430,7 @@ struct mw::XdgSurfaceV6::Thunks
 
     static void get_popup_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* parent, struct wl_resource* positioner)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "get_popup"};
         auto me = static_cast<XdgSurfaceV6*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &zxdg_popup_v6_interface_data, wl_resource_get_version(resource), id)};
@@ -437,6 +451,7 @@ struct mw::XdgSurfaceV6::Thunks
 
     static void set_window_geometry_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_window_geometry"};
         auto me = static_cast<XdgSurfaceV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -450,6 +465,7 @@ struct mw::XdgSurfaceV6::Thunks
 
     static void ack_configure_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "ack_configure"};
         auto me = static_cast<XdgSurfaceV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -539,6 +555,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -552,6 +569,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_parent_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* parent)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_parent"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> parent_resolved;
         if (parent != nullptr)
@@ -570,6 +588,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_title_thunk(struct wl_client* client, struct wl_resource* resource, char const* title)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_title"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -583,6 +602,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_app_id_thunk(struct wl_client* client, struct wl_resource* resource, char const* app_id)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_app_id"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -596,6 +616,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void show_window_menu_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "show_window_menu"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -609,6 +630,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void move_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "move"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -622,6 +644,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void resize_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, uint32_t edges)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "resize"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -635,6 +658,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_max_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 7, "set_max_size"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -648,6 +672,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_min_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 8, "set_min_size"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -661,6 +686,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_maximized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 9, "set_maximized"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -674,6 +700,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void unset_maximized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 10, "unset_maximized"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -687,6 +714,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_fullscreen_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* output)
     {
+        RequestTimer const request_timer{client, interface_name, 11, "set_fullscreen"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> output_resolved;
         if (output != nullptr)
@@ -705,6 +733,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void unset_fullscreen_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 12, "unset_fullscreen"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -718,6 +747,7 @@ struct mw::XdgToplevelV6::Thunks
 
     static void set_minimized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 13, "set_minimized"};
         auto me = static_cast<XdgToplevelV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -847,6 +877,7 @@ struct mw::XdgPopupV6::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgPopupV6*>(wl_resource_get_user_data(resource));
         try
         {
@@ -860,6 +891,7 @@ struct mw::XdgPopupV6::Thunks
 
     static void grab_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "grab"};
         auto me = static_cast<XdgPopupV6*>(wl_resource_get_user_data(resource));
         try
         {
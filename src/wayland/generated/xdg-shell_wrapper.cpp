@@ -55,6 +55,7 @@ struct mw::XdgWmBase::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgWmBase*>(wl_resource_get_user_data(resource));
         try
         {
@@ -68,6 +69,7 @@ struct mw::XdgWmBase::Thunks
 
     static void create_positioner_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "create_positioner"};
         auto me = static_cast<XdgWmBase*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &xdg_positioner_interface_data, wl_resource_get_version(resource), id)};
@@ -88,6 +90,7 @@ struct mw::XdgWmBase::Thunks
 
     static void get_xdg_surface_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* surface)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "get_xdg_surface"};
         auto me = static_cast<XdgWmBase*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &xdg_surface_interface_data, wl_resource_get_version(resource), id)};
@@ -108,6 +111,7 @@ struct mw::XdgWmBase::Thunks
 
     static void pong_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "pong"};
         auto me = static_cast<XdgWmBase*>(wl_resource_get_user_data(resource));
         try
         {
@@ -232,6 +236,7 @@ struct mw::XdgPositioner::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -245,6 +250,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_size"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -258,6 +264,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_anchor_rect_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_anchor_rect"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -271,6 +278,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_anchor_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t anchor)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_anchor"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -284,6 +292,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_gravity_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t gravity)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "set_gravity"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -297,6 +306,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_constraint_adjustment_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t constraint_adjustment)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "set_constraint_adjustment"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -310,6 +320,7 @@ struct mw::XdgPositioner::Thunks
 
     static void set_offset_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "set_offset"};
         auto me = static_cast<XdgPositioner*>(wl_resource_get_user_data(resource));
         try
         {
@@ -384,6 +395,7 @@ struct mw::XdgSurface::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -397,6 +409,7 @@ struct mw::XdgSurface::Thunks
 
     static void get_toplevel_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "get_toplevel"};
         auto me = static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &xdg_toplevel_interface_data, wl_resource_get_version(resource), id)};
@@ -417,6 +430,7 @@ struct mw::XdgSurface::Thunks
 
     static void get_popup_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t id, struct wl_resource* parent, struct wl_resource* positioner)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "get_popup"};
         auto me = static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
         wl_resource* id_resolved{
             wl_resource_create(client, &xdg_popup_interface_data, wl_resource_get_version(resource), id)};
@@ -442,6 +456,7 @@ struct mw::XdgSurface::Thunks
 
     static void set_window_geometry_thunk(struct wl_client* client, struct wl_resource* resource, int32_t x, int32_t y, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_window_geometry"};
         auto me = static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -455,6 +470,7 @@ struct mw::XdgSurface::Thunks
 
     static void ack_configure_thunk(struct wl_client* client, struct wl_resource* resource, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "ack_configure"};
         auto me = static_cast<XdgSurface*>(wl_resource_get_user_data(resource));
         try
         {
@@ -544,6 +560,7 @@ struct mw::XdgToplevel::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -557,6 +574,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_parent_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* parent)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "set_parent"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> parent_resolved;
         if (parent != nullptr)
@@ -575,6 +593,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_title_thunk(struct wl_client* client, struct wl_resource* resource, char const* title)
     {
+        RequestTimer const request_timer{client, interface_name, 2, "set_title"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -588,6 +607,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_app_id_thunk(struct wl_client* client, struct wl_resource* resource, char const* app_id)
     {
+        RequestTimer const request_timer{client, interface_name, 3, "set_app_id"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -601,6 +621,7 @@ struct mw::XdgToplevel::Thunks
 
     static void show_window_menu_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, int32_t x, int32_t y)
     {
+        RequestTimer const request_timer{client, interface_name, 4, "show_window_menu"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -614,6 +635,7 @@ struct mw::XdgToplevel::Thunks
 
     static void move_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 5, "move"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -627,6 +649,7 @@ struct mw::XdgToplevel::Thunks
 
     static void resize_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial, uint32_t edges)
     {
+        RequestTimer const request_timer{client, interface_name, 6, "resize"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -640,6 +663,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_max_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 7, "set_max_size"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -653,6 +677,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_min_size_thunk(struct wl_client* client, struct wl_resource* resource, int32_t width, int32_t height)
     {
+        RequestTimer const request_timer{client, interface_name, 8, "set_min_size"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -666,6 +691,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_maximized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 9, "set_maximized"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -679,6 +705,7 @@ struct mw::XdgToplevel::Thunks
 
     static void unset_maximized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 10, "unset_maximized"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -692,6 +719,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_fullscreen_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* output)
     {
+        RequestTimer const request_timer{client, interface_name, 11, "set_fullscreen"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         std::experimental::optional<struct wl_resource*> output_resolved;
         if (output != nullptr)
@@ -710,6 +738,7 @@ struct mw::XdgToplevel::Thunks
 
     static void unset_fullscreen_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 12, "unset_fullscreen"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -723,6 +752,7 @@ struct mw::XdgToplevel::Thunks
 
     static void set_minimized_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 13, "set_minimized"};
         auto me = static_cast<XdgToplevel*>(wl_resource_get_user_data(resource));
         try
         {
@@ -852,6 +882,7 @@ struct mw::XdgPopup::Thunks
 
     static void destroy_thunk(struct wl_client* client, struct wl_resource* resource)
     {
+        RequestTimer const request_timer{client, interface_name, 0, "destroy"};
         auto me = static_cast<XdgPopup*>(wl_resource_get_user_data(resource));
         try
         {
@@ -865,6 +896,7 @@ struct mw::XdgPopup::Thunks
 
     static void grab_thunk(struct wl_client* client, struct wl_resource* resource, struct wl_resource* seat, uint32_t serial)
     {
+        RequestTimer const request_timer{client, interface_name, 1, "grab"};
         auto me = static_cast<XdgPopup*>(wl_resource_get_user_data(resource));
         try
         {
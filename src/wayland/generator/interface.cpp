@@ -451,10 +451,12 @@ Emitter Interface::types_init() const
 std::vector<Request> Interface::get_requests(xmlpp::Element const& node, std::string generated_name)
 {
     std::vector<Request> requests;
+    int opcode = 0;
     for (auto method_node : node.get_children("request"))
     {
         auto elem = dynamic_cast<xmlpp::Element*>(method_node);
-        requests.emplace_back(Request{std::ref(*elem), generated_name});
+        requests.emplace_back(Request{std::ref(*elem), generated_name, opcode});
+        opcode++;
     }
     return requests;
 }
@@ -18,8 +18,9 @@
 
 #include "request.h"
 
-Request::Request(xmlpp::Element const& node, std::string const& class_name)
-    : Method{node, class_name, false}
+Request::Request(xmlpp::Element const& node, std::string const& class_name, int opcode)
+    : Method{node, class_name, false},
+      opcode{opcode}
 {
 }
 
@@ -34,6 +35,7 @@ Emitter Request::thunk_impl() const
 {
     return {"static void ", name, "_thunk(", wl_args(), ")",
         Block{
+            {"RequestTimer const request_timer{client, interface_name, ", std::to_string(opcode), ", \"", name, "\"};"},
             {"auto me = static_cast<", class_name, "*>(wl_resource_get_user_data(resource));"},
             wl2mir_converters(),
             "try",
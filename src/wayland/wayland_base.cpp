@@ -22,8 +22,26 @@
 
 #include "mir/wayland/wayland_base.h"
 
+#include <atomic>
+
 namespace mw = mir::wayland;
 
+namespace
+{
+std::shared_ptr<mw::RequestReport> request_report;
+
+// Checked first, so that timing costs a single load while there is no report
+std::atomic<bool> reporting_requests{false};
+
+auto current_request_report() -> std::shared_ptr<mw::RequestReport>
+{
+    if (!reporting_requests.load(std::memory_order_relaxed))
+        return {};
+
+    return std::atomic_load(&request_report);
+}
+}
+
 mw::Resource::Resource()
 {
 }
@@ -55,3 +73,36 @@ void mw::internal_error_processing_request(wl_client* client, char const* method
         std::current_exception(),
         std::string() + "Exception processing " + method_name + " request");
 }
+
+void mw::set_request_report(std::shared_ptr<RequestReport> const& report)
+{
+    std::atomic_store(&request_report, report);
+    reporting_requests = static_cast<bool>(report);
+}
+
+mw::RequestTimer::RequestTimer(
+    wl_client* client,
+    char const* interface_name,
+    uint32_t opcode,
+    char const* request_name)
+    : report{current_request_report()},
+      client{client},
+      interface_name{interface_name},
+      opcode{opcode},
+      request_name{request_name},
+      start{report ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}}
+{
+}
+
+mw::RequestTimer::~RequestTimer()
+{
+    if (report)
+    {
+        report->request_handled(
+            client,
+            interface_name,
+            opcode,
+            request_name,
+            std::chrono::steady_clock::now() - start);
+    }
+}
@@ -38,6 +38,8 @@ public:
     MOCK_METHOD1(for_each_display_sync_group, void (std::function<void(graphics::DisplaySyncGroup&)> const&));
     MOCK_CONST_METHOD0(configuration, std::unique_ptr<graphics::DisplayConfiguration>());
     MOCK_METHOD1(apply_if_configuration_preserves_display_buffers, bool(graphics::DisplayConfiguration const&));
+    MOCK_METHOD2(apply_if_configuration_preserves_unchanged_sync_groups,
+                 bool(graphics::DisplayConfiguration const&, std::function<void(graphics::DisplaySyncGroup&)> const&));
     MOCK_METHOD1(configure, void(graphics::DisplayConfiguration const&));
     MOCK_METHOD2(register_configuration_change_handler,
                  void(graphics::EventHandlerRegister&, graphics::DisplayConfigurationChangeHandler const&));
@@ -86,6 +86,11 @@ struct StubShell : public shell::Shell
     {
     }
 
+    void apply_atomically(std::function<void()> const& changes) override
+    {
+        changes();
+    }
+
     void set_drag_and_drop_handle(std::vector<uint8_t> const& /*handle*/) override
     {
     }
@@ -74,6 +74,11 @@ struct TestSurfaceStack : public msh::SurfaceStack
         return wrapped->surface_at(point);
     }
 
+    void apply_atomically(std::function<void()> const& changes) override
+    {
+        wrapped->apply_atomically(changes);
+    }
+
     void default_add_surface(
         std::shared_ptr<ms::Surface> const& surface,
         mir::input::InputReceptionMode input_mode)
@@ -107,6 +107,10 @@ public:
         scene->remove_observer(observer);
     }
 
+    // The display used here never reconfigures incrementally
+    void remove_display_sync_group(mg::DisplaySyncGroup&) override {}
+    void add_new_display_sync_groups() override {}
+
 private:
     std::shared_ptr<mg::Display> const display;
     std::shared_ptr<mc::DisplayListener> const display_listener;
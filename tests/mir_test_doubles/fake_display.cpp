@@ -127,6 +127,13 @@ bool mtd::FakeDisplay::apply_if_configuration_preserves_display_buffers(graphics
     return false;
 }
 
+bool mtd::FakeDisplay::apply_if_configuration_preserves_unchanged_sync_groups(
+    graphics::DisplayConfiguration const&,
+    std::function<void(graphics::DisplaySyncGroup&)> const&)
+{
+    return false;
+}
+
 void mtd::FakeDisplay::configure(mir::graphics::DisplayConfiguration const& new_config)
 {
     std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
@@ -67,6 +67,12 @@ struct WrappingDisplay : mg::Display
     {
         return false;
     }
+    bool apply_if_configuration_preserves_unchanged_sync_groups(
+        mg::DisplayConfiguration const& /*conf*/,
+        std::function<void(mg::DisplaySyncGroup&)> const& /*remove_sync_group*/) override
+    {
+        return false;
+    }
     void configure(mg::DisplayConfiguration const& conf) override
     {
         display->configure(conf);
@@ -90,6 +90,67 @@ TEST_P(ForNormalSurface, state)
     EXPECT_THAT(info.state(), Eq(original_state));
     EXPECT_TRUE(info.is_visible());
 }
+
+using ForSeveralWindows = ModifyWindowState;
+
+TEST_F(ForSeveralWindows, modify_windows_applies_every_modification)
+{
+    create_window_of_type(mir_window_type_normal);
+    auto const first = window;
+    create_window_of_type(mir_window_type_normal);
+    auto const second = window;
+
+    WindowSpecification maximize;
+    maximize.state() = mir_window_state_maximized;
+    WindowSpecification move;
+    move.top_left() = Point{42, 24};
+
+    window_manager_tools.modify_windows({{first, maximize}, {second, move}});
+
+    EXPECT_THAT(window_manager_tools.info_for(first).state(), Eq(mir_window_state_maximized));
+    EXPECT_THAT(second.top_left(), Eq(Point{42, 24}));
+}
+
+TEST_F(ForSeveralWindows, modify_windows_with_an_invalid_modification_modifies_no_window)
+{
+    create_window_of_type(mir_window_type_normal);
+    auto const first = window;
+    create_window_of_type(mir_window_type_normal);
+    auto const second = window;
+
+    WindowSpecification maximize;
+    maximize.state() = mir_window_state_maximized;
+    WindowSpecification invalid;
+    invalid.type() = mir_window_type_gloss;
+
+    EXPECT_THROW(
+        window_manager_tools.modify_windows({{first, maximize}, {second, invalid}}),
+        std::runtime_error);
+
+    EXPECT_THAT(window_manager_tools.info_for(first).state(), Eq(mir_window_state_restored));
+    EXPECT_THAT(window_manager_tools.info_for(second).type(), Eq(mir_window_type_normal));
+}
+
+TEST_F(ForSeveralWindows, modify_windows_with_a_window_listed_twice_modifies_no_window)
+{
+    create_window_of_type(mir_window_type_normal);
+    auto const first = window;
+    create_window_of_type(mir_window_type_normal);
+    auto const second = window;
+    auto const original_top_left = second.top_left();
+
+    WindowSpecification maximize;
+    maximize.state() = mir_window_state_maximized;
+    WindowSpecification move;
+    move.top_left() = Point{42, 24};
+
+    EXPECT_THROW(
+        window_manager_tools.modify_windows({{first, maximize}, {second, move}, {first, move}}),
+        std::runtime_error);
+
+    EXPECT_THAT(window_manager_tools.info_for(first).state(), Eq(mir_window_state_restored));
+    EXPECT_THAT(second.top_left(), Eq(original_top_left));
+}
 }
 
 INSTANTIATE_TEST_SUITE_P(ModifyWindowState, ForNormalSurface, ::testing::Values(
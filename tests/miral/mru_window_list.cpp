@@ -189,3 +189,48 @@ TEST_F(MRUWindowList, hiding_then_showing_windows_retains_order)
     EXPECT_THAT(as_enumerated, ElementsAre(window_c, window_b, window_a));
 }
 
+
+TEST_F(MRUWindowList, erasing_a_window_keeps_the_order_of_the_others)
+{
+    mru_list.push(window_a);
+    mru_list.push(window_b);
+    mru_list.push(window_c);
+    mru_list.erase(window_b);
+
+    std::vector<miral::Window> as_enumerated;
+
+    mru_list.enumerate([&](miral::Window& window)
+       { as_enumerated.push_back(window); return true; });
+
+    EXPECT_THAT(as_enumerated, ElementsAre(window_c, window_a));
+}
+
+TEST_F(MRUWindowList, candidates_are_enumerated_in_mru_order)
+{
+    mru_list.push(window_a);
+    mru_list.push(window_b);
+    mru_list.push(window_c);
+    mru_list.push(window_a);
+
+    std::vector<miral::Window> as_enumerated;
+
+    mru_list.enumerate({window_c, window_a}, [&](miral::Window& window)
+       { as_enumerated.push_back(window); return true; });
+
+    EXPECT_THAT(as_enumerated, ElementsAre(window_a, window_c));
+}
+
+TEST_F(MRUWindowList, candidates_not_in_the_list_or_hidden_are_not_enumerated)
+{
+    mru_list.push(window_a);
+    mru_list.push(window_b);
+
+    hide_window(window_a_id);
+
+    std::vector<miral::Window> as_enumerated;
+
+    mru_list.enumerate({window_a, window_b, window_c}, [&](miral::Window& window)
+       { as_enumerated.push_back(window); return true; });
+
+    EXPECT_THAT(as_enumerated, ElementsAre(window_b));
+}
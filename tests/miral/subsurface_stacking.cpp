@@ -0,0 +1,358 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <miral/test_server.h>
+#include <miral/internal_client.h>
+#include <miral/minimal_window_manager.h>
+
+#include <mir/scene/session.h>
+#include <mir/scene/surface.h>
+#include <mir/graphics/renderable.h>
+
+#include <wayland-client.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+using namespace testing;
+using mir::geometry::Size;
+
+namespace
+{
+template<typename Type>
+auto make_scoped(Type* owned, void(*deleter)(Type*)) -> std::unique_ptr<Type, void(*)(Type*)>
+{
+    return {owned, deleter};
+}
+
+class WaylandClient
+{
+public:
+    void operator()(struct wl_display* display)
+    {
+        code(display);
+    }
+
+    void operator()(std::weak_ptr<mir::scene::Session> const& session)
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        session_ = session;
+    }
+
+    std::shared_ptr<mir::scene::Session> session() const
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        return session_.lock();
+    }
+
+    std::function<void (struct wl_display*)> code = [](auto){};
+
+private:
+    std::mutex mutable mutex;
+    std::weak_ptr<mir::scene::Session> session_;
+};
+
+// Counts the requests that reach the window manager
+struct CountingWindowManager : miral::MinimalWindowManager
+{
+    CountingWindowManager(miral::WindowManagerTools const& tools, std::atomic<int>& modifications) :
+        MinimalWindowManager{tools},
+        modifications{modifications}
+    {
+    }
+
+    void handle_modify_window(miral::WindowInfo& window_info, miral::WindowSpecification const& modifications) override
+    {
+        ++this->modifications;
+        MinimalWindowManager::handle_modify_window(window_info, modifications);
+    }
+
+    std::atomic<int>& modifications;
+};
+
+// A toplevel made of a 100x100 parent surface and subsurfaces of distinct sizes, so the stacking order of
+// the scene surface's renderables can be identified by their sizes
+struct Toplevel
+{
+    Toplevel(wl_display* display) : display{display}
+    {
+        auto const registry = make_scoped(wl_display_get_registry(display), &wl_registry_destroy);
+        wl_registry_add_listener(registry.get(), &registry_listener, this);
+        wl_display_roundtrip(display);
+
+        parent = wl_compositor_create_surface(compositor);
+        shell_surface = wl_shell_get_shell_surface(shell, parent);
+        wl_shell_surface_set_toplevel(shell_surface);
+        attach_buffer(parent, parent_size);
+        wl_surface_commit(parent);
+        wl_display_roundtrip(display);
+    }
+
+    ~Toplevel()
+    {
+        for (auto const& child : children)
+        {
+            wl_subsurface_destroy(child.subsurface);
+            wl_surface_destroy(child.surface);
+        }
+        wl_shell_surface_destroy(shell_surface);
+        wl_surface_destroy(parent);
+        for (auto const buffer : buffers)
+            wl_buffer_destroy(buffer);
+        wl_subcompositor_destroy(subcompositor);
+        wl_shm_destroy(shm);
+        wl_shell_destroy(shell);
+        wl_compositor_destroy(compositor);
+        wl_display_roundtrip(display);
+    }
+
+    struct Child
+    {
+        wl_surface* surface;
+        wl_subsurface* subsurface;
+    };
+
+    auto add_child(Size size) -> Child
+    {
+        auto const surface = wl_compositor_create_surface(compositor);
+        auto const subsurface = wl_subcompositor_get_subsurface(subcompositor, surface, parent);
+        children.push_back({surface, subsurface});
+
+        wl_subsurface_set_position(subsurface, 10, 10);
+        attach_buffer(surface, size);
+        wl_surface_commit(surface);
+        wl_surface_commit(parent);
+        wl_display_roundtrip(display);
+        return children.back();
+    }
+
+    void attach_buffer(wl_surface* surface, Size size)
+    {
+        auto const width = size.width.as_int();
+        auto const height = size.height.as_int();
+        auto const stride = 4 * width;
+
+        auto const fd = memfd_create("subsurface-stacking", MFD_CLOEXEC);
+        ASSERT_THAT(fd, Ge(0));
+        ASSERT_THAT(ftruncate(fd, stride * height), Eq(0));
+
+        auto const pool = wl_shm_create_pool(shm, fd, stride * height);
+        buffers.push_back(wl_shm_pool_create_buffer(pool, 0, width, height, stride, WL_SHM_FORMAT_ARGB8888));
+        wl_shm_pool_destroy(pool);
+        close(fd);
+
+        wl_surface_attach(surface, buffers.back(), 0, 0);
+        wl_surface_damage(surface, 0, 0, width, height);
+    }
+
+    static void new_global(void* data, wl_registry* registry, uint32_t id, char const* interface, uint32_t)
+    {
+        auto const self = static_cast<Toplevel*>(data);
+
+        if (strcmp(interface, wl_compositor_interface.name) == 0)
+            self->compositor = static_cast<wl_compositor*>(wl_registry_bind(registry, id, &wl_compositor_interface, 3));
+
+        if (strcmp(interface, wl_subcompositor_interface.name) == 0)
+            self->subcompositor =
+                static_cast<wl_subcompositor*>(wl_registry_bind(registry, id, &wl_subcompositor_interface, 1));
+
+        if (strcmp(interface, wl_shm_interface.name) == 0)
+            self->shm = static_cast<wl_shm*>(wl_registry_bind(registry, id, &wl_shm_interface, 1));
+
+        if (strcmp(interface, wl_shell_interface.name) == 0)
+            self->shell = static_cast<wl_shell*>(wl_registry_bind(registry, id, &wl_shell_interface, 1));
+    }
+
+    static void global_remove(void*, wl_registry*, uint32_t)
+    {
+    }
+
+    static wl_registry_listener constexpr registry_listener = {
+        new_global,
+        global_remove
+    };
+
+    Size const parent_size{100, 100};
+
+    wl_display* const display;
+    wl_compositor* compositor = nullptr;
+    wl_subcompositor* subcompositor = nullptr;
+    wl_shm* shm = nullptr;
+    wl_shell* shell = nullptr;
+    wl_surface* parent = nullptr;
+    wl_shell_surface* shell_surface = nullptr;
+    std::vector<Child> children;
+    std::vector<wl_buffer*> buffers;
+};
+
+wl_registry_listener constexpr Toplevel::registry_listener;
+
+struct SubsurfaceStacking : miral::TestServer
+{
+    SubsurfaceStacking()
+    {
+        add_server_init(launcher);
+    }
+
+    auto build_window_manager_policy(miral::WindowManagerTools const& tools)
+    -> std::unique_ptr<miral::WindowManagementPolicy> override
+    {
+        return std::make_unique<CountingWindowManager>(tools, modifications);
+    }
+
+    void run_as_client(std::function<void (struct wl_display*)>&& code)
+    {
+        bool client_run = false;
+        std::condition_variable cv;
+        std::mutex mutex;
+
+        client.code = [&](struct wl_display* display)
+            {
+                std::lock_guard<decltype(mutex)> lock{mutex};
+                code(display);
+                client_run = true;
+                cv.notify_one();
+            };
+
+        std::unique_lock<decltype(mutex)> lock{mutex};
+        launcher.launch(client);
+        cv.wait(lock, [&]{ return client_run; });
+    }
+
+    // The sizes of the window's renderables, bottom to top
+    auto stacking() const -> std::vector<Size>
+    {
+        std::vector<Size> result;
+        for (auto const& renderable : client.session()->default_surface()->generate_renderables(this))
+            result.push_back(renderable->screen_position().size);
+        return result;
+    }
+
+    std::atomic<int> modifications{0};
+
+private:
+    miral::InternalClientLauncher launcher;
+    WaylandClient client;
+};
+
+Size const small{20, 20};
+Size const medium{40, 40};
+}
+
+TEST_F(SubsurfaceStacking, subsurfaces_start_above_the_parent_in_creation_order)
+{
+    run_as_client([&](wl_display* display)
+        {
+            Toplevel toplevel{display};
+            toplevel.add_child(medium);
+            toplevel.add_child(small);
+
+            EXPECT_THAT(stacking(), ElementsAre(toplevel.parent_size, medium, small));
+        });
+}
+
+TEST_F(SubsurfaceStacking, place_below_the_parent_takes_effect_when_the_parent_commits)
+{
+    run_as_client([&](wl_display* display)
+        {
+            Toplevel toplevel{display};
+            auto const child = toplevel.add_child(medium);
+
+            wl_subsurface_place_below(child.subsurface, toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(toplevel.parent_size, medium));
+
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(medium, toplevel.parent_size));
+        });
+}
+
+TEST_F(SubsurfaceStacking, place_above_the_parent_restores_the_order)
+{
+    run_as_client([&](wl_display* display)
+        {
+            Toplevel toplevel{display};
+            auto const lower = toplevel.add_child(medium);
+            auto const upper = toplevel.add_child(small);
+
+            wl_subsurface_place_below(upper.subsurface, toplevel.parent);
+            wl_subsurface_place_below(lower.subsurface, upper.surface);
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            ASSERT_THAT(stacking(), ElementsAre(medium, small, toplevel.parent_size));
+
+            wl_subsurface_place_above(upper.subsurface, toplevel.parent);
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(medium, toplevel.parent_size, small));
+        });
+}
+
+TEST_F(SubsurfaceStacking, place_above_and_below_a_sibling)
+{
+    run_as_client([&](wl_display* display)
+        {
+            Toplevel toplevel{display};
+            auto const lower = toplevel.add_child(medium);
+            auto const upper = toplevel.add_child(small);
+
+            wl_subsurface_place_above(lower.subsurface, upper.surface);
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(toplevel.parent_size, small, medium));
+
+            wl_subsurface_place_below(lower.subsurface, upper.surface);
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(toplevel.parent_size, medium, small));
+        });
+}
+
+TEST_F(SubsurfaceStacking, restacking_reaches_the_scene_without_the_window_manager)
+{
+    run_as_client([&](wl_display* display)
+        {
+            Toplevel toplevel{display};
+            auto const lower = toplevel.add_child(medium);
+            auto const upper = toplevel.add_child(small);
+            auto const modifications_before = modifications.load();
+
+            wl_subsurface_place_above(lower.subsurface, upper.surface);
+            wl_subsurface_place_below(upper.subsurface, toplevel.parent);
+            wl_surface_commit(toplevel.parent);
+            wl_display_roundtrip(display);
+
+            EXPECT_THAT(stacking(), ElementsAre(small, toplevel.parent_size, medium));
+            EXPECT_THAT(modifications.load(), Eq(modifications_before));
+        });
+}
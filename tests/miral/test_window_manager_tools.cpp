@@ -57,6 +57,8 @@ struct StubFocusController : mir::shell::FocusController
 
     void raise(mir::shell::SurfaceSet const& /*windows*/) override {}
 
+    void apply_atomically(std::function<void()> const& changes) override { changes(); }
+
     virtual auto surface_at(mir::geometry::Point /*cursor*/) const -> std::shared_ptr<mir::scene::Surface> override
         { return {}; }
 
@@ -275,6 +277,14 @@ struct mt::TestWindowManagerTools::Self
 };
 
 mt::TestWindowManagerTools::TestWindowManagerTools()
+    : TestWindowManagerTools{[](miral::WindowManagerTools const& tools, miral::WindowManagementPolicyBuilder const& build)
+        {
+            return build(tools);
+        }}
+{
+}
+
+mt::TestWindowManagerTools::TestWindowManagerTools(PolicyWrapper const& wrap_policy)
     : self{std::make_unique<Self>()},
       session{std::make_shared<StubStubSession>()},
       window_manager_policy{nullptr},
@@ -284,12 +294,16 @@ mt::TestWindowManagerTools::TestWindowManagerTools()
         mir::test::fake_shared(self->display_layout),
         mir::test::fake_shared(self->persistent_surface_store),
         self->display_configuration_observer,
-        [this](miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+        [this, wrap_policy](miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
             {
-                auto policy = std::make_unique<testing::NiceMock<MockWindowManagerPolicy>>(tools);
-                window_manager_policy = policy.get();
-                window_manager_tools = tools;
-                return policy;
+                return wrap_policy(tools, [this](miral::WindowManagerTools const& tools)
+                    -> std::unique_ptr<miral::WindowManagementPolicy>
+                    {
+                        auto policy = std::make_unique<testing::NiceMock<MockWindowManagerPolicy>>(tools);
+                        window_manager_policy = policy.get();
+                        window_manager_tools = tools;
+                        return policy;
+                    });
             }
     }
 {
@@ -80,6 +80,12 @@ public:
     TestWindowManagerTools();
     ~TestWindowManagerTools();
 
+    /// Builds the policy given to the window manager (for example a trace) around the mock policy
+    using PolicyWrapper = std::function<std::unique_ptr<miral::WindowManagementPolicy>(
+        miral::WindowManagerTools const& tools, miral::WindowManagementPolicyBuilder const& build_mock_policy)>;
+
+    explicit TestWindowManagerTools(PolicyWrapper const& wrap_policy);
+
     std::shared_ptr<mir::scene::Session> session;
     MockWindowManagerPolicy* window_manager_policy;
     miral::WindowManagerTools window_manager_tools;
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "window_management_trace_record.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+
+using namespace testing;
+using miral::WindowManagementTraceRecord;
+
+namespace
+{
+auto record_with(std::map<std::string, std::string> const& fields) -> WindowManagementTraceRecord
+{
+    WindowManagementTraceRecord record;
+    record.timestamp = std::chrono::nanoseconds{1042117};
+    record.operation = "advise_new_window";
+    record.fields = fields;
+    return record;
+}
+}
+
+TEST(WindowManagementTraceRecord, survives_a_round_trip_through_a_line)
+{
+    auto const record = record_with({{"window", "1f1b2d0"}, {"width", "640"}, {"x", "-12"}});
+
+    auto const copy = WindowManagementTraceRecord::from_line(record.to_line());
+
+    EXPECT_THAT(copy.timestamp, Eq(record.timestamp));
+    EXPECT_THAT(copy.operation, Eq(record.operation));
+    EXPECT_THAT(copy.fields, Eq(record.fields));
+}
+
+TEST(WindowManagementTraceRecord, values_with_separators_survive_a_round_trip)
+{
+    std::string const awkward{"100% = a\tname\nwith spaces"};
+    auto const record = record_with({{"name", awkward}, {"empty", ""}});
+
+    auto const line = record.to_line();
+    auto const copy = WindowManagementTraceRecord::from_line(line);
+
+    EXPECT_THAT(line, Not(HasSubstr("\n")));
+    EXPECT_THAT(copy.field("name"), Eq(awkward));
+    EXPECT_THAT(copy.field("empty"), Eq(""));
+}
+
+TEST(WindowManagementTraceRecord, numeric_fields_are_parsed)
+{
+    auto const record = WindowManagementTraceRecord::from_line("7 handle_pointer_event x=12.5 buttons=3");
+
+    EXPECT_THAT(record.number_field("x"), DoubleEq(12.5));
+    EXPECT_THAT(record.integer_field("buttons"), Eq(3));
+}
+
+TEST(WindowManagementTraceRecord, missing_field_throws)
+{
+    auto const record = record_with({});
+
+    EXPECT_FALSE(record.has_field("window"));
+    EXPECT_THROW(record.field("window"), std::runtime_error);
+}
+
+TEST(WindowManagementTraceRecord, malformed_lines_throw)
+{
+    EXPECT_THROW(WindowManagementTraceRecord::from_line(""), std::runtime_error);
+    EXPECT_THROW(WindowManagementTraceRecord::from_line("not-a-timestamp advise_new_app"), std::runtime_error);
+    EXPECT_THROW(WindowManagementTraceRecord::from_line("1 advise_new_app app"), std::runtime_error);
+    EXPECT_THROW(WindowManagementTraceRecord::from_line("1 advise_new_app name=trunc%2"), std::runtime_error);
+}
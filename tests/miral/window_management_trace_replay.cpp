@@ -0,0 +1,138 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trace_replay.h"
+#include "window_management_trace.h"
+
+#include <miral/minimal_window_manager.h>
+
+#include <mir/events/event_builders.h>
+#include <mir/scene/surface_creation_parameters.h>
+#include <mir/shell/surface_specification.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fstream>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace mb = mir::benchmark;
+namespace mev = mir::events;
+namespace ms = mir::scene;
+namespace msh = mir::shell;
+namespace geom = mir::geometry;
+
+using namespace testing;
+using miral::WindowManagementTraceRecord;
+
+namespace
+{
+geom::Rectangle const output{{0, 0}, {1920, 1080}};
+
+auto minimal_window_manager(miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+{
+    return std::make_unique<miral::MinimalWindowManager>(tools);
+}
+
+struct WindowManagementTraceReplay : Test
+{
+    WindowManagementTraceReplay()
+    {
+        char name[] = "/tmp/miral_window_management_trace_XXXXXX";
+        close(mkstemp(name));
+        trace_file = name;
+    }
+
+    ~WindowManagementTraceReplay()
+    {
+        unlink(trace_file.c_str());
+    }
+
+    auto traced_window_manager() -> std::unique_ptr<mb::HeadlessWindowManager>
+    {
+        auto const path = trace_file;
+        return std::make_unique<mb::HeadlessWindowManager>(
+            std::vector<geom::Rectangle>{output},
+            [path](miral::WindowManagerTools const& tools) -> std::unique_ptr<miral::WindowManagementPolicy>
+            {
+                return std::make_unique<miral::WindowManagementTrace>(
+                    tools,
+                    &minimal_window_manager,
+                    false,
+                    miral::WindowManagementTrace::open_trace_records(path));
+            });
+    }
+
+    auto operations_in_trace() const -> std::vector<std::string>
+    {
+        std::vector<std::string> result;
+        for (auto const& record : mb::read_trace(trace_file))
+            result.push_back(record.operation);
+        return result;
+    }
+
+    std::string trace_file;
+};
+}
+
+TEST_F(WindowManagementTraceReplay, a_traced_session_replays_without_skipping_anything)
+{
+    {
+        auto const traced = traced_window_manager();
+        auto& window_manager = traced->window_manager();
+
+        auto const application = traced->add_application("traced");
+
+        ms::SurfaceCreationParameters params;
+        params.name = "window";
+        params.type = mir_window_type_normal;
+        params.size = geom::Size{640, 480};
+        auto const window = traced->add_window(application, params);
+        traced->post_first_frame(window);
+
+        msh::SurfaceSpecification modifications;
+        modifications.top_left = geom::Point{42, 24};
+        window_manager.modify_surface(application, window, modifications);
+
+        window_manager.handle_raise_surface(application, window, 0);
+
+        auto const pointer = mev::make_event(0, std::chrono::nanoseconds{1}, std::vector<uint8_t>{},
+            mir_input_event_modifier_none, mir_pointer_action_motion, 0, 100.0f, 100.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        window_manager.handle_pointer_event(
+            mir_input_event_get_pointer_event(mir_event_get_input_event(pointer.get())));
+
+        traced->remove_window(window);
+        traced->remove_application(application);
+
+        // The trace is written as it goes, not only when tracing stops
+        EXPECT_THAT(operations_in_trace(), IsSupersetOf({
+            "advise_new_app", "advise_new_window", "handle_window_ready", "handle_modify_window",
+            "handle_raise_window", "handle_pointer_event", "advise_delete_window", "advise_delete_app"}));
+    }
+
+    mb::TraceReplay replay{&minimal_window_manager};
+    std::vector<std::string> skipped;
+
+    for (auto const& record : mb::read_trace(trace_file))
+    {
+        if (!replay.apply(record))
+            skipped.push_back(record.to_line());
+    }
+
+    EXPECT_THAT(skipped, IsEmpty());
+}
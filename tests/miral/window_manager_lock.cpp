@@ -0,0 +1,268 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_window_manager_tools.h"
+#include "window_management_trace.h"
+
+#include <mir/events/event_builders.h>
+#include <mir/scene/surface_creation_parameters.h>
+#include <mir/shell/shell_report.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace miral;
+using namespace testing;
+using namespace std::chrono_literals;
+namespace mt = mir::test;
+namespace mev = mir::events;
+
+namespace
+{
+struct WindowManagerLock : mt::TestWindowManagerTools
+{
+    using mt::TestWindowManagerTools::TestWindowManagerTools;
+
+    /// Waits (for a while) until count threads have arrived
+    bool all_arrive(int count)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        ++arrived;
+        cv.notify_all();
+        return cv.wait_for(lock, 5s, [&]{ return arrived >= count; });
+    }
+
+    auto create_window() -> Window
+    {
+        basic_window_manager.add_session(session);
+
+        Window window;
+        EXPECT_CALL(*window_manager_policy, advise_new_window(_))
+            .WillOnce(Invoke([&window](WindowInfo const& window_info) { window = window_info.window(); }));
+
+        mir::scene::SurfaceCreationParameters params;
+        params.type = mir_window_type_normal;
+        params.size = mir::geometry::Size{200, 200};
+        basic_window_manager.add_surface(session, params, &create_surface);
+
+        Mock::VerifyAndClearExpectations(window_manager_policy);
+        return window;
+    }
+
+    /// Requests made before a button press are for earlier input
+    void handle_button_press_at(std::chrono::nanoseconds timestamp)
+    {
+        auto const event = mev::make_event(0, timestamp, std::vector<uint8_t>{},
+            mir_input_event_modifier_none, mir_pointer_action_button_down, mir_pointer_button_primary,
+            100.0f, 100.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        basic_window_manager.handle_pointer_event(
+            mir_input_event_get_pointer_event(mir_event_get_input_event(event.get())));
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int arrived{0};
+};
+
+struct TracedWindowManagerLock : WindowManagerLock
+{
+    TracedWindowManagerLock() :
+        WindowManagerLock{[](WindowManagerTools const& tools, WindowManagementPolicyBuilder const& build_mock_policy)
+            {
+                return std::make_unique<WindowManagementTrace>(tools, build_mock_policy, true, nullptr);
+            }}
+    {
+    }
+};
+}
+
+TEST_F(WindowManagerLock, shared_lock_callbacks_run_concurrently)
+{
+    std::atomic<bool> other_saw_both{false};
+
+    std::thread other{[&]
+        {
+            window_manager_tools.invoke_under_shared_lock([&]{ other_saw_both = all_arrive(2); });
+        }};
+
+    bool saw_both{false};
+    window_manager_tools.invoke_under_shared_lock([&]{ saw_both = all_arrive(2); });
+    other.join();
+
+    EXPECT_TRUE(saw_both);
+    EXPECT_TRUE(other_saw_both);
+}
+
+TEST_F(WindowManagerLock, shared_lock_callbacks_can_query_the_model)
+{
+    basic_window_manager.add_session(session);
+
+    unsigned int applications{0};
+    Window active;
+    window_manager_tools.invoke_under_shared_lock([&]
+        {
+            applications = window_manager_tools.count_applications();
+            active = window_manager_tools.active_window();
+        });
+
+    EXPECT_THAT(applications, Eq(1u));
+    EXPECT_FALSE(active);
+}
+
+TEST_F(WindowManagerLock, acquisitions_are_counted)
+{
+    auto const before = basic_window_manager.lock_contention();
+
+    basic_window_manager.add_session(session);
+    window_manager_tools.invoke_under_lock([]{});
+    window_manager_tools.invoke_under_shared_lock([]{});
+
+    auto const after = basic_window_manager.lock_contention();
+
+    EXPECT_THAT(after.exclusive_acquisitions - before.exclusive_acquisitions, Eq(2u));
+    EXPECT_THAT(after.shared_acquisitions - before.shared_acquisitions, Eq(1u));
+    EXPECT_THAT(after.exclusive_contended, Eq(before.exclusive_contended));
+    EXPECT_THAT(after.shared_contended, Eq(before.shared_contended));
+}
+
+TEST_F(WindowManagerLock, waiting_for_the_lock_is_counted)
+{
+    auto const before = basic_window_manager.lock_contention();
+    std::thread other;
+
+    window_manager_tools.invoke_under_lock([&]
+        {
+            other = std::thread{[&]
+                {
+                    all_arrive(2);
+                    window_manager_tools.invoke_under_shared_lock([]{});
+                }};
+
+            all_arrive(2);
+            std::this_thread::sleep_for(100ms);
+        });
+    other.join();
+
+    auto const after = basic_window_manager.lock_contention();
+
+    EXPECT_THAT(after.shared_contended - before.shared_contended, Eq(1u));
+    EXPECT_THAT(after.time_waiting, Gt(before.time_waiting));
+}
+
+TEST_F(WindowManagerLock, stale_requests_are_dropped_under_the_shared_lock)
+{
+    auto const window = create_window();
+    handle_button_press_at(1000ns);
+
+    auto const before = basic_window_manager.lock_contention();
+
+    EXPECT_CALL(*window_manager_policy, advise_raise(_)).Times(0);
+    basic_window_manager.handle_raise_surface(session, window, 999);
+    basic_window_manager.handle_request_move(session, window, 999);
+    basic_window_manager.handle_request_resize(session, window, 999, mir_resize_edge_east);
+    basic_window_manager.handle_request_drag_and_drop(session, window, 999);
+
+    auto const after = basic_window_manager.lock_contention();
+
+    EXPECT_THAT(after.shared_acquisitions - before.shared_acquisitions, Eq(4u));
+    EXPECT_THAT(after.exclusive_acquisitions, Eq(before.exclusive_acquisitions));
+}
+
+TEST_F(WindowManagerLock, current_requests_are_handled_under_the_exclusive_lock)
+{
+    auto const window = create_window();
+    handle_button_press_at(1000ns);
+
+    auto const before = basic_window_manager.lock_contention();
+
+    EXPECT_CALL(*window_manager_policy, advise_raise(_));
+    basic_window_manager.handle_raise_surface(session, window, 1000);
+
+    auto const after = basic_window_manager.lock_contention();
+
+    EXPECT_THAT(after.shared_acquisitions - before.shared_acquisitions, Eq(1u));
+    EXPECT_THAT(after.exclusive_acquisitions - before.exclusive_acquisitions, Eq(1u));
+}
+
+TEST_F(WindowManagerLock, waiting_writer_is_preferred_to_new_readers)
+{
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+    auto const ran = [&](std::string const& name)
+        {
+            std::lock_guard<std::mutex> const lock{order_mutex};
+            order.push_back(name);
+        };
+
+    std::thread writer;
+    std::thread reader;
+
+    window_manager_tools.invoke_under_shared_lock([&]
+        {
+            writer = std::thread{[&] { window_manager_tools.invoke_under_lock([&]{ ran("writer"); }); }};
+            std::this_thread::sleep_for(100ms);
+
+            reader = std::thread{[&] { window_manager_tools.invoke_under_shared_lock([&]{ ran("reader"); }); }};
+            std::this_thread::sleep_for(100ms);
+        });
+
+    writer.join();
+    reader.join();
+
+    EXPECT_THAT(order, ElementsAre("writer", "reader"));
+}
+
+TEST_F(TracedWindowManagerLock, shared_lock_queries_run_concurrently_after_input)
+{
+    basic_window_manager.add_session(session);
+
+    {
+        // The policy doesn't query the window manager while handling this, so the trace has yet to log it
+        auto const event = mev::make_event(0, std::chrono::nanoseconds{1}, std::vector<uint8_t>{},
+            mir_input_event_modifier_none, mir_pointer_action_motion, 0, 100.0f, 100.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        basic_window_manager.handle_pointer_event(
+            mir_input_event_get_pointer_event(mir_event_get_input_event(event.get())));
+    }
+
+    int const threads{4};
+    int const queries{10};
+    std::atomic<unsigned int> applications{0};
+    std::atomic<int> all_arrived{0};
+
+    auto const query = [&]
+        {
+            window_manager_tools.invoke_under_shared_lock([&]
+                {
+                    all_arrived += all_arrive(threads);
+                    for (auto i = 0; i != queries; ++i)
+                        applications += window_manager_tools.count_applications();
+                });
+        };
+
+    std::vector<std::thread> others;
+    for (auto i = 1; i != threads; ++i)
+        others.emplace_back(query);
+
+    query();
+    for (auto& other : others)
+        other.join();
+
+    EXPECT_THAT(all_arrived.load(), Eq(threads));
+    EXPECT_THAT(applications.load(), Eq(static_cast<unsigned int>(threads * queries)));
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xcursor_loader.h"
+
+#include <mir/graphics/cursor_image.h>
+#include <mir_toolkit/cursors.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace geom = mir::geometry;
+namespace mi = mir::input;
+
+using namespace testing;
+
+namespace
+{
+// XCursor reads the search path once, so every test shares it and uses a theme of its own
+auto cursor_path() -> std::string const&
+{
+    static std::string const path = []
+        {
+            char name[] = "/tmp/miral_xcursor_loader_XXXXXX";
+            if (!mkdtemp(name))
+                throw std::runtime_error{"Failed to create cursor theme directory"};
+            setenv("XCURSOR_PATH", name, 1);
+            return std::string{name};
+        }();
+
+    return path;
+}
+
+void write_uint(std::ofstream& file, uint32_t value)
+{
+    for (auto i = 0; i != 4; ++i)
+        file.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+struct XCursorLoader : Test
+{
+    XCursorLoader() :
+        theme{::testing::UnitTest::GetInstance()->current_test_info()->name()},
+        theme_dir{cursor_path() + "/" + theme}
+    {
+        mkdir(theme_dir.c_str(), 0700);
+        mkdir((theme_dir + "/cursors").c_str(), 0700);
+    }
+
+    ~XCursorLoader()
+    {
+        for (auto const& file : written)
+            unlink(file.c_str());
+
+        rmdir((theme_dir + "/cursors").c_str());
+        rmdir(theme_dir.c_str());
+    }
+
+    /// Writes a square, single frame XCursor file with an image at each of \a sizes
+    void write_cursor(std::string const& name, std::vector<uint32_t> const& sizes)
+    {
+        uint32_t const image_type = 0xfffd0002;
+        uint32_t const file_header_length = 16;
+        uint32_t const image_header_length = 36;
+
+        auto const filename = theme_dir + "/cursors/" + name;
+        std::ofstream file{filename, std::ios::binary};
+
+        write_uint(file, 0x72756358); // "Xcur"
+        write_uint(file, file_header_length);
+        write_uint(file, 0x10000);
+        write_uint(file, sizes.size());
+
+        auto position = file_header_length + 12 * sizes.size();
+        for (auto const size : sizes)
+        {
+            write_uint(file, image_type);
+            write_uint(file, size);
+            write_uint(file, position);
+            position += image_header_length + 4 * size * size;
+        }
+
+        for (auto const size : sizes)
+        {
+            write_uint(file, image_header_length);
+            write_uint(file, image_type);
+            write_uint(file, size);
+            write_uint(file, 1);
+            write_uint(file, size);     // width
+            write_uint(file, size);     // height
+            write_uint(file, 0);        // xhot
+            write_uint(file, 0);        // yhot
+            write_uint(file, 0);        // delay
+            for (auto pixel = 0u; pixel != size * size; ++pixel)
+                write_uint(file, 0xff000000);
+        }
+
+        written.push_back(filename);
+    }
+
+    std::string const theme;
+    std::string const theme_dir;
+    std::vector<std::string> written;
+};
+}
+
+TEST_F(XCursorLoader, loads_cursors_when_first_used)
+{
+    miral::XCursorLoader loader{theme};
+
+    // Written after the loader was created
+    write_cursor("watch", {24});
+
+    auto const image = loader.image(mir_busy_cursor_name, mi::default_cursor_size);
+
+    ASSERT_THAT(image, NotNull());
+    EXPECT_THAT(image->size(), Eq(geom::Size{24, 24}));
+}
+
+TEST_F(XCursorLoader, returns_the_image_of_the_requested_size)
+{
+    write_cursor("arrow", {16, 24, 32});
+    miral::XCursorLoader loader{theme};
+
+    for (auto const size : {16, 24, 32})
+    {
+        auto const image = loader.image(mir_arrow_cursor_name, geom::Size{size, size});
+
+        ASSERT_THAT(image, NotNull());
+        EXPECT_THAT(image->size(), Eq(geom::Size{size, size}));
+    }
+}
+
+TEST_F(XCursorLoader, falls_back_to_the_arrow_for_unknown_cursors)
+{
+    write_cursor("arrow", {24});
+    miral::XCursorLoader loader{theme};
+
+    auto const image = loader.image("no-such-cursor", mi::default_cursor_size);
+
+    ASSERT_THAT(image, NotNull());
+    EXPECT_THAT(image, Eq(loader.image(mir_arrow_cursor_name, mi::default_cursor_size)));
+}
+
+TEST_F(XCursorLoader, keeps_the_most_recently_used_images_loaded)
+{
+    auto const max_loaded_images = 32;
+    for (auto i = 0; i != max_loaded_images; ++i)
+        write_cursor("cursor-" + std::to_string(i), {24});
+    miral::XCursorLoader loader{theme};
+
+    auto const first = loader.image("cursor-0", mi::default_cursor_size);
+    for (auto i = 1; i != max_loaded_images; ++i)
+        loader.image("cursor-" + std::to_string(i), mi::default_cursor_size);
+
+    EXPECT_THAT(loader.image("cursor-0", mi::default_cursor_size), Eq(first));
+}
+
+TEST_F(XCursorLoader, evicts_the_least_recently_used_image_when_full)
+{
+    auto const max_loaded_images = 32;
+    for (auto i = 0; i != max_loaded_images + 1; ++i)
+        write_cursor("cursor-" + std::to_string(i), {24});
+    miral::XCursorLoader loader{theme};
+
+    auto const first = loader.image("cursor-0", mi::default_cursor_size);
+    auto const second = loader.image("cursor-1", mi::default_cursor_size);
+    loader.image("cursor-0", mi::default_cursor_size);
+
+    for (auto i = 2; i != max_loaded_images + 1; ++i)
+        loader.image("cursor-" + std::to_string(i), mi::default_cursor_size);
+
+    // cursor-1 was the least recently used, so it alone is loaded again
+    EXPECT_THAT(loader.image("cursor-0", mi::default_cursor_size), Eq(first));
+    EXPECT_THAT(loader.image("cursor-1", mi::default_cursor_size), Ne(second));
+}
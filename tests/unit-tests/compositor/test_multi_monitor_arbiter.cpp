@@ -661,3 +661,66 @@ TEST_F(MultiMonitorArbiter, second_compositor_advances_schedule_after_both_aquir
     auto cbuffer4 = arbiter.compositor_acquire(&comp_id2);
     EXPECT_THAT(cbuffer1, Not(IsSameBufferAs(cbuffer4)));
 }
+
+TEST_F(MultiMonitorArbiter, in_mailbox_delivery_slower_compositor_gets_the_newest_buffer)
+{
+    int fast_id{0};
+    int slow_id{0};
+    arbiter.set_delivery(mc::MultiMonitorArbiter::Delivery::mailbox);
+
+    schedule.set_schedule({buffers[0]});
+    auto fast1 = arbiter.compositor_acquire(&fast_id);
+    auto slow1 = arbiter.compositor_acquire(&slow_id);
+
+    schedule.set_schedule({buffers[1]});
+    auto fast2 = arbiter.compositor_acquire(&fast_id);
+    schedule.set_schedule({buffers[2]});
+    auto fast3 = arbiter.compositor_acquire(&fast_id);
+
+    // In lockstep the slow compositor would be given buffers[1] here, a frame behind
+    auto slow2 = arbiter.compositor_acquire(&slow_id);
+
+    EXPECT_THAT(fast1, IsSameBufferAs(buffers[0]));
+    EXPECT_THAT(slow1, IsSameBufferAs(buffers[0]));
+    EXPECT_THAT(fast2, IsSameBufferAs(buffers[1]));
+    EXPECT_THAT(fast3, IsSameBufferAs(buffers[2]));
+    EXPECT_THAT(slow2, IsSameBufferAs(buffers[2]));
+}
+
+TEST_F(MultiMonitorArbiter, in_mailbox_delivery_compositor_reuses_current_buffer_until_a_new_one_is_scheduled)
+{
+    int comp_id1{0};
+    int comp_id2{0};
+    arbiter.set_delivery(mc::MultiMonitorArbiter::Delivery::mailbox);
+
+    schedule.set_schedule({buffers[0]});
+    auto b1 = arbiter.compositor_acquire(&comp_id1);
+    auto b2 = arbiter.compositor_acquire(&comp_id1);
+    auto b3 = arbiter.compositor_acquire(&comp_id2);
+
+    EXPECT_THAT(b1, IsSameBufferAs(buffers[0]));
+    EXPECT_THAT(b2, IsSameBufferAs(buffers[0]));
+    EXPECT_THAT(b3, IsSameBufferAs(buffers[0]));
+    EXPECT_FALSE(arbiter.buffer_ready_for(&comp_id1));
+    EXPECT_FALSE(arbiter.buffer_ready_for(&comp_id2));
+}
+
+TEST_F(MultiMonitorArbiter, in_mailbox_delivery_superseded_buffer_is_released_when_no_compositor_shows_it)
+{
+    int fast_id{0};
+    int slow_id{0};
+    auto buffer_released = std::make_shared<bool>(false);
+    arbiter.set_delivery(mc::MultiMonitorArbiter::Delivery::mailbox);
+
+    schedule.set_schedule({wrap_with_destruction_notifier(buffers[0], buffer_released)});
+    auto fast1 = arbiter.compositor_acquire(&fast_id);
+    auto slow1 = arbiter.compositor_acquire(&slow_id);
+
+    schedule.set_schedule({buffers[1]});
+    auto fast2 = arbiter.compositor_acquire(&fast_id);
+    fast1.reset();
+    EXPECT_FALSE(*buffer_released);
+
+    slow1.reset();
+    EXPECT_TRUE(*buffer_released);
+}
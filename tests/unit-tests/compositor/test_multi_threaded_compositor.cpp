@@ -871,6 +871,62 @@ TEST(MultiThreadedCompositor, registers_and_unregisters_with_scene)
     compositor.stop();
 }
 
+TEST(MultiThreadedCompositor, removing_a_display_sync_group_only_stops_compositing_it)
+{
+    using namespace testing;
+    unsigned int const nbuffers{3};
+    auto display = std::make_shared<StubDisplayWithMockBuffers>(nbuffers);
+    auto mock_scene = std::make_shared<NiceMock<mtd::MockScene>>();
+    auto db_compositor_factory = std::make_shared<mtd::NullDisplayBufferCompositorFactory>();
+    auto mock_report = std::make_shared<testing::NiceMock<mtd::MockCompositorReport>>();
+
+    mc::MultiThreadedCompositor compositor{
+        display, mock_scene, db_compositor_factory, null_display_listener, mock_report, default_delay, true};
+
+    compositor.start();
+
+    mg::DisplaySyncGroup* first_group{nullptr};
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { if (!first_group) first_group = &group; });
+
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(1);
+    compositor.remove_display_sync_group(*first_group);
+    Mock::VerifyAndClearExpectations(mock_scene.get());
+
+    EXPECT_CALL(*mock_scene, unregister_compositor(_)).Times(nbuffers - 1);
+    compositor.stop();
+}
+
+TEST(MultiThreadedCompositor, adding_new_display_sync_groups_only_starts_compositing_new_groups)
+{
+    using namespace testing;
+    unsigned int const nbuffers{3};
+    auto display = std::make_shared<StubDisplayWithMockBuffers>(nbuffers);
+    auto mock_scene = std::make_shared<NiceMock<mtd::MockScene>>();
+    auto db_compositor_factory = std::make_shared<mtd::NullDisplayBufferCompositorFactory>();
+    auto mock_report = std::make_shared<testing::NiceMock<mtd::MockCompositorReport>>();
+
+    mc::MultiThreadedCompositor compositor{
+        display, mock_scene, db_compositor_factory, null_display_listener, mock_report, default_delay, true};
+
+    compositor.start();
+
+    mg::DisplaySyncGroup* first_group{nullptr};
+    display->for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group) { if (!first_group) first_group = &group; });
+    compositor.remove_display_sync_group(*first_group);
+
+    EXPECT_CALL(*mock_scene, register_compositor(_)).Times(1);
+    compositor.add_new_display_sync_groups();
+    Mock::VerifyAndClearExpectations(mock_scene.get());
+
+    EXPECT_CALL(*mock_scene, register_compositor(_)).Times(0);
+    compositor.add_new_display_sync_groups();
+    Mock::VerifyAndClearExpectations(mock_scene.get());
+
+    compositor.stop();
+}
+
 TEST(MultiThreadedCompositor, notifies_about_display_additions_and_removals)
 {
     using namespace testing;
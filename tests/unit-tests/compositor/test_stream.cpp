@@ -128,6 +128,28 @@ TEST_F(Stream, indicates_buffers_ready_when_dropping)
     EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(0));
 }
 
+TEST_F(Stream, when_dropping_each_compositor_gets_the_newest_buffer)
+{
+    int fast_id{0};
+    int slow_id{0};
+    stream.allow_framedropping(true);
+
+    stream.submit_buffer(buffers[0]);
+    auto fast1 = stream.lock_compositor_buffer(&fast_id);
+    auto slow1 = stream.lock_compositor_buffer(&slow_id);
+
+    stream.submit_buffer(buffers[1]);
+    auto fast2 = stream.lock_compositor_buffer(&fast_id);
+    stream.submit_buffer(buffers[2]);
+
+    EXPECT_THAT(stream.buffers_ready_for_compositor(&slow_id), Eq(1));
+    auto slow2 = stream.lock_compositor_buffer(&slow_id);
+
+    EXPECT_THAT(fast2->id(), Eq(buffers[1]->id()));
+    EXPECT_THAT(slow2->id(), Eq(buffers[2]->id()));
+    EXPECT_THAT(stream.buffers_ready_for_compositor(&fast_id), Eq(1));
+}
+
 TEST_F(Stream, tracks_has_buffer)
 {
     EXPECT_FALSE(stream.has_submitted_buffer());
@@ -0,0 +1,216 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/geometry/region.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <random>
+
+using namespace mir::geometry;
+using namespace testing;
+
+namespace
+{
+auto contents_of(Region const& region) -> std::vector<Rectangle>
+{
+    return {std::begin(region), std::end(region)};
+}
+
+auto area_of(Region const& region) -> int
+{
+    int area = 0;
+    for (auto const& rect : region)
+        area += rect.size.width.as_int() * rect.size.height.as_int();
+    return area;
+}
+}
+
+TEST(Region, is_initially_empty)
+{
+    Region const region;
+
+    EXPECT_TRUE(region.empty());
+    EXPECT_THAT(region.size(), Eq(0u));
+    EXPECT_FALSE(region.contains({0, 0}));
+    EXPECT_THAT(region.bounding_rectangle(), Eq(Rectangle{}));
+}
+
+TEST(Region, ignores_empty_rectangles)
+{
+    Region region{Rectangle{{5, 5}, {0, 10}}};
+    region.add(Rectangle{{5, 5}, {10, 0}});
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(Region, contains_points_of_its_rectangles_only)
+{
+    Region const region{Rectangle{{10, 20}, {30, 40}}};
+
+    EXPECT_TRUE(region.contains({10, 20}));
+    EXPECT_TRUE(region.contains({39, 59}));
+    EXPECT_FALSE(region.contains({40, 20}));
+    EXPECT_FALSE(region.contains({10, 60}));
+    EXPECT_FALSE(region.contains({9, 20}));
+    EXPECT_FALSE(region.contains({10, 19}));
+}
+
+TEST(Region, overlapping_rectangles_are_split_into_bands)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}};
+    region.add(Rectangle{{5, 5}, {10, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{0, 0}, {10, 5}},
+        Rectangle{{0, 5}, {15, 5}},
+        Rectangle{{5, 10}, {10, 5}}));
+}
+
+TEST(Region, adjacent_rectangles_are_merged)
+{
+    Region region{Rectangle{{0, 0}, {10, 10}}};
+    region.add(Rectangle{{10, 0}, {10, 10}});
+    region.add(Rectangle{{0, 10}, {20, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(Rectangle{{0, 0}, {20, 20}}));
+}
+
+TEST(Region, equal_areas_compare_equal_however_they_were_built)
+{
+    Region const by_rows{std::vector<Rectangle>{{{0, 0}, {20, 10}}, {{0, 10}, {20, 10}}}};
+    Region const by_columns{std::vector<Rectangle>{{{0, 0}, {10, 20}}, {{10, 0}, {10, 20}}}};
+
+    EXPECT_THAT(by_rows, Eq(by_columns));
+    EXPECT_THAT(by_rows, Eq(Region{Rectangle{{0, 0}, {20, 20}}}));
+}
+
+TEST(Region, subtracting_a_hole_leaves_a_frame)
+{
+    Region region{Rectangle{{0, 0}, {30, 30}}};
+    region.subtract(Rectangle{{10, 10}, {10, 10}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{0, 0}, {30, 10}},
+        Rectangle{{0, 10}, {10, 10}},
+        Rectangle{{20, 10}, {10, 10}},
+        Rectangle{{0, 20}, {30, 10}}));
+    EXPECT_FALSE(region.contains({15, 15}));
+    EXPECT_TRUE(region.contains({5, 15}));
+    EXPECT_TRUE(region.contains({25, 15}));
+    EXPECT_THAT(region.bounding_rectangle(), Eq(Rectangle{{0, 0}, {30, 30}}));
+}
+
+TEST(Region, subtracting_everything_leaves_nothing)
+{
+    Region region{Rectangle{{0, 0}, {30, 30}}};
+    region.subtract(Rectangle{{-10, -10}, {50, 50}});
+
+    EXPECT_TRUE(region.empty());
+}
+
+TEST(Region, intersection_keeps_only_the_common_area)
+{
+    Region region{std::vector<Rectangle>{{{0, 0}, {10, 10}}, {{20, 0}, {10, 10}}}};
+    region.intersect(Rectangle{{5, 5}, {20, 20}});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{5, 5}, {5, 5}},
+        Rectangle{{20, 5}, {5, 5}}));
+}
+
+TEST(Region, translation_moves_every_rectangle)
+{
+    Region region{std::vector<Rectangle>{{{0, 0}, {10, 10}}, {{20, 0}, {10, 10}}}};
+    region.translate({5, -5});
+
+    EXPECT_THAT(contents_of(region), ElementsAre(
+        Rectangle{{5, -5}, {10, 10}},
+        Rectangle{{25, -5}, {10, 10}}));
+}
+
+TEST(Region, agrees_with_a_bitmap_for_random_operations)
+{
+    int const size = 64;
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<int> coordinate{0, size - 1};
+
+    std::vector<bool> bitmap(size * size, false);
+    Region region;
+
+    for (int step = 0; step != 200; ++step)
+    {
+        auto const x = coordinate(random);
+        auto const y = coordinate(random);
+        Rectangle const rect{{x, y}, {coordinate(random) % (size - x) + 1, coordinate(random) % (size - y) + 1}};
+
+        auto const operation = step % 3;
+        switch (operation)
+        {
+        case 0: region.add(rect); break;
+        case 1: region.subtract(rect); break;
+        case 2: if (step % 15 == 2) region.intersect(rect); else region.add(rect); break;
+        }
+
+        for (int py = 0; py != size; ++py)
+        {
+            for (int px = 0; px != size; ++px)
+            {
+                bool const in_rect = rect.contains(Point{px, py});
+                auto&& pixel = bitmap[py * size + px];
+                if (operation == 1)
+                    pixel = pixel && !in_rect;
+                else if (operation == 2 && step % 15 == 2)
+                    pixel = pixel && in_rect;
+                else
+                    pixel = pixel || in_rect;
+            }
+        }
+
+        int set_pixels = 0;
+        for (int py = 0; py != size; ++py)
+        {
+            for (int px = 0; px != size; ++px)
+            {
+                ASSERT_THAT(region.contains(Point{px, py}), Eq(bool{bitmap[py * size + px]}))
+                    << "at (" << px << ", " << py << ") after step " << step;
+                set_pixels += bitmap[py * size + px];
+            }
+        }
+
+        // The rectangles don't overlap, and are already in canonical form
+        EXPECT_THAT(area_of(region), Eq(set_pixels));
+        EXPECT_THAT(Region{contents_of(region)}, Eq(region));
+    }
+}
+
+TEST(Region, constructing_from_rectangles_agrees_with_adding_them_one_at_a_time)
+{
+    std::mt19937 random{4321};
+    std::uniform_int_distribution<int> coordinate{-100, 400};
+    std::uniform_int_distribution<int> extent{0, 120};
+
+    std::vector<Rectangle> rects;
+    Region added;
+    for (int i = 0; i != 500; ++i)
+    {
+        rects.push_back({{coordinate(random), coordinate(random)}, {extent(random), extent(random)}});
+        added.add(rects.back());
+    }
+
+    EXPECT_THAT(Region{rects}, Eq(added));
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/egl_wayland_allocator.h"
+#include "mir/graphics/egl_extensions.h"
+#include "mir/graphics/buffer.h"
+#include "mir/renderer/gl/context.h"
+
+#include "mir/test/doubles/mock_egl.h"
+#include "mir/test/doubles/mock_gl.h"
+#include "mir/test/doubles/explicit_executor.h"
+
+#include <wayland-server-core.h>
+#include <wayland-server-protocol.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace mg = mir::graphics;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+
+namespace
+{
+struct MockContext : mir::renderer::gl::Context
+{
+    MOCK_CONST_METHOD0(make_current, void());
+    MOCK_CONST_METHOD0(release_current, void());
+};
+
+struct EGLWaylandAllocator : Test
+{
+    EGLWaylandAllocator()
+    {
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+        client_fd = fds[1];
+        client = wl_client_create(display, fds[0]);
+        buffer = wl_resource_create(client, &wl_buffer_interface, 1, 0);
+
+        ON_CALL(mock_egl, eglQueryWaylandBufferWL(_, buffer, _, _))
+            .WillByDefault(Invoke(
+                [this](EGLDisplay, wl_resource*, EGLint attribute, EGLint* value)
+                {
+                    switch (attribute)
+                    {
+                    case EGL_WIDTH:
+                        *value = 640;
+                        return EGL_TRUE;
+                    case EGL_HEIGHT:
+                        *value = 480;
+                        return EGL_TRUE;
+                    case EGL_TEXTURE_FORMAT:
+                        *value = egl_format;
+                        return EGL_TRUE;
+                    default:
+                        return EGL_FALSE;
+                    }
+                }));
+
+        ON_CALL(mock_gl, glGenTextures(_, _))
+            .WillByDefault(Invoke(
+                [this](GLsizei n, GLuint* textures)
+                {
+                    for (auto i = 0; i != n; ++i)
+                        textures[i] = next_texture++;
+                }));
+    }
+
+    ~EGLWaylandAllocator()
+    {
+        wl_client_destroy(client);
+        close(client_fd);
+        wl_display_destroy(display);
+    }
+
+    auto commit() -> std::unique_ptr<mg::Buffer>
+    {
+        return mg::wayland::buffer_from_resource(buffer, [](){}, [](){}, ctx, *extensions, executor);
+    }
+
+    NiceMock<mtd::MockEGL> mock_egl;
+    NiceMock<mtd::MockGL> mock_gl;
+    std::unique_ptr<mg::EGLExtensions> const extensions{std::make_unique<mg::EGLExtensions>()};
+    std::shared_ptr<NiceMock<MockContext>> const ctx{std::make_shared<NiceMock<MockContext>>()};
+    std::shared_ptr<mtd::ExplicitExectutor> const executor{std::make_shared<mtd::ExplicitExectutor>()};
+
+    EGLint egl_format{EGL_TEXTURE_RGBA};
+    GLuint next_texture{42};
+
+    wl_display* const display{wl_display_create()};
+    int client_fd;
+    wl_client* client;
+    wl_resource* buffer;
+};
+}
+
+TEST_F(EGLWaylandAllocator, committing_a_buffer_again_imports_nothing)
+{
+    auto const first = commit();
+
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(mock_gl, glGenTextures(_, _)).Times(0);
+    EXPECT_CALL(*ctx, make_current()).Times(0);
+
+    auto const second = commit();
+}
+
+TEST_F(EGLWaylandAllocator, texture_outlives_the_last_commit_while_the_buffer_exists)
+{
+    auto const texture = next_texture;
+    auto first = commit();
+
+    EXPECT_CALL(mock_gl, glDeleteTextures(_, _)).Times(0);
+
+    first.reset();
+    executor->execute();
+
+    Mock::VerifyAndClearExpectations(&mock_gl);
+    EXPECT_CALL(mock_gl, glDeleteTextures(1, Pointee(texture)));
+
+    wl_resource_destroy(buffer);
+    executor->execute();
+}
+
+TEST_F(EGLWaylandAllocator, texture_outlives_the_buffer_while_a_commit_is_held)
+{
+    auto const texture = next_texture;
+    auto first = commit();
+
+    EXPECT_CALL(mock_gl, glDeleteTextures(_, _)).Times(0);
+
+    wl_resource_destroy(buffer);
+    executor->execute();
+
+    Mock::VerifyAndClearExpectations(&mock_gl);
+    EXPECT_CALL(*ctx, make_current());
+    EXPECT_CALL(mock_gl, glDeleteTextures(1, Pointee(texture)));
+
+    first.reset();
+    executor->execute();
+}
+
+TEST_F(EGLWaylandAllocator, failed_import_does_not_leak_textures)
+{
+    // The first plane of a two-plane YUV buffer imports; the second fails
+    egl_format = EGL_TEXTURE_Y_UV_WL;
+    auto const first_plane = next_texture;
+
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_, _, _, _, _))
+        .WillOnce(Return(mock_egl.fake_egl_image))
+        .WillOnce(Return(EGL_NO_IMAGE_KHR));
+    EXPECT_CALL(mock_gl, glDeleteTextures(1, Pointee(first_plane)));
+
+    EXPECT_THROW(commit(), std::runtime_error);
+}
+
+TEST_F(EGLWaylandAllocator, failed_import_is_retried_on_the_next_commit)
+{
+    EXPECT_CALL(mock_egl, eglCreateImageKHR(_, _, _, _, _))
+        .WillOnce(Return(EGL_NO_IMAGE_KHR))
+        .WillOnce(Return(mock_egl.fake_egl_image));
+
+    EXPECT_THROW(commit(), std::runtime_error);
+    EXPECT_THAT(commit(), NotNull());
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/linux_dmabuf.h"
+
+#include "linux-dmabuf-unstable-v1_wrapper.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <linux/memfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <system_error>
+
+namespace mg = mir::graphics;
+namespace mw = mir::wayland;
+
+using namespace testing;
+using Error = mw::LinuxBufferParamsV1::Error;
+
+namespace
+{
+uint32_t const argb8888 = 0x34325241;   // DRM_FORMAT_ARGB8888
+uint32_t const nv12 = 0x3231564e;       // DRM_FORMAT_NV12
+uint64_t const linear = 0;              // DRM_FORMAT_MOD_LINEAR
+
+/// A memfd of size bytes, standing in for a dmabuf
+auto fake_dmabuf(off_t size) -> mir::Fd
+{
+    mir::Fd fd{static_cast<int>(syscall(SYS_memfd_create, "fake dmabuf", MFD_CLOEXEC))};
+    if (fd < 0 || ftruncate(fd, size) < 0)
+    {
+        throw std::system_error{errno, std::system_category(), "Failed to create memfd"};
+    }
+    return fd;
+}
+
+MATCHER_P(IsProtocolError, code, "")
+{
+    return arg.code == static_cast<uint32_t>(code);
+}
+
+struct LinuxDmaBuf : Test
+{
+    LinuxDmaBuf()
+    {
+        formats.add(argb8888, mg::DmaBufFormats::implicit_modifier, false);
+        formats.add(argb8888, linear, false);
+        formats.add(nv12, linear, true);
+    }
+
+    /// The ProtocolError that check() throws, or a default one with code 0 if it doesn't
+    auto error_checking(int32_t width, int32_t height, uint32_t format) const -> mg::DmaBufParams::ProtocolError
+    {
+        try
+        {
+            params.check(width, height, format, formats);
+        }
+        catch (mg::DmaBufParams::ProtocolError const& error)
+        {
+            return error;
+        }
+        return {0, "check() passed"};
+    }
+
+    mg::DmaBufFormats formats;
+    mg::DmaBufParams params;
+};
+}
+
+TEST_F(LinuxDmaBuf, formats_are_listed_once_in_the_order_added)
+{
+    formats.add(argb8888, linear, false);
+
+    ASSERT_THAT(formats.entries().size(), Eq(3u));
+    EXPECT_THAT(formats.entries()[0].modifier, Eq(mg::DmaBufFormats::implicit_modifier));
+    EXPECT_THAT(formats.entries()[1].modifier, Eq(linear));
+    EXPECT_THAT(formats.entries()[2].format, Eq(nv12));
+}
+
+TEST_F(LinuxDmaBuf, find_matches_both_format_and_modifier)
+{
+    ASSERT_THAT(formats.find(nv12, linear), NotNull());
+    EXPECT_TRUE(formats.find(nv12, linear)->external_only);
+    EXPECT_THAT(formats.find(nv12, mg::DmaBufFormats::implicit_modifier), IsNull());
+}
+
+TEST_F(LinuxDmaBuf, plane_beyond_the_last_is_a_protocol_error)
+{
+    try
+    {
+        params.add(fake_dmabuf(4096), mg::DmaBufParams::max_planes, 0, 64, linear);
+        FAIL() << "Adding an out of range plane should throw";
+    }
+    catch (mg::DmaBufParams::ProtocolError const& error)
+    {
+        EXPECT_THAT(error, IsProtocolError(Error::plane_idx));
+    }
+}
+
+TEST_F(LinuxDmaBuf, setting_a_plane_twice_is_a_protocol_error)
+{
+    params.add(fake_dmabuf(4096), 0, 0, 64, linear);
+
+    try
+    {
+        params.add(fake_dmabuf(4096), 0, 0, 64, linear);
+        FAIL() << "Setting a plane twice should throw";
+    }
+    catch (mg::DmaBufParams::ProtocolError const& error)
+    {
+        EXPECT_THAT(error, IsProtocolError(Error::plane_set));
+    }
+}
+
+TEST_F(LinuxDmaBuf, planes_with_different_modifiers_are_a_protocol_error)
+{
+    params.add(fake_dmabuf(4096), 0, 0, 64, linear);
+
+    try
+    {
+        params.add(fake_dmabuf(4096), 1, 0, 64, mg::DmaBufFormats::implicit_modifier);
+        FAIL() << "Mixing modifiers should throw";
+    }
+    catch (mg::DmaBufParams::ProtocolError const& error)
+    {
+        EXPECT_THAT(error, IsProtocolError(Error::invalid_format));
+    }
+}
+
+TEST_F(LinuxDmaBuf, buffer_without_planes_is_incomplete)
+{
+    EXPECT_THAT(error_checking(16, 16, argb8888), IsProtocolError(Error::incomplete));
+}
+
+TEST_F(LinuxDmaBuf, buffer_with_a_gap_in_its_planes_is_incomplete)
+{
+    params.add(fake_dmabuf(4096), 0, 0, 16, linear);
+    params.add(fake_dmabuf(4096), 2, 0, 16, linear);
+
+    EXPECT_THAT(error_checking(16, 16, nv12), IsProtocolError(Error::incomplete));
+}
+
+TEST_F(LinuxDmaBuf, buffer_without_area_has_invalid_dimensions)
+{
+    params.add(fake_dmabuf(4096), 0, 0, 64, linear);
+
+    EXPECT_THAT(error_checking(0, 16, argb8888), IsProtocolError(Error::invalid_dimensions));
+    EXPECT_THAT(error_checking(16, -1, argb8888), IsProtocolError(Error::invalid_dimensions));
+}
+
+TEST_F(LinuxDmaBuf, unadvertised_format_and_modifier_is_an_invalid_format)
+{
+    params.add(fake_dmabuf(4096), 0, 0, 64, mg::DmaBufFormats::implicit_modifier);
+
+    EXPECT_THAT(error_checking(16, 16, nv12), IsProtocolError(Error::invalid_format));
+}
+
+TEST_F(LinuxDmaBuf, plane_larger_than_its_dmabuf_is_out_of_bounds)
+{
+    params.add(fake_dmabuf(64 * 15), 0, 0, 64, linear);
+
+    EXPECT_THAT(error_checking(16, 16, argb8888), IsProtocolError(Error::out_of_bounds));
+}
+
+TEST_F(LinuxDmaBuf, plane_offset_past_the_end_of_its_dmabuf_is_out_of_bounds)
+{
+    params.add(fake_dmabuf(64 * 16), 0, 0, 16, linear);
+    params.add(fake_dmabuf(64 * 16), 1, 64 * 16, 16, linear);
+
+    EXPECT_THAT(error_checking(16, 16, nv12), IsProtocolError(Error::out_of_bounds));
+}
+
+TEST_F(LinuxDmaBuf, planes_that_fit_pass_the_check)
+{
+    auto const shared = fake_dmabuf(16 * 16 * 3 / 2);
+    params.add(mir::Fd{dup(shared)}, 0, 0, 16, linear);
+    params.add(mir::Fd{dup(shared)}, 1, 16 * 16, 16, linear);
+
+    EXPECT_NO_THROW(params.check(16, 16, nv12, formats));
+    EXPECT_THAT(params.planes().size(), Eq(2u));
+    EXPECT_THAT(params.planes()[1].offset, Eq(16u * 16u));
+    EXPECT_THAT(params.modifier(), Eq(linear));
+}
@@ -18,8 +18,14 @@
 
 #include <gtest/gtest.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <boost/throw_exception.hpp>
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <system_error>
+
 #include "mir/graphics/platform.h"
 #include "src/server/graphics/platform_probe.h"
 #include "mir/options/program_option.h"
@@ -157,6 +163,32 @@ public:
 #endif
 };
 
+class ServerPlatformProbeCache : public ServerPlatformProbeMockDRM
+{
+public:
+    ServerPlatformProbeCache()
+    {
+        char tmp_name[] = "/tmp/mir_probe_cache_XXXXXX";
+        if (mkdtemp(tmp_name) == NULL)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        }
+        temporary_directory = tmp_name;
+        cache_file = temporary_directory + "/probe-cache";
+    }
+
+    ~ServerPlatformProbeCache()
+    {
+        // Can't do anything useful in case of failure...
+        std::remove(cache_file.c_str());
+        rmdir(temporary_directory.c_str());
+    }
+
+    std::string temporary_directory;
+    std::string cache_file;
+    std::string const device_set{"card0=pci:v00008086d00001234;"};
+};
+
 }
 
 TEST(ServerPlatformProbe, ConstructingWithNoModulesIsAnError)
@@ -274,3 +306,130 @@ TEST_F(ServerPlatformProbeMockDRM, IgnoresNonPlatformModules)
         std::make_shared<StubConsoleServices>());
     EXPECT_NE(nullptr, module);
 }
+
+TEST_F(ServerPlatformProbeCache, remembers_unsupported_modules_for_the_same_device_set)
+{
+    {
+        mir::graphics::ProbeResultCache cache{cache_file, device_set};
+        cache.record("unsupported.so build-id:1234", mir::graphics::PlatformPriority::unsupported);
+        cache.record("supported.so build-id:5678", mir::graphics::PlatformPriority::supported);
+        cache.save();
+    }
+
+    mir::graphics::ProbeResultCache const cache{cache_file, device_set};
+
+    EXPECT_TRUE(cache.known_unsupported("unsupported.so build-id:1234"));
+    EXPECT_FALSE(cache.known_unsupported("supported.so build-id:5678"));
+    EXPECT_FALSE(cache.known_unsupported("unknown.so build-id:9abc"));
+}
+
+TEST_F(ServerPlatformProbeCache, forgets_results_when_device_set_changes)
+{
+    {
+        mir::graphics::ProbeResultCache cache{cache_file, device_set};
+        cache.record("unsupported.so build-id:1234", mir::graphics::PlatformPriority::unsupported);
+        cache.save();
+    }
+
+    mir::graphics::ProbeResultCache const cache{cache_file, device_set + "card1=pci:v000010DEd00005678;"};
+
+    EXPECT_FALSE(cache.known_unsupported("unsupported.so build-id:1234"));
+}
+
+TEST_F(ServerPlatformProbeCache, forgets_failures_once_they_expire)
+{
+    {
+        mir::graphics::ProbeResultCache cache{cache_file, device_set};
+        cache.record("unsupported.so build-id:1234", mir::graphics::PlatformPriority::unsupported);
+        cache.save();
+    }
+
+    mir::graphics::ProbeResultCache const cache{cache_file, device_set, std::chrono::seconds{0}};
+
+    EXPECT_FALSE(cache.known_unsupported("unsupported.so build-id:1234"));
+}
+
+TEST_F(ServerPlatformProbeCache, ignores_entries_it_cannot_parse)
+{
+    {
+        std::ofstream file{cache_file};
+        file << "device-set " << device_set << '\n';
+        file << "0 unsupported.so build-id:1234\n";
+    }
+
+    mir::graphics::ProbeResultCache const cache{cache_file, device_set};
+
+    EXPECT_FALSE(cache.known_unsupported("unsupported.so build-id:1234"));
+}
+
+TEST_F(ServerPlatformProbeCache, module_identity_is_stable)
+{
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    auto const dummy_identity = mir::graphics::module_identity(*modules.front());
+
+    EXPECT_THAT(dummy_identity, testing::HasSubstr("graphics-dummy.so"));
+    EXPECT_THAT(mir::graphics::module_identity(*modules.front()), testing::Eq(dummy_identity));
+}
+
+TEST_F(ServerPlatformProbeCache, reprobes_cached_modules_when_nothing_else_is_supported)
+{
+    using namespace testing;
+    mir::options::ProgramOption options;
+    auto block_mesa = ensure_mesa_probing_fails();
+
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    auto const dummy_identity = mir::graphics::module_identity(*modules.front());
+
+    {
+        mir::graphics::ProbeResultCache cache{cache_file, device_set};
+        cache.record(dummy_identity, mir::graphics::PlatformPriority::unsupported);
+        cache.save();
+    }
+
+    mir::graphics::ProbeResultCache cache{cache_file, device_set};
+    auto module = mir::graphics::module_for_device(
+        modules,
+        options,
+        std::make_shared<mtd::NullConsoleServices>(),
+        cache);
+    ASSERT_NE(nullptr, module);
+
+    auto descriptor = module->load_function<mir::graphics::DescribeModule>(describe_module);
+    EXPECT_THAT(descriptor()->name, HasSubstr("mir:stub-graphics"));
+
+    EXPECT_FALSE(mir::graphics::ProbeResultCache(cache_file, device_set).known_unsupported(dummy_identity));
+}
+
+#ifdef MIR_BUILD_PLATFORM_MESA_KMS
+TEST_F(ServerPlatformProbeCache, skips_modules_known_to_be_unsupported)
+{
+    using namespace testing;
+    mir::options::ProgramOption options;
+    auto fake_mesa = ensure_mesa_probing_succeeds();
+
+    auto modules = available_platforms();
+    auto const mesa_identity = mir::graphics::module_identity(*modules.front());
+    add_dummy_platform(modules);
+
+    {
+        mir::graphics::ProbeResultCache cache{cache_file, device_set};
+        cache.record(mesa_identity, mir::graphics::PlatformPriority::unsupported);
+        cache.save();
+    }
+
+    mir::graphics::ProbeResultCache cache{cache_file, device_set};
+    auto module = mir::graphics::module_for_device(
+        modules,
+        options,
+        std::make_shared<StubConsoleServices>(),
+        cache);
+    ASSERT_NE(nullptr, module);
+
+    auto descriptor = module->load_function<mir::graphics::DescribeModule>(describe_module);
+    EXPECT_THAT(descriptor()->name, HasSubstr("mir:stub-graphics"));
+}
+#endif
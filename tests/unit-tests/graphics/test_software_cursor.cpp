@@ -45,6 +45,7 @@ struct MockInputScene : mtd::StubInputScene
                  void(std::weak_ptr<mg::Renderable> const&));
 
     MOCK_METHOD0(emit_scene_changed, void());
+    MOCK_METHOD1(emit_scene_damaged, void(geom::Rectangle const&));
 };
 
 struct StubCursorImage : mg::CursorImage
@@ -189,14 +190,33 @@ TEST_F(SoftwareCursor, moves_scene_renderable_offset_by_hotspot_when_moved)
                 Eq(new_position - stub_cursor_image.hotspot()));
 }
 
-TEST_F(SoftwareCursor, notifies_scene_when_moving)
+TEST_F(SoftwareCursor, notifies_scene_of_damage_when_moving)
 {
     using namespace testing;
 
-    EXPECT_CALL(mock_input_scene, emit_scene_changed());
+    geom::Rectangle const old_area{
+        geom::Point{0,0} - stub_cursor_image.hotspot(), stub_cursor_image.size()};
+    geom::Rectangle const new_area{
+        geom::Point{22,23} - stub_cursor_image.hotspot(), stub_cursor_image.size()};
+
+    EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(old_area));
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(new_area));
+
+    cursor.show(stub_cursor_image);
+    cursor.move_to({22,23});
+}
+
+TEST_F(SoftwareCursor, does_not_notify_scene_when_position_is_unchanged)
+{
+    using namespace testing;
 
     cursor.show(stub_cursor_image);
     cursor.move_to({22,23});
+
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(_)).Times(0);
+
+    cursor.move_to({22,23});
 }
 
 TEST_F(SoftwareCursor, multiple_shows_just_show)
@@ -246,6 +266,7 @@ TEST_F(SoftwareCursor, does_not_hide_or_move_when_already_hidden)
 
     EXPECT_CALL(mock_input_scene, remove_input_visualization(_)).Times(0);
     EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(_)).Times(0);
 
     // Already hidden, nothing should happen
     cursor.hide();
@@ -0,0 +1,78 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/solid_color_buffer.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstring>
+
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+auto pixel_of(mg::SolidColorBuffer& buffer) -> uint32_t
+{
+    uint32_t pixel{0};
+    buffer.read([&pixel](unsigned char const* pixels) { std::memcpy(&pixel, pixels, sizeof pixel); });
+    return pixel;
+}
+}
+
+TEST(SolidColorBuffer, is_a_single_pixel)
+{
+    mg::SolidColorBuffer buffer{0xff102030};
+
+    EXPECT_THAT(buffer.size(), Eq(geom::Size{1, 1}));
+    EXPECT_THAT(buffer.stride(), Eq(geom::Stride{4}));
+}
+
+TEST(SolidColorBuffer, opaque_colors_need_no_blending)
+{
+    EXPECT_THAT(mg::SolidColorBuffer{0xff102030}.pixel_format(), Eq(mir_pixel_format_xrgb_8888));
+    EXPECT_THAT(mg::SolidColorBuffer{0x80102030}.pixel_format(), Eq(mir_pixel_format_argb_8888));
+}
+
+TEST(SolidColorBuffer, pixel_is_premultiplied)
+{
+    mg::SolidColorBuffer opaque{0xff102030};
+    mg::SolidColorBuffer half{0x80ff8040};
+    mg::SolidColorBuffer clear{0x00ffffff};
+
+    EXPECT_THAT(pixel_of(opaque), Eq(0xff102030u));
+    EXPECT_THAT(pixel_of(half), Eq(0x80804020u));
+    EXPECT_THAT(pixel_of(clear), Eq(0x00000000u));
+}
+
+TEST(SolidColorBuffer, cannot_be_written)
+{
+    mg::SolidColorBuffer buffer{0xff102030};
+    unsigned char const pixel[4]{};
+
+    EXPECT_THROW(buffer.write(pixel, sizeof pixel), std::logic_error);
+}
+
+TEST(SolidColorBuffer, shader_returns_the_premultiplied_color)
+{
+    auto const shader = mg::solid_color_fragment_shader(0x80ff0000);
+
+    EXPECT_THAT(shader, HasSubstr("vec4 sample_to_rgba(in vec2 texcoord)"));
+    EXPECT_THAT(shader, HasSubstr("return vec4(0.50196081, 0.00000000, 0.00000000, 0.50196081);"));
+}
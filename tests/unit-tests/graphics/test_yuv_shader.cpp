@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/yuv_shader.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mgl = mir::graphics::gl;
+namespace geom = mir::geometry;
+
+using namespace testing;
+using Matrix = mgl::YuvEncoding::Matrix;
+using Range = mgl::YuvEncoding::Range;
+
+namespace
+{
+/// What the shader computes, on the CPU; y, u and v in [0, 255]
+auto convert(mgl::YuvEncoding encoding, float y, float u, float v) -> std::array<float, 3>
+{
+    auto const conversion = mgl::yuv_to_rgb(encoding);
+    float const yuv[3] = {
+        y / 255 - conversion.offset[0],
+        u / 255 - conversion.offset[1],
+        v / 255 - conversion.offset[2]};
+
+    std::array<float, 3> rgb{};
+    for (auto column = 0; column != 3; ++column)
+    {
+        for (auto row = 0; row != 3; ++row)
+        {
+            rgb[row] += conversion.matrix[column * 3 + row] * yuv[column];
+        }
+    }
+    return rgb;
+}
+
+auto near(float r, float g, float b, float tolerance = 0.002f) -> Matcher<std::array<float, 3>>
+{
+    return ElementsAre(FloatNear(r, tolerance), FloatNear(g, tolerance), FloatNear(b, tolerance));
+}
+
+// The commonly quoted 8-bit encodings are rounded, so are only good to one code value
+float const one_code_value = 1.0f / 255;
+}
+
+TEST(YuvShader, limited_range_black_and_white_are_16_and_235)
+{
+    for (auto const matrix : {Matrix::bt601, Matrix::bt709})
+    {
+        EXPECT_THAT(convert({matrix, Range::limited}, 16, 128, 128), near(0, 0, 0));
+        EXPECT_THAT(convert({matrix, Range::limited}, 235, 128, 128), near(1, 1, 1));
+    }
+}
+
+TEST(YuvShader, full_range_black_and_white_are_0_and_255)
+{
+    for (auto const matrix : {Matrix::bt601, Matrix::bt709})
+    {
+        EXPECT_THAT(convert({matrix, Range::full}, 0, 128, 128), near(0, 0, 0));
+        EXPECT_THAT(convert({matrix, Range::full}, 255, 128, 128), near(1, 1, 1));
+    }
+}
+
+TEST(YuvShader, primaries_convert_back_to_rgb)
+{
+    // Red, green and blue as encoded by BT.601 in limited range
+    EXPECT_THAT(convert({Matrix::bt601, Range::limited}, 81, 90, 240), near(1, 0, 0, one_code_value));
+    EXPECT_THAT(convert({Matrix::bt601, Range::limited}, 145, 54, 34), near(0, 1, 0, one_code_value));
+    EXPECT_THAT(convert({Matrix::bt601, Range::limited}, 41, 240, 110), near(0, 0, 1, one_code_value));
+
+    // …and by BT.709 in full range
+    EXPECT_THAT(convert({Matrix::bt709, Range::full}, 54.213f, 98.786f, 255.5f), near(1, 0, 0));
+    EXPECT_THAT(convert({Matrix::bt709, Range::full}, 18.411f, 255.5f, 116.387f), near(0, 0, 1));
+}
+
+TEST(YuvShader, standard_definition_is_assumed_to_be_bt601)
+{
+    auto const encoding = mgl::default_yuv_encoding(geom::Size{720, 576});
+
+    EXPECT_THAT(encoding.matrix, Eq(Matrix::bt601));
+    EXPECT_THAT(encoding.range, Eq(Range::limited));
+}
+
+TEST(YuvShader, high_definition_is_assumed_to_be_bt709)
+{
+    EXPECT_THAT(mgl::default_yuv_encoding(geom::Size{1280, 720}).matrix, Eq(Matrix::bt709));
+    EXPECT_THAT(mgl::default_yuv_encoding(geom::Size{1920, 1080}).matrix, Eq(Matrix::bt709));
+}
+
+TEST(YuvShader, shader_samples_a_texture_per_plane)
+{
+    auto const encoding = mgl::default_yuv_encoding(geom::Size{640, 480});
+
+    EXPECT_THAT(mgl::yuv_fragment_shader(mgl::YuvPlanes::y_u_v, encoding), HasSubstr("uniform sampler2D tex[3];"));
+    EXPECT_THAT(mgl::yuv_fragment_shader(mgl::YuvPlanes::y_uv, encoding), HasSubstr("uniform sampler2D tex[2];"));
+    EXPECT_THAT(mgl::yuv_fragment_shader(mgl::YuvPlanes::y_uv_la, encoding), HasSubstr("texture2D(tex[1], texcoord).ra"));
+    EXPECT_THAT(mgl::yuv_fragment_shader(mgl::YuvPlanes::y_xuxv, encoding), HasSubstr("texture2D(tex[1], texcoord).ga"));
+}
+
+TEST(YuvShader, shader_defines_sample_to_rgba)
+{
+    auto const shader = mgl::yuv_fragment_shader(mgl::YuvPlanes::y_uv, {Matrix::bt709, Range::full});
+
+    EXPECT_THAT(shader, HasSubstr("vec4 sample_to_rgba(in vec2 texcoord)"));
+    EXPECT_THAT(shader, HasSubstr("mat3(1.00000000, 1.00000000, 1.00000000, 0.00000000, "));
+}
@@ -35,10 +35,18 @@
 #include "mir/test/doubles/mock_input_device_registry.h"
 #include "src/platforms/evdev/platform.h"
 #include "src/platforms/mesa/server/x11/input/input_platform.h"
+#include "src/server/graphics/platform_probe.h"
+#include "mir/shared_library.h"
 #include "mir/test/fake_shared.h"
 
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <unistd.h>
+
 namespace mt = mir::test;
 namespace mtd = mt::doubles;
+namespace mg = mir::graphics;
 namespace mi = mir::input;
 namespace mr = mir::report;
 namespace mtf = mir_test_framework;
@@ -54,6 +62,7 @@ struct StubEmergencyCleanupRegistry : mir::EmergencyCleanupRegistry
 };
 char const platform_input_lib[] = "platform-input-lib";
 char const platform_path[] = "platform-path";
+char const platform_probe_cache[] = "platform-probe-cache";
 
 struct InputPlatformProbe : ::testing::Test
 {
@@ -102,6 +111,50 @@ struct InputPlatformProbe : ::testing::Test
     boost::any platform_input_lib_value_as_any;
 };
 
+struct InputPlatformProbeCache : InputPlatformProbe
+{
+    InputPlatformProbeCache()
+    {
+        char tmp_name[] = "/tmp/mir_input_probe_cache_XXXXXX";
+        if (mkdtemp(tmp_name) == NULL)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        }
+        temporary_directory = tmp_name;
+        cache_file = temporary_directory + "/probe-cache";
+        cache_file_as_any = cache_file;
+
+        ON_CALL(mock_options, is_set(StrEq(platform_probe_cache))).WillByDefault(Return(true));
+        ON_CALL(mock_options, get(StrEq(platform_probe_cache)))
+            .WillByDefault(Invoke(
+                    [this](char const*) -> boost::any const&
+                    {
+                        return cache_file_as_any;
+                    }));
+    }
+
+    ~InputPlatformProbeCache()
+    {
+        // Can't do anything useful in case of failure...
+        std::remove(cache_file.c_str());
+        rmdir(temporary_directory.c_str());
+    }
+
+    auto cache_contents() const -> std::string
+    {
+        std::ifstream file{cache_file};
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::string temporary_directory;
+    std::string cache_file;
+    boost::any cache_file_as_any;
+    mir::SharedLibrary const evdev{mtf::server_input_platform("input-evdev")};
+    std::string const evdev_identity{"input " + mg::module_identity(evdev, "describe_input_module")};
+};
+
 template <typename Expected>
 struct OfPtrTypeMatcher
 {
@@ -143,6 +196,45 @@ TEST_F(InputPlatformProbe, stub_platform_not_picked_up_by_default)
     EXPECT_THAT(platform, OfPtrType<mi::evdev::Platform>());
 }
 
+TEST_F(InputPlatformProbeCache, probe_results_are_saved_to_the_probe_cache)
+{
+    disable_x11();
+    auto platform =
+        mi::probe_input_platforms(
+            mock_options,
+            mt::fake_shared(stub_emergency),
+            mt::fake_shared(mock_registry),
+            nullptr,
+            mr::null_input_report(),
+            *stub_prober_report);
+
+    EXPECT_THAT(platform, OfPtrType<mi::evdev::Platform>());
+    EXPECT_THAT(cache_contents(), HasSubstr(evdev_identity));
+    EXPECT_FALSE(mg::ProbeResultCache(cache_file, mg::current_device_set()).known_unsupported(evdev_identity));
+}
+
+TEST_F(InputPlatformProbeCache, module_cached_as_unsupported_is_reprobed_when_nothing_else_is_supported)
+{
+    disable_x11();
+    {
+        mg::ProbeResultCache cache{cache_file, mg::current_device_set()};
+        cache.record(evdev_identity, mg::unsupported);
+        cache.save();
+    }
+
+    auto platform =
+        mi::probe_input_platforms(
+            mock_options,
+            mt::fake_shared(stub_emergency),
+            mt::fake_shared(mock_registry),
+            nullptr,
+            mr::null_input_report(),
+            *stub_prober_report);
+
+    EXPECT_THAT(platform, OfPtrType<mi::evdev::Platform>());
+    EXPECT_FALSE(mg::ProbeResultCache(cache_file, mg::current_device_set()).known_unsupported(evdev_identity));
+}
+
 #ifdef MIR_BUILD_PLATFORM_MESA_X11
 char const vt[] = "vt";
 TEST_F(InputPlatformProbe, x11_platform_found_and_used_when_display_connection_works)
@@ -0,0 +1,219 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/logging/async_logger.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ml = mir::logging;
+
+using namespace testing;
+
+namespace
+{
+struct LoggedMessage
+{
+    ml::Severity severity;
+    std::string message;
+    std::string component;
+};
+
+/// Records messages, and can hold up the writer thread until released
+struct RecordingLogger : ml::Logger
+{
+    void log(ml::Severity severity, std::string const& message, std::string const& component) override
+    {
+        std::unique_lock<decltype(mutex)> lock{mutex};
+        released.wait(lock, [this] { return !blocked; });
+        messages.push_back({severity, message, component});
+    }
+
+    void block()
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        blocked = true;
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<decltype(mutex)> lock{mutex};
+            blocked = false;
+        }
+        released.notify_all();
+    }
+
+    auto recorded() -> std::vector<LoggedMessage>
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        return messages;
+    }
+
+    std::mutex mutex;
+    std::condition_variable released;
+    bool blocked{false};
+    std::vector<LoggedMessage> messages;
+};
+
+auto texts_of(std::vector<LoggedMessage> const& messages) -> std::vector<std::string>
+{
+    std::vector<std::string> result;
+    for (auto const& message : messages)
+        result.push_back(message.message);
+    return result;
+}
+
+struct AsyncLogger : Test
+{
+    std::shared_ptr<RecordingLogger> const sink{std::make_shared<RecordingLogger>()};
+};
+}
+
+TEST_F(AsyncLogger, formatted_messages_reach_the_sink)
+{
+    ml::AsyncLogger logger{sink};
+
+    logger.log("test-component", ml::Severity::warning, "%d little %s", 3, "pigs");
+    logger.flush();
+
+    auto const messages = sink->recorded();
+    ASSERT_THAT(messages.size(), Eq(1u));
+    EXPECT_THAT(messages[0].severity, Eq(ml::Severity::warning));
+    EXPECT_THAT(messages[0].message, Eq("3 little pigs"));
+    EXPECT_THAT(messages[0].component, Eq("test-component"));
+}
+
+TEST_F(AsyncLogger, messages_from_a_thread_keep_their_order)
+{
+    ml::AsyncLogger logger{sink, 4};
+
+    for (auto i = 0; i != 100; ++i)
+        logger.log(ml::Severity::error, std::to_string(i), "test");
+    logger.flush();
+
+    auto const texts = texts_of(sink->recorded());
+    ASSERT_THAT(texts.size(), Eq(100u));
+    for (auto i = 0; i != 100; ++i)
+        EXPECT_THAT(texts[i], Eq(std::to_string(i)));
+}
+
+TEST_F(AsyncLogger, long_messages_are_not_truncated)
+{
+    ml::AsyncLogger logger{sink};
+    std::string const long_message(5000, 'x');
+    std::string const long_component(1000, 'c');
+
+    logger.log(ml::Severity::informational, long_message, "test");
+    logger.log(ml::Severity::informational, "short", long_component);
+    logger.flush();
+
+    auto const messages = sink->recorded();
+    ASSERT_THAT(messages.size(), Eq(2u));
+    EXPECT_THAT(messages[0].message, Eq(long_message));
+    EXPECT_THAT(messages[1].message, Eq("short"));
+    EXPECT_THAT(messages[1].component, Eq(long_component));
+}
+
+TEST_F(AsyncLogger, messages_from_many_threads_all_arrive)
+{
+    ml::AsyncLogger logger{sink};
+    auto const threads = 4;
+    auto const messages_per_thread = 200;
+
+    std::vector<std::thread> loggers;
+    for (auto t = 0; t != threads; ++t)
+    {
+        loggers.emplace_back([&logger, t]
+            {
+                for (auto i = 0; i != messages_per_thread; ++i)
+                    logger.log("test", ml::Severity::error, "%d:%d", t, i);
+            });
+    }
+    for (auto& thread : loggers)
+        thread.join();
+    logger.flush();
+
+    auto const texts = texts_of(sink->recorded());
+    EXPECT_THAT(texts.size(), Eq(static_cast<size_t>(threads * messages_per_thread)));
+    EXPECT_THAT(logger.dropped_messages(), Eq(0u));
+}
+
+TEST_F(AsyncLogger, when_the_ring_is_full_debug_messages_are_dropped_and_counted)
+{
+    ml::AsyncLogger logger{sink, 2};
+    sink->block();
+
+    for (auto i = 0; i != 10; ++i)
+        logger.log("test", ml::Severity::debug, "%d", i);
+
+    // The writer holds its slot until the sink returns, so only two messages fit
+    EXPECT_THAT(logger.dropped_messages(), Eq(8u));
+
+    sink->release();
+    logger.flush();
+
+    EXPECT_THAT(sink->recorded(), Contains(AllOf(
+        Field(&LoggedMessage::severity, Eq(ml::Severity::warning)),
+        Field(&LoggedMessage::message, StartsWith("8 messages dropped")))));
+    EXPECT_THAT(texts_of(sink->recorded()), IsSupersetOf({"0", "1"}));
+}
+
+TEST_F(AsyncLogger, when_the_ring_is_full_errors_wait_for_space)
+{
+    ml::AsyncLogger logger{sink, 2};
+    sink->block();
+
+    std::thread releaser{[this]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            sink->release();
+        }};
+
+    for (auto i = 0; i != 10; ++i)
+        logger.log("test", ml::Severity::error, "%d", i);
+
+    releaser.join();
+    logger.flush();
+
+    EXPECT_THAT(sink->recorded().size(), Eq(10u));
+    EXPECT_THAT(logger.dropped_messages(), Eq(0u));
+}
+
+TEST_F(AsyncLogger, critical_messages_are_written_before_log_returns)
+{
+    ml::AsyncLogger logger{sink};
+
+    logger.log("test", ml::Severity::informational, "before");
+    logger.log("test", ml::Severity::critical, "critical");
+
+    EXPECT_THAT(texts_of(sink->recorded()), ElementsAre("before", "critical"));
+}
+
+TEST_F(AsyncLogger, pending_messages_are_written_on_destruction)
+{
+    {
+        ml::AsyncLogger logger{sink};
+        for (auto i = 0; i != 10; ++i)
+            logger.log("test", ml::Severity::debug, "%d", i);
+    }
+
+    EXPECT_THAT(sink->recorded().size(), Eq(10u));
+}
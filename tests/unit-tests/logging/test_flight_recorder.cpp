@@ -0,0 +1,129 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/flight_recorder/recorder.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+namespace mrf = mir::report::flight_recorder;
+
+using namespace testing;
+using Event = mrf::Recorder::Event;
+
+namespace
+{
+auto values_of(std::vector<mrf::Recorder::Record> const& records) -> std::vector<int64_t>
+{
+    std::vector<int64_t> result;
+    for (auto const& record : records)
+        result.push_back(record.value);
+    return result;
+}
+}
+
+TEST(FlightRecorder, records_events_oldest_first)
+{
+    mrf::Recorder recorder;
+
+    recorder.record(Event::frame_began, 1);
+    recorder.record(Event::buffer_consumed, 1, 42);
+    recorder.record(Event::frame_finished, 1);
+
+    auto const records = recorder.records();
+
+    ASSERT_THAT(records.size(), Eq(3u));
+    EXPECT_THAT(records[0].event, Eq(Event::frame_began));
+    EXPECT_THAT(records[1].event, Eq(Event::buffer_consumed));
+    EXPECT_THAT(records[1].id, Eq(1u));
+    EXPECT_THAT(records[1].value, Eq(42));
+    EXPECT_THAT(records[2].event, Eq(Event::frame_finished));
+    EXPECT_THAT(records[0].time, Le(records[2].time));
+}
+
+TEST(FlightRecorder, keeps_only_the_most_recent_records)
+{
+    mrf::Recorder recorder{4};
+
+    for (auto i = 0; i != 10; ++i)
+        recorder.record(Event::buffer_submitted, 1, i);
+
+    EXPECT_THAT(values_of(recorder.records()), ElementsAre(6, 7, 8, 9));
+}
+
+TEST(FlightRecorder, records_of_threads_that_have_exited_are_kept)
+{
+    mrf::Recorder recorder;
+
+    std::thread{[&] { recorder.record(Event::input_received, 1, 2, 3); }}.join();
+    recorder.record(Event::page_flip, 1);
+
+    auto const records = recorder.records();
+
+    ASSERT_THAT(records.size(), Eq(2u));
+    EXPECT_THAT(records[0].event, Eq(Event::input_received));
+    EXPECT_THAT(records[1].event, Eq(Event::page_flip));
+    EXPECT_THAT(records[0].thread, Ne(records[1].thread));
+}
+
+TEST(FlightRecorder, reading_while_a_thread_records_sees_only_whole_records)
+{
+    mrf::Recorder recorder{64};
+    std::atomic<bool> done{false};
+
+    std::thread writer{[&]
+        {
+            for (int64_t i = 0; !done; ++i)
+                recorder.record(Event::buffer_consumed, i, i, i);
+        }};
+
+    for (auto read = 0; read != 1000; ++read)
+    {
+        auto const records = recorder.records();
+        EXPECT_THAT(records.size(), Le(64u));
+        for (auto const& record : records)
+        {
+            ASSERT_THAT(record.value, Eq(static_cast<int64_t>(record.id)));
+            ASSERT_THAT(record.extra, Eq(record.value));
+        }
+    }
+
+    done = true;
+    writer.join();
+}
+
+TEST(FlightRecorder, trace_pairs_frame_begin_and_end_and_names_threads)
+{
+    mrf::Recorder recorder;
+
+    recorder.record(Event::frame_began, 7);
+    recorder.record(Event::page_flip, 2, 100, 1234567);
+    recorder.record(Event::frame_finished, 7);
+
+    std::stringstream trace;
+    recorder.write_trace(trace);
+
+    EXPECT_THAT(trace.str(), StartsWith("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_THAT(trace.str(), HasSubstr("\"ph\":\"M\""));
+    EXPECT_THAT(trace.str(), HasSubstr("\"name\":\"composite\",\"cat\":\"compositor\",\"ph\":\"B\""));
+    EXPECT_THAT(trace.str(), HasSubstr("\"name\":\"composite\",\"cat\":\"compositor\",\"ph\":\"E\""));
+    EXPECT_THAT(trace.str(), HasSubstr("{\"output\":2,\"msc\":100,\"flip_time\":1234.567}"));
+    EXPECT_THAT(trace.str(), EndsWith("]}\n"));
+}
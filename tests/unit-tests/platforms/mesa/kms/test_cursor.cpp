@@ -465,6 +465,53 @@ TEST_F(MesaCursorTest, pads_missing_data_when_buffer_size_differs)
     cursor_tmp.show(SinglePixelCursorImage());
 }
 
+TEST_F(MesaCursorTest, reshowing_a_recent_image_does_not_rewrite_the_buffer)
+{
+    using namespace testing;
+
+    // One write for each distinct image
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, _, _)).Times(2);
+
+    cursor.show(stub_image);
+    cursor.show(SinglePixelCursorImage());
+    cursor.show(stub_image);
+    cursor.show(SinglePixelCursorImage());
+}
+
+MATCHER_P2(StartsWithPixels, first, second, "")
+{
+    auto pixels = static_cast<uint32_t const*>(arg);
+    return pixels[0] == first && pixels[1] == second;
+}
+
+TEST_F(MesaCursorTest, show_cursor_rotates_image_for_inverted_output)
+{
+    using namespace testing;
+
+    struct TwoPixelCursorImage : public StubCursorImage
+    {
+        geom::Size size() const override
+        {
+            return {2, 1};
+        }
+        void const* as_argb_8888() const override
+        {
+            static uint32_t const pixels[] = { 0xff0000ff, 0xffff0000 };
+            return pixels;
+        }
+    };
+
+    size_t const stride = 64 * 4;
+    ON_CALL(mock_gbm, gbm_bo_get_stride(_))
+        .WillByDefault(Return(stride));
+
+    current_configuration.conf.set_orentation_of_output(mg::DisplayConfigurationOutputId{0}, mir_orientation_inverted);
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(_, StartsWithPixels(0xffff0000, 0xff0000ff), _));
+
+    cursor.show(TwoPixelCursorImage());
+}
+
 TEST_F(MesaCursorTest, does_not_throw_when_images_are_too_large)
 {
     using namespace testing;
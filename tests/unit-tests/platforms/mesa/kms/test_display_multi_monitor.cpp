@@ -40,6 +40,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <map>
 #include <unordered_set>
 #include <fcntl.h>
 
@@ -255,6 +256,39 @@ public:
     int const drm_fd;
 };
 
+/// The sync groups of a side-by-side display, by the left edge of their area
+auto sync_groups_by_left_edge(mg::Display& display) -> std::map<int, mg::DisplaySyncGroup*>
+{
+    std::map<int, mg::DisplaySyncGroup*> groups;
+
+    display.for_each_display_sync_group(
+        [&](mg::DisplaySyncGroup& group)
+        {
+            group.for_each_display_buffer(
+                [&](mg::DisplayBuffer& buffer)
+                {
+                    groups[buffer.view_area().top_left.x.as_int()] = &group;
+                });
+        });
+
+    return groups;
+}
+
+/// Applies conf and returns the sync groups it removed
+auto apply_keeping_unchanged(mg::Display& display, mg::DisplayConfiguration const& conf)
+    -> std::vector<mg::DisplaySyncGroup*>
+{
+    std::vector<mg::DisplaySyncGroup*> removed;
+
+    EXPECT_TRUE(display.apply_if_configuration_preserves_unchanged_sync_groups(
+        conf,
+        [&](mg::DisplaySyncGroup& group) { removed.push_back(&group); }));
+
+    return removed;
+}
+
+int const second_output_left{1920};
+int const third_output_left{3840};
 }
 
 TEST_F(MesaDisplayMultiMonitorTest, create_display_sets_all_connected_crtcs)
@@ -594,3 +628,145 @@ TEST_F(MesaDisplayMultiMonitorTest, resume_clears_unused_connected_outputs)
                         .Times(1);
     }
 }
+
+TEST_F(MesaDisplayMultiMonitorTest, unchanged_sync_groups_are_kept_when_another_output_changes_mode)
+{
+    using namespace testing;
+
+    setup_outputs(3, 0);
+
+    auto display = create_display_side_by_side(create_platform());
+    auto const before = sync_groups_by_left_edge(*display);
+    ASSERT_THAT(before.size(), Eq(3u));
+
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.top_left.x.as_int() == third_output_left)
+                output.current_mode_index = 2;
+        });
+
+    Mock::VerifyAndClearExpectations(&mock_drm);
+
+    /* The outputs that keep their sync group are not modeset */
+    for (int i = 0; i != 2; ++i)
+    {
+        EXPECT_CALL(mock_drm, drmModeSetCrtc(mtd::IsFdOfDevice(drm_device), crtc_ids[i], _, _, _, _, _, _))
+            .Times(0);
+    }
+
+    auto const removed = apply_keeping_unchanged(*display, *conf);
+
+    Mock::VerifyAndClearExpectations(&mock_drm);
+
+    auto const after = sync_groups_by_left_edge(*display);
+
+    EXPECT_THAT(removed, ElementsAre(before.at(third_output_left)));
+    EXPECT_THAT(after.size(), Eq(3u));
+    EXPECT_THAT(after.at(0), Eq(before.at(0)));
+    EXPECT_THAT(after.at(second_output_left), Eq(before.at(second_output_left)));
+}
+
+TEST_F(MesaDisplayMultiMonitorTest, changed_sync_group_is_replaced)
+{
+    using namespace testing;
+
+    setup_outputs(3, 0);
+
+    auto display = create_display_side_by_side(create_platform());
+    auto const before = sync_groups_by_left_edge(*display);
+
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.top_left.x.as_int() == third_output_left)
+                output.orientation = mir_orientation_left;
+        });
+
+    Mock::VerifyAndClearExpectations(&mock_drm);
+
+    /* The changed output is modeset for its new sync group */
+    EXPECT_CALL(mock_drm, drmModeSetCrtc(mtd::IsFdOfDevice(drm_device), crtc_ids[2], _, _, _, _, _, _))
+        .Times(AtLeast(1));
+
+    auto const removed = apply_keeping_unchanged(*display, *conf);
+
+    Mock::VerifyAndClearExpectations(&mock_drm);
+
+    auto const after = sync_groups_by_left_edge(*display);
+
+    EXPECT_THAT(removed, ElementsAre(before.at(third_output_left)));
+    ASSERT_THAT(after.size(), Eq(3u));
+    EXPECT_THAT(after.at(third_output_left), Ne(before.at(third_output_left)));
+
+    after.at(third_output_left)->for_each_display_buffer(
+        [](mg::DisplayBuffer& buffer)
+        {
+            EXPECT_THAT(buffer.view_area().size, Eq(geom::Size{1080, 1920}));
+        });
+}
+
+TEST_F(MesaDisplayMultiMonitorTest, sync_group_of_an_output_no_longer_used_is_removed)
+{
+    using namespace testing;
+
+    setup_outputs(3, 0);
+
+    auto display = create_display_side_by_side(create_platform());
+    auto const before = sync_groups_by_left_edge(*display);
+
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.top_left.x.as_int() == third_output_left)
+                output.used = false;
+        });
+
+    auto const removed = apply_keeping_unchanged(*display, *conf);
+    auto const after = sync_groups_by_left_edge(*display);
+
+    EXPECT_THAT(removed, ElementsAre(before.at(third_output_left)));
+    EXPECT_THAT(after.size(), Eq(2u));
+    EXPECT_THAT(after.at(0), Eq(before.at(0)));
+    EXPECT_THAT(after.at(second_output_left), Eq(before.at(second_output_left)));
+}
+
+TEST_F(MesaDisplayMultiMonitorTest, sync_group_is_added_for_an_output_newly_used)
+{
+    using namespace testing;
+
+    setup_outputs(3, 0);
+
+    auto display = create_display_side_by_side(create_platform());
+
+    auto conf = display->configuration();
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.top_left.x.as_int() == third_output_left)
+                output.used = false;
+        });
+    display->configure(*conf);
+
+    auto const before = sync_groups_by_left_edge(*display);
+    ASSERT_THAT(before.size(), Eq(2u));
+
+    conf->for_each_output(
+        [&](mg::UserDisplayConfigurationOutput& output)
+        {
+            if (output.top_left.x.as_int() == third_output_left)
+                output.used = true;
+        });
+
+    auto const removed = apply_keeping_unchanged(*display, *conf);
+    auto const after = sync_groups_by_left_edge(*display);
+
+    EXPECT_THAT(removed, IsEmpty());
+    EXPECT_THAT(after.size(), Eq(3u));
+    EXPECT_THAT(after.at(0), Eq(before.at(0)));
+    EXPECT_THAT(after.at(second_output_left), Eq(before.at(second_output_left)));
+    EXPECT_THAT(after.count(third_output_left), Eq(1u));
+}
@@ -29,6 +29,7 @@
 #include <mir/test/doubles/mock_gl.h>
 #include <mir/test/doubles/mock_egl.h>
 #include <src/renderers/gl/renderer.h>
+#include <src/renderers/gl/program_cache.h>
 #include <mir/test/doubles/stub_gl_display_buffer.h>
 #include <mir/test/doubles/mock_gl_display_buffer.h>
 
@@ -40,6 +41,9 @@ using testing::Pointee;
 using testing::AnyNumber;
 using testing::AtLeast;
 using testing::DoAll;
+using testing::Contains;
+using testing::Invoke;
+using testing::StrEq;
 using testing::_;
 
 namespace mt=mir::test;
@@ -62,6 +66,26 @@ const GLint tex_uniform_location = 6;
 const GLint display_transform_uniform_location = 7;
 const GLint centre_uniform_location = 8;
 
+GLenum const num_program_binary_formats = 0x87FE;
+GLenum const program_binary_retrievable_hint = 0x8257;
+
+std::vector<GLuint> retrievable_programs;
+
+void stub_get_program_binary(GLuint, GLsizei, GLsizei* length, GLenum*, void*)
+{
+    *length = 0;
+}
+
+void stub_program_binary(GLuint, GLenum, void const*, GLint)
+{
+}
+
+void record_program_parameteri(GLuint program, GLenum pname, GLint value)
+{
+    if (pname == program_binary_retrievable_hint && value == GL_TRUE)
+        retrievable_programs.push_back(program);
+}
+
 void SetUpMockProgramData(mtd::MockGL &mock_gl)
 {
     /* Uniforms and Attributes */
@@ -466,3 +490,33 @@ TEST_F(GLRenderer, sets_viewport_downscaled_wide)
 
     mrg::Renderer renderer(mock_display_buffer);
 }
+
+TEST_F(GLRenderer, without_a_program_cache_does_not_look_for_program_binaries)
+{
+    EXPECT_CALL(mock_gl, glGetIntegerv(num_program_binary_formats, _)).Times(0);
+
+    mrg::Renderer renderer(display_buffer);
+}
+
+TEST_F(GLRenderer, with_a_program_cache_asks_for_retrievable_programs_before_linking)
+{
+    using generic_function_pointer_t = mtd::MockEGL::generic_function_pointer_t;
+
+    ON_CALL(mock_gl, glGetString(GL_EXTENSIONS))
+        .WillByDefault(Return(reinterpret_cast<GLubyte const*>("GL_ARB_get_program_binary")));
+    ON_CALL(mock_gl, glGetIntegerv(num_program_binary_formats, _))
+        .WillByDefault(SetArgPointee<1>(1));
+    ON_CALL(mock_egl, eglGetProcAddress(StrEq("glGetProgramBinary")))
+        .WillByDefault(Return(reinterpret_cast<generic_function_pointer_t>(&stub_get_program_binary)));
+    ON_CALL(mock_egl, eglGetProcAddress(StrEq("glProgramBinary")))
+        .WillByDefault(Return(reinterpret_cast<generic_function_pointer_t>(&stub_program_binary)));
+    ON_CALL(mock_egl, eglGetProcAddress(StrEq("glProgramParameteri")))
+        .WillByDefault(Return(reinterpret_cast<generic_function_pointer_t>(&record_program_parameteri)));
+
+    retrievable_programs.clear();
+    EXPECT_CALL(mock_gl, glLinkProgram(_))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke([](GLuint program) { EXPECT_THAT(retrievable_programs, Contains(program)); }));
+
+    mrg::Renderer renderer(display_buffer, std::make_shared<mrg::ProgramCache>(""));
+}
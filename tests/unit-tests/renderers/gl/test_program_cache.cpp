@@ -0,0 +1,146 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <src/renderers/gl/program_cache.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <system_error>
+
+#include <dirent.h>
+#include <unistd.h>
+
+using namespace testing;
+namespace mrg = mir::renderer::gl;
+
+namespace
+{
+char const* const vertex_src = "void main() { gl_Position = vec4(0.0); }\n";
+char const* const fragment_src = "void main() { gl_FragColor = vec4(1.0); }\n";
+char const* const driver = "Vendor\nRenderer\n3.0 Mesa 20.0\n";
+
+struct GLProgramCache : Test
+{
+    GLProgramCache()
+    {
+        // Can't use std::string, as mkdtemp mutates its argument.
+        auto tmp_name = std::unique_ptr<char[], std::function<void(char*)>>{strdup("/tmp/mir_program_cache_XXXXXX"),
+                                                                            [](char* data) {free(data);}};
+        if (mkdtemp(tmp_name.get()) == NULL)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        }
+        directory = std::string{tmp_name.get()};
+    }
+
+    ~GLProgramCache()
+    {
+        if (auto const dir = opendir(directory.c_str()))
+        {
+            while (auto const entry = readdir(dir))
+            {
+                if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, ".."))
+                    unlink((directory + "/" + entry->d_name).c_str());
+            }
+            closedir(dir);
+        }
+        rmdir(directory.c_str());
+    }
+
+    std::string directory;
+    std::string const key{mrg::ProgramCache::key_for(driver, vertex_src, fragment_src)};
+    mrg::ProgramCache::Binary const binary{0x1234, {'b', 'i', 'n', 'a', 'r', 'y'}};
+};
+}
+
+TEST_F(GLProgramCache, keys_depend_on_driver_and_sources)
+{
+    EXPECT_THAT(mrg::ProgramCache::key_for(driver, vertex_src, fragment_src), Eq(key));
+    EXPECT_THAT(mrg::ProgramCache::key_for("Other driver", vertex_src, fragment_src), Ne(key));
+    EXPECT_THAT(mrg::ProgramCache::key_for(driver, fragment_src, vertex_src), Ne(key));
+    EXPECT_THAT(mrg::ProgramCache::key_for(driver, vertex_src, "void main() {}\n"), Ne(key));
+}
+
+TEST_F(GLProgramCache, misses_until_a_binary_is_inserted)
+{
+    mrg::ProgramCache cache{directory};
+
+    EXPECT_THAT(cache.find(key), IsNull());
+
+    cache.insert(key, binary);
+
+    auto const found = cache.find(key);
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(binary.format));
+    EXPECT_THAT(found->data, ContainerEq(binary.data));
+}
+
+TEST_F(GLProgramCache, binaries_persist_between_instances)
+{
+    mrg::ProgramCache{directory}.insert(key, binary);
+
+    auto const found = mrg::ProgramCache{directory}.find(key);
+
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(binary.format));
+    EXPECT_THAT(found->data, ContainerEq(binary.data));
+}
+
+TEST_F(GLProgramCache, without_a_directory_binaries_are_kept_in_memory_only)
+{
+    mrg::ProgramCache cache{""};
+
+    cache.insert(key, binary);
+
+    EXPECT_THAT(cache.find(key), NotNull());
+    EXPECT_THAT(mrg::ProgramCache{""}.find(key), IsNull());
+}
+
+TEST_F(GLProgramCache, erased_binaries_are_removed_from_disk)
+{
+    mrg::ProgramCache cache{directory};
+    cache.insert(key, binary);
+
+    cache.erase(key);
+
+    EXPECT_THAT(cache.find(key), IsNull());
+    EXPECT_THAT(mrg::ProgramCache{directory}.find(key), IsNull());
+}
+
+TEST_F(GLProgramCache, ignores_files_it_did_not_write)
+{
+    std::ofstream{directory + "/" + key + ".bin"} << "not a program binary";
+
+    EXPECT_THAT(mrg::ProgramCache{directory}.find(key), IsNull());
+}
+
+TEST_F(GLProgramCache, creates_missing_directories)
+{
+    auto const nested = directory + "/mir/gl-programs";
+    mrg::ProgramCache{nested}.insert(key, binary);
+
+    EXPECT_THAT(mrg::ProgramCache{nested}.find(key), NotNull());
+
+    unlink((nested + "/" + key + ".bin").c_str());
+    rmdir(nested.c_str());
+    rmdir((directory + "/mir").c_str());
+}
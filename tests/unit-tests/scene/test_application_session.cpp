@@ -127,6 +127,10 @@ struct StubSurfaceStack : public msh::SurfaceStack
     {
         return std::shared_ptr<ms::Surface>{};
     }
+    void apply_atomically(std::function<void()> const& changes) override
+    {
+        changes();
+    }
 };
 
 struct ApplicationSession : public testing::Test
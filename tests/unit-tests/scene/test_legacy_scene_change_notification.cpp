@@ -18,6 +18,7 @@
 
 #include "mir/scene/legacy_scene_change_notification.h"
 #include "mir/scene/surface_observer.h"
+#include "mir/geometry/rectangle.h"
 
 #include "mir/test/fake_shared.h"
 #include "mir/test/doubles/mock_surface.h"
@@ -39,6 +40,10 @@ struct MockBufferCallback
 {
     MOCK_METHOD1(invoke, void(int));
 };
+struct MockDamageCallback
+{
+    MOCK_METHOD2(invoke, void(int, mir::geometry::Rectangle const&));
+};
 
 struct LegacySceneChangeNotificationTest : public testing::Test
 {
@@ -65,6 +70,29 @@ TEST_F(LegacySceneChangeNotificationTest, fowards_all_observations_to_callback)
     observer.surfaces_reordered();
 }
 
+TEST_F(LegacySceneChangeNotificationTest, forwards_scene_damage_to_damage_callback)
+{
+    using namespace ::testing;
+    mir::geometry::Rectangle const damage{{1, 2}, {3, 4}};
+    MockDamageCallback damage_callback;
+
+    EXPECT_CALL(scene_callback, invoke()).Times(0);
+    EXPECT_CALL(damage_callback, invoke(1, damage)).Times(1);
+
+    ms::LegacySceneChangeNotification observer(
+        scene_change_callback,
+        [&](int frames, mir::geometry::Rectangle const& damage) { damage_callback.invoke(frames, damage); });
+    observer.scene_damaged(damage);
+}
+
+TEST_F(LegacySceneChangeNotificationTest, without_damage_callback_scene_damage_is_a_scene_change)
+{
+    EXPECT_CALL(scene_callback, invoke()).Times(1);
+
+    ms::LegacySceneChangeNotification observer(scene_change_callback, buffer_change_callback);
+    observer.scene_damaged({{1, 2}, {3, 4}});
+}
+
 TEST_F(LegacySceneChangeNotificationTest, registers_observer_with_surfaces)
 {
     EXPECT_CALL(*surface, add_observer(testing::_))
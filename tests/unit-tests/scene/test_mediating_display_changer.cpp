@@ -25,6 +25,7 @@
 
 #include "mir/test/doubles/mock_display.h"
 #include "mir/test/doubles/mock_compositor.h"
+#include "mir/test/doubles/null_display_sync_group.h"
 #include "mir/test/doubles/null_display_configuration.h"
 #include "mir/test/doubles/stub_display_configuration.h"
 #include "mir/test/doubles/mock_scene_session.h"
@@ -259,6 +260,33 @@ TEST_F(MediatingDisplayChangerTest, handles_hardware_change_when_display_buffers
     changer->configure_for_hardware_change(mt::fake_shared(conf));
 }
 
+TEST_F(MediatingDisplayChangerTest, handles_hardware_change_replacing_only_changed_sync_groups_where_supported)
+{
+    using namespace testing;
+    mtd::NullDisplayConfiguration conf;
+    mtd::StubDisplaySyncGroup removed_group{geom::Size{10, 10}};
+
+    ON_CALL(mock_display, apply_if_configuration_preserves_display_buffers(_))
+        .WillByDefault(Return(false));
+
+    EXPECT_CALL(mock_compositor, stop()).Times(0);
+    EXPECT_CALL(mock_display, configure(_)).Times(0);
+    EXPECT_CALL(mock_compositor, start()).Times(0);
+
+    InSequence s;
+    EXPECT_CALL(mock_display, apply_if_configuration_preserves_unchanged_sync_groups(Ref(conf), _))
+        .WillOnce(Invoke(
+            [&](auto const&, auto const& remove_sync_group)
+            {
+                remove_sync_group(removed_group);
+                return true;
+            }));
+    EXPECT_CALL(mock_compositor, remove_display_sync_group(Ref(removed_group)));
+    EXPECT_CALL(mock_compositor, add_new_display_sync_groups());
+
+    changer->configure_for_hardware_change(mt::fake_shared(conf));
+}
+
 TEST_F(MediatingDisplayChangerTest, handles_error_when_applying_hardware_change)
 {
     using namespace testing;
@@ -323,8 +351,8 @@ TEST_F(MediatingDisplayChangerTest, handles_hardware_change_when_display_buffers
     EXPECT_CALL(mock_conf_policy, apply_to(Ref(*conf)));
 
     /*
-     * Currently we have to tear down and recreate the compositor in order to add
-     * a new output. This is not an inherent limitation, and we might do better later.
+     * When the display can't add an output without replacing every sync group
+     * we have to tear down and recreate the compositor.
      */
     EXPECT_CALL(mock_compositor, stop()).Times(1);
     EXPECT_CALL(mock_display, configure(Ref(*conf)));
@@ -451,8 +479,8 @@ TEST_F(MediatingDisplayChangerTest, focusing_a_session_with_db_preserving_but_ou
     changer->configure(session1, conf);
 
     /*
-     * Currently we have to tear down and recreate the compositor in order to add
-     * a new output. This is not an inherent limitation, and we might do better later.
+     * When the display can't add an output without replacing every sync group
+     * we have to tear down and recreate the compositor.
      */
     InSequence s;
     EXPECT_CALL(mock_compositor, stop()).Times(1);
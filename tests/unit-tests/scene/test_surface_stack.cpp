@@ -79,6 +79,7 @@ struct MockSceneObserver : public ms::Observer
     MOCK_METHOD1(surface_removed, void(std::shared_ptr<ms::Surface> const&));
     MOCK_METHOD0(surfaces_reordered, void());
     MOCK_METHOD0(scene_changed, void());
+    MOCK_METHOD1(scene_damaged, void(geom::Rectangle const&));
 
     MOCK_METHOD1(surface_exists, void(std::shared_ptr<ms::Surface> const&));
     MOCK_METHOD0(end_observation, void());
@@ -625,6 +626,52 @@ TEST_F(SurfaceStack, scene_elements_hold_snapshot_of_positioning_info)
         EXPECT_THAT(changed_position, testing::Ne(element->renderable()->screen_position().top_left));
 }
 
+TEST_F(SurfaceStack, scene_elements_are_not_snapshot_part_way_through_atomic_changes)
+{
+    using namespace testing;
+
+    stack.add_surface(stub_surface1, default_params.input_mode);
+    stack.add_surface(stub_surface2, default_params.input_mode);
+
+    auto const changed_position = geom::Point{43,44};
+    std::future<mc::SceneElementSequence> elements;
+
+    stack.apply_atomically([&]
+        {
+            stub_surface1->move_to(changed_position);
+
+            elements = std::async(std::launch::async, [&]{ return stack.scene_elements_for(compositor_id); });
+            EXPECT_THAT(elements.wait_for(std::chrono::milliseconds{50}), Eq(std::future_status::timeout));
+
+            stub_surface2->move_to(changed_position);
+        });
+
+    for (auto& element : elements.get())
+        EXPECT_THAT(element->renderable()->screen_position().top_left, Eq(changed_position));
+}
+
+TEST_F(SurfaceStack, scene_observers_are_notified_once_atomic_changes_are_complete)
+{
+    using namespace testing;
+
+    MockSceneObserver observer;
+    bool changes_complete{false};
+
+    stack.add_surface(stub_surface1, default_params.input_mode);
+    stack.add_observer(mt::fake_shared(observer));
+
+    EXPECT_CALL(observer, scene_changed())
+        .WillOnce(Invoke([&]{ EXPECT_TRUE(changes_complete); }));
+
+    stack.apply_atomically([&]
+        {
+            stack.emit_scene_changed();
+            stack.raise(stub_surface1);
+            stack.emit_scene_changed();
+            changes_complete = true;
+        });
+}
+
 TEST_F(SurfaceStack, generates_scene_elements_that_delay_buffer_acquisition)
 {
     using namespace testing;
@@ -931,6 +978,31 @@ TEST_F(SurfaceStack, scene_observers_notified_of_generic_scene_change)
     stack.emit_scene_changed();
 }
 
+TEST_F(SurfaceStack, scene_observers_notified_of_scene_damage)
+{
+    MockSceneObserver o1, o2;
+    geom::Rectangle const damage{{10, 20}, {24, 24}};
+
+    EXPECT_CALL(o1, scene_damaged(damage)).Times(1);
+    EXPECT_CALL(o2, scene_damaged(damage)).Times(1);
+    EXPECT_CALL(o1, scene_changed()).Times(0);
+    EXPECT_CALL(o2, scene_changed()).Times(0);
+
+    stack.add_observer(mt::fake_shared(o1));
+    stack.add_observer(mt::fake_shared(o2));
+
+    stack.emit_scene_damaged(damage);
+}
+
+TEST_F(SurfaceStack, scene_damage_does_not_leave_frames_pending_for_all_compositors)
+{
+    using namespace testing;
+
+    stack.emit_scene_damaged({{10, 20}, {24, 24}});
+
+    EXPECT_THAT(stack.frames_pending(this), Eq(0));
+}
+
 TEST_F(SurfaceStack, for_each_enumerates_all_input_surfaces)
 {
     using namespace ::testing;
@@ -35,6 +35,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <set>
+
 namespace ms = mir::scene;
 namespace mi = mir::input;
 namespace mc = mir::compositor;
@@ -318,6 +320,15 @@ TEST_F(DecorationBasicDecoration, redrawn_on_focus_state_change)
     Mock::VerifyAndClearExpectations(&buffer_stream);
 }
 
+TEST_F(DecorationBasicDecoration, not_redrawn_on_window_resize)
+{
+    EXPECT_CALL(buffer_stream, submit_buffer(_))
+        .Times(0);
+    window_surface.resize({203, 305});
+    executor.execute();
+    Mock::VerifyAndClearExpectations(&buffer_stream);
+}
+
 TEST_F(DecorationBasicDecoration, decoration_resized_on_window_resize)
 {
     geom::Size new_size{203, 305};
@@ -368,7 +379,7 @@ TEST_F(DecorationBasicDecoration, padding_comes_back_when_restored)
     EXPECT_THAT(window_surface.content_size().height, Lt(window_surface.window_size().height));
 }
 
-TEST_F(DecorationBasicDecoration, four_decoration_streams_when_restored)
+TEST_F(DecorationBasicDecoration, ten_decoration_streams_when_restored)
 {
     window_surface.configure(mir_window_attrib_state, mir_window_state_maximized);
     executor.execute();
@@ -380,7 +391,9 @@ TEST_F(DecorationBasicDecoration, four_decoration_streams_when_restored)
     window_surface.configure(mir_window_attrib_state, mir_window_state_restored);
     executor.execute();
     ASSERT_TRUE(spec.streams.is_set());
-    EXPECT_THAT(spec.streams.value().size(), Eq(4)); // Titlebar and left, right and bottom borders
+    // Titlebar, a background and an icon for each of three buttons, and left, right and bottom borders
+    // (the window has no name, so no title)
+    EXPECT_THAT(spec.streams.value().size(), Eq(10));
 }
 
 TEST_F(DecorationBasicDecoration, input_area_contains_borders_when_restored)
@@ -403,6 +416,52 @@ TEST_F(DecorationBasicDecoration, input_area_contains_borders_when_restored)
                 << "   Point: " << y_strs[y] << "-" << x_strs[x] << " " << points[y][x];
 }
 
+TEST_F(DecorationBasicDecoration, every_stream_has_a_buffer_when_restored_after_being_created_maximized)
+{
+    basic_decoration.reset();
+    executor.execute();
+
+    std::vector<std::shared_ptr<NiceMock<mtd::MockBufferStream>>> streams;
+    std::set<mc::BufferStream const*> streams_with_buffers;
+    ON_CALL(*session, create_buffer_stream(_))
+        .WillByDefault(Invoke([&](mir::graphics::BufferProperties const&) -> std::shared_ptr<mc::BufferStream>
+            {
+                auto const stream = std::make_shared<NiceMock<mtd::MockBufferStream>>();
+                ON_CALL(*stream, submit_buffer(_))
+                    .WillByDefault(InvokeWithoutArgs([&streams_with_buffers, raw = stream.get()]()
+                        {
+                            streams_with_buffers.insert(raw);
+                        }));
+                streams.push_back(stream);
+                return stream;
+            }));
+
+    window_surface.configure(mir_window_attrib_state, mir_window_state_maximized);
+    basic_decoration = std::make_shared<msd::BasicDecoration>(
+        mt::fake_shared(shell),
+        mt::fake_shared(buffer_allocator),
+        mt::fake_shared(executor),
+        mt::fake_shared(cursor_images),
+        mt::fake_shared(window_surface));
+    executor.execute();
+
+    std::shared_ptr<ms::Surface> decoration_surface_{mt::fake_shared(decoration_surface)};
+    msh::SurfaceSpecification spec;
+    EXPECT_CALL(shell, did_modify_surface(decoration_surface_, _))
+        .WillRepeatedly(SaveArg<1>(&spec));
+    window_surface.configure(mir_window_attrib_state, mir_window_state_restored);
+    executor.execute();
+
+    ASSERT_TRUE(spec.streams.is_set());
+    ASSERT_THAT(spec.streams.value().size(), Eq(10));
+    for (auto const& stream : spec.streams.value())
+    {
+        auto const shown = std::dynamic_pointer_cast<mc::BufferStream>(stream.stream.lock());
+        EXPECT_THAT(streams_with_buffers.count(shown.get()), Eq(1u))
+            << "stream displaced by " << stream.displacement << " has no buffer";
+    }
+}
+
 // Maximized window tests (should only have titlebar)
 
 TEST_F(DecorationBasicDecoration, only_has_titlebar_padding_when_maximized)
@@ -413,7 +472,7 @@ TEST_F(DecorationBasicDecoration, only_has_titlebar_padding_when_maximized)
     EXPECT_THAT(window_surface.content_size().height, Lt(window_surface.window_size().height));
 }
 
-TEST_F(DecorationBasicDecoration, one_decoration_stream_when_maximized)
+TEST_F(DecorationBasicDecoration, seven_decoration_streams_when_maximized)
 {
     std::shared_ptr<ms::Surface> decoration_surface_{mt::fake_shared(decoration_surface)};
     msh::SurfaceSpecification spec;
@@ -423,7 +482,7 @@ TEST_F(DecorationBasicDecoration, one_decoration_stream_when_maximized)
     window_surface.configure(mir_window_attrib_state, mir_window_state_maximized);
     executor.execute();
     ASSERT_TRUE(spec.streams.is_set());
-    EXPECT_THAT(spec.streams.value().size(), Eq(1)); // Titlebar only
+    EXPECT_THAT(spec.streams.value().size(), Eq(7)); // Titlebar and its buttons only
 }
 
 TEST_F(DecorationBasicDecoration, input_area_contains_only_top_bar_when_maximized)
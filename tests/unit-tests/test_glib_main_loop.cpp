@@ -1045,6 +1045,42 @@ TEST_F(GLibMainLoopAlarmTest, multiple_alarms_fire)
         EXPECT_EQ(mir::time::Alarm::triggered, alarm->state());
 }
 
+TEST_F(GLibMainLoopAlarmTest, alarms_due_in_one_iteration_fire_in_order_of_their_deadlines)
+{
+    using namespace testing;
+
+    std::vector<int> const delays_ms{7000, 5, 300, 64, 65, 4096, 1};
+    std::vector<int> fired;
+    std::vector<std::unique_ptr<mir::time::Alarm>> alarms;
+
+    for (auto const delay_ms : delays_ms)
+    {
+        alarms.push_back(ml.create_alarm([&fired, delay_ms]{ fired.push_back(delay_ms); }));
+        alarms.back()->reschedule_in(std::chrono::milliseconds{delay_ms});
+    }
+
+    UnblockMainLoop unblocker(ml);
+    clock->advance_by(std::chrono::seconds{10}, ml);
+
+    EXPECT_THAT(fired, ElementsAre(1, 5, 64, 65, 300, 4096, 7000));
+}
+
+TEST_F(GLibMainLoopAlarmTest, alarm_cancelled_by_another_due_at_the_same_time_doesnt_fire)
+{
+    std::unique_ptr<mir::time::Alarm> second;
+    auto first = ml.create_alarm([&second]{ second->cancel(); });
+    second = ml.create_alarm([]{});
+
+    first->reschedule_in(delay);
+    second->reschedule_in(delay);
+
+    UnblockMainLoop unblocker(ml);
+    clock->advance_by(delay, ml);
+
+    EXPECT_EQ(mir::time::Alarm::triggered, first->state());
+    EXPECT_EQ(mir::time::Alarm::cancelled, second->state());
+}
+
 TEST_F(GLibMainLoopAlarmTest, alarm_changes_to_triggered_state)
 {
     auto alarm_fired = std::make_shared<mt::Signal>();
@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/per_thread_rings.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <thread>
+
+using namespace testing;
+
+namespace
+{
+struct Ring : mir::PerThreadRing
+{
+};
+
+struct PerThreadRings : Test
+{
+    auto ring_for_this_thread(mir::PerThreadRings<Ring>& owner) -> Ring&
+    {
+        return owner.for_this_thread([this]
+            {
+                auto const ring = std::make_shared<Ring>();
+                created.push_back(ring);
+                return ring;
+            });
+    }
+
+    auto ring_on_another_thread(mir::PerThreadRings<Ring>& owner) -> Ring*
+    {
+        Ring* result = nullptr;
+        std::thread{[&] { result = &ring_for_this_thread(owner); }}.join();
+        return result;
+    }
+
+    mir::PerThreadRings<Ring> owner;
+    std::vector<std::shared_ptr<Ring>> created;
+};
+}
+
+TEST_F(PerThreadRings, a_thread_gets_the_same_ring_each_time)
+{
+    auto const first = &ring_for_this_thread(owner);
+
+    EXPECT_THAT(&ring_for_this_thread(owner), Eq(first));
+    EXPECT_THAT(created.size(), Eq(1u));
+}
+
+TEST_F(PerThreadRings, each_thread_and_owner_gets_a_ring_of_its_own)
+{
+    mir::PerThreadRings<Ring> other_owner;
+
+    auto const mine = &ring_for_this_thread(owner);
+
+    EXPECT_THAT(&ring_for_this_thread(other_owner), Ne(mine));
+    EXPECT_THAT(ring_on_another_thread(owner), Ne(mine));
+    EXPECT_THAT(created.size(), Eq(3u));
+}
+
+TEST_F(PerThreadRings, ring_is_marked_when_its_thread_exits)
+{
+    ring_on_another_thread(owner);
+    ring_for_this_thread(owner);
+
+    ASSERT_THAT(created.size(), Eq(2u));
+    EXPECT_TRUE(created[0]->thread_exited);
+    EXPECT_FALSE(created[1]->thread_exited);
+}
+
+TEST_F(PerThreadRings, thread_forgets_the_rings_of_destroyed_owners)
+{
+    {
+        mir::PerThreadRings<Ring> destroyed_owner;
+        ring_for_this_thread(destroyed_owner);
+    }
+    created.front()->owner_destroyed = true;
+
+    std::weak_ptr<Ring> const forgotten = created.front();
+    created.clear();
+
+    // The next lookup, for any owner, lets go of it
+    ring_for_this_thread(owner);
+
+    EXPECT_TRUE(forgotten.expired());
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/time/timer_wheel.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+
+namespace mt = mir::time;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct TimerWheel : Test
+{
+    auto advance_by(mt::Duration step) -> std::vector<mt::TimerWheel::Timer*>
+    {
+        now += step;
+        return wheel.advance_to(now);
+    }
+
+    mt::Timestamp const origin{std::chrono::hours{1}};
+    mt::Timestamp now{origin};
+    mt::TimerWheel wheel{origin, 1ms};
+};
+}
+
+TEST_F(TimerWheel, empty_wheel_has_no_next_event)
+{
+    EXPECT_THAT(wheel.next_event(), Eq(mt::Timestamp::max()));
+    EXPECT_THAT(advance_by(1h), IsEmpty());
+}
+
+TEST_F(TimerWheel, timer_comes_due_at_its_expiry_and_not_before)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, now + 120ms);
+
+    EXPECT_THAT(advance_by(119ms), IsEmpty());
+    EXPECT_TRUE(timer.is_scheduled());
+
+    EXPECT_THAT(advance_by(1ms), ElementsAre(&timer));
+    EXPECT_FALSE(timer.is_scheduled());
+}
+
+TEST_F(TimerWheel, expiry_is_rounded_up_to_a_whole_tick)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, now + 1500us);
+
+    EXPECT_THAT(advance_by(1500us), IsEmpty());
+    EXPECT_THAT(advance_by(500us), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheel, timer_in_the_past_is_due_immediately)
+{
+    advance_by(1s);
+
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, origin);
+
+    EXPECT_THAT(wheel.next_event(), Le(now));
+    EXPECT_THAT(wheel.advance_to(now), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheel, cancelled_timer_does_not_come_due)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, now + 10ms);
+    wheel.cancel(timer);
+
+    EXPECT_FALSE(timer.is_scheduled());
+    EXPECT_THAT(wheel.next_event(), Eq(mt::Timestamp::max()));
+    EXPECT_THAT(advance_by(20ms), IsEmpty());
+}
+
+TEST_F(TimerWheel, rescheduling_replaces_the_previous_expiry)
+{
+    mt::TimerWheel::Timer timer;
+    wheel.schedule(timer, now + 10ms);
+    wheel.schedule(timer, now + 10min);
+
+    EXPECT_THAT(advance_by(10ms), IsEmpty());
+    EXPECT_THAT(advance_by(10min - 10ms), ElementsAre(&timer));
+}
+
+TEST_F(TimerWheel, next_event_is_no_later_than_the_earliest_expiry)
+{
+    mt::TimerWheel::Timer soon, later;
+    wheel.schedule(later, now + 2h);
+    wheel.schedule(soon, now + 5s);
+
+    EXPECT_THAT(wheel.next_event(), AllOf(Gt(now), Le(now + 5s)));
+}
+
+TEST_F(TimerWheel, timers_expiring_in_the_same_tick_come_due_together_in_the_order_scheduled)
+{
+    mt::TimerWheel::Timer first, second, third;
+    wheel.schedule(first, now + 3s + 100us);
+    wheel.schedule(second, now + 3s + 900us);
+    wheel.schedule(third, now + 3s + 1ms);
+
+    EXPECT_THAT(advance_by(3s + 1ms), ElementsAre(&first, &second, &third));
+}
+
+TEST_F(TimerWheel, timers_far_apart_come_due_in_order_of_expiry)
+{
+    std::vector<mt::Duration> const delays{1ms, 63ms, 64ms, 65ms, 4095ms, 4096ms, 5min, 6h, 40h, 3000h};
+    std::vector<mt::TimerWheel::Timer> timers(delays.size());
+
+    // Schedule in reverse so that order of scheduling can't explain the result
+    for (auto i = delays.size(); i-- != 0;)
+        wheel.schedule(timers[i], now + delays[i]);
+
+    for (auto i = 0u; i != delays.size(); ++i)
+    {
+        auto const step = delays[i] - (i ? delays[i - 1] : mt::Duration::zero());
+        EXPECT_THAT(advance_by(step - 1ms), IsEmpty()) << "delay #" << i;
+        EXPECT_THAT(advance_by(1ms), ElementsAre(&timers[i])) << "delay #" << i;
+    }
+}
+
+TEST_F(TimerWheel, one_big_step_returns_everything_due_in_order_of_expiry)
+{
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> milliseconds{0, 10'000'000};
+
+    std::vector<mt::TimerWheel::Timer> timers(1000);
+    std::vector<std::pair<mt::Timestamp, mt::TimerWheel::Timer*>> expected;
+    for (auto& timer : timers)
+    {
+        auto const expiry = now + std::chrono::milliseconds{milliseconds(random)};
+        wheel.schedule(timer, expiry);
+        expected.emplace_back(expiry, &timer);
+    }
+    std::stable_sort(begin(expected), end(expected),
+        [](auto const& a, auto const& b) { return a.first < b.first; });
+
+    auto const due = advance_by(3h);
+
+    ASSERT_THAT(due.size(), Eq(timers.size()));
+    for (auto i = 0u; i != due.size(); ++i)
+    {
+        EXPECT_THAT(due[i]->is_scheduled(), Eq(false));
+        EXPECT_THAT(due[i], Eq(expected[i].second)) << "timer #" << i;
+    }
+}
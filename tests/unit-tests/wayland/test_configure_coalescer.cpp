@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/configure_coalescer.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+struct MockWindow
+{
+    MOCK_METHOD1(handle_state_change, void(MirWindowState));
+    MOCK_METHOD2(handle_resize, void(std::experimental::optional<geom::Point> const&, geom::Size const&));
+};
+
+struct ConfigureCoalescer : Test
+{
+    /// Runs the work scheduled for the Wayland thread
+    void catch_up()
+    {
+        auto const work = std::move(scheduled);
+        scheduled.clear();
+        for (auto const& item : work)
+            item();
+    }
+
+    geom::Size const client_size{640, 480};
+    geom::Size const other_size{800, 600};
+    geom::Point const top_left{12, 34};
+
+    std::vector<std::function<void()>> scheduled;
+    StrictMock<MockWindow> window;
+    mf::ConfigureCoalescer configure{
+        [this](std::function<void()>&& work) { scheduled.push_back(std::move(work)); },
+        [this](MirWindowState state) { window.handle_state_change(state); },
+        [this](std::experimental::optional<geom::Point> const& top_left, geom::Size const& size)
+        {
+            window.handle_resize(top_left, size);
+        }};
+};
+}
+
+TEST_F(ConfigureCoalescer, state_change_and_resize_are_sent_as_one_configure)
+{
+    configure.latest_client_size(client_size);
+
+    EXPECT_CALL(window, handle_resize(Eq(std::experimental::nullopt), other_size));
+
+    configure.state_changed_to(mir_window_state_maximized);
+    configure.resized_to(other_size);
+
+    EXPECT_THAT(scheduled.size(), Eq(1u));
+    catch_up();
+
+    EXPECT_THAT(configure.state(), Eq(mir_window_state_maximized));
+    EXPECT_THAT(configure.requested_window_size(), Eq(std::experimental::make_optional(other_size)));
+}
+
+TEST_F(ConfigureCoalescer, resize_to_the_same_size_with_a_state_change_sends_the_state)
+{
+    configure.latest_client_size(client_size);
+
+    EXPECT_CALL(window, handle_state_change(mir_window_state_maximized));
+
+    configure.resized_to(client_size);
+    configure.state_changed_to(mir_window_state_maximized);
+    catch_up();
+
+    EXPECT_THAT(configure.state(), Eq(mir_window_state_maximized));
+}
+
+TEST_F(ConfigureCoalescer, resize_to_the_same_size_alone_sends_nothing)
+{
+    configure.latest_client_size(client_size);
+
+    configure.resized_to(client_size);
+    catch_up();
+}
+
+TEST_F(ConfigureCoalescer, later_resize_keeps_top_left_of_placement)
+{
+    configure.latest_client_size(client_size);
+
+    EXPECT_CALL(window, handle_resize(Eq(std::experimental::make_optional(top_left)), other_size));
+
+    configure.placed_at({top_left, client_size});
+    configure.resized_to(other_size);
+    catch_up();
+}
+
+TEST_F(ConfigureCoalescer, placement_at_the_client_size_is_sent)
+{
+    configure.latest_client_size(client_size);
+
+    EXPECT_CALL(window, handle_resize(Eq(std::experimental::make_optional(top_left)), client_size));
+
+    configure.placed_at({top_left, client_size});
+    catch_up();
+}
+
+TEST_F(ConfigureCoalescer, changes_after_a_configure_is_sent_are_sent_separately)
+{
+    configure.latest_client_size(client_size);
+
+    InSequence seq;
+    EXPECT_CALL(window, handle_state_change(mir_window_state_maximized));
+    EXPECT_CALL(window, handle_state_change(mir_window_state_restored));
+
+    configure.state_changed_to(mir_window_state_maximized);
+    catch_up();
+    configure.state_changed_to(mir_window_state_restored);
+    catch_up();
+}
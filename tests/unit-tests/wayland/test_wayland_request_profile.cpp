@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2020 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/wayland_request_profile.h"
+
+#include <wayland-server-core.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace mw = mir::wayland;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct MockRequestReport : mw::RequestReport
+{
+    MOCK_METHOD5(request_handled, void(wl_client*, char const*, uint32_t, char const*, std::chrono::steady_clock::duration));
+};
+
+char const* const surface = "wl_surface";
+char const* const pointer = "wl_pointer";
+
+struct WaylandRequestProfile : Test
+{
+    WaylandRequestProfile()
+    {
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds);
+        client_fd = fds[1];
+        client = wl_client_create(display, fds[0]);
+    }
+
+    ~WaylandRequestProfile()
+    {
+        mw::set_request_report(nullptr);
+        wl_client_destroy(client);
+        close(client_fd);
+        wl_display_destroy(display);
+    }
+
+    wl_display* const display{wl_display_create()};
+    int client_fd;
+    wl_client* client;
+    mf::WaylandRequestProfile profile;
+};
+}
+
+TEST_F(WaylandRequestProfile, handled_requests_are_reported)
+{
+    auto const report = std::make_shared<NiceMock<MockRequestReport>>();
+    mw::set_request_report(report);
+
+    EXPECT_CALL(*report, request_handled(client, StrEq(surface), 6, StrEq("commit"), Ge(0ns)));
+
+    mw::RequestTimer{client, surface, 6, "commit"};
+}
+
+TEST_F(WaylandRequestProfile, nothing_is_reported_once_the_report_is_cleared)
+{
+    auto const report = std::make_shared<NiceMock<MockRequestReport>>();
+    mw::set_request_report(report);
+    mw::set_request_report(nullptr);
+
+    EXPECT_CALL(*report, request_handled(_, _, _, _, _)).Times(0);
+
+    mw::RequestTimer{client, surface, 6, "commit"};
+}
+
+TEST_F(WaylandRequestProfile, requests_are_profiled_by_interface_and_opcode)
+{
+    profile.request_handled(client, surface, 6, "commit", 10us);
+    profile.request_handled(client, surface, 6, "commit", 30us);
+    profile.request_handled(client, surface, 1, "attach", 5us);
+    profile.request_handled(client, pointer, 0, "set_cursor", 100us);
+
+    auto const clients = profile.clients();
+
+    ASSERT_THAT(clients.size(), Eq(1u));
+    EXPECT_THAT(clients[0].pid, Eq(getpid()));
+    EXPECT_THAT(clients[0].handling.count, Eq(4u));
+    EXPECT_THAT(clients[0].handling.total, Eq(145us));
+
+    auto const& requests = clients[0].requests;
+    ASSERT_THAT(requests.size(), Eq(3u));
+
+    EXPECT_THAT(requests[0].interface_name, Eq(pointer));
+    EXPECT_THAT(requests[0].request_name, Eq("set_cursor"));
+
+    EXPECT_THAT(requests[1].interface_name, Eq(surface));
+    EXPECT_THAT(requests[1].opcode, Eq(6u));
+    EXPECT_THAT(requests[1].request_name, Eq("commit"));
+    EXPECT_THAT(requests[1].handling.count, Eq(2u));
+    EXPECT_THAT(requests[1].handling.total, Eq(40us));
+    EXPECT_THAT(requests[1].handling.max, Eq(30us));
+
+    EXPECT_THAT(requests[2].request_name, Eq("attach"));
+}
+
+TEST_F(WaylandRequestProfile, histogram_buckets_double_in_width)
+{
+    mf::WaylandRequestProfile::Histogram histogram;
+
+    histogram.add(500ns);
+    histogram.add(1us);
+    histogram.add(3us);
+    histogram.add(3us);
+    histogram.add(1s);
+
+    EXPECT_THAT(histogram.buckets[0], Eq(1u));
+    EXPECT_THAT(histogram.buckets[1], Eq(1u));
+    EXPECT_THAT(histogram.buckets[2], Eq(2u));
+    EXPECT_THAT(histogram.buckets.back(), Eq(1u));
+}
+
+TEST_F(WaylandRequestProfile, percentiles_are_bounded_by_their_bucket)
+{
+    mf::WaylandRequestProfile::Histogram histogram;
+
+    for (auto i = 0; i != 98; ++i)
+        histogram.add(3us);
+    histogram.add(100us);
+    histogram.add(150us);
+
+    EXPECT_THAT(histogram.percentile(0.5), Eq(4us));
+    EXPECT_THAT(histogram.percentile(0.99), Eq(128us));
+    EXPECT_THAT(histogram.percentile(1.0), Eq(150us));
+}
+
+TEST_F(WaylandRequestProfile, dumping_does_not_clear_the_profile)
+{
+    profile.request_handled(client, surface, 6, "commit", 10us);
+
+    profile.dump();
+
+    EXPECT_THAT(profile.clients().size(), Eq(1u));
+}